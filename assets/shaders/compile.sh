@@ -5,7 +5,15 @@ echo "Compiling HLSL shaders..."
 # Compile vertex shader
 dxc -T vs_6_0 -E vsmain -Fo bin/vertex.cso vertex.hlsl
 
+# Compile instanced vertex shader (per-instance transform / color stream)
+dxc -T vs_6_0 -E vsmain -Fo bin/instanced_vertex.cso instanced_vertex.hlsl
+
 # Compile pixel shader
 dxc -T ps_6_0 -E psmain -Fo bin/pixel.cso pixel.hlsl
 
+# Compile draw culling compute shaders (one entry point per step)
+dxc -T cs_6_0 -E cscount -Fo bin/cull_draws_count.cso cull_draws.hlsl
+dxc -T cs_6_0 -E csscan -Fo bin/cull_draws_scan.cso cull_draws.hlsl
+dxc -T cs_6_0 -E cswrite -Fo bin/cull_draws_write.cso cull_draws.hlsl
+
 echo "Shader compilation done."
@@ -0,0 +1,135 @@
+// GPU-driven draw culling + compaction (IndirectDrawCuller).
+// Three entry points, dispatched in order with UAV barriers on groupOffsets in between:
+//   cscount -> visible draws per group of 64
+//   csscan  -> exclusive scan of the group counts (one group), total -> drawCount
+//   cswrite -> every visible draw writes its arguments at its group's offset + its rank in the group
+// The output keeps the input order -> byte-identical to IndirectDrawReference on the CPU.
+
+#define GROUP_SIZE 64
+#define SCAN_GROUP_SIZE 1024
+
+struct IndirectDrawSource {
+    float4 sphere; // center xyz, radius w
+    uint indexCount;
+    uint startIndex;
+    int baseVertex;
+    uint constantsIndex;
+};
+
+// root constant + D3D12_DRAW_INDEXED_ARGUMENTS
+struct IndirectDrawArguments {
+    uint constantsIndex;
+    uint indexCountPerInstance;
+    uint instanceCount;
+    uint startIndexLocation;
+    int baseVertexLocation;
+    uint startInstanceLocation;
+};
+
+cbuffer CullConstants : register(b0)
+{
+    float4 planes[6];
+    uint drawCount;
+    uint groupCount;
+}
+
+StructuredBuffer<IndirectDrawSource> draws : register(t0);
+RWStructuredBuffer<IndirectDrawArguments> arguments : register(u0);
+RWStructuredBuffer<uint> groupOffsets : register(u1);
+RWStructuredBuffer<uint> visibleCount : register(u2);
+
+groupshared uint visibleFlags[GROUP_SIZE];
+groupshared uint scanSums[SCAN_GROUP_SIZE];
+
+// precise + explicit association -> no mad contraction, rounds exactly like the CPU reference
+bool isVisible(IndirectDrawSource draw) {
+    [unroll]
+    for (uint i = 0; i < 6; ++i) {
+        precise float distance = planes[i].x * draw.sphere.x + planes[i].y * draw.sphere.y;
+        distance = distance + planes[i].z * draw.sphere.z;
+        distance = distance + planes[i].w;
+        if (distance < -draw.sphere.w) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// visibleFlags of the group filled, synchronized
+void testGroup(uint group, uint thread) {
+    uint index = group * GROUP_SIZE + thread;
+    visibleFlags[thread] = (index < drawCount && isVisible(draws[index])) ? 1 : 0;
+    GroupMemoryBarrierWithGroupSync();
+}
+
+[numthreads(GROUP_SIZE, 1, 1)]
+void cscount(uint3 groupId : SV_GroupID, uint thread : SV_GroupIndex) {
+    testGroup(groupId.x, thread);
+
+    if (thread == 0) {
+        uint visible = 0;
+        for (uint i = 0; i < GROUP_SIZE; ++i) {
+            visible += visibleFlags[i];
+        }
+        groupOffsets[groupId.x] = visible;
+    }
+}
+
+[numthreads(SCAN_GROUP_SIZE, 1, 1)]
+void csscan(uint thread : SV_GroupIndex) {
+    // each thread owns a contiguous chunk of groups
+    uint chunk = (groupCount + SCAN_GROUP_SIZE - 1) / SCAN_GROUP_SIZE;
+    uint begin = min(thread * chunk, groupCount);
+    uint end = min(begin + chunk, groupCount);
+
+    uint sum = 0;
+    for (uint i = begin; i < end; ++i) {
+        sum += groupOffsets[i];
+    }
+    scanSums[thread] = sum;
+    GroupMemoryBarrierWithGroupSync();
+
+    // inclusive Hillis-Steele scan over the chunk sums
+    for (uint stride = 1; stride < SCAN_GROUP_SIZE; stride <<= 1) {
+        uint add = thread >= stride ? scanSums[thread - stride] : 0;
+        GroupMemoryBarrierWithGroupSync();
+        scanSums[thread] += add;
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    uint offset = scanSums[thread] - sum;
+    for (uint j = begin; j < end; ++j) {
+        uint visible = groupOffsets[j];
+        groupOffsets[j] = offset;
+        offset += visible;
+    }
+
+    if (thread == SCAN_GROUP_SIZE - 1) {
+        visibleCount[0] = scanSums[thread];
+    }
+}
+
+[numthreads(GROUP_SIZE, 1, 1)]
+void cswrite(uint3 groupId : SV_GroupID, uint thread : SV_GroupIndex) {
+    testGroup(groupId.x, thread);
+
+    if (visibleFlags[thread] == 0) {
+        return;
+    }
+
+    uint slot = groupOffsets[groupId.x];
+    for (uint i = 0; i < thread; ++i) {
+        slot += visibleFlags[i];
+    }
+
+    IndirectDrawSource draw = draws[groupId.x * GROUP_SIZE + thread];
+
+    IndirectDrawArguments command;
+    command.constantsIndex = draw.constantsIndex;
+    command.indexCountPerInstance = draw.indexCount;
+    command.instanceCount = 1;
+    command.startIndexLocation = draw.startIndex;
+    command.baseVertexLocation = draw.baseVertex;
+    command.startInstanceLocation = 0;
+    arguments[slot] = command;
+}
@@ -0,0 +1,33 @@
+struct VertexInputType {
+    float4 position: POSITION;
+    float4 color: COLOR0;
+
+    // per-instance stream (slot 1) -> rows of the world matrix + tint
+    float4 transform0: INSTANCE_TRANSFORM0;
+    float4 transform1: INSTANCE_TRANSFORM1;
+    float4 transform2: INSTANCE_TRANSFORM2;
+    float4 transform3: INSTANCE_TRANSFORM3;
+    float4 instanceColor: INSTANCE_COLOR0;
+};
+
+struct PixelInputType {
+    float4 position : SV_POSITION; // -> Required by rasterizer
+    float4 color    : COLOR0;
+};
+
+// Frame matrix, applied after the instance's world matrix
+cbuffer ModelViewProjectionCB : register(b0)
+{
+    matrix mvp;
+}
+
+PixelInputType vsmain(VertexInputType input) {
+    PixelInputType output;
+
+    float4x4 world = float4x4(input.transform0, input.transform1, input.transform2, input.transform3);
+    output.position = mul(mul(input.position, world), mvp);
+
+    output.color = input.color * input.instanceColor;
+
+    return output;
+}
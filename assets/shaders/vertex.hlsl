@@ -8,16 +8,24 @@ struct PixelInputType {
     float4 color    : COLOR0;
 };
 
-// Constant buffer for MVP
-cbuffer ModelViewProjectionCB : register(b0)
-{
+// Per-draw root constants -> bindless heap indices
+struct DrawConstants {
+    uint constantsIndex;
+    uint materialIndex;
+};
+ConstantBuffer<DrawConstants> drawConstants : register(b0);
+
+// Frame constants, looked up in the unbounded CBV table over the bindless heap
+struct ModelViewProjection {
     matrix mvp;
-}
+};
+ConstantBuffer<ModelViewProjection> frameConstants[] : register(b0, space1);
 
 PixelInputType vsmain(VertexInputType input) {
     PixelInputType output;
 
-    output.position = mul(input.position, mvp);
+    // same index for the whole draw -> uniform, no NonUniformResourceIndex needed
+    output.position = mul(input.position, frameConstants[drawConstants.constantsIndex].mvp);
 
     output.color = input.color;
 
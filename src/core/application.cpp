@@ -2,12 +2,9 @@
 #include "window.h"
 
 #include "engine/device.h"
-#include "engine/command_queue.h"
-#include "engine/swapchain.h"
-#include "engine/mesh.h"
-#include "engine/buffer/constant.h"
-#include "engine/shader.h"
-#include "engine/pipeline.h"
+#include "engine/renderer.h"
+#include "engine/job_system.h"
+#include "engine/frame_pipeline.h"
 #include "engine/scene/camera.h"
 
 #include "utils/events.h"
@@ -31,93 +28,35 @@ Application::~Application() {
 void Application::init() {
     LOG_INFO(L"Application -> Initializing...");
 
-    scissorRect = CD3DX12_RECT(
-        0, 
-        0, 
-        static_cast<LONG>(config.width), 
-        static_cast<LONG>(config.height)
-    );
-
-    viewport = CD3DX12_VIEWPORT(
-        0.0f, 
-        0.0f, 
-        static_cast<float>(config.width), 
-        static_cast<float>(config.height)
-    );
-
     device = std::make_unique<Device>(config.useWarp);
     LOG_INFO(L"Application -> device initialized!");
 
-    directCommandQueue = std::make_unique<CommandQueue>(
-        device->getDevice(),
-        D3D12_COMMAND_LIST_TYPE_DIRECT
-    );
-    LOG_INFO(L"Application -> directCommandQueue initialized!");
-
-    // computeCommandQueue = std::make_unique<CommandQueue>(
-    //     device->getDevice(),
-    //     D3D12_COMMAND_LIST_TYPE_COMPUTE
-    // );
-    // LOG_INFO(L"Engine->DirectX 12 computeCommandQueue initialized.");
-
-    // copyCommandQueue = std::make_unique<CommandQueue>(
-    //     device->getDevice(),
-    //     D3D12_COMMAND_LIST_TYPE_COPY
-    // );
-    // LOG_INFO(L"Engine->DirectX 12 copyCommandQueue initialized.");
-
-    swapchain = std::make_unique<Swapchain>(
-        window->getHwnd(),
-        device->getDevice(),
-        directCommandQueue->getCommandQueue(),
-        config.width,
-        config.height,
-        FRAMEBUFFERCOUNT,
-        device->getSupportTearingState()
+    JobSystemConfig jobConfig;
+    jobConfig.pinThreads = true;
+    jobs = std::make_unique<JobSystem>(jobConfig);
+    LOG_INFO(L"Application -> job system initialized!");
+
+    RendererConfig rendererConfig;
+    rendererConfig.window = window->getHwnd();
+    rendererConfig.width = config.width;
+    rendererConfig.height = config.height;
+    rendererConfig.framesInFlight = config.framesInFlight;
+    rendererConfig.jobs = jobs.get();
+
+    renderer = std::make_unique<Renderer>(
+        device.get(),
+        rendererConfig
     );
-    LOG_INFO(L"Application -> swapchain initialized!");
+    LOG_INFO(L"Application -> renderer initialized!");
 
-    currentBackBufferIndex = swapchain->getSwapchain()->GetCurrentBackBufferIndex();
+    // double-buffered: update N + 1 runs while frame N is recorded and submitted
+    frames = std::make_unique<FramePipeline<FrameSnapshot>>(2, [this](const FrameSnapshot& snapshot) {
+        RenderEventArgs renderArgs(snapshot.elapsedTime, snapshot.totalTime);
+        onRender(renderArgs, snapshot);
+    });
+    LOG_INFO(L"Application -> frame pipeline initialized!");
 
     LOG_INFO(L"Application Class initialized!");
-    LOG_INFO(L"-- Resources --");
-
-    std::vector<VertexStruct> vertices = {
-        { XMFLOAT4(-1.0f, -1.0f, -1.0f, 1.0f), XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f) }, // 0
-        { XMFLOAT4(-1.0f,  1.0f, -1.0f, 1.0f), XMFLOAT4(0.0f, 1.0f, 0.0f, 1.0f) }, // 1
-        { XMFLOAT4( 1.0f,  1.0f, -1.0f, 1.0f), XMFLOAT4(1.0f, 1.0f, 0.0f, 1.0f) }, // 2
-        { XMFLOAT4( 1.0f, -1.0f, -1.0f, 1.0f), XMFLOAT4(1.0f, 0.0f, 0.0f, 1.0f) }, // 3
-        { XMFLOAT4(-1.0f, -1.0f,  1.0f, 1.0f), XMFLOAT4(0.0f, 0.0f, 1.0f, 1.0f) }, // 4
-        { XMFLOAT4(-1.0f,  1.0f,  1.0f, 1.0f), XMFLOAT4(0.0f, 1.0f, 1.0f, 1.0f) }, // 5
-        { XMFLOAT4( 1.0f,  1.0f,  1.0f, 1.0f), XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f) }, // 6
-        { XMFLOAT4( 1.0f, -1.0f,  1.0f, 1.0f), XMFLOAT4(1.0f, 0.0f, 1.0f, 1.0f) }  // 7
-    };
-
-    // 36 indices for cube (12 triangles)
-    std::vector<uint32_t> indices =
-    {
-        0, 1, 2, 0, 2, 3,
-        4, 6, 5, 4, 7, 6,
-        4, 5, 1, 4, 1, 0,
-        3, 2, 6, 3, 6, 7,
-        1, 5, 6, 1, 6, 2,
-        4, 0, 3, 4, 3, 7
-    };
-
-    // create buffers
-    mesh = std::make_unique<Mesh>(
-        device->getDevice(),
-        vertices,
-        indices
-    );
-    LOG_INFO(L"Mesh Resource initialized!");
-
-    // mvpBuffer?
-    constantBuffer1 = std::make_unique<ConstantBuffer>(
-        device->getDevice(),
-        static_cast<UINT>(sizeof(ConstantMVP))
-    );
-    LOG_INFO(L"ConstantBuffer1 Resource initialized!");
 
     camera1 = std::make_unique<Camera>(
         45.0f,
@@ -131,37 +70,6 @@ void Application::init() {
     XMMATRIX proj = camera1->getProjectionMatrix();
     LOG_INFO(L"Camera View matrix[0][0]: %f", view.r[0].m128_f32[0]);
     LOG_INFO(L"Camera Projection matrix[0][0]: %f", proj.r[0].m128_f32[0]);
-
-    // pipeline
-    // Root parameter for CBV
-    // CD3DX12_ROOT_PARAMETER cbvRootParam;
-    // cbvRootParam.InitAsConstantBufferView(0, 0, D3D12_SHADER_VISIBILITY_VERTEX);
-
-    CD3DX12_ROOT_PARAMETER cbvRootParam;
-    cbvRootParam.InitAsConstantBufferView(0, 0, D3D12_SHADER_VISIBILITY_ALL);
-
-    std::vector<D3D12_INPUT_ELEMENT_DESC> inputLayout = {
-        { "POSITION", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-        { "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 16, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
-    };
-
-    std::vector<D3D12_ROOT_PARAMETER> rootParams = { cbvRootParam };
-
-    auto vertexShader = Shader(L"assets/shaders/vertex.cso");
-    auto pixelShader = Shader(L"assets/shaders/pixel.cso");
-
-    std::vector<D3D12_STATIC_SAMPLER_DESC> samplers{};
-
-    pipeline1 = std::make_unique<Pipeline>(
-        device->getDevice(),
-        vertexShader,
-        pixelShader,
-        inputLayout,
-        rootParams,
-        samplers,
-        DXGI_FORMAT_R8G8B8A8_UNORM,
-        DXGI_FORMAT_D24_UNORM_S8_UINT
-    );
 }
 
 int Application::run() {
@@ -177,20 +85,24 @@ int Application::run() {
         }
         else
         {
+            // throttle first (the first frame too) -> the update below samples time and input
+            // right before its frame can actually be queued
+            renderer->waitForNextFrame();
+
             timer.tick();
 
             UpdateEventArgs updateArgs(
                 timer.getDeltaSeconds(), 
                 timer.getTotalSeconds()
             );
-            onUpdate(updateArgs);
 
-            RenderEventArgs renderArgs(
-                timer.getDeltaSeconds(), 
-                timer.getTotalSeconds()
-            );
-            onRender(renderArgs);
-            
+            // blocks only while the render thread is a full pipeline behind
+            FrameSnapshot& snapshot = frames->beginUpdate();
+            snapshot.elapsedTime = timer.getDeltaSeconds();
+            snapshot.totalTime = timer.getTotalSeconds();
+            onUpdate(updateArgs, snapshot);
+            frames->endUpdate();
+
             std::wstring title = std::wstring(config.appName) + L" - " + timer.getFPSString();
             if (window) {
                 SetWindowTextW(window->getHwnd(), title.c_str());
@@ -203,7 +115,7 @@ int Application::run() {
     return static_cast<int>(msg.wParam);
 }
 
-void Application::onUpdate(UpdateEventArgs& args)
+void Application::onUpdate(UpdateEventArgs& args, FrameSnapshot& snapshot)
 {
     camera1->update(static_cast<float>(args.totalTime));
 
@@ -212,99 +124,21 @@ void Application::onUpdate(UpdateEventArgs& args)
     XMMATRIX view = camera1->getViewMatrix();
     XMMATRIX projection = camera1->getProjectionMatrix();
 
-    // Update Constant Buffer In GPU
-    ConstantMVP mvpData;
-    mvpData.mvp = XMMatrixTranspose(model * view * projection);
-    constantBuffer1->update(&mvpData, sizeof(mvpData)); // Upload to GPU
+    // the render stage uploads it one frame later
+    snapshot.mvp.mvp = XMMatrixTranspose(model * view * projection);
 }
 
-void Application::onRender(RenderEventArgs& args)
+void Application::onRender(RenderEventArgs& args, const FrameSnapshot& snapshot)
 {
-    // Get a command list from the queue; allocator is managed internally
-    auto commandList = directCommandQueue->getCommandList();
-    auto commandQueue = directCommandQueue->getCommandQueue();
-
-    auto pipelineState = pipeline1->getPipelineState();
-    auto rootSignature = pipeline1->getRootSignature();
-    auto rtvHeap = swapchain->getRTVHeap();
-    auto dsvHeap = swapchain->getDSVHeap();
-    auto vertex = mesh->getVertex();
-    auto index = mesh->getIndex();
-    auto vsync = device->getSupportTearingState();
-
-    // Reset command list with current pipeline
-    commandList->SetPipelineState(pipelineState.Get());
-    commandList->SetGraphicsRootSignature(rootSignature.Get());
-
-    // Set constant buffer (MVP updated in onUpdate)
-    commandList->SetGraphicsRootConstantBufferView(0, constantBuffer1->getGPUAddress());
-
-    // Set viewport and scissor
-    commandList->RSSetViewports(1, &viewport);
-    commandList->RSSetScissorRects(1, &scissorRect);
-
-    // Transition back buffer to render target
-    auto backBuffer = swapchain->getBackBuffer(currentBackBufferIndex);
-    transitionResource(commandList, backBuffer.Get(),
-                       D3D12_RESOURCE_STATE_PRESENT,
-                       D3D12_RESOURCE_STATE_RENDER_TARGET);
-
-    // Set render target and depth-stencil
-    CD3DX12_CPU_DESCRIPTOR_HANDLE rtvHandle(rtvHeap->getHeap()->GetCPUDescriptorHandleForHeapStart(),
-                                            currentBackBufferIndex, rtvHeap->getDescriptorSize());
-    CD3DX12_CPU_DESCRIPTOR_HANDLE dsvHandle(dsvHeap->getHeap()->GetCPUDescriptorHandleForHeapStart());
-    commandList->OMSetRenderTargets(1, &rtvHandle, FALSE, &dsvHandle);
-
-    // Clear render target and depth-stencil
-    const float clearColor[] = {0.1f, 0.1f, 0.1f, 1.0f};
-    commandList->ClearRenderTargetView(rtvHandle, clearColor, 0, nullptr);
-    commandList->ClearDepthStencilView(dsvHandle, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr);
-
-    // Draw the cube
-    commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    auto vbView = vertex->getView();
-    auto ibView = index->getView();
-    commandList->IASetVertexBuffers(0, 1, &vbView);
-    commandList->IASetIndexBuffer(&ibView);
-    commandList->DrawIndexedInstanced(index->getCount(), 1, 0, 0, 0);
-
-    // Transition back buffer to present
-    transitionResource(commandList, backBuffer.Get(),
-                       D3D12_RESOURCE_STATE_RENDER_TARGET,
-                       D3D12_RESOURCE_STATE_PRESENT);
-
-    // Execute command list
-    fenceValues[currentBackBufferIndex] = directCommandQueue->executeCommandList(commandList);
-
-    // Present
-    INT syncInterval = vsync ? 1 : 0;
-    UINT presentFlags = !vsync ? DXGI_PRESENT_ALLOW_TEARING : 0;
-    throwFailed(swapchain->getSwapchain()->Present(syncInterval, presentFlags));
-
-    currentBackBufferIndex = swapchain->getSwapchain()->GetCurrentBackBufferIndex();
-
-    // Wait for GPU to finish frame
-    directCommandQueue->fenceWait(fenceValues[currentBackBufferIndex]);
-}
-
-void Application::transitionResource(
-    ComPtr<ID3D12GraphicsCommandList2> commandList,
-    ComPtr<ID3D12Resource> resource,
-    D3D12_RESOURCE_STATES beforeState,
-    D3D12_RESOURCE_STATES afterState
-) {
-    CD3DX12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(
-        resource.Get(),
-        beforeState,
-        afterState
-    );
-
-    commandList->ResourceBarrier(1, &barrier);
+    // Upload constants, record, submit and present through the RHI
+    renderer->beginFrame();
+    renderer->update(&snapshot.mvp, sizeof(snapshot.mvp));
+    renderer->render();
 }
 
 void Application::onResize(ResizeEventArgs& args)
 {
-    if (!device || !swapchain)
+    if (!device || !renderer || !frames)
         return;
 
     // Skip if minimized
@@ -319,14 +153,9 @@ void Application::onResize(ResizeEventArgs& args)
         config.width = std::max(1u, static_cast<unsigned int>(args.width));
         config.height = std::max(1u, static_cast<unsigned int>(args.height));
 
-        // Wait for GPU to finish any in-flight commands
-        directCommandQueue->flush();
-
-        // Resize swap chain buffers
-        swapchain->resize(config.width, config.height);
-
-        // Reset back buffer index after resize
-        currentBackBufferIndex = swapchain->getSwapchain()->GetCurrentBackBufferIndex();
+        // render thread idle first, then flush, resize swap chain buffers and reset viewport + scissor rect
+        frames->flush();
+        renderer->resize(config.width, config.height);
 
         // Update camera projection
         camera1->setProjection(
@@ -336,10 +165,6 @@ void Application::onResize(ResizeEventArgs& args)
             100.0f
         );
 
-        // Update viewport + scissor rect
-        viewport = { 0.0f, 0.0f, float(config.width), float(config.height), 0.0f, 1.0f };
-        scissorRect = { 0, 0, static_cast<LONG>(config.width), static_cast<LONG>(config.height) };
-
         LOG_INFO(L"Application resized to %dx%d", config.width, config.height);
     }
 }
@@ -366,25 +191,11 @@ void Application::onMouseMoved(MouseMotionEventArgs& args) {
 void Application::cleanUp() {
     LOG_INFO(L"Application cleanup started.");
 
-    if (directCommandQueue) {
-        LOG_INFO(L"Flushing GPU commands before releasing resources...");
-        directCommandQueue->flush(); // ensure GPU has finished all work
-    }
-
     // Reset resources in reverse creation order
-    if (mesh) {
-        mesh.reset();
-        LOG_INFO(L"Mesh released.");
-    }
-
-    if (constantBuffer1) {
-        constantBuffer1.reset();
-        LOG_INFO(L"Constant buffer released.");
-    }
-
-    if (pipeline1) {
-        pipeline1.reset();
-        LOG_INFO(L"Pipeline released.");
+    // (the render thread first -> it renders whatever is still queued, then stops)
+    if (frames) {
+        frames.reset();
+        LOG_INFO(L"Frame pipeline released.");
     }
 
     if (camera1) {
@@ -392,17 +203,15 @@ void Application::cleanUp() {
         LOG_INFO(L"Camera released.");
     }
 
-    if (swapchain) {
-        // Wait for GPU to finish using back buffers before releasing
-        directCommandQueue->flush();
-
-        swapchain.reset();
-        LOG_INFO(L"Swapchain released.");
+    if (renderer) {
+        // flushes the GPU before releasing its resources
+        renderer.reset();
+        LOG_INFO(L"Renderer released.");
     }
 
-    if (directCommandQueue) {
-        directCommandQueue.reset();
-        LOG_INFO(L"Command queue released.");
+    if (jobs) {
+        jobs.reset();
+        LOG_INFO(L"Job system released.");
     }
 
     if (device) {
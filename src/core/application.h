@@ -4,12 +4,10 @@
 
 class Window;
 class Device;
-class CommandQueue;
-class Swapchain;
-class Mesh;
-class ConstantBuffer;
-class Pipeline;
+class Renderer;
 class Camera;
+class JobSystem;
+template <typename Snapshot> class FramePipeline;
 
 class UpdateEventArgs;
 class RenderEventArgs;
@@ -17,6 +15,13 @@ class ResizeEventArgs;
 class MouseWheelEventArgs;
 class MouseMotionEventArgs;
 
+// What the render stage needs from one update; immutable once handed to the pipeline
+struct FrameSnapshot {
+    ConstantMVP mvp;
+    double elapsedTime = 0.0;
+    double totalTime = 0.0;
+};
+
 class Application
 {
     public:
@@ -29,18 +34,13 @@ class Application
         void onResize(ResizeEventArgs& args);
 
         // main functions for rendering / callbacks
-        void onUpdate(UpdateEventArgs& args);
-        void onRender(RenderEventArgs& args);
+        // onUpdate runs on the main thread and fills the frame's snapshot,
+        // onRender runs on the render thread one frame later
+        void onUpdate(UpdateEventArgs& args, FrameSnapshot& snapshot);
+        void onRender(RenderEventArgs& args, const FrameSnapshot& snapshot);
         void onMouseWheel(MouseWheelEventArgs& args);
         void onMouseMoved(MouseMotionEventArgs& args);
 
-        void transitionResource(
-            ComPtr<ID3D12GraphicsCommandList2> commandList,
-            ComPtr<ID3D12Resource> resource,
-            D3D12_RESOURCE_STATES beforeState,
-            D3D12_RESOURCE_STATES afterState
-        );
-
     private:
         void init();
         void cleanUp();
@@ -50,21 +50,14 @@ class Application
         WindowConfig config;
         RECT windowRect = {};
 
-        UINT currentBackBufferIndex;
-        uint64_t fenceValues[FRAMEBUFFERCOUNT] {};
-
-        D3D12_VIEWPORT viewport;
-        D3D12_RECT scissorRect;
-
         // unique pttrsssssss -> GPU resources
         std::unique_ptr<Window> window;
         std::unique_ptr<Device> device;
-        std::unique_ptr<CommandQueue> directCommandQueue;
-        // std::unique_ptr<CommandQueue> computeCommandQueue;
-        // std::unique_ptr<CommandQueue> copyCommandQueue;
-        std::unique_ptr<Swapchain> swapchain;
-        std::unique_ptr<Mesh> mesh;
-        std::unique_ptr<ConstantBuffer> constantBuffer1;
-        std::unique_ptr<Pipeline> pipeline1;
+        // worker threads shared by the engine (render graph recording, ...)
+        std::unique_ptr<JobSystem> jobs;
+        // queues, swapchain and scene resources live in the renderer (backend independent)
+        std::unique_ptr<Renderer> renderer;
+        // update (main thread) -> snapshot -> render thread
+        std::unique_ptr<FramePipeline<FrameSnapshot>> frames;
         std::unique_ptr<Camera> camera1;
 };
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "bindless_heap.h"
+#include "rhi/rhi_command_queue.h"
+#include "utils/logger.h"
+
+#include <stdexcept>
+
+BindlessHeap::BindlessHeap(
+    RhiDevice* device,
+    RhiCommandQueue* queue,
+    uint32_t persistentCount,
+    uint32_t transientCount
+) :
+    device(device),
+    queue(queue),
+    persistentCount(persistentCount),
+    ring(transientCount)
+{
+    heap = device->createDescriptorHeap(RhiDescriptorHeapType::CbvSrvUav, persistentCount + transientCount, true);
+
+    LOG_INFO(L"BindlessHeap -> %u persistent + %u transient descriptors", persistentCount, transientCount);
+}
+
+uint32_t BindlessHeap::allocatePersistent() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!freeIndices.empty()) {
+        uint32_t index = freeIndices.back();
+        freeIndices.pop_back();
+        return index;
+    }
+
+    if (nextIndex == persistentCount) {
+        LOG_ERROR(L"BindlessHeap -> Persistent region exhausted (%u descriptors)", persistentCount);
+        throw std::runtime_error("Bindless heap exhausted");
+    }
+    return nextIndex++;
+}
+
+uint32_t BindlessHeap::registerPersistent(RhiCpuDescriptor source) {
+    uint32_t index = allocatePersistent();
+    device->copyDescriptors(heap->getCPUDescriptor(index), source, 1, RhiDescriptorHeapType::CbvSrvUav);
+    return index;
+}
+
+void BindlessHeap::releasePersistent(uint32_t index) {
+    if (index >= persistentCount) {
+        LOG_ERROR(L"BindlessHeap -> Released index %u is not persistent", index);
+        throw std::runtime_error("Invalid bindless index");
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    freeIndices.push_back(index);
+}
+
+uint32_t BindlessHeap::allocateTransient(uint32_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (;;) {
+        ring.release(queue->getCompletedFenceValue());
+
+        uint64_t offset = ring.allocate(count, 1);
+        if (offset != StagingRing::INVALID_OFFSET) {
+            return persistentCount + static_cast<uint32_t>(offset);
+        }
+
+        // slots of the frame being recorded only come back after its endFrame
+        uint64_t oldest = ring.getOldestPendingFence();
+        if (oldest == 0) {
+            LOG_ERROR(L"BindlessHeap -> %u transient descriptors do not fit in this frame's ring", count);
+            throw std::runtime_error("Transient descriptor ring exhausted");
+        }
+        queue->fenceWait(oldest);
+    }
+}
+
+uint32_t BindlessHeap::copyTransient(RhiCpuDescriptor source, uint32_t count) {
+    uint32_t index = allocateTransient(count);
+    device->copyDescriptors(heap->getCPUDescriptor(index), source, count, RhiDescriptorHeapType::CbvSrvUav);
+    return index;
+}
+
+void BindlessHeap::endFrame(uint64_t fenceValue) {
+    std::lock_guard<std::mutex> lock(mutex);
+    ring.finishBatch(fenceValue);
+}
+
+void BindlessHeap::bind(RhiCommandList* list, const uint32_t* tableRootIndices, uint32_t tableCount) const {
+    list->setDescriptorHeap(heap.get());
+
+    RhiGpuDescriptor start = heap->getGPUDescriptor(0);
+    for (uint32_t i = 0; i < tableCount; ++i) {
+        list->setGraphicsRootDescriptorTable(tableRootIndices[i], start);
+    }
+}
+
+uint32_t BindlessHeap::getPersistentUsed() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return nextIndex - static_cast<uint32_t>(freeIndices.size());
+}
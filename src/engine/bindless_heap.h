@@ -0,0 +1,77 @@
+#pragma once
+
+#include "rhi/rhi.h"
+#include "memory/staging_ring.h"
+#include <mutex>
+
+class RhiCommandQueue;
+
+// The one shader-visible CBV_SRV_UAV heap, shaders index it with 32-bit indices passed in
+// per-draw root constants instead of getting a descriptor table per draw.
+//
+//   [0, persistentCount)                       -> long-lived views, O(1) free list
+//   [persistentCount, persistentCount + ring)  -> transient views, recycled per frame by fence
+//
+// Indices are absolute in the heap, so one unbounded table at the heap start reaches both regions.
+class BindlessHeap {
+    public:
+        static constexpr uint32_t INVALID_INDEX = ~0u;
+        static constexpr uint32_t DEFAULT_PERSISTENT_COUNT = 16384;
+        static constexpr uint32_t DEFAULT_TRANSIENT_COUNT = 8192;
+
+        BindlessHeap(
+            RhiDevice* device,
+            RhiCommandQueue* queue,
+            uint32_t persistentCount = DEFAULT_PERSISTENT_COUNT,
+            uint32_t transientCount = DEFAULT_TRANSIENT_COUNT
+        );
+
+        // Copies a staged CPU descriptor in and returns its index; throws when the region is full.
+        uint32_t registerPersistent(RhiCpuDescriptor source);
+        uint32_t allocatePersistent();
+
+        // The GPU must be done with the index (no frame in flight references it)
+        void releasePersistent(uint32_t index);
+
+        // count contiguous slots valid until the current frame's fence completes.
+        // Blocks on the oldest frame when the ring is full.
+        uint32_t allocateTransient(uint32_t count = 1);
+        uint32_t copyTransient(RhiCpuDescriptor source, uint32_t count = 1);
+
+        // Tags every transient slot handed out since the previous call with fenceValue
+        void endFrame(uint64_t fenceValue);
+
+        // setDescriptorHeap, then point each bindless table at the heap start
+        void bind(RhiCommandList* list, const uint32_t* tableRootIndices, uint32_t tableCount) const;
+
+        // views are written straight into the shader-visible heap
+        RhiCpuDescriptor getCpuDescriptor(uint32_t index) const {
+            return heap->getCPUDescriptor(index);
+        }
+
+        RhiGpuDescriptor getGpuDescriptor(uint32_t index) const {
+            return heap->getGPUDescriptor(index);
+        }
+
+        RhiDescriptorHeap* getHeap() const {
+            return heap.get();
+        }
+
+        uint32_t getPersistentCount() const {
+            return persistentCount;
+        }
+
+        uint32_t getPersistentUsed() const;
+
+    private:
+        RhiDevice* device = nullptr;
+        RhiCommandQueue* queue = nullptr;
+        std::unique_ptr<RhiDescriptorHeap> heap;
+
+        uint32_t persistentCount = 0;
+
+        mutable std::mutex mutex;
+        std::vector<uint32_t> freeIndices; // released persistent slots, reused LIFO
+        uint32_t nextIndex = 0;            // persistent slots never handed out yet
+        StagingRing ring;                  // transient region in descriptor units
+};
@@ -0,0 +1,133 @@
+#include "buffer.h"
+
+Buffer::Buffer(
+    ComPtr<ID3D12Device2> device,
+    const RhiBufferDesc& desc
+) :
+    desc(desc)
+{
+    CD3DX12_HEAP_PROPERTIES heapProps(static_cast<D3D12_HEAP_TYPE>(desc.heapType));
+    CD3DX12_RESOURCE_DESC bufferDesc = getResourceDesc();
+
+    throwFailed(device->CreateCommittedResource(
+        &heapProps,
+        D3D12_HEAP_FLAG_NONE,
+        &bufferDesc,
+        getInitialState(),
+        nullptr,
+        IID_PPV_ARGS(&buffer)
+    ));
+
+    map();
+
+    LOG_INFO(L"Buffer -> Created %llu bytes in heap type %d", desc.sizeInBytes, static_cast<int>(desc.heapType));
+}
+
+Buffer::Buffer(
+    ComPtr<ID3D12Device2> device,
+    const RhiBufferDesc& desc,
+    HeapAllocator* heaps
+) :
+    desc(desc),
+    heaps(heaps)
+{
+    CD3DX12_RESOURCE_DESC bufferDesc = getResourceDesc();
+
+    allocation = heaps->allocate(desc.sizeInBytes);
+
+    throwFailed(device->CreatePlacedResource(
+        allocation.heap,
+        allocation.offset,
+        &bufferDesc,
+        getInitialState(),
+        nullptr,
+        IID_PPV_ARGS(&buffer)
+    ));
+
+    map();
+}
+
+Buffer::Buffer(
+    ComPtr<ID3D12Device2> device,
+    const RhiBufferDesc& desc,
+    ID3D12Heap* heap,
+    UINT64 offset
+) :
+    desc(desc),
+    placedHeap(heap)
+{
+    CD3DX12_RESOURCE_DESC bufferDesc = getResourceDesc();
+
+    throwFailed(device->CreatePlacedResource(
+        heap,
+        offset,
+        &bufferDesc,
+        getInitialState(),
+        nullptr,
+        IID_PPV_ARGS(&buffer)
+    ));
+
+    map();
+}
+
+Buffer::~Buffer() {
+    if (buffer && mappedData)
+        buffer->Unmap(0, nullptr);
+
+    // release the resource before its range can be handed out again
+    buffer.Reset();
+    if (heaps)
+        heaps->free(allocation);
+}
+
+RhiPageable Buffer::getPageable() const {
+    if (heaps) {
+        return { allocation.heap };
+    }
+    if (placedHeap) {
+        return { placedHeap };
+    }
+    return { buffer.Get() };
+}
+
+uint64_t Buffer::getPageableSize() const {
+    if (heaps) {
+        return heaps->getBlockSize();
+    }
+    return (desc.sizeInBytes + D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT - 1) & ~UINT64(D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT - 1);
+}
+
+D3D12_RESOURCE_STATES Buffer::getInitialState() const {
+    // upload heaps must start in GENERIC_READ, readback heaps in COPY_DEST
+    if (desc.heapType == RhiHeapType::Upload) {
+        return D3D12_RESOURCE_STATE_GENERIC_READ;
+    }
+    if (desc.heapType == RhiHeapType::Readback) {
+        return D3D12_RESOURCE_STATE_COPY_DEST;
+    }
+    return static_cast<D3D12_RESOURCE_STATES>(desc.initialState);
+}
+
+CD3DX12_RESOURCE_DESC Buffer::getResourceDesc() const {
+    D3D12_RESOURCE_FLAGS flags = desc.unorderedAccess ? D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS : D3D12_RESOURCE_FLAG_NONE;
+    return CD3DX12_RESOURCE_DESC::Buffer(desc.sizeInBytes, flags);
+}
+
+void Buffer::map() {
+    if (desc.heapType == RhiHeapType::Upload) {
+        CD3DX12_RANGE readRange(0, 0);
+        throwFailed(buffer->Map(0, &readRange, reinterpret_cast<void**>(&mappedData)));
+    }
+}
+
+void Buffer::update(const void* data, size_t size) {
+    if (!mappedData) {
+        LOG_ERROR(L"Buffer -> Buffer is not CPU writable, upload through the copy queue");
+        return;
+    }
+    if (size > desc.sizeInBytes) {
+        LOG_ERROR(L"Buffer -> Update size %zu exceeds buffer size %llu", size, desc.sizeInBytes);
+        return;
+    }
+    memcpy(mappedData, data, size);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "utils/pch.h"
+#include "engine/rhi/rhi.h"
+#include "engine/heap_allocator.h"
+
+// Generic buffer -> any heap, any initial state.
+// Either committed or placed in a HeapAllocator block.
+// Upload heap buffers stay mapped for their whole lifetime.
+class Buffer : public RhiBuffer {
+    public:
+        Buffer(
+            ComPtr<ID3D12Device2> device,
+            const RhiBufferDesc& desc
+        );
+
+        // placed -> the range goes back to heaps when the buffer is destroyed
+        Buffer(
+            ComPtr<ID3D12Device2> device,
+            const RhiBufferDesc& desc,
+            HeapAllocator* heaps
+        );
+
+        // placed at a fixed offset of a heap the caller owns (aliased transient buffers)
+        Buffer(
+            ComPtr<ID3D12Device2> device,
+            const RhiBufferDesc& desc,
+            ID3D12Heap* heap,
+            UINT64 offset
+        );
+        ~Buffer() override;
+
+        ComPtr<ID3D12Resource> getBuffer() const {
+            return buffer;
+        }
+
+        UINT getSize() const override {
+            return static_cast<UINT>(desc.sizeInBytes);
+        }
+
+        UINT getCount() const override {
+            return desc.count;
+        }
+
+        UINT getStride() const override {
+            return desc.stride;
+        }
+
+        RhiResourceHandle getHandle() const override {
+            return { buffer.Get() };
+        }
+
+        uint64_t getGPUAddress() const override {
+            return buffer->GetGPUVirtualAddress();
+        }
+
+        void update(const void* data, size_t size) override;
+
+        void* getMappedData() const override {
+            return mappedData;
+        }
+
+        // placed -> the whole heap block is the unit of residency
+        RhiPageable getPageable() const override;
+        uint64_t getPageableSize() const override;
+
+    private:
+        D3D12_RESOURCE_STATES getInitialState() const;
+        CD3DX12_RESOURCE_DESC getResourceDesc() const;
+        void map();
+
+    private:
+        ComPtr<ID3D12Resource> buffer;
+        RhiBufferDesc desc;
+        UINT8* mappedData = nullptr;
+
+        HeapAllocator* heaps = nullptr;
+        HeapAllocation allocation;
+        ID3D12Heap* placedHeap = nullptr;
+};
@@ -1,26 +1,52 @@
 #pragma once
 
 #include "utils/pch.h"
+#include "engine/rhi/rhi.h"
 
-class ConstantBuffer {
+class ConstantBuffer : public RhiBuffer {
     public:
         ConstantBuffer(
             ComPtr<ID3D12Device2> device, 
             UINT size
         );
-        ~ConstantBuffer();
+        ~ConstantBuffer() override;
 
         ComPtr<ID3D12Resource> getBuffer() const { 
             return buffer; 
         }
 
-        UINT getSize() const { 
+        UINT getSize() const override { 
             return sizeInBytes; 
         }
 
-        void update(const void* data, size_t size);
+        UINT getCount() const override {
+            return 0;
+        }
+
+        UINT getStride() const override {
+            return 0;
+        }
+
+        RhiResourceHandle getHandle() const override {
+            return { buffer.Get() };
+        }
+
+        void update(const void* data, size_t size) override;
+
+        void* getMappedData() const override {
+            return mappedData;
+        }
+
+        RhiPageable getPageable() const override {
+            return { buffer.Get() };
+        }
+
+        // committed resources are backed in 64 KB pages
+        uint64_t getPageableSize() const override {
+            return (UINT64(sizeInBytes) + D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT - 1) & ~UINT64(D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT - 1);
+        }
 
-        D3D12_GPU_VIRTUAL_ADDRESS getGPUAddress() const { 
+        D3D12_GPU_VIRTUAL_ADDRESS getGPUAddress() const override { 
             return buffer->GetGPUVirtualAddress(); 
         }
 
@@ -2,9 +2,11 @@
 
 IndexBuffer::IndexBuffer(
     ComPtr<ID3D12Device2> device, 
-    const std::vector<uint32_t>& indices
-) {
-    count = static_cast<UINT>(indices.size());
+    const uint32_t* indices,
+    UINT count
+) :
+    count(count)
+{
     sizeInBytes = static_cast<UINT>(sizeof(uint32_t) * count);
 
     CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_UPLOAD);
@@ -22,7 +24,7 @@ IndexBuffer::IndexBuffer(
     void* pData;
 
     throwFailed(buffer->Map(0, nullptr, &pData));
-    memcpy(pData, indices.data(), sizeInBytes);
+    memcpy(pData, indices, sizeInBytes);
     buffer->Unmap(0, nullptr);
 
     bufferView.BufferLocation = buffer->GetGPUVirtualAddress();
@@ -32,3 +34,6 @@ IndexBuffer::IndexBuffer(
     LOG_INFO(L" -> Index buffer created with %d indices", count);
 }
 
+void IndexBuffer::update(const void* data, size_t size) {
+    LOG_ERROR(L"IndexBuffer -> update is not supported, recreate the buffer instead");
+}
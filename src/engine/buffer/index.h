@@ -1,27 +1,57 @@
 #pragma once
 
 #include "utils/pch.h"
+#include "engine/rhi/rhi.h"
 
-class IndexBuffer {
+class IndexBuffer : public RhiBuffer {
     public:
         IndexBuffer(
             ComPtr<ID3D12Device2> device, 
-            const std::vector<uint32_t>& indices
+            const uint32_t* indices,
+            UINT count
         );
-        ~IndexBuffer() = default;
+        ~IndexBuffer() override = default;
 
         ComPtr<ID3D12Resource> getBuffer() const { 
             return buffer; 
         }
 
-        UINT getSize() const { 
+        UINT getSize() const override { 
             return sizeInBytes; 
         }
 
-        UINT getCount() const { 
+        UINT getCount() const override { 
             return count; 
         }
 
+        UINT getStride() const override {
+            return sizeof(uint32_t);
+        }
+
+        RhiResourceHandle getHandle() const override {
+            return { buffer.Get() };
+        }
+
+        uint64_t getGPUAddress() const override {
+            return bufferView.BufferLocation;
+        }
+
+        // lives in an upload heap but is written once at creation
+        void update(const void* data, size_t size) override;
+
+        void* getMappedData() const override {
+            return nullptr;
+        }
+
+        RhiPageable getPageable() const override {
+            return { buffer.Get() };
+        }
+
+        // committed resources are backed in 64 KB pages
+        uint64_t getPageableSize() const override {
+            return (UINT64(sizeInBytes) + D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT - 1) & ~UINT64(D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT - 1);
+        }
+
         D3D12_INDEX_BUFFER_VIEW getView() const {
             return bufferView;
         }
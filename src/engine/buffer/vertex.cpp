@@ -2,10 +2,13 @@
 
 VertexBuffer::VertexBuffer(
     ComPtr<ID3D12Device2> device, 
-    const std::vector<VertexStruct>& vertices
-) {
-    count = static_cast<UINT>(vertices.size());
-    sizeInBytes = static_cast<UINT>(sizeof(VertexStruct) * count);
+    const void* vertices,
+    UINT count,
+    UINT stride
+) :
+    count(count)
+{
+    sizeInBytes = stride * count;
 
     CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_UPLOAD);
     CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(sizeInBytes);
@@ -22,13 +25,16 @@ VertexBuffer::VertexBuffer(
     void* pData;
 
     throwFailed(buffer->Map(0, nullptr, &pData));
-    memcpy(pData, vertices.data(), sizeInBytes);
+    memcpy(pData, vertices, sizeInBytes);
     buffer->Unmap(0, nullptr);
 
     bufferView.BufferLocation = buffer->GetGPUVirtualAddress();
-    bufferView.StrideInBytes = sizeof(VertexStruct);
+    bufferView.StrideInBytes = stride;
     bufferView.SizeInBytes = sizeInBytes;
 
     LOG_INFO(L"VertexBuffer -> Vertex buffer created with %d vertices", count);
 }
 
+void VertexBuffer::update(const void* data, size_t size) {
+    LOG_ERROR(L"VertexBuffer -> update is not supported, recreate the buffer instead");
+}
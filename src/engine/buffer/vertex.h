@@ -1,27 +1,58 @@
 #pragma once
 
 #include "utils/pch.h"
+#include "engine/rhi/rhi.h"
 
-class VertexBuffer {
+class VertexBuffer : public RhiBuffer {
     public:
         VertexBuffer(
             ComPtr<ID3D12Device2> device, 
-            const std::vector<VertexStruct>& vertices
+            const void* vertices,
+            UINT count,
+            UINT stride
         );
-        ~VertexBuffer() = default;
+        ~VertexBuffer() override = default;
 
         ComPtr<ID3D12Resource> getBuffer() const { 
             return buffer; 
         }
 
-        UINT getSize() const { 
+        UINT getSize() const override { 
             return sizeInBytes; 
         }
 
-        UINT getCount() const { 
+        UINT getCount() const override { 
             return count; 
         }
 
+        UINT getStride() const override {
+            return bufferView.StrideInBytes;
+        }
+
+        RhiResourceHandle getHandle() const override {
+            return { buffer.Get() };
+        }
+
+        uint64_t getGPUAddress() const override {
+            return bufferView.BufferLocation;
+        }
+
+        // lives in an upload heap but is written once at creation
+        void update(const void* data, size_t size) override;
+
+        void* getMappedData() const override {
+            return nullptr;
+        }
+
+        RhiPageable getPageable() const override {
+            return { buffer.Get() };
+        }
+
+        // committed resources are backed in 64 KB pages
+        uint64_t getPageableSize() const override {
+            return (UINT64(sizeInBytes) + D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT - 1) & ~UINT64(D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT - 1);
+        }
+
         D3D12_VERTEX_BUFFER_VIEW getView() const {
             return bufferView;
         }
@@ -0,0 +1,222 @@
+#include "command_list.h"
+#include "pipeline.h"
+#include "descriptor_heap.h"
+#include "command_signature.h"
+
+static_assert(static_cast<UINT>(RhiResourceState::GenericRead) == D3D12_RESOURCE_STATE_GENERIC_READ);
+static_assert(static_cast<UINT>(RhiResourceState::CopyDest) == D3D12_RESOURCE_STATE_COPY_DEST);
+static_assert(static_cast<UINT>(RhiPrimitiveTopology::TriangleList) == D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+static_assert(static_cast<UINT>(RhiFormat::R32Uint) == DXGI_FORMAT_R32_UINT);
+static_assert(static_cast<UINT>(RhiBarrierFlags::BeginOnly) == D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY);
+static_assert(static_cast<UINT>(RhiBarrierFlags::EndOnly) == D3D12_RESOURCE_BARRIER_FLAG_END_ONLY);
+static_assert(static_cast<UINT>(RhiBarrierType::Aliasing) == D3D12_RESOURCE_BARRIER_TYPE_ALIASING);
+static_assert(static_cast<UINT>(RhiBarrierType::Uav) == D3D12_RESOURCE_BARRIER_TYPE_UAV);
+
+CommandAllocator::CommandAllocator(ComPtr<ID3D12Device2> device, D3D12_COMMAND_LIST_TYPE type) {
+    throwFailed(device->CreateCommandAllocator(type, IID_PPV_ARGS(&allocator)));
+}
+
+void CommandAllocator::reset() {
+    throwFailed(allocator->Reset());
+}
+
+CommandList::CommandList(
+    ComPtr<ID3D12Device2> device, 
+    D3D12_COMMAND_LIST_TYPE type, 
+    CommandAllocator* allocator
+) {
+    throwFailed(device->CreateCommandList(0, type, allocator->getAllocator().Get(), nullptr, IID_PPV_ARGS(&list)));
+}
+
+void CommandList::reset(RhiCommandAllocator* allocator) {
+    auto d3dAllocator = static_cast<CommandAllocator*>(allocator);
+    throwFailed(list->Reset(d3dAllocator->getAllocator().Get(), nullptr));
+}
+
+void CommandList::close() {
+    throwFailed(list->Close());
+}
+
+void CommandList::setPipeline(RhiPipeline* pipeline) {
+    auto d3dPipeline = static_cast<Pipeline*>(pipeline);
+    list->SetPipelineState(d3dPipeline->getPipelineState().Get());
+    list->SetGraphicsRootSignature(d3dPipeline->getRootSignature().Get());
+}
+
+void CommandList::setGraphicsRootConstantBufferView(uint32_t rootIndex, uint64_t gpuAddress) {
+    list->SetGraphicsRootConstantBufferView(rootIndex, gpuAddress);
+}
+
+void CommandList::setGraphicsRoot32BitConstants(uint32_t rootIndex, uint32_t count, const void* data, uint32_t offset) {
+    list->SetGraphicsRoot32BitConstants(rootIndex, count, data, offset);
+}
+
+void CommandList::setDescriptorHeap(RhiDescriptorHeap* heap) {
+    ID3D12DescriptorHeap* heaps[] = { static_cast<DescriptorHeap*>(heap)->getHeap().Get() };
+    list->SetDescriptorHeaps(1, heaps);
+}
+
+void CommandList::setGraphicsRootDescriptorTable(uint32_t rootIndex, RhiGpuDescriptor base) {
+    list->SetGraphicsRootDescriptorTable(rootIndex, { base.ptr });
+}
+
+void CommandList::setViewport(const RhiViewport& viewport) {
+    D3D12_VIEWPORT vp = { 
+        viewport.x, 
+        viewport.y, 
+        viewport.width, 
+        viewport.height, 
+        viewport.minDepth, 
+        viewport.maxDepth 
+    };
+    list->RSSetViewports(1, &vp);
+}
+
+void CommandList::setScissorRect(const RhiRect& rect) {
+    D3D12_RECT r = { rect.left, rect.top, rect.right, rect.bottom };
+    list->RSSetScissorRects(1, &r);
+}
+
+void CommandList::transitionResource(
+    RhiResourceHandle resource,
+    RhiResourceState beforeState,
+    RhiResourceState afterState
+) {
+    CD3DX12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(
+        static_cast<ID3D12Resource*>(resource.native),
+        static_cast<D3D12_RESOURCE_STATES>(beforeState),
+        static_cast<D3D12_RESOURCE_STATES>(afterState)
+    );
+
+    list->ResourceBarrier(1, &barrier);
+}
+
+void CommandList::transitionResources(const RhiResourceBarrier* barriers, uint32_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    std::vector<CD3DX12_RESOURCE_BARRIER> nativeBarriers(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (barriers[i].type == RhiBarrierType::Aliasing) {
+            nativeBarriers[i] = CD3DX12_RESOURCE_BARRIER::Aliasing(
+                static_cast<ID3D12Resource*>(barriers[i].aliasBefore.native),
+                static_cast<ID3D12Resource*>(barriers[i].resource.native)
+            );
+            continue;
+        }
+        if (barriers[i].type == RhiBarrierType::Uav) {
+            nativeBarriers[i] = CD3DX12_RESOURCE_BARRIER::UAV(static_cast<ID3D12Resource*>(barriers[i].resource.native));
+            continue;
+        }
+        nativeBarriers[i] = CD3DX12_RESOURCE_BARRIER::Transition(
+            static_cast<ID3D12Resource*>(barriers[i].resource.native),
+            static_cast<D3D12_RESOURCE_STATES>(barriers[i].before),
+            static_cast<D3D12_RESOURCE_STATES>(barriers[i].after),
+            D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES,
+            static_cast<D3D12_RESOURCE_BARRIER_FLAGS>(barriers[i].flags)
+        );
+    }
+
+    list->ResourceBarrier(count, nativeBarriers.data());
+}
+
+void CommandList::copyBufferRegion(
+    RhiResourceHandle destination,
+    uint64_t destinationOffset,
+    RhiResourceHandle source,
+    uint64_t sourceOffset,
+    uint64_t size
+) {
+    list->CopyBufferRegion(
+        static_cast<ID3D12Resource*>(destination.native),
+        destinationOffset,
+        static_cast<ID3D12Resource*>(source.native),
+        sourceOffset,
+        size
+    );
+}
+
+void CommandList::setRenderTargets(const RhiCpuDescriptor* rtv, const RhiCpuDescriptor* dsv) {
+    D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = { rtv ? rtv->ptr : 0 };
+    D3D12_CPU_DESCRIPTOR_HANDLE dsvHandle = { dsv ? dsv->ptr : 0 };
+
+    list->OMSetRenderTargets(
+        rtv ? 1 : 0, 
+        rtv ? &rtvHandle : nullptr, 
+        FALSE, 
+        dsv ? &dsvHandle : nullptr
+    );
+}
+
+void CommandList::clearRenderTarget(RhiCpuDescriptor rtv, const float color[4]) {
+    list->ClearRenderTargetView({ rtv.ptr }, color, 0, nullptr);
+}
+
+void CommandList::clearDepth(RhiCpuDescriptor dsv, float depth) {
+    list->ClearDepthStencilView({ dsv.ptr }, D3D12_CLEAR_FLAG_DEPTH, depth, 0, 0, nullptr);
+}
+
+void CommandList::setPrimitiveTopology(RhiPrimitiveTopology topology) {
+    list->IASetPrimitiveTopology(static_cast<D3D12_PRIMITIVE_TOPOLOGY>(topology));
+}
+
+void CommandList::setVertexBuffer(uint32_t slot, const RhiVertexBufferView& view) {
+    D3D12_VERTEX_BUFFER_VIEW vbView = { view.gpuAddress, view.sizeInBytes, view.strideInBytes };
+    list->IASetVertexBuffers(slot, 1, &vbView);
+}
+
+void CommandList::setIndexBuffer(const RhiIndexBufferView& view) {
+    D3D12_INDEX_BUFFER_VIEW ibView = { view.gpuAddress, view.sizeInBytes, static_cast<DXGI_FORMAT>(view.format) };
+    list->IASetIndexBuffer(&ibView);
+}
+
+void CommandList::drawIndexedInstanced(
+    uint32_t indexCount,
+    uint32_t instanceCount,
+    uint32_t startIndex,
+    int32_t baseVertex,
+    uint32_t startInstance
+) {
+    list->DrawIndexedInstanced(indexCount, instanceCount, startIndex, baseVertex, startInstance);
+}
+
+void CommandList::setComputePipeline(RhiPipeline* pipeline) {
+    auto d3dPipeline = static_cast<Pipeline*>(pipeline);
+    list->SetPipelineState(d3dPipeline->getPipelineState().Get());
+    list->SetComputeRootSignature(d3dPipeline->getRootSignature().Get());
+}
+
+void CommandList::setComputeRoot32BitConstants(uint32_t rootIndex, uint32_t count, const void* data, uint32_t offset) {
+    list->SetComputeRoot32BitConstants(rootIndex, count, data, offset);
+}
+
+void CommandList::setComputeRootShaderResourceView(uint32_t rootIndex, uint64_t gpuAddress) {
+    list->SetComputeRootShaderResourceView(rootIndex, gpuAddress);
+}
+
+void CommandList::setComputeRootUnorderedAccessView(uint32_t rootIndex, uint64_t gpuAddress) {
+    list->SetComputeRootUnorderedAccessView(rootIndex, gpuAddress);
+}
+
+void CommandList::dispatch(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) {
+    list->Dispatch(groupsX, groupsY, groupsZ);
+}
+
+void CommandList::executeIndirect(
+    RhiCommandSignature* signature,
+    uint32_t maxCommandCount,
+    RhiResourceHandle arguments,
+    uint64_t argumentOffset,
+    RhiResourceHandle countBuffer,
+    uint64_t countOffset
+) {
+    list->ExecuteIndirect(
+        static_cast<CommandSignature*>(signature)->getSignature().Get(),
+        maxCommandCount,
+        static_cast<ID3D12Resource*>(arguments.native),
+        argumentOffset,
+        static_cast<ID3D12Resource*>(countBuffer.native),
+        countOffset
+    );
+}
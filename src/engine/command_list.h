@@ -0,0 +1,90 @@
+#pragma once
+
+#include "utils/pch.h"
+#include "rhi/rhi.h"
+
+class CommandAllocator : public RhiCommandAllocator {
+    public:
+        CommandAllocator(ComPtr<ID3D12Device2> device, D3D12_COMMAND_LIST_TYPE type);
+
+        void reset() override;
+
+        ComPtr<ID3D12CommandAllocator> getAllocator() const {
+            return allocator;
+        }
+
+    private:
+        ComPtr<ID3D12CommandAllocator> allocator;
+};
+
+class CommandList : public RhiCommandList {
+    public:
+        CommandList(ComPtr<ID3D12Device2> device, D3D12_COMMAND_LIST_TYPE type, CommandAllocator* allocator);
+
+        void reset(RhiCommandAllocator* allocator) override;
+        void close() override;
+
+        void setPipeline(RhiPipeline* pipeline) override;
+        void setGraphicsRootConstantBufferView(uint32_t rootIndex, uint64_t gpuAddress) override;
+        void setGraphicsRoot32BitConstants(uint32_t rootIndex, uint32_t count, const void* data, uint32_t offset = 0) override;
+
+        void setDescriptorHeap(RhiDescriptorHeap* heap) override;
+        void setGraphicsRootDescriptorTable(uint32_t rootIndex, RhiGpuDescriptor base) override;
+
+        void setViewport(const RhiViewport& viewport) override;
+        void setScissorRect(const RhiRect& rect) override;
+
+        void transitionResource(
+            RhiResourceHandle resource,
+            RhiResourceState beforeState,
+            RhiResourceState afterState
+        ) override;
+
+        void transitionResources(const RhiResourceBarrier* barriers, uint32_t count) override;
+
+        void copyBufferRegion(
+            RhiResourceHandle destination,
+            uint64_t destinationOffset,
+            RhiResourceHandle source,
+            uint64_t sourceOffset,
+            uint64_t size
+        ) override;
+
+        void setRenderTargets(const RhiCpuDescriptor* rtv, const RhiCpuDescriptor* dsv) override;
+        void clearRenderTarget(RhiCpuDescriptor rtv, const float color[4]) override;
+        void clearDepth(RhiCpuDescriptor dsv, float depth) override;
+
+        void setPrimitiveTopology(RhiPrimitiveTopology topology) override;
+        void setVertexBuffer(uint32_t slot, const RhiVertexBufferView& view) override;
+        void setIndexBuffer(const RhiIndexBufferView& view) override;
+
+        void drawIndexedInstanced(
+            uint32_t indexCount,
+            uint32_t instanceCount,
+            uint32_t startIndex,
+            int32_t baseVertex,
+            uint32_t startInstance
+        ) override;
+
+        void setComputePipeline(RhiPipeline* pipeline) override;
+        void setComputeRoot32BitConstants(uint32_t rootIndex, uint32_t count, const void* data, uint32_t offset = 0) override;
+        void setComputeRootShaderResourceView(uint32_t rootIndex, uint64_t gpuAddress) override;
+        void setComputeRootUnorderedAccessView(uint32_t rootIndex, uint64_t gpuAddress) override;
+        void dispatch(uint32_t groupsX, uint32_t groupsY = 1, uint32_t groupsZ = 1) override;
+
+        void executeIndirect(
+            RhiCommandSignature* signature,
+            uint32_t maxCommandCount,
+            RhiResourceHandle arguments,
+            uint64_t argumentOffset,
+            RhiResourceHandle countBuffer = {},
+            uint64_t countOffset = 0
+        ) override;
+
+        ComPtr<ID3D12GraphicsCommandList2> getCommandList() const {
+            return list;
+        }
+
+    private:
+        ComPtr<ID3D12GraphicsCommandList2> list;
+};
@@ -1,20 +1,30 @@
 #include "command_queue.h"
-
-CommandQueue::CommandQueue(ComPtr<ID3D12Device2> device, D3D12_COMMAND_LIST_TYPE type)
-    : device(device), type(type), fenceValue(0) 
+#include "command_list.h"
+
+static_assert(static_cast<INT>(RhiQueuePriority::High) == D3D12_COMMAND_QUEUE_PRIORITY_HIGH);
+static_assert(static_cast<INT>(RhiQueuePriority::GlobalRealtime) == D3D12_COMMAND_QUEUE_PRIORITY_GLOBAL_REALTIME);
+
+CommandQueue::CommandQueue(
+    ComPtr<ID3D12Device2> device,
+    D3D12_COMMAND_LIST_TYPE type,
+    D3D12_COMMAND_QUEUE_PRIORITY priority
+) :
+    RhiCommandQueue(static_cast<RhiCommandListType>(type), static_cast<RhiQueuePriority>(priority)),
+    device(device),
+    type(type)
 {
-    LOG_INFO(L"Initializing CommandQueue of type %d", type);
+    LOG_INFO(L"Initializing CommandQueue of type %d, priority %d", type, priority);
 
     D3D12_COMMAND_QUEUE_DESC desc{};
     desc.Type = type;
-    desc.Priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
+    desc.Priority = priority; // GLOBAL_REALTIME needs a privileged process, creation fails otherwise
     desc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
 
     throwFailed(device->CreateCommandQueue(&desc, IID_PPV_ARGS(&queue)));
     LOG_INFO(L"CommandQueue created");
 
-    throwFailed(device->CreateFence(fenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence)));
-    LOG_INFO(L"Fence created with initial value %llu", fenceValue);
+    throwFailed(device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence)));
+    LOG_INFO(L"Fence created with initial value %llu", getFenceValue());
 
     fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
     if (!fenceEvent) {
@@ -33,99 +43,70 @@ CommandQueue::~CommandQueue() {
     }
 }
 
-ComPtr<ID3D12CommandAllocator> CommandQueue::createCommandAllocator() {
-    ComPtr<ID3D12CommandAllocator> allocator;
-    throwFailed(device->CreateCommandAllocator(type, IID_PPV_ARGS(&allocator)));
-    LOG_INFO(L"Created new CommandAllocator");
-    return allocator;
+std::unique_ptr<RhiCommandAllocator> CommandQueue::createCommandAllocator() {
+    return std::make_unique<CommandAllocator>(device, type);
 }
 
-ComPtr<ID3D12GraphicsCommandList2> CommandQueue::createCommandList(ComPtr<ID3D12CommandAllocator> allocator) {
-    ComPtr<ID3D12GraphicsCommandList2> list;
-    throwFailed(device->CreateCommandList(0, type, allocator.Get(), nullptr, IID_PPV_ARGS(&list)));
-    LOG_INFO(L"Created new CommandList (open)");
-    return list;
+std::unique_ptr<RhiCommandList> CommandQueue::createCommandList(RhiCommandAllocator* allocator) {
+    return std::make_unique<CommandList>(device, type, static_cast<CommandAllocator*>(allocator));
 }
 
-ComPtr<ID3D12GraphicsCommandList2> CommandQueue::getCommandList() {
-    LOG_INFO(L"Requesting CommandList");
-
-    // Acquire allocator
-    ComPtr<ID3D12CommandAllocator> alloc;
-    if (!allocatorQueue.empty() && isFenceComplete(allocatorQueue.front().fenceValue)) {
-        alloc = allocatorQueue.front().allocator;
-        allocatorQueue.pop();
-        throwFailed(alloc->Reset());
-        LOG_INFO(L"Reusing CommandAllocator from pool");
-    } else {
-        alloc = createCommandAllocator();
-    }
-
-    // Acquire command list
-    ComPtr<ID3D12GraphicsCommandList2> cmdList;
-    if (!listQueue.empty()) {
-        ListEntry entry = listQueue.front();
-        listQueue.pop();
-        cmdList = entry.list;
-        throwFailed(cmdList->Reset(alloc.Get(), nullptr));
-        LOG_INFO(L"Reusing CommandList from pool (reset)");
-    } else {
-        cmdList = createCommandList(alloc);
-        LOG_INFO(L"Created new CommandList (open)");
+void CommandQueue::executeNative(uint32_t count, RhiCommandList* const* lists) {
+    std::vector<ID3D12CommandList*> d3dLists(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        d3dLists[i] = static_cast<CommandList*>(lists[i])->getCommandList().Get();
     }
-
-    liveListAllocMap[cmdList.Get()] = alloc;
-    return cmdList;
+    queue->ExecuteCommandLists(count, d3dLists.data());
 }
 
-UINT64 CommandQueue::executeCommandList(ComPtr<ID3D12GraphicsCommandList2> cmdList) {
-    throwFailed(cmdList->Close());
-
-    // Retrieve allocator
-    auto it = liveListAllocMap.find(cmdList.Get());
-    ComPtr<ID3D12CommandAllocator> allocatorForList = nullptr;
-    if (it != liveListAllocMap.end()) {
-        allocatorForList = it->second;
-        liveListAllocMap.erase(it);
-    } else {
-        LOG_ERROR(L"Allocator not found for executed command list!");
-    }
+void CommandQueue::signal(uint64_t value) {
+    throwFailed(queue->Signal(fence.Get(), value));
+}
 
-    // Execute
-    ID3D12CommandList* lists[] = { cmdList.Get() };
-    queue->ExecuteCommandLists(1, lists);
+uint64_t CommandQueue::getCompletedValue() {
+    return fence->GetCompletedValue();
+}
 
-    // Signal fence
-    UINT64 val = signalFence();
-    allocatorQueue.push({ val, allocatorForList });
+void CommandQueue::waitForValue(uint64_t value) {
+    throwFailed(fence->SetEventOnCompletion(value, fenceEvent));
+    WaitForSingleObject(fenceEvent, DWORD_MAX);
+}
 
-    // Return list to pool
-    listQueue.push({ cmdList, allocatorForList });
+void CommandQueue::waitOnGpu(RhiCommandQueue* producer, uint64_t value) {
+    // queue-to-queue wait, resolved on the GPU timeline
+    auto producerQueue = static_cast<CommandQueue*>(producer);
+    throwFailed(queue->Wait(producerQueue->getFence().Get(), value));
+}
 
-    return val;
+void CommandQueue::fenceFlush(UINT64 value) {
+    fenceWait(value);
 }
 
-UINT64 CommandQueue::signalFence() {
-    fenceValue++;
-    throwFailed(queue->Signal(fence.Get(), fenceValue));
-    return fenceValue;
+FenceEvent::FenceEvent() {
+    event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+    if (!event) {
+        LOG_ERROR(L"Failed to create fence waiter event!");
+        throw std::runtime_error("Failed to create fence waiter event");
+    }
 }
 
-bool CommandQueue::isFenceComplete(UINT64 value) {
-    return fence->GetCompletedValue() >= value;
+FenceEvent::~FenceEvent() {
+    if (event)
+        CloseHandle(event);
 }
 
-void CommandQueue::fenceWait(UINT64 value) {
-    if (!isFenceComplete(value)) {
-        throwFailed(fence->SetEventOnCompletion(value, fenceEvent));
-        WaitForSingleObject(fenceEvent, DWORD_MAX);
+void FenceEvent::arm(const RhiSyncPoint* points, size_t count) {
+    // a value that already completed sets the event right away -> no lost wakeups
+    for (size_t i = 0; i < count; ++i) {
+        auto queue = static_cast<CommandQueue*>(points[i].queue);
+        throwFailed(queue->getFence()->SetEventOnCompletion(points[i].value, event));
     }
 }
 
-void CommandQueue::fenceFlush(UINT64 value) {
-    fenceWait(value);
+void FenceEvent::wait() {
+    WaitForSingleObject(event, INFINITE);
 }
 
-void CommandQueue::flush() {
-    fenceWait(signalFence());
+void FenceEvent::wake() {
+    SetEvent(event);
 }
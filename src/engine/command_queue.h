@@ -1,56 +1,54 @@
 #pragma once
 
 #include "utils/pch.h"
-#include <queue>
-#include <unordered_map>
+#include "rhi/rhi_command_queue.h"
 
-class CommandQueue {
+// Auto-reset Win32 event that every armed fence signals on completion
+class FenceEvent : public RhiFenceEvent {
 public:
-    CommandQueue(ComPtr<ID3D12Device2> device, D3D12_COMMAND_LIST_TYPE type);
-    ~CommandQueue();
+    FenceEvent();
+    ~FenceEvent() override;
 
-    // Command Allocator
-    ComPtr<ID3D12CommandAllocator> createCommandAllocator();
+    void arm(const RhiSyncPoint* points, size_t count) override;
+    void wait() override;
+    void wake() override;
 
-    // Command List
-    ComPtr<ID3D12GraphicsCommandList2> createCommandList(ComPtr<ID3D12CommandAllocator> allocator);
-    ComPtr<ID3D12GraphicsCommandList2> getCommandList();
-    UINT64 executeCommandList(ComPtr<ID3D12GraphicsCommandList2> commandList);
+private:
+    HANDLE event = nullptr;
+};
+
+// D3D12 backend for RhiCommandQueue -> pooling lives in the base class
+class CommandQueue : public RhiCommandQueue {
+public:
+    CommandQueue(
+        ComPtr<ID3D12Device2> device,
+        D3D12_COMMAND_LIST_TYPE type,
+        D3D12_COMMAND_QUEUE_PRIORITY priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL
+    );
+    ~CommandQueue() override;
 
-    // Fence
-    UINT64 signalFence();
-    void fenceWait(UINT64 value);
     void fenceFlush(UINT64 value);
-    bool isFenceComplete(UINT64 value);
-    void flush();
 
     // Getters
     ComPtr<ID3D12CommandQueue> getCommandQueue() const { return queue; }
     ComPtr<ID3D12Fence> getFence() const { return fence; }
-    UINT64 getFenceValue() const { return fenceValue; }
     HANDLE getFenceHandle() const { return fenceEvent; }
 
-private:
-    struct AllocatorEntry {
-        UINT64 fenceValue = 0;
-        ComPtr<ID3D12CommandAllocator> allocator;
-    };
-
-    struct ListEntry {
-        ComPtr<ID3D12GraphicsCommandList2> list;
-        ComPtr<ID3D12CommandAllocator> allocator;
-    };
+protected:
+    std::unique_ptr<RhiCommandAllocator> createCommandAllocator() override;
+    std::unique_ptr<RhiCommandList> createCommandList(RhiCommandAllocator* allocator) override;
+    void executeNative(uint32_t count, RhiCommandList* const* lists) override;
+    void signal(uint64_t value) override;
+    uint64_t getCompletedValue() override;
+    void waitForValue(uint64_t value) override;
+    void waitOnGpu(RhiCommandQueue* producer, uint64_t value) override;
 
+private:
     ComPtr<ID3D12Device2> device;
     ComPtr<ID3D12CommandQueue> queue;
 
     D3D12_COMMAND_LIST_TYPE type;
 
-    std::queue<AllocatorEntry> allocatorQueue;
-    std::queue<ListEntry> listQueue;
-    std::unordered_map<ID3D12GraphicsCommandList2*, ComPtr<ID3D12CommandAllocator>> liveListAllocMap;
-
     ComPtr<ID3D12Fence> fence;
-    UINT64 fenceValue = 0;
     HANDLE fenceEvent = nullptr;
 };
@@ -0,0 +1,42 @@
+#include "command_signature.h"
+#include "pipeline.h"
+
+static_assert(static_cast<UINT>(RhiIndirectArgumentType::DrawIndexed) == D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED);
+static_assert(static_cast<UINT>(RhiIndirectArgumentType::Dispatch) == D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH);
+static_assert(static_cast<UINT>(RhiIndirectArgumentType::Constant) == D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT);
+
+CommandSignature::CommandSignature(
+    ComPtr<ID3D12Device2> device,
+    const RhiCommandSignatureDesc& desc,
+    Pipeline* rootSignatureOwner
+) :
+    byteStride(desc.byteStride)
+{
+    std::vector<D3D12_INDIRECT_ARGUMENT_DESC> arguments(desc.arguments.size());
+    bool changesRoot = false;
+    for (size_t i = 0; i < desc.arguments.size(); ++i) {
+        const auto& argument = desc.arguments[i];
+        arguments[i].Type = static_cast<D3D12_INDIRECT_ARGUMENT_TYPE>(argument.type);
+        if (argument.type == RhiIndirectArgumentType::Constant) {
+            arguments[i].Constant.RootParameterIndex = argument.rootIndex;
+            arguments[i].Constant.DestOffsetIn32BitValues = argument.destOffsetIn32BitValues;
+            arguments[i].Constant.Num32BitValuesToSet = argument.num32BitValues;
+            changesRoot = true;
+        }
+    }
+
+    if (changesRoot && !rootSignatureOwner) {
+        LOG_ERROR(L"CommandSignature -> Root constant arguments need the pipeline they are set on");
+        throw std::runtime_error("Command signature without root signature");
+    }
+
+    D3D12_COMMAND_SIGNATURE_DESC signatureDesc = {};
+    signatureDesc.ByteStride = desc.byteStride;
+    signatureDesc.NumArgumentDescs = static_cast<UINT>(arguments.size());
+    signatureDesc.pArgumentDescs = arguments.data();
+
+    ID3D12RootSignature* rootSignature = changesRoot ? rootSignatureOwner->getRootSignature().Get() : nullptr;
+    throwFailed(device->CreateCommandSignature(&signatureDesc, rootSignature, IID_PPV_ARGS(&signature)));
+
+    LOG_INFO(L"CommandSignature -> %u arguments, stride %u", signatureDesc.NumArgumentDescs, byteStride);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "utils/pch.h"
+#include "rhi/rhi.h"
+
+class Pipeline;
+
+// Layout of the commands ExecuteIndirect reads out of an argument buffer
+class CommandSignature : public RhiCommandSignature {
+    public:
+        // rootSignatureOwner -> required once an argument writes root constants
+        CommandSignature(ComPtr<ID3D12Device2> device, const RhiCommandSignatureDesc& desc, Pipeline* rootSignatureOwner);
+
+        ~CommandSignature() override = default;
+
+        uint32_t getByteStride() const override {
+            return byteStride;
+        }
+
+        ComPtr<ID3D12CommandSignature> getSignature() const {
+            return signature;
+        }
+
+    private:
+        ComPtr<ID3D12CommandSignature> signature;
+        UINT byteStride = 0;
+};
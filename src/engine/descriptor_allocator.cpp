@@ -0,0 +1,166 @@
+#include "descriptor_allocator.h"
+#include "utils/logger.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+DescriptorCache::DescriptorCache(DescriptorAllocator* allocator)
+    : allocator(allocator)
+{
+    singles.reserve(BATCH_SIZE * 2);
+}
+
+DescriptorCache::~DescriptorCache() {
+    flush();
+}
+
+DescriptorAllocation DescriptorCache::allocate() {
+    if (singles.empty()) {
+        allocator->allocateSingles(BATCH_SIZE, singles);
+    }
+
+    DescriptorAllocation allocation = singles.back();
+    singles.pop_back();
+    return allocation;
+}
+
+void DescriptorCache::free(const DescriptorAllocation& allocation) {
+    if (allocation.count != 1) {
+        allocator->free(allocation);
+        return;
+    }
+
+    singles.push_back(allocation);
+
+    // keep one batch around, give the rest back
+    if (singles.size() >= BATCH_SIZE * 2) {
+        allocator->freeSingles(singles.data() + BATCH_SIZE, singles.size() - BATCH_SIZE);
+        singles.resize(BATCH_SIZE);
+    }
+}
+
+void DescriptorCache::flush() {
+    if (!singles.empty()) {
+        allocator->freeSingles(singles.data(), singles.size());
+        singles.clear();
+    }
+}
+
+DescriptorAllocator::DescriptorAllocator(RhiDevice* device, RhiDescriptorHeapType type, uint32_t pageSize) :
+    device(device),
+    type(type),
+    pageSize(pageSize)
+{
+}
+
+DescriptorAllocator::~DescriptorAllocator() {
+    // caches hand their descriptors back first
+    caches.clear();
+
+    if (allocatedCount > 0) {
+        LOG_WARNING(L"DescriptorAllocator -> %llu descriptors of type %d still allocated on shutdown",
+            static_cast<unsigned long long>(allocatedCount), static_cast<int>(type));
+    }
+}
+
+DescriptorCache* DescriptorAllocator::createCache() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    caches.push_back(std::unique_ptr<DescriptorCache>(new DescriptorCache(this)));
+    return caches.back().get();
+}
+
+DescriptorAllocation DescriptorAllocator::allocate(uint32_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return allocateLocked(count);
+}
+
+void DescriptorAllocator::free(const DescriptorAllocation& allocation) {
+    std::lock_guard<std::mutex> lock(mutex);
+    freeLocked(allocation);
+}
+
+void DescriptorAllocator::allocateSingles(uint32_t count, std::vector<DescriptorAllocation>& out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (uint32_t i = 0; i < count; ++i) {
+        out.push_back(allocateLocked(1));
+    }
+}
+
+void DescriptorAllocator::freeSingles(const DescriptorAllocation* allocations, size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < count; ++i) {
+        freeLocked(allocations[i]);
+    }
+}
+
+DescriptorAllocation DescriptorAllocator::allocateLocked(uint32_t count) {
+    DescriptorAllocation allocation;
+    if (count == 0) {
+        return allocation;
+    }
+
+    // current page first, then the others -> the common case touches one page
+    uint32_t pageCount = static_cast<uint32_t>(pages.size());
+    for (uint32_t i = 0; i < pageCount; ++i) {
+        uint32_t index = (currentPage + i) % pageCount;
+        Page& page = pages[index];
+
+        if (page.ranges->getFree() < count) {
+            continue;
+        }
+
+        allocation.range = page.ranges->allocate(count);
+        if (allocation.range.isValid()) {
+            currentPage = index;
+            allocation.page = index;
+            break;
+        }
+    }
+
+    // grow
+    if (!allocation.isValid()) {
+        uint32_t size = std::max(pageSize, count);
+
+        Page page;
+        page.heap = device->createDescriptorHeap(type, size, false);
+        page.ranges = std::make_unique<TlsfAllocator>(size, 1);
+        pages.push_back(std::move(page));
+
+        currentPage = static_cast<uint32_t>(pages.size() - 1);
+        allocation.range = pages.back().ranges->allocate(count);
+        allocation.page = currentPage;
+
+        LOG_INFO(L"DescriptorAllocator -> Added page %u (%u descriptors, type %d)", currentPage, size, static_cast<int>(type));
+    }
+
+    const Page& page = pages[allocation.page];
+    allocation.count = count;
+    allocation.descriptorSize = page.heap->getDescriptorSize();
+    allocation.base = page.heap->getCPUDescriptor(static_cast<uint32_t>(allocation.range.offset));
+
+    allocatedCount += count;
+    return allocation;
+}
+
+void DescriptorAllocator::freeLocked(const DescriptorAllocation& allocation) {
+    if (!allocation.isValid()) {
+        return;
+    }
+    if (allocation.page >= pages.size()) {
+        LOG_ERROR(L"DescriptorAllocator -> Freeing descriptors from unknown page %u", allocation.page);
+        throw std::runtime_error("Invalid descriptor free");
+    }
+
+    pages[allocation.page].ranges->free(allocation.range);
+    allocatedCount -= allocation.count;
+}
+
+uint32_t DescriptorAllocator::getPageCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<uint32_t>(pages.size());
+}
+
+uint64_t DescriptorAllocator::getAllocatedCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return allocatedCount;
+}
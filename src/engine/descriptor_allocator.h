@@ -0,0 +1,103 @@
+#pragma once
+
+#include "rhi/rhi.h"
+#include "memory/tlsf_allocator.h"
+#include <mutex>
+
+struct DescriptorAllocation {
+    static constexpr uint32_t INVALID_PAGE = ~0u;
+
+    RhiCpuDescriptor base;
+    uint32_t count = 0;
+    uint32_t descriptorSize = 0;
+    uint32_t page = INVALID_PAGE;
+    TlsfAllocation range;
+
+    RhiCpuDescriptor get(uint32_t index = 0) const {
+        return { base.ptr + size_t(index) * descriptorSize };
+    }
+
+    bool isValid() const {
+        return page != INVALID_PAGE;
+    }
+};
+
+class DescriptorAllocator;
+
+// Per-thread stash of single descriptors -> allocate / free without touching the
+// allocator's lock; refills and drains in batches. Not thread-safe: one per thread.
+class DescriptorCache {
+public:
+    static constexpr uint32_t BATCH_SIZE = 32;
+
+    ~DescriptorCache();
+
+    DescriptorAllocation allocate();
+
+    // single descriptors stay in the cache, ranges go straight back to the allocator
+    void free(const DescriptorAllocation& allocation);
+
+    // hands every cached descriptor back
+    void flush();
+
+private:
+    friend class DescriptorAllocator;
+
+    explicit DescriptorCache(DescriptorAllocator* allocator);
+
+private:
+    DescriptorAllocator* allocator = nullptr;
+    std::vector<DescriptorAllocation> singles;
+};
+
+// Growable CPU (non shader-visible) descriptor allocator for one heap type.
+// Descriptors live in fixed-size pages (one RhiDescriptorHeap each) added on demand;
+// contiguous ranges inside a page come from a TlsfAllocator, so allocate and free are
+// O(1) per page. Ranges larger than a page get a dedicated page.
+class DescriptorAllocator {
+public:
+    static constexpr uint32_t DEFAULT_PAGE_SIZE = 256;
+
+    DescriptorAllocator(RhiDevice* device, RhiDescriptorHeapType type, uint32_t pageSize = DEFAULT_PAGE_SIZE);
+    ~DescriptorAllocator();
+
+    // Thread-safe
+    DescriptorAllocation allocate(uint32_t count = 1);
+    void free(const DescriptorAllocation& allocation);
+
+    // One cache per recording / loading thread; owned by the allocator
+    DescriptorCache* createCache();
+
+    RhiDescriptorHeapType getType() const { return type; }
+    uint32_t getPageSize() const { return pageSize; }
+    uint32_t getPageCount();
+    uint64_t getAllocatedCount();
+
+private:
+    friend class DescriptorCache;
+
+    // count single descriptors under one lock
+    void allocateSingles(uint32_t count, std::vector<DescriptorAllocation>& out);
+    void freeSingles(const DescriptorAllocation* allocations, size_t count);
+
+    DescriptorAllocation allocateLocked(uint32_t count);
+    void freeLocked(const DescriptorAllocation& allocation);
+
+private:
+    struct Page {
+        std::unique_ptr<RhiDescriptorHeap> heap;
+        std::unique_ptr<TlsfAllocator> ranges;
+    };
+
+    RhiDevice* device = nullptr;
+    RhiDescriptorHeapType type;
+    uint32_t pageSize = 0;
+
+    std::mutex mutex;
+    std::vector<Page> pages;
+    uint32_t currentPage = 0; // last page that had room -> first one tried
+    uint64_t allocatedCount = 0;
+
+    std::mutex cacheMutex;
+    std::vector<std::unique_ptr<DescriptorCache>> caches;
+};
@@ -1,8 +1,9 @@
 #pragma once
 
 #include "utils/pch.h"
+#include "rhi/rhi.h"
 
-class DescriptorHeap {
+class DescriptorHeap : public RhiDescriptorHeap {
     public:
         DescriptorHeap(
             ComPtr<ID3D12Device2> device, 
@@ -14,16 +15,29 @@ class DescriptorHeap {
         CD3DX12_CPU_DESCRIPTOR_HANDLE getCPUHandle(UINT index) const;
         CD3DX12_GPU_DESCRIPTOR_HANDLE getGPUHandle(UINT index) const;
 
+        RhiCpuDescriptor getCPUDescriptor(uint32_t index) const override {
+            return { getCPUHandle(index).ptr };
+        }
+
+        RhiGpuDescriptor getGPUDescriptor(uint32_t index) const override {
+            return { getGPUHandle(index).ptr };
+        }
+
         ComPtr<ID3D12DescriptorHeap> getHeap() const { 
             return heap; 
         }
 
-        UINT getDescriptorSize() const { 
+        UINT getDescriptorSize() const override { 
             return descriptorSize; 
         }
 
+        UINT getNumDescriptors() const override {
+            return numDescriptors;
+        }
+
     private:
         ComPtr<ID3D12DescriptorHeap> heap;
         UINT descriptorSize;
+        UINT numDescriptors;
         D3D12_DESCRIPTOR_HEAP_TYPE type;
 };
\ No newline at end of file
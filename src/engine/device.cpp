@@ -1,4 +1,20 @@
 #include "device.h"
+#include "command_queue.h"
+#include "swapchain.h"
+#include "descriptor_heap.h"
+#include "pipeline.h"
+#include "command_signature.h"
+#include "shader.h"
+#include "buffer/vertex.h"
+#include "buffer/index.h"
+#include "buffer/constant.h"
+#include "buffer/buffer.h"
+#include "resource_heap.h"
+#include "texture.h"
+
+static_assert(static_cast<UINT>(RhiRootParameterType::Constants) == D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS);
+static_assert(static_cast<UINT>(RhiRootParameterType::ConstantBufferView) == D3D12_ROOT_PARAMETER_TYPE_CBV);
+static_assert(static_cast<UINT>(RhiDescriptorRangeType::Cbv) == D3D12_DESCRIPTOR_RANGE_TYPE_CBV);
 
 Device::Device(bool useWarp)
 {
@@ -11,6 +27,13 @@ Device::Device(bool useWarp)
 
     device = createDevice(adapter);
 
+    defaultHeaps = std::make_unique<HeapAllocator>(device, D3D12_HEAP_TYPE_DEFAULT);
+    uploadHeaps = std::make_unique<HeapAllocator>(device, D3D12_HEAP_TYPE_UPLOAD);
+
+    for (UINT type = 0; type < D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES; ++type) {
+        descriptorAllocators[type] = std::make_unique<DescriptorAllocator>(this, static_cast<RhiDescriptorHeapType>(type));
+    }
+
     LOG_INFO(L"Device->DirectX 12 device initialized.");
 }
 
@@ -169,3 +192,256 @@ bool Device::checkForTearingSupport()
 
     return allowTearing == TRUE;
 }
+
+std::unique_ptr<RhiCommandQueue> Device::createCommandQueue(
+    RhiCommandListType type,
+    RhiQueuePriority priority
+)
+{
+    return std::make_unique<CommandQueue>(
+        device,
+        static_cast<D3D12_COMMAND_LIST_TYPE>(type),
+        static_cast<D3D12_COMMAND_QUEUE_PRIORITY>(priority)
+    );
+}
+
+std::unique_ptr<RhiSwapchain> Device::createSwapchain(
+    const RhiSwapchainDesc& desc,
+    RhiCommandQueue* presentQueue
+) {
+    return std::make_unique<Swapchain>(
+        static_cast<HWND>(desc.window),
+        device,
+        static_cast<CommandQueue*>(presentQueue)->getCommandQueue(),
+        desc.width,
+        desc.height,
+        desc.bufferCount,
+        desc.frameLatency,
+        supportTearing,
+        getDescriptorAllocator(RhiDescriptorHeapType::Rtv)
+    );
+}
+
+std::unique_ptr<RhiDescriptorHeap> Device::createDescriptorHeap(
+    RhiDescriptorHeapType type,
+    uint32_t numDescriptors,
+    bool shaderVisible
+) {
+    return std::make_unique<DescriptorHeap>(
+        device,
+        static_cast<D3D12_DESCRIPTOR_HEAP_TYPE>(type),
+        numDescriptors,
+        shaderVisible
+    );
+}
+
+void Device::copyDescriptors(
+    RhiCpuDescriptor destination,
+    RhiCpuDescriptor source,
+    uint32_t count,
+    RhiDescriptorHeapType type
+) {
+    device->CopyDescriptorsSimple(
+        count,
+        { destination.ptr },
+        { source.ptr },
+        static_cast<D3D12_DESCRIPTOR_HEAP_TYPE>(type)
+    );
+}
+
+void Device::createConstantBufferView(uint64_t gpuAddress, uint32_t sizeInBytes, RhiCpuDescriptor destination)
+{
+    D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
+    cbvDesc.BufferLocation = gpuAddress;
+    cbvDesc.SizeInBytes = sizeInBytes;
+    device->CreateConstantBufferView(&cbvDesc, { destination.ptr });
+}
+
+static std::vector<D3D12_ROOT_PARAMETER> buildRootParameters(
+    const std::vector<RhiRootParameter>& parameters,
+    std::vector<CD3DX12_DESCRIPTOR_RANGE>& ranges
+) {
+    std::vector<D3D12_ROOT_PARAMETER> rootParams;
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        const auto& param = parameters[i];
+        auto visibility = static_cast<D3D12_SHADER_VISIBILITY>(param.visibility);
+
+        CD3DX12_ROOT_PARAMETER rootParam;
+        switch (param.type) {
+            case RhiRootParameterType::Constants:
+                rootParam.InitAsConstants(param.num32BitValues, param.shaderRegister, param.registerSpace, visibility);
+                break;
+
+            case RhiRootParameterType::DescriptorTable:
+                ranges[i].Init(
+                    static_cast<D3D12_DESCRIPTOR_RANGE_TYPE>(param.rangeType),
+                    param.numDescriptors == 0 ? UINT_MAX : param.numDescriptors, // UINT_MAX -> unbounded
+                    param.shaderRegister,
+                    param.registerSpace,
+                    0
+                );
+                rootParam.InitAsDescriptorTable(1, &ranges[i], visibility);
+                break;
+
+            case RhiRootParameterType::ShaderResourceView:
+                rootParam.InitAsShaderResourceView(param.shaderRegister, param.registerSpace, visibility);
+                break;
+
+            case RhiRootParameterType::UnorderedAccessView:
+                rootParam.InitAsUnorderedAccessView(param.shaderRegister, param.registerSpace, visibility);
+                break;
+
+            default:
+                rootParam.InitAsConstantBufferView(param.shaderRegister, param.registerSpace, visibility);
+                break;
+        }
+        rootParams.push_back(rootParam);
+    }
+    return rootParams;
+}
+
+std::unique_ptr<RhiPipeline> Device::createPipeline(const RhiPipelineDesc& desc)
+{
+    std::vector<D3D12_INPUT_ELEMENT_DESC> inputLayout;
+    for (const auto& element : desc.inputLayout) {
+        inputLayout.push_back({
+            element.semanticName,
+            element.semanticIndex,
+            static_cast<DXGI_FORMAT>(element.format),
+            element.inputSlot,
+            element.alignedByteOffset,
+            static_cast<D3D12_INPUT_CLASSIFICATION>(element.classification),
+            element.instanceStepRate
+        });
+    }
+
+    // tables point into ranges -> sized up front so the pointers stay valid
+    std::vector<CD3DX12_DESCRIPTOR_RANGE> ranges(desc.rootParameters.size());
+    std::vector<D3D12_ROOT_PARAMETER> rootParams = buildRootParameters(desc.rootParameters, ranges);
+
+    auto vertexShader = Shader(desc.vertexShader);
+    auto pixelShader = Shader(desc.pixelShader);
+
+    std::vector<D3D12_STATIC_SAMPLER_DESC> samplers{};
+
+    return std::make_unique<Pipeline>(
+        device,
+        vertexShader,
+        pixelShader,
+        inputLayout,
+        rootParams,
+        samplers,
+        static_cast<DXGI_FORMAT>(desc.rtvFormat),
+        static_cast<DXGI_FORMAT>(desc.dsvFormat)
+    );
+}
+
+std::unique_ptr<RhiPipeline> Device::createComputePipeline(const RhiComputePipelineDesc& desc)
+{
+    std::vector<CD3DX12_DESCRIPTOR_RANGE> ranges(desc.rootParameters.size());
+    std::vector<D3D12_ROOT_PARAMETER> rootParams = buildRootParameters(desc.rootParameters, ranges);
+
+    auto computeShader = Shader(desc.computeShader);
+    return std::make_unique<Pipeline>(device, computeShader, rootParams);
+}
+
+std::unique_ptr<RhiCommandSignature> Device::createCommandSignature(const RhiCommandSignatureDesc& desc, RhiPipeline* pipeline)
+{
+    return std::make_unique<CommandSignature>(device, desc, static_cast<Pipeline*>(pipeline));
+}
+
+std::unique_ptr<RhiFenceEvent> Device::createFenceEvent()
+{
+    return std::make_unique<FenceEvent>();
+}
+
+std::unique_ptr<RhiBuffer> Device::createVertexBuffer(const void* data, uint32_t count, uint32_t stride)
+{
+    return std::make_unique<VertexBuffer>(device, data, count, stride);
+}
+
+std::unique_ptr<RhiBuffer> Device::createIndexBuffer(const uint32_t* indices, uint32_t count)
+{
+    return std::make_unique<IndexBuffer>(device, indices, count);
+}
+
+std::unique_ptr<RhiBuffer> Device::createConstantBuffer(uint32_t size)
+{
+    return std::make_unique<ConstantBuffer>(device, size);
+}
+
+std::unique_ptr<RhiBuffer> Device::createBuffer(const RhiBufferDesc& desc)
+{
+    if (desc.sizeInBytes <= PLACEMENT_LIMIT) {
+        if (desc.heapType == RhiHeapType::Default) {
+            return std::make_unique<Buffer>(device, desc, defaultHeaps.get());
+        }
+        if (desc.heapType == RhiHeapType::Upload) {
+            return std::make_unique<Buffer>(device, desc, uploadHeaps.get());
+        }
+    }
+    return std::make_unique<Buffer>(device, desc);
+}
+
+std::unique_ptr<RhiHeap> Device::createHeap(uint64_t size, RhiHeapUsage usage)
+{
+    return std::make_unique<ResourceHeap>(device, size, usage);
+}
+
+RhiAllocationInfo Device::getTextureAllocationInfo(const RhiTextureDesc& desc)
+{
+    D3D12_RESOURCE_DESC resourceDesc = Texture::getResourceDesc(desc);
+    D3D12_RESOURCE_ALLOCATION_INFO info = device->GetResourceAllocationInfo(0, 1, &resourceDesc);
+    return { info.SizeInBytes, info.Alignment };
+}
+
+std::unique_ptr<RhiTexture> Device::createPlacedTexture(RhiHeap* heap, uint64_t offset, const RhiTextureDesc& desc)
+{
+    return std::make_unique<Texture>(device, static_cast<ResourceHeap*>(heap)->getHeap(), offset, desc);
+}
+
+std::unique_ptr<RhiBuffer> Device::createPlacedBuffer(RhiHeap* heap, uint64_t offset, const RhiBufferDesc& desc)
+{
+    return std::make_unique<Buffer>(device, desc, static_cast<ResourceHeap*>(heap)->getHeap(), offset);
+}
+
+void Device::createRenderTargetView(RhiTexture* texture, RhiCpuDescriptor destination)
+{
+    device->CreateRenderTargetView(static_cast<ID3D12Resource*>(texture->getHandle().native), nullptr, { destination.ptr });
+}
+
+void Device::createDepthStencilView(RhiTexture* texture, RhiCpuDescriptor destination)
+{
+    D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc = {};
+    dsvDesc.Format = static_cast<DXGI_FORMAT>(texture->getDesc().format);
+    dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
+    dsvDesc.Flags = D3D12_DSV_FLAG_NONE;
+
+    device->CreateDepthStencilView(static_cast<ID3D12Resource*>(texture->getHandle().native), &dsvDesc, { destination.ptr });
+}
+
+RhiMemoryBudget Device::getMemoryBudget()
+{
+    DXGI_QUERY_VIDEO_MEMORY_INFO info = {};
+    throwFailed(adapter->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &info));
+    return { info.Budget, info.CurrentUsage };
+}
+
+void Device::evict(const RhiPageable* pageables, uint32_t count)
+{
+    std::vector<ID3D12Pageable*> objects(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        objects[i] = static_cast<ID3D12Pageable*>(pageables[i].native);
+    }
+    throwFailed(device->Evict(count, objects.data()));
+}
+
+void Device::makeResident(const RhiPageable* pageables, uint32_t count)
+{
+    std::vector<ID3D12Pageable*> objects(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        objects[i] = static_cast<ID3D12Pageable*>(pageables[i].native);
+    }
+    // blocks until the memory is paged in -> batched so it happens once per frame at most
+    throwFailed(device->MakeResident(count, objects.data()));
+}
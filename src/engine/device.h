@@ -1,12 +1,73 @@
 #pragma once
 
 #include "utils/pch.h"
+#include "rhi/rhi.h"
+#include "heap_allocator.h"
+#include "descriptor_allocator.h"
 
-class Device
+class Device : public RhiDevice
 {
     public:
         Device(bool useWarp);
-        ~Device() = default;
+        ~Device() override = default;
+
+        // buffers up to this size are placed in shared heap blocks, larger ones stay committed
+        static constexpr UINT64 PLACEMENT_LIMIT = HeapAllocator::DEFAULT_BLOCK_SIZE / 4;
+
+        // RhiDevice
+        std::unique_ptr<RhiCommandQueue> createCommandQueue(
+            RhiCommandListType type,
+            RhiQueuePriority priority = RhiQueuePriority::Normal
+        ) override;
+
+        std::unique_ptr<RhiSwapchain> createSwapchain(
+            const RhiSwapchainDesc& desc,
+            RhiCommandQueue* presentQueue
+        ) override;
+
+        std::unique_ptr<RhiDescriptorHeap> createDescriptorHeap(
+            RhiDescriptorHeapType type,
+            uint32_t numDescriptors,
+            bool shaderVisible = false
+        ) override;
+
+        DescriptorAllocator* getDescriptorAllocator(RhiDescriptorHeapType type) override {
+            return descriptorAllocators[static_cast<uint32_t>(type)].get();
+        }
+
+        void copyDescriptors(
+            RhiCpuDescriptor destination,
+            RhiCpuDescriptor source,
+            uint32_t count,
+            RhiDescriptorHeapType type
+        ) override;
+
+        void createConstantBufferView(uint64_t gpuAddress, uint32_t sizeInBytes, RhiCpuDescriptor destination) override;
+
+        std::unique_ptr<RhiPipeline> createPipeline(const RhiPipelineDesc& desc) override;
+        std::unique_ptr<RhiPipeline> createComputePipeline(const RhiComputePipelineDesc& desc) override;
+        std::unique_ptr<RhiCommandSignature> createCommandSignature(
+            const RhiCommandSignatureDesc& desc,
+            RhiPipeline* pipeline = nullptr
+        ) override;
+        std::unique_ptr<RhiFenceEvent> createFenceEvent() override;
+
+        std::unique_ptr<RhiBuffer> createVertexBuffer(const void* data, uint32_t count, uint32_t stride) override;
+        std::unique_ptr<RhiBuffer> createIndexBuffer(const uint32_t* indices, uint32_t count) override;
+        std::unique_ptr<RhiBuffer> createConstantBuffer(uint32_t size) override;
+        std::unique_ptr<RhiBuffer> createBuffer(const RhiBufferDesc& desc) override;
+
+        std::unique_ptr<RhiHeap> createHeap(uint64_t size, RhiHeapUsage usage) override;
+        RhiAllocationInfo getTextureAllocationInfo(const RhiTextureDesc& desc) override;
+        std::unique_ptr<RhiTexture> createPlacedTexture(RhiHeap* heap, uint64_t offset, const RhiTextureDesc& desc) override;
+        std::unique_ptr<RhiBuffer> createPlacedBuffer(RhiHeap* heap, uint64_t offset, const RhiBufferDesc& desc) override;
+
+        void createRenderTargetView(RhiTexture* texture, RhiCpuDescriptor destination) override;
+        void createDepthStencilView(RhiTexture* texture, RhiCpuDescriptor destination) override;
+
+        RhiMemoryBudget getMemoryBudget() override;
+        void evict(const RhiPageable* pageables, uint32_t count) override;
+        void makeResident(const RhiPageable* pageables, uint32_t count) override;
 
         ComPtr<ID3D12Device2> getDevice() const { 
             return device; 
@@ -33,6 +94,11 @@ class Device
     private:
         ComPtr<IDXGIAdapter4> adapter;
         ComPtr<ID3D12Device2> device;
+
+        // declared after device -> released before it
+        std::unique_ptr<HeapAllocator> defaultHeaps;
+        std::unique_ptr<HeapAllocator> uploadHeaps;
+        std::unique_ptr<DescriptorAllocator> descriptorAllocators[4];
         
         bool supportTearing = false;
         UINT dxgiFactoryFlags = 0;
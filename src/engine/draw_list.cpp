@@ -0,0 +1,211 @@
+#include "draw_list.h"
+#include "job_system.h"
+#include "utils/logger.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+static constexpr uint32_t RADIX = 256;
+static constexpr uint32_t MIN_BLOCK_SIZE = 16 * 1024; // below -> one block, not worth a job
+
+DrawListStats& DrawListStats::operator+=(const DrawListStats& other) {
+    draws += other.draws;
+    pipelineChanges += other.pipelineChanges;
+    materialChanges += other.materialChanges;
+    bufferChanges += other.bufferChanges;
+    return *this;
+}
+
+uint32_t DrawList::addPipeline(RhiPipeline* pipeline) {
+    if (pipelines.size() >= MAX_PIPELINES) {
+        LOG_ERROR(L"DrawList -> More than %u pipelines", MAX_PIPELINES);
+        throw std::runtime_error("Too many draw list pipelines");
+    }
+    pipelines.push_back(pipeline);
+    return static_cast<uint32_t>(pipelines.size() - 1);
+}
+
+void DrawList::setDepthRange(float nearZ, float farZ) {
+    depthBias = -nearZ;
+    depthScale = farZ > nearZ ? 1.0f / (farZ - nearZ) : 1.0f;
+}
+
+void DrawList::clear() {
+    draws.clear();
+    entries.clear();
+    sorted = false;
+    keyBitsAny = 0;
+    keyBitsAll = ~0ull;
+}
+
+uint32_t DrawList::quantizeDepth(float depth) const {
+    const float maxDepth = static_cast<float>((1u << DEPTH_BITS) - 1);
+    float normalized = (depth + depthBias) * depthScale;
+    // also catches NaN -> front
+    if (!(normalized > 0.0f)) {
+        return 0;
+    }
+    return normalized >= 1.0f ? (1u << DEPTH_BITS) - 1 : static_cast<uint32_t>(normalized * maxDepth);
+}
+
+uint64_t DrawList::makeKey(uint32_t pass, DrawBlend blend, uint32_t pipeline, uint32_t material, uint32_t depth) {
+    uint64_t key = uint64_t(pass & (MAX_PASSES - 1)) << 56;
+    uint64_t state = (uint64_t(pipeline & (MAX_PIPELINES - 1)) << 20) | (material & (MAX_MATERIALS - 1));
+    depth &= (1u << DEPTH_BITS) - 1;
+
+    if (blend == DrawBlend::Opaque) {
+        return key | (state << DEPTH_BITS) | depth;
+    }
+    uint64_t farFirst = ((1u << DEPTH_BITS) - 1) - depth;
+    return key | (1ull << 55) | (farFirst << 31) | state;
+}
+
+void DrawList::add(uint32_t pass, DrawBlend blend, float depth, const DrawCommand& draw) {
+    if (pass >= MAX_PASSES) {
+        LOG_ERROR(L"DrawList -> Pass %u out of range", pass);
+        throw std::runtime_error("Draw list pass out of range");
+    }
+
+    uint64_t key = makeKey(pass, blend, draw.pipeline, draw.materialIndex, quantizeDepth(depth));
+    keyBitsAny |= key;
+    keyBitsAll &= key;
+
+    entries.push_back({ key, static_cast<uint32_t>(draws.size()) });
+    draws.push_back(draw);
+    sorted = false;
+}
+
+void DrawList::sort(JobSystem* jobs) {
+    uint32_t count = static_cast<uint32_t>(entries.size());
+    if (count < 2) {
+        return; // already in order (and record reads draws directly)
+    }
+
+    uint32_t blocks = 1;
+    if (jobs && jobs->getThreadCount() > 1) {
+        blocks = std::clamp(count / MIN_BLOCK_SIZE, 1u, jobs->getThreadCount());
+    }
+    uint32_t blockSize = (count + blocks - 1) / blocks;
+
+    scratch.resize(count);
+    histograms.resize(size_t(blocks) * RADIX);
+
+    Entry* source = entries.data();
+    Entry* destination = scratch.data();
+
+    auto forBlocks = [&](const auto& function) {
+        if (blocks == 1) {
+            function(0u);
+            return;
+        }
+        jobs->parallelFor(blocks, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t block = begin; block < end; ++block) {
+                function(block);
+            }
+        }, 1);
+    };
+
+    uint64_t varying = keyBitsAny ^ keyBitsAll;
+    for (uint32_t shift = 0; shift < 64; shift += 8) {
+        if (((varying >> shift) & 0xff) == 0) {
+            continue; // every key has the same byte here -> the pass would not move anything
+        }
+
+        // 1. digit counts per block
+        forBlocks([&](uint32_t block) {
+            uint32_t* histogram = &histograms[size_t(block) * RADIX];
+            std::fill(histogram, histogram + RADIX, 0u);
+            uint32_t end = std::min(count, (block + 1) * blockSize);
+            for (uint32_t i = block * blockSize; i < end; ++i) {
+                histogram[(source[i].key >> shift) & 0xff]++;
+            }
+        });
+
+        // 2. digit-major, block-minor offsets -> block b's digit d lands after every earlier block's d (stable)
+        uint32_t offset = 0;
+        for (uint32_t digit = 0; digit < RADIX; ++digit) {
+            for (uint32_t block = 0; block < blocks; ++block) {
+                uint32_t& slot = histograms[size_t(block) * RADIX + digit];
+                uint32_t digitCount = slot;
+                slot = offset;
+                offset += digitCount;
+            }
+        }
+
+        // 3. scatter
+        forBlocks([&](uint32_t block) {
+            uint32_t* offsets = &histograms[size_t(block) * RADIX];
+            uint32_t end = std::min(count, (block + 1) * blockSize);
+            for (uint32_t i = block * blockSize; i < end; ++i) {
+                destination[offsets[(source[i].key >> shift) & 0xff]++] = source[i];
+            }
+        });
+
+        std::swap(source, destination);
+    }
+
+    if (source != entries.data()) {
+        entries.swap(scratch);
+    }
+
+    // commands into key order: a tight copy loop overlaps the cache misses far better than
+    // recording (virtual calls per draw) could -> record() then streams
+    sortedDraws.resize(count);
+    forBlocks([&](uint32_t block) {
+        uint32_t end = std::min(count, (block + 1) * blockSize);
+        for (uint32_t i = block * blockSize; i < end; ++i) {
+            sortedDraws[i] = draws[entries[i].draw];
+        }
+    });
+    sorted = true;
+}
+
+DrawRange DrawList::getPassRange(uint32_t pass) const {
+    auto byKey = [](const Entry& entry, uint64_t key) { return entry.key < key; };
+    auto first = std::lower_bound(entries.begin(), entries.end(), uint64_t(pass) << 56, byKey);
+    auto last = pass + 1 >= MAX_PASSES ? entries.end() : std::lower_bound(first, entries.end(), uint64_t(pass + 1) << 56, byKey);
+    return { static_cast<uint32_t>(first - entries.begin()), static_cast<uint32_t>(last - entries.begin()) };
+}
+
+DrawListStats DrawList::record(RhiCommandList* list, DrawRange range, const PipelineBindFunction& onPipeline) const {
+    DrawListStats stats;
+
+    const DrawCommand* last = nullptr;
+    for (uint32_t i = range.begin; i < range.end; ++i) {
+        const DrawCommand& draw = sorted ? sortedDraws[i] : draws[entries[i].draw];
+
+        // a new pipeline brings a new root signature -> every root argument is gone
+        bool newPipeline = !last || draw.pipeline != last->pipeline;
+        if (newPipeline) {
+            list->setPipeline(pipelines[draw.pipeline]);
+            if (onPipeline) {
+                onPipeline(list);
+            }
+            stats.pipelineChanges++;
+        }
+        if (newPipeline || draw.constantsIndex != last->constantsIndex || draw.materialIndex != last->materialIndex) {
+            const uint32_t drawConstants[] = { draw.constantsIndex, draw.materialIndex };
+            list->setGraphicsRoot32BitConstants(0, 2, drawConstants);
+            stats.materialChanges++;
+        }
+
+        // input assembler state survives pipeline changes
+        if (!last || draw.vertexBuffer.gpuAddress != last->vertexBuffer.gpuAddress) {
+            list->setVertexBuffer(0, draw.vertexBuffer);
+            stats.bufferChanges++;
+        }
+        if (!last || draw.indexBuffer.gpuAddress != last->indexBuffer.gpuAddress) {
+            list->setIndexBuffer(draw.indexBuffer);
+            stats.bufferChanges++;
+        }
+
+        list->drawIndexedInstanced(draw.indexCount, draw.instanceCount, draw.startIndex, draw.baseVertex, 0);
+        stats.draws++;
+        last = &draw;
+    }
+    return stats;
+}
+
+DrawListStats DrawList::record(RhiCommandList* list, const PipelineBindFunction& onPipeline) const {
+    return record(list, { 0, getCount() }, onPipeline);
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "rhi/rhi.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class JobSystem;
+
+enum class DrawBlend : uint8_t {
+    Opaque,      // front-to-back -> early depth rejects hidden pixels
+    Transparent  // back-to-front -> blending composes correctly
+};
+
+// Everything one draw binds. pipeline is the id DrawList::addPipeline returned.
+// Root layout of the renderer: 0 = DrawConstants (constantsIndex, materialIndex); everything else is
+// reached through those bindless indices
+struct DrawCommand {
+    uint32_t pipeline = 0;
+    uint32_t constantsIndex = ~0u; // bindless indices -> root constants
+    uint32_t materialIndex = ~0u;
+    RhiVertexBufferView vertexBuffer;
+    RhiIndexBufferView indexBuffer;
+    uint32_t indexCount = 0;
+    uint32_t instanceCount = 1;
+    uint32_t startIndex = 0;
+    int32_t baseVertex = 0;
+};
+
+// [begin, end) of the sorted list
+struct DrawRange {
+    uint32_t begin = 0;
+    uint32_t end = 0;
+};
+
+// State the recording actually set (redundant binds are skipped)
+struct DrawListStats {
+    uint64_t draws = 0;
+    uint64_t pipelineChanges = 0;
+    uint64_t materialChanges = 0;  // root constants
+    uint64_t bufferChanges = 0;    // vertex / index buffers
+
+    DrawListStats& operator+=(const DrawListStats& other);
+};
+
+// Per-frame draw submission list. Every draw gets a packed 64-bit key, the list is sorted once
+// (parallel LSD radix sort) and recorded in key order, so draws sharing a pipeline / material
+// are adjacent and their binds are set once.
+//
+// Key, most significant first:
+//   pass 8 | transparent 1 | opaque:      pipeline 11 | material 20 | depth 24
+//                            transparent: ~depth 24   | pipeline 11 | material 20
+// Opaque draws group by state and go front-to-back within it; transparent ones are ordered
+// back-to-front first (correctness beats state changes) and only grouped on equal depth.
+class DrawList {
+    public:
+        static constexpr uint32_t MAX_PASSES = 1u << 8;
+        static constexpr uint32_t MAX_PIPELINES = 1u << 11;
+        static constexpr uint32_t MAX_MATERIALS = 1u << 20; // larger indices alias -> still correct, less grouping
+        static constexpr uint32_t DEPTH_BITS = 24;
+
+        // called after every pipeline change -> rebind what the new root signature dropped (descriptor tables)
+        using PipelineBindFunction = std::function<void(RhiCommandList* list)>;
+
+        // Sort id for a pipeline; registered once, kept across clear()
+        uint32_t addPipeline(RhiPipeline* pipeline);
+
+        // view-space depth range quantized into the key (default -> depth is already 0..1)
+        void setDepthRange(float nearZ, float farZ);
+
+        // drops the draws, keeps the pipelines and the memory
+        void clear();
+
+        void add(uint32_t pass, DrawBlend blend, float depth, const DrawCommand& draw);
+
+        // Stable LSD radix sort over the keys, 8 bits per pass; bytes that are equal in every key
+        // are skipped. With a job system each pass histograms / scatters in parallel blocks.
+        // The commands are then gathered into key order so recording reads them sequentially.
+        void sort(JobSystem* jobs = nullptr);
+
+        // Sorted draws of one pass (after sort)
+        DrawRange getPassRange(uint32_t pass) const;
+
+        // Records [range) in key order; starts from an unknown list state -> chunks of one pass
+        // can record on different threads into their own lists
+        DrawListStats record(RhiCommandList* list, DrawRange range, const PipelineBindFunction& onPipeline = {}) const;
+        DrawListStats record(RhiCommandList* list, const PipelineBindFunction& onPipeline = {}) const;
+
+        uint32_t getCount() const {
+            return static_cast<uint32_t>(entries.size());
+        }
+
+        uint64_t getKey(uint32_t index) const {
+            return entries[index].key;
+        }
+
+        static uint64_t makeKey(uint32_t pass, DrawBlend blend, uint32_t pipeline, uint32_t material, uint32_t depth);
+
+    private:
+        struct Entry {
+            uint64_t key;
+            uint32_t draw; // index into draws
+        };
+
+        uint32_t quantizeDepth(float depth) const;
+
+    private:
+        std::vector<RhiPipeline*> pipelines;
+        std::vector<DrawCommand> draws;     // in add() order
+        std::vector<DrawCommand> sortedDraws; // in key order, filled by sort()
+        bool sorted = false;
+        std::vector<Entry> entries;
+        std::vector<Entry> scratch;
+        std::vector<uint32_t> histograms; // 256 per block
+
+        // bits set in any key / in every key -> their xor marks the bytes worth a radix pass
+        uint64_t keyBitsAny = 0;
+        uint64_t keyBitsAll = ~0ull;
+
+        float depthBias = 0.0f;
+        float depthScale = 1.0f;
+};
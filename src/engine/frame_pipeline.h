@@ -0,0 +1,166 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+
+// Single producer / single consumer ring of frame snapshots.
+// The producer fills a slot and publishes it, the consumer reads it and hands the slot back;
+// the slot contents are only ever touched by one side at a time, so the hand-off is two atomic
+// counters. Either side only blocks (atomic wait) when the ring is full / empty.
+template <typename Snapshot>
+class SnapshotQueue {
+    public:
+        explicit SnapshotQueue(uint32_t depth) : slots(depth < 1 ? 1 : depth) {}
+
+        SnapshotQueue(const SnapshotQueue&) = delete;
+        SnapshotQueue& operator=(const SnapshotQueue&) = delete;
+
+        // producer: next slot to fill; blocks while the consumer still holds every slot
+        Snapshot& beginWrite() {
+            uint32_t depth = static_cast<uint32_t>(slots.size());
+            uint32_t read = readCount.load(std::memory_order_acquire);
+            while (((writeIndex - read) & COUNT_MASK) >= depth) {
+                readCount.wait(read, std::memory_order_acquire);
+                read = readCount.load(std::memory_order_acquire);
+            }
+            return slots[writeIndex % depth];
+        }
+
+        void endWrite() {
+            writeIndex = (writeIndex + 1) & COUNT_MASK;
+            writeCount.store(writeIndex, std::memory_order_release);
+            writeCount.notify_one();
+        }
+
+        // consumer: oldest published snapshot; nullptr once closed and everything was read
+        const Snapshot* beginRead() {
+            uint32_t written = writeCount.load(std::memory_order_acquire);
+            while ((written & COUNT_MASK) == readIndex) {
+                if (written & CLOSED) {
+                    return nullptr;
+                }
+                writeCount.wait(written, std::memory_order_acquire);
+                written = writeCount.load(std::memory_order_acquire);
+            }
+            return &slots[readIndex % slots.size()];
+        }
+
+        void endRead() {
+            readIndex = (readIndex + 1) & COUNT_MASK;
+            readCount.store(readIndex, std::memory_order_release);
+            readCount.notify_one();
+        }
+
+        // producer: no more snapshots; the consumer still gets the published ones
+        void close() {
+            writeCount.fetch_or(CLOSED, std::memory_order_release);
+            writeCount.notify_one();
+        }
+
+        // producer: blocks until the consumer handed back everything published so far
+        void drain() {
+            uint32_t read = readCount.load(std::memory_order_acquire);
+            while (read != writeIndex) {
+                readCount.wait(read, std::memory_order_acquire);
+                read = readCount.load(std::memory_order_acquire);
+            }
+        }
+
+        uint32_t getDepth() const {
+            return static_cast<uint32_t>(slots.size());
+        }
+
+    private:
+        // 32-bit counters -> atomic wait maps straight onto a futex / WaitOnAddress.
+        // The top bit of writeCount is the closed flag, counts wrap at 2^31 (differences stay valid)
+        static constexpr uint32_t CLOSED = 0x80000000u;
+        static constexpr uint32_t COUNT_MASK = 0x7fffffffu;
+
+        std::vector<Snapshot> slots;
+
+        alignas(64) std::atomic<uint32_t> writeCount{ 0 }; // published snapshots (+ CLOSED)
+        uint32_t writeIndex = 0;                            // producer only
+        alignas(64) std::atomic<uint32_t> readCount{ 0 };  // snapshots handed back
+        uint32_t readIndex = 0;                             // consumer only
+};
+
+// Two-stage frame loop: the caller's thread runs the update stage and fills an immutable
+// snapshot of everything the frame needs; a render thread consumes the snapshots in order,
+// one frame behind. With depth 2 (double-buffered) update N + 1 overlaps render N, with 3 the
+// update may run two frames ahead. A frame then costs max(update, render) instead of their sum.
+// The render stage owns the renderer: anything else touching it (resize, scene changes)
+// calls flush first so the render thread is idle.
+template <typename Snapshot>
+class FramePipeline {
+    public:
+        using RenderStage = std::function<void(const Snapshot&)>;
+
+        FramePipeline(uint32_t depth, RenderStage render) : queue(depth), render(std::move(render)) {
+            thread = std::thread([this] { renderLoop(); });
+        }
+
+        ~FramePipeline() {
+            queue.close();
+            thread.join();
+        }
+
+        FramePipeline(const FramePipeline&) = delete;
+        FramePipeline& operator=(const FramePipeline&) = delete;
+
+        // Snapshot to fill for the next frame; blocks while the render stage is depth frames behind.
+        // Rethrows what the render stage threw.
+        Snapshot& beginUpdate() {
+            rethrow();
+            return queue.beginWrite();
+        }
+
+        // Hands the snapshot to the render stage; it must not be touched afterwards
+        void endUpdate() {
+            queue.endWrite();
+        }
+
+        // Blocks until every submitted snapshot was rendered
+        void flush() {
+            queue.drain();
+            rethrow();
+        }
+
+        uint32_t getDepth() const {
+            return queue.getDepth();
+        }
+
+    private:
+        void renderLoop() {
+            while (const Snapshot* snapshot = queue.beginRead()) {
+                // after a failure the remaining snapshots are only handed back -> the update side never blocks forever
+                if (!failed.load(std::memory_order_relaxed)) {
+                    try {
+                        render(*snapshot);
+                    } catch (...) {
+                        error = std::current_exception();
+                        failed.store(true, std::memory_order_release);
+                    }
+                }
+                queue.endRead();
+            }
+        }
+
+        void rethrow() {
+            if (failed.load(std::memory_order_acquire) && error) {
+                std::exception_ptr pending = error;
+                error = nullptr;
+                std::rethrow_exception(pending);
+            }
+        }
+
+    private:
+        SnapshotQueue<Snapshot> queue;
+        RenderStage render;
+        std::thread thread;
+        std::atomic<bool> failed{ false };
+        std::exception_ptr error;
+};
@@ -0,0 +1,77 @@
+#include "frame_upload_allocator.h"
+#include "rhi/rhi_command_queue.h"
+#include "utils/logger.h"
+
+#include <cstring>
+#include <stdexcept>
+
+FrameUploadAllocator::FrameUploadAllocator(
+    RhiDevice* device,
+    RhiCommandQueue* queue,
+    uint32_t frameCount,
+    uint64_t frameSize
+) :
+    queue(queue),
+    frameSize((frameSize + CONSTANT_ALIGNMENT - 1) & ~(CONSTANT_ALIGNMENT - 1)),
+    frameFences(frameCount, 0),
+    frameIndex(frameCount - 1) // first beginFrame lands on region 0
+{
+    RhiBufferDesc desc;
+    desc.sizeInBytes = this->frameSize * frameCount;
+    desc.heapType = RhiHeapType::Upload;
+    desc.initialState = RhiResourceState::GenericRead;
+
+    buffer = device->createBuffer(desc);
+    cpuBase = static_cast<uint8_t*>(buffer->getMappedData());
+    gpuBase = buffer->getGPUAddress();
+
+    if (!cpuBase) {
+        LOG_ERROR(L"FrameUploadAllocator -> Upload buffer is not mapped");
+        throw std::runtime_error("Upload buffer is not mapped");
+    }
+
+    LOG_INFO(L"FrameUploadAllocator -> %u frames x %llu KB", frameCount, static_cast<unsigned long long>(this->frameSize / 1024));
+}
+
+void FrameUploadAllocator::beginFrame() {
+    frameIndex = (frameIndex + 1) % static_cast<uint32_t>(frameFences.size());
+    regionStart = uint64_t(frameIndex) * frameSize;
+
+    // normally already complete -> the renderer throttles on the same fence
+    queue->fenceWait(frameFences[frameIndex]);
+
+    head.store(0, std::memory_order_relaxed);
+}
+
+void FrameUploadAllocator::endFrame(uint64_t fenceValue) {
+    frameFences[frameIndex] = fenceValue;
+}
+
+UploadAllocation FrameUploadAllocator::allocate(uint64_t size, uint64_t alignment) {
+    uint64_t current = head.load(std::memory_order_relaxed);
+    uint64_t offset = 0;
+
+    // the pointer bump; only retries when another recording thread bumped in between
+    do {
+        offset = (current + alignment - 1) & ~(alignment - 1);
+        if (offset + size > frameSize) {
+            LOG_ERROR(L"FrameUploadAllocator -> Frame region exhausted (%llu + %llu > %llu bytes)",
+                static_cast<unsigned long long>(offset), static_cast<unsigned long long>(size),
+                static_cast<unsigned long long>(frameSize));
+            throw std::runtime_error("Frame upload region exhausted");
+        }
+    } while (!head.compare_exchange_weak(current, offset + size, std::memory_order_relaxed));
+
+    UploadAllocation allocation;
+    allocation.offset = regionStart + offset;
+    allocation.cpu = cpuBase + allocation.offset;
+    allocation.gpuAddress = gpuBase + allocation.offset;
+    allocation.size = size;
+    return allocation;
+}
+
+UploadAllocation FrameUploadAllocator::upload(const void* data, uint64_t size, uint64_t alignment) {
+    UploadAllocation allocation = allocate(size, alignment);
+    memcpy(allocation.cpu, data, size);
+    return allocation;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "rhi/rhi.h"
+#include <atomic>
+
+class RhiCommandQueue;
+
+struct UploadAllocation {
+    void* cpu = nullptr;
+    uint64_t gpuAddress = 0;
+    uint64_t offset = 0; // within the backing buffer
+    uint64_t size = 0;
+};
+
+// Transient per-frame upload memory (constants, dynamic vertices).
+// One persistently mapped upload buffer split into frameCount regions; a frame bumps
+// through its region and the region is handed out again once the fence of the frame
+// that last used it completes. allocate() is lock-free, so recording threads can share it.
+class FrameUploadAllocator {
+    public:
+        static constexpr uint64_t DEFAULT_FRAME_SIZE = 4ull * 1024 * 1024;
+        static constexpr uint64_t CONSTANT_ALIGNMENT = 256;
+
+        FrameUploadAllocator(
+            RhiDevice* device,
+            RhiCommandQueue* queue,
+            uint32_t frameCount,
+            uint64_t frameSize = DEFAULT_FRAME_SIZE
+        );
+
+        // Moves to the next region, blocking only if the GPU still reads it
+        void beginFrame();
+
+        // Tags the current region with the fence value of the frame's last submission
+        void endFrame(uint64_t fenceValue);
+
+        // alignment must be a power of two; throws when the frame region is exhausted
+        UploadAllocation allocate(uint64_t size, uint64_t alignment = CONSTANT_ALIGNMENT);
+
+        // allocate + memcpy
+        UploadAllocation upload(const void* data, uint64_t size, uint64_t alignment = CONSTANT_ALIGNMENT);
+
+        uint64_t getFrameSize() const {
+            return frameSize;
+        }
+
+        // bytes bumped in the current frame (including alignment padding)
+        uint64_t getFrameUsed() const {
+            return head.load(std::memory_order_relaxed);
+        }
+
+        RhiBuffer* getBuffer() const {
+            return buffer.get();
+        }
+
+    private:
+        RhiCommandQueue* queue = nullptr;
+        std::unique_ptr<RhiBuffer> buffer;
+        uint8_t* cpuBase = nullptr;
+        uint64_t gpuBase = 0;
+
+        uint64_t frameSize = 0;
+        std::vector<uint64_t> frameFences; // last fence value per region
+        uint32_t frameIndex = 0;
+        uint64_t regionStart = 0;
+
+        std::atomic<uint64_t> head{ 0 }; // offset within the current region
+};
@@ -0,0 +1,407 @@
+#include "frustum_culler.h"
+#include "job_system.h"
+#include "utils/logger.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define FRUSTUM_CULLER_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        #define FRUSTUM_CULLER_AVX2
+    #else
+        // only this function is compiled for AVX2 -> the binary still runs on SSE-only CPUs
+        #define FRUSTUM_CULLER_AVX2 __attribute__((target("avx2")))
+    #endif
+#endif
+
+void BoundingSpheres::resize(uint32_t count) {
+    centerX.resize(count);
+    centerY.resize(count);
+    centerZ.resize(count);
+    radius.resize(count);
+}
+
+void BoundingSpheres::set(uint32_t index, float x, float y, float z, float r) {
+    centerX[index] = x;
+    centerY[index] = y;
+    centerZ[index] = z;
+    radius[index] = r;
+}
+
+void BoundingBoxes::resize(uint32_t count) {
+    centerX.resize(count);
+    centerY.resize(count);
+    centerZ.resize(count);
+    extentX.resize(count);
+    extentY.resize(count);
+    extentZ.resize(count);
+}
+
+void BoundingBoxes::set(uint32_t index, const float center[3], const float extent[3]) {
+    centerX[index] = center[0];
+    centerY[index] = center[1];
+    centerZ[index] = center[2];
+    extentX[index] = extent[0];
+    extentY[index] = extent[1];
+    extentZ[index] = extent[2];
+}
+
+// ((x + y) + z) + w, every product rounded on its own -> what the SIMD kernels compute per lane
+static float planeDistance(const float plane[4], float x, float y, float z) {
+    float distance = plane[0] * x + plane[1] * y;
+    distance = distance + plane[2] * z;
+    return distance + plane[3];
+}
+
+static uint32_t cullSpheresScalar(const void* volumes, const CullPlanes& planes, uint32_t begin, uint32_t end, uint32_t* out) {
+    const BoundingSpheres& spheres = *static_cast<const BoundingSpheres*>(volumes);
+    uint32_t written = 0;
+    for (uint32_t i = begin; i < end; ++i) {
+        bool inside = true;
+        for (const float* plane : planes.planes) {
+            if (planeDistance(plane, spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i]) < -spheres.radius[i]) {
+                inside = false;
+                break;
+            }
+        }
+        if (inside) {
+            out[written++] = i;
+        }
+    }
+    return written;
+}
+
+static uint32_t cullBoxesScalar(const void* volumes, const CullPlanes& planes, uint32_t begin, uint32_t end, uint32_t* out) {
+    const BoundingBoxes& boxes = *static_cast<const BoundingBoxes*>(volumes);
+    uint32_t written = 0;
+    for (uint32_t i = begin; i < end; ++i) {
+        bool inside = true;
+        for (const float* plane : planes.planes) {
+            // projected half extent: the box corner furthest along the normal
+            float extent = std::fabs(plane[0]) * boxes.extentX[i] + std::fabs(plane[1]) * boxes.extentY[i];
+            extent = extent + std::fabs(plane[2]) * boxes.extentZ[i];
+            if (planeDistance(plane, boxes.centerX[i], boxes.centerY[i], boxes.centerZ[i]) < -extent) {
+                inside = false;
+                break;
+            }
+        }
+        if (inside) {
+            out[written++] = i;
+        }
+    }
+    return written;
+}
+
+// lane mask -> ascending indices
+static uint32_t writeVisible(uint32_t mask, uint32_t base, uint32_t* out) {
+    uint32_t written = 0;
+    while (mask != 0) {
+        out[written++] = base + static_cast<uint32_t>(std::countr_zero(mask));
+        mask &= mask - 1;
+    }
+    return written;
+}
+
+#ifdef FRUSTUM_CULLER_X86
+
+// Kernels: plane loop unrolled, no early out -> the lanes stay branch-free, one movemask per step.
+// The compare is "not less than" so NaN distances count as visible, like the scalar `<` test.
+
+static uint32_t cullSpheresSse(const void* volumes, const CullPlanes& planes, uint32_t begin, uint32_t end, uint32_t* out) {
+    const BoundingSpheres& spheres = *static_cast<const BoundingSpheres*>(volumes);
+
+    __m128 normal[6][4];
+    for (uint32_t p = 0; p < 6; ++p) {
+        for (uint32_t c = 0; c < 4; ++c) {
+            normal[p][c] = _mm_set1_ps(planes.planes[p][c]);
+        }
+    }
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+
+    uint32_t written = 0;
+    uint32_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 x = _mm_loadu_ps(&spheres.centerX[i]);
+        __m128 y = _mm_loadu_ps(&spheres.centerY[i]);
+        __m128 z = _mm_loadu_ps(&spheres.centerZ[i]);
+        __m128 negRadius = _mm_xor_ps(_mm_loadu_ps(&spheres.radius[i]), signBit);
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (uint32_t p = 0; p < 6; ++p) {
+            __m128 distance = _mm_add_ps(_mm_mul_ps(normal[p][0], x), _mm_mul_ps(normal[p][1], y));
+            distance = _mm_add_ps(distance, _mm_mul_ps(normal[p][2], z));
+            distance = _mm_add_ps(distance, normal[p][3]);
+            inside = _mm_and_ps(inside, _mm_cmpnlt_ps(distance, negRadius));
+        }
+        written += writeVisible(static_cast<uint32_t>(_mm_movemask_ps(inside)), i, out + written);
+    }
+    return written + cullSpheresScalar(volumes, planes, i, end, out + written);
+}
+
+static uint32_t cullBoxesSse(const void* volumes, const CullPlanes& planes, uint32_t begin, uint32_t end, uint32_t* out) {
+    const BoundingBoxes& boxes = *static_cast<const BoundingBoxes*>(volumes);
+
+    __m128 normal[6][4];
+    __m128 absNormal[6][3];
+    for (uint32_t p = 0; p < 6; ++p) {
+        for (uint32_t c = 0; c < 4; ++c) {
+            normal[p][c] = _mm_set1_ps(planes.planes[p][c]);
+        }
+        for (uint32_t c = 0; c < 3; ++c) {
+            absNormal[p][c] = _mm_set1_ps(std::fabs(planes.planes[p][c]));
+        }
+    }
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+
+    uint32_t written = 0;
+    uint32_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 x = _mm_loadu_ps(&boxes.centerX[i]);
+        __m128 y = _mm_loadu_ps(&boxes.centerY[i]);
+        __m128 z = _mm_loadu_ps(&boxes.centerZ[i]);
+        __m128 ex = _mm_loadu_ps(&boxes.extentX[i]);
+        __m128 ey = _mm_loadu_ps(&boxes.extentY[i]);
+        __m128 ez = _mm_loadu_ps(&boxes.extentZ[i]);
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (uint32_t p = 0; p < 6; ++p) {
+            __m128 extent = _mm_add_ps(_mm_mul_ps(absNormal[p][0], ex), _mm_mul_ps(absNormal[p][1], ey));
+            extent = _mm_add_ps(extent, _mm_mul_ps(absNormal[p][2], ez));
+
+            __m128 distance = _mm_add_ps(_mm_mul_ps(normal[p][0], x), _mm_mul_ps(normal[p][1], y));
+            distance = _mm_add_ps(distance, _mm_mul_ps(normal[p][2], z));
+            distance = _mm_add_ps(distance, normal[p][3]);
+            inside = _mm_and_ps(inside, _mm_cmpnlt_ps(distance, _mm_xor_ps(extent, signBit)));
+        }
+        written += writeVisible(static_cast<uint32_t>(_mm_movemask_ps(inside)), i, out + written);
+    }
+    return written + cullBoxesScalar(volumes, planes, i, end, out + written);
+}
+
+FRUSTUM_CULLER_AVX2 static uint32_t cullSpheresAvx2(const void* volumes, const CullPlanes& planes, uint32_t begin, uint32_t end, uint32_t* out) {
+    const BoundingSpheres& spheres = *static_cast<const BoundingSpheres*>(volumes);
+
+    __m256 normal[6][4];
+    for (uint32_t p = 0; p < 6; ++p) {
+        for (uint32_t c = 0; c < 4; ++c) {
+            normal[p][c] = _mm256_set1_ps(planes.planes[p][c]);
+        }
+    }
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+
+    uint32_t written = 0;
+    uint32_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 x = _mm256_loadu_ps(&spheres.centerX[i]);
+        __m256 y = _mm256_loadu_ps(&spheres.centerY[i]);
+        __m256 z = _mm256_loadu_ps(&spheres.centerZ[i]);
+        __m256 negRadius = _mm256_xor_ps(_mm256_loadu_ps(&spheres.radius[i]), signBit);
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (uint32_t p = 0; p < 6; ++p) {
+            __m256 distance = _mm256_add_ps(_mm256_mul_ps(normal[p][0], x), _mm256_mul_ps(normal[p][1], y));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(normal[p][2], z));
+            distance = _mm256_add_ps(distance, normal[p][3]);
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negRadius, _CMP_NLT_UQ));
+        }
+        written += writeVisible(static_cast<uint32_t>(_mm256_movemask_ps(inside)), i, out + written);
+    }
+    return written + cullSpheresScalar(volumes, planes, i, end, out + written);
+}
+
+FRUSTUM_CULLER_AVX2 static uint32_t cullBoxesAvx2(const void* volumes, const CullPlanes& planes, uint32_t begin, uint32_t end, uint32_t* out) {
+    const BoundingBoxes& boxes = *static_cast<const BoundingBoxes*>(volumes);
+
+    __m256 normal[6][4];
+    __m256 absNormal[6][3];
+    for (uint32_t p = 0; p < 6; ++p) {
+        for (uint32_t c = 0; c < 4; ++c) {
+            normal[p][c] = _mm256_set1_ps(planes.planes[p][c]);
+        }
+        for (uint32_t c = 0; c < 3; ++c) {
+            absNormal[p][c] = _mm256_set1_ps(std::fabs(planes.planes[p][c]));
+        }
+    }
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+
+    uint32_t written = 0;
+    uint32_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 x = _mm256_loadu_ps(&boxes.centerX[i]);
+        __m256 y = _mm256_loadu_ps(&boxes.centerY[i]);
+        __m256 z = _mm256_loadu_ps(&boxes.centerZ[i]);
+        __m256 ex = _mm256_loadu_ps(&boxes.extentX[i]);
+        __m256 ey = _mm256_loadu_ps(&boxes.extentY[i]);
+        __m256 ez = _mm256_loadu_ps(&boxes.extentZ[i]);
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (uint32_t p = 0; p < 6; ++p) {
+            __m256 extent = _mm256_add_ps(_mm256_mul_ps(absNormal[p][0], ex), _mm256_mul_ps(absNormal[p][1], ey));
+            extent = _mm256_add_ps(extent, _mm256_mul_ps(absNormal[p][2], ez));
+
+            __m256 distance = _mm256_add_ps(_mm256_mul_ps(normal[p][0], x), _mm256_mul_ps(normal[p][1], y));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(normal[p][2], z));
+            distance = _mm256_add_ps(distance, normal[p][3]);
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_xor_ps(extent, signBit), _CMP_NLT_UQ));
+        }
+        written += writeVisible(static_cast<uint32_t>(_mm256_movemask_ps(inside)), i, out + written);
+    }
+    return written + cullBoxesScalar(volumes, planes, i, end, out + written);
+}
+
+static bool detectAvx2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    // the OS has to save the YMM registers too (OSXSAVE + XCR0 bits 1, 2)
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 6) != 6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif
+
+bool FrustumCuller::isSupported(CullKernel kernel) {
+    switch (kernel) {
+        case CullKernel::Scalar:
+        case CullKernel::Auto:
+            return true;
+#ifdef FRUSTUM_CULLER_X86
+        case CullKernel::Sse:
+            return true;
+        case CullKernel::Avx2: {
+            static const bool avx2 = detectAvx2();
+            return avx2;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+const char* FrustumCuller::getKernelName(CullKernel kernel) {
+    switch (kernel) {
+        case CullKernel::Scalar: return "scalar";
+        case CullKernel::Sse: return "SSE";
+        case CullKernel::Avx2: return "AVX2";
+        default: return "auto";
+    }
+}
+
+FrustumCuller::FrustumCuller(CullKernel kernel) :
+    kernel(kernel)
+{
+    if (kernel == CullKernel::Auto) {
+        this->kernel = isSupported(CullKernel::Avx2) ? CullKernel::Avx2 :
+            isSupported(CullKernel::Sse) ? CullKernel::Sse : CullKernel::Scalar;
+    } else if (!isSupported(kernel)) {
+        LOG_ERROR(L"FrustumCuller -> Kernel %u not supported on this CPU", static_cast<uint32_t>(kernel));
+        throw std::runtime_error("Unsupported culling kernel");
+    }
+}
+
+CullPlanes FrustumCuller::extractPlanes(const float viewProjection[4][4]) {
+    // clip = [x y z 1] * M -> clip component j = dot(p, column j) (Gribb / Hartmann)
+    const float (*m)[4] = viewProjection;
+    auto column = [m](uint32_t j, float sign, uint32_t k, float plane[4]) {
+        for (uint32_t r = 0; r < 4; ++r) {
+            plane[r] = m[r][j] + sign * m[r][k];
+        }
+    };
+
+    CullPlanes planes;
+    column(3, 1.0f, 0, planes.planes[0]);  // left:   w + x >= 0
+    column(3, -1.0f, 0, planes.planes[1]); // right:  w - x >= 0
+    column(3, 1.0f, 1, planes.planes[2]);  // bottom: w + y >= 0
+    column(3, -1.0f, 1, planes.planes[3]); // top:    w - y >= 0
+    column(2, 0.0f, 0, planes.planes[4]);  // near:   z >= 0
+    column(3, -1.0f, 2, planes.planes[5]); // far:    w - z >= 0
+
+    for (float* plane : planes.planes) {
+        float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        if (length > 0.0f) {
+            for (uint32_t c = 0; c < 4; ++c) {
+                plane[c] /= length;
+            }
+        }
+    }
+    return planes;
+}
+
+uint32_t FrustumCuller::cull(const BoundingSpheres& spheres, const CullPlanes& planes, uint32_t* visible, JobSystem* jobs) {
+    ChunkFunction function = cullSpheresScalar;
+#ifdef FRUSTUM_CULLER_X86
+    if (kernel == CullKernel::Sse) {
+        function = cullSpheresSse;
+    } else if (kernel == CullKernel::Avx2) {
+        function = cullSpheresAvx2;
+    }
+#endif
+    return run(function, &spheres, spheres.size(), planes, visible, jobs);
+}
+
+uint32_t FrustumCuller::cull(const BoundingBoxes& boxes, const CullPlanes& planes, uint32_t* visible, JobSystem* jobs) {
+    ChunkFunction function = cullBoxesScalar;
+#ifdef FRUSTUM_CULLER_X86
+    if (kernel == CullKernel::Sse) {
+        function = cullBoxesSse;
+    } else if (kernel == CullKernel::Avx2) {
+        function = cullBoxesAvx2;
+    }
+#endif
+    return run(function, &boxes, boxes.size(), planes, visible, jobs);
+}
+
+uint32_t FrustumCuller::run(ChunkFunction function, const void* volumes, uint32_t count, const CullPlanes& planes, uint32_t* visible, JobSystem* jobs) {
+    // one chunk (or one thread) -> straight into the output
+    if (!jobs || count <= CHUNK_SIZE) {
+        return function(volumes, planes, 0, count, visible);
+    }
+
+    const uint32_t chunks = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    scratch.resize(count);
+    chunkOffsets.resize(chunks + 1);
+
+    // 1. every chunk culls into its own slice of scratch
+    jobs->parallelFor(chunks, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t chunk = begin; chunk < end; ++chunk) {
+            uint32_t first = chunk * CHUNK_SIZE;
+            uint32_t last = std::min(count, first + CHUNK_SIZE);
+            chunkOffsets[chunk + 1] = function(volumes, planes, first, last, scratch.data() + first);
+        }
+    });
+
+    // 2. inclusive scan -> chunk c lands at [offsets[c], offsets[c + 1])
+    chunkOffsets[0] = 0;
+    for (uint32_t chunk = 0; chunk < chunks; ++chunk) {
+        chunkOffsets[chunk + 1] += chunkOffsets[chunk];
+    }
+
+    // 3. compact in chunk order
+    jobs->parallelFor(chunks, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t chunk = begin; chunk < end; ++chunk) {
+            uint32_t size = chunkOffsets[chunk + 1] - chunkOffsets[chunk];
+            if (size > 0) {
+                std::memcpy(visible + chunkOffsets[chunk], scratch.data() + size_t(chunk) * CHUNK_SIZE, size * sizeof(uint32_t));
+            }
+        }
+    });
+
+    return chunkOffsets[chunks];
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "indirect_draws.h"
+
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+// Bounding spheres in structure-of-arrays layout -> 4 / 8 consecutive objects load as one register
+// per component, no gathers
+struct BoundingSpheres {
+    std::vector<float> centerX;
+    std::vector<float> centerY;
+    std::vector<float> centerZ;
+    std::vector<float> radius;
+
+    uint32_t size() const {
+        return static_cast<uint32_t>(radius.size());
+    }
+
+    void resize(uint32_t count);
+    void set(uint32_t index, float x, float y, float z, float r);
+};
+
+// Axis-aligned boxes as center + half extents, same layout
+struct BoundingBoxes {
+    std::vector<float> centerX;
+    std::vector<float> centerY;
+    std::vector<float> centerZ;
+    std::vector<float> extentX;
+    std::vector<float> extentY;
+    std::vector<float> extentZ;
+
+    uint32_t size() const {
+        return static_cast<uint32_t>(extentX.size());
+    }
+
+    void resize(uint32_t count);
+    void set(uint32_t index, const float center[3], const float extent[3]);
+};
+
+enum class CullKernel : uint8_t {
+    Scalar,
+    Sse,  // 4 objects per step
+    Avx2, // 8 objects per step, picked at runtime when the CPU has it
+    Auto  // the widest one the CPU supports
+};
+
+// CPU frustum culling: bounding volumes against 6 planes, output = indices of the visible objects
+// in ascending order (a compact list to build draws from).
+// Sphere visible <=> dot(n, c) + w >= -r for every plane; box visible <=> dot(n, c) + w >= -dot(|n|, e)
+// (conservative: boxes straddling two planes near a corner pass).
+// Every kernel evaluates the same products in the same order (no FMA contraction), so the SIMD and
+// scalar paths return identical lists. With a job system chunks of objects cull in parallel into
+// scratch and are then copied to their scanned offsets -> the order doesn't depend on scheduling.
+class FrustumCuller {
+    public:
+        static constexpr uint32_t CHUNK_SIZE = 4096; // objects per parallel work item
+
+        explicit FrustumCuller(CullKernel kernel = CullKernel::Auto);
+
+        // Planes of a row-vector view-projection matrix (DirectXMath layout, clip z in [0, 1]),
+        // normalized and facing inward -> plane distances are world-space distances
+        static CullPlanes extractPlanes(const float viewProjection[4][4]);
+
+        static bool isSupported(CullKernel kernel);
+
+        // visible -> room for every object; returns how many were written
+        uint32_t cull(const BoundingSpheres& spheres, const CullPlanes& planes, uint32_t* visible, JobSystem* jobs = nullptr);
+        uint32_t cull(const BoundingBoxes& boxes, const CullPlanes& planes, uint32_t* visible, JobSystem* jobs = nullptr);
+
+        CullKernel getKernel() const {
+            return kernel;
+        }
+
+        static const char* getKernelName(CullKernel kernel);
+
+    private:
+        // [begin, end) -> visible indices at out, returns their count
+        using ChunkFunction = uint32_t (*)(const void* volumes, const CullPlanes& planes, uint32_t begin, uint32_t end, uint32_t* out);
+
+        uint32_t run(ChunkFunction function, const void* volumes, uint32_t count, const CullPlanes& planes, uint32_t* visible, JobSystem* jobs);
+
+    private:
+        CullKernel kernel = CullKernel::Scalar;
+        std::vector<uint32_t> scratch;      // per-chunk results of a parallel cull
+        std::vector<uint32_t> chunkOffsets; // visible per chunk, scanned in place into output offsets
+};
@@ -0,0 +1,270 @@
+#include "geometry_buffer.h"
+#include "upload_manager.h"
+#include "rhi/rhi_command_queue.h"
+#include "rhi/rhi_deferred_release.h"
+#include "utils/logger.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+GeometryBuffer::GeometryBuffer(
+    RhiDevice* device,
+    RhiCommandQueue* queue,
+    UploadManager* uploads,
+    RhiDeferredReleaseQueue* releaseQueue,
+    const GeometryBufferConfig& config
+) :
+    device(device),
+    queue(queue),
+    uploads(uploads),
+    releaseQueue(releaseQueue),
+    config(config)
+{
+    if (config.vertexCapacity == 0 || config.indexCapacity == 0 || config.vertexStride == 0) {
+        LOG_ERROR(L"GeometryBuffer -> Capacities and stride must not be 0");
+        throw std::runtime_error("Invalid geometry buffer config");
+    }
+
+    vertexBuffer = createBuffer(uint64_t(config.vertexCapacity) * config.vertexStride, config.vertexCapacity, config.vertexStride);
+    indexBuffer = createBuffer(uint64_t(config.indexCapacity) * sizeof(uint32_t), config.indexCapacity, sizeof(uint32_t));
+
+    // granularity 1 -> offsets and sizes in elements
+    vertexRanges = std::make_unique<TlsfAllocator>(config.vertexCapacity, 1);
+    indexRanges = std::make_unique<TlsfAllocator>(config.indexCapacity, 1);
+
+    LOG_INFO(L"GeometryBuffer -> %u vertices (stride %u), %u indices", config.vertexCapacity, config.vertexStride, config.indexCapacity);
+}
+
+GeometryBuffer::~GeometryBuffer() = default;
+
+std::unique_ptr<RhiBuffer> GeometryBuffer::createBuffer(uint64_t size, uint32_t count, uint32_t stride) {
+    // stays in COMMON: promoted to COPY_DEST by uploads, to vertex / index reads by draws
+    RhiBufferDesc desc;
+    desc.sizeInBytes = size;
+    desc.heapType = RhiHeapType::Default;
+    desc.initialState = RhiResourceState::Common;
+    desc.count = count;
+    desc.stride = stride;
+    return device->createBuffer(desc);
+}
+
+GeometryHandle GeometryBuffer::add(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) {
+    if (vertexCount == 0 || indexCount == 0) {
+        LOG_ERROR(L"GeometryBuffer -> Empty mesh");
+        throw std::runtime_error("Empty mesh");
+    }
+
+    collectFrees();
+
+    TlsfAllocation vertexRange = vertexRanges->allocate(vertexCount);
+    TlsfAllocation indexRange = indexRanges->allocate(indexCount);
+
+    // enough space, just not in one piece -> repack and try again
+    if ((!vertexRange.isValid() || !indexRange.isValid()) &&
+        vertexRanges->getFree() - (vertexRange.isValid() ? vertexRange.size : 0) >= (vertexRange.isValid() ? 0 : vertexCount) &&
+        indexRanges->getFree() - (indexRange.isValid() ? indexRange.size : 0) >= (indexRange.isValid() ? 0 : indexCount)) {
+        if (vertexRange.isValid()) {
+            vertexRanges->free(vertexRange);
+        }
+        if (indexRange.isValid()) {
+            indexRanges->free(indexRange);
+        }
+        compact();
+        vertexRange = vertexRanges->allocate(vertexCount);
+        indexRange = indexRanges->allocate(indexCount);
+    }
+
+    if (!vertexRange.isValid() || !indexRange.isValid()) {
+        if (vertexRange.isValid()) {
+            vertexRanges->free(vertexRange);
+        }
+        if (indexRange.isValid()) {
+            indexRanges->free(indexRange);
+        }
+        LOG_ERROR(L"GeometryBuffer -> Out of space for %u vertices / %u indices", vertexCount, indexCount);
+        throw std::runtime_error("Geometry buffer full");
+    }
+
+    uploads->upload(vertexBuffer.get(), vertexRange.offset * config.vertexStride, vertices, uint64_t(vertexCount) * config.vertexStride);
+    uploads->upload(indexBuffer.get(), indexRange.offset * sizeof(uint32_t), indices, uint64_t(indexCount) * sizeof(uint32_t));
+    uncommitted = true;
+
+    uint32_t id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+    } else {
+        id = static_cast<uint32_t>(entries.size());
+        entries.emplace_back();
+    }
+
+    Entry& entry = entries[id];
+    entry.vertices = vertexRange;
+    entry.indices = indexRange;
+    entry.range = { static_cast<int32_t>(vertexRange.offset), static_cast<uint32_t>(indexRange.offset), indexCount, vertexCount };
+    entry.live = true;
+    meshCount++;
+
+    return { id };
+}
+
+void GeometryBuffer::remove(GeometryHandle handle, const RhiSyncPoint& lastUse) {
+    if (!handle.isValid() || handle.id >= entries.size() || !entries[handle.id].live) {
+        LOG_ERROR(L"GeometryBuffer -> Removing an invalid handle");
+        throw std::runtime_error("Invalid geometry handle");
+    }
+
+    entries[handle.id].live = false;
+    meshCount--;
+
+    if (!lastUse.queue || lastUse.queue->isFenceComplete(lastUse.value)) {
+        freeEntry(handle.id);
+        return;
+    }
+    pendingFrees.push_back({ lastUse, handle.id });
+}
+
+void GeometryBuffer::freeEntry(uint32_t id) {
+    Entry& entry = entries[id];
+    vertexRanges->free(entry.vertices);
+    indexRanges->free(entry.indices);
+    entry = {};
+    freeIds.push_back(id);
+}
+
+void GeometryBuffer::collectFrees() {
+    auto completed = [this](const PendingFree& pending) {
+        if (!pending.lastUse.queue->isFenceComplete(pending.lastUse.value)) {
+            return false;
+        }
+        freeEntry(pending.id);
+        return true;
+    };
+    pendingFrees.erase(std::remove_if(pendingFrees.begin(), pendingFrees.end(), completed), pendingFrees.end());
+}
+
+void GeometryBuffer::commit() {
+    if (!uncommitted) {
+        return;
+    }
+    uploads->submit();
+    uploads->handOff(queue);
+    uncommitted = false;
+}
+
+const MeshRange& GeometryBuffer::getRange(GeometryHandle handle) const {
+    return entries[handle.id].range;
+}
+
+float GeometryBuffer::getFragmentation() const {
+    auto fragmentation = [](const TlsfAllocator& ranges) {
+        uint64_t free = ranges.getFree();
+        if (free == 0) {
+            return 0.0f;
+        }
+        return 1.0f - static_cast<float>(ranges.getLargestFreeBlock()) / static_cast<float>(free);
+    };
+    return std::max(fragmentation(*vertexRanges), fragmentation(*indexRanges));
+}
+
+bool GeometryBuffer::compactIfFragmented() {
+    collectFrees();
+    if (getFragmentation() <= config.compactionThreshold) {
+        return false;
+    }
+    compact();
+    return true;
+}
+
+void GeometryBuffer::compact() {
+    // the copies read what was uploaded so far -> the queue waits for the copy queue first
+    uploads->submit();
+    uploads->handOff(queue);
+    uncommitted = false;
+
+    auto newVertexBuffer = createBuffer(vertexBuffer->getSize(), config.vertexCapacity, config.vertexStride);
+    auto newIndexBuffer = createBuffer(indexBuffer->getSize(), config.indexCapacity, sizeof(uint32_t));
+    auto newVertexRanges = std::make_unique<TlsfAllocator>(config.vertexCapacity, 1);
+    auto newIndexRanges = std::make_unique<TlsfAllocator>(config.indexCapacity, 1);
+
+    // ranges whose free waits for a fence live in the old buffers only -> dropped with them
+    for (const PendingFree& pending : pendingFrees) {
+        entries[pending.id] = {};
+        freeIds.push_back(pending.id);
+    }
+    pendingFrees.clear();
+
+    // in old vertex order, allocated from an empty allocator -> packed from 0, and neighbours stay
+    // neighbours so their copies merge
+    std::vector<uint32_t> order;
+    order.reserve(meshCount);
+    for (uint32_t id = 0; id < entries.size(); ++id) {
+        if (entries[id].live) {
+            order.push_back(id);
+        }
+    }
+    std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+        return entries[a].vertices.offset < entries[b].vertices.offset;
+    });
+
+    struct CopyRun {
+        uint64_t source = 0;
+        uint64_t destination = 0;
+        uint64_t size = 0;
+    };
+
+    RhiCommandList* list = queue->getCommandList();
+    auto copyRun = [&](RhiBuffer* destination, RhiBuffer* source, CopyRun& run, uint64_t from, uint64_t to, uint64_t size) {
+        if (run.size > 0 && run.source + run.size == from && run.destination + run.size == to) {
+            run.size += size;
+            return;
+        }
+        if (run.size > 0) {
+            list->copyBufferRegion(destination->getHandle(), run.destination, source->getHandle(), run.source, run.size);
+            stats.copyRegions++;
+        }
+        run = { from, to, size };
+    };
+    auto flushRun = [&](RhiBuffer* destination, RhiBuffer* source, CopyRun& run) {
+        if (run.size > 0) {
+            list->copyBufferRegion(destination->getHandle(), run.destination, source->getHandle(), run.source, run.size);
+            stats.copyRegions++;
+        }
+    };
+
+    CopyRun vertexRun;
+    CopyRun indexRun;
+    for (uint32_t id : order) {
+        Entry& entry = entries[id];
+        TlsfAllocation vertexRange = newVertexRanges->allocate(entry.range.vertexCount);
+        TlsfAllocation indexRange = newIndexRanges->allocate(entry.range.indexCount);
+
+        const uint64_t stride = config.vertexStride;
+        const uint64_t vertexBytes = uint64_t(entry.range.vertexCount) * stride;
+        const uint64_t indexBytes = uint64_t(entry.range.indexCount) * sizeof(uint32_t);
+        copyRun(newVertexBuffer.get(), vertexBuffer.get(), vertexRun, entry.vertices.offset * stride, vertexRange.offset * stride, vertexBytes);
+        copyRun(newIndexBuffer.get(), indexBuffer.get(), indexRun, entry.indices.offset * sizeof(uint32_t), indexRange.offset * sizeof(uint32_t), indexBytes);
+        stats.bytesMoved += vertexBytes + indexBytes;
+
+        entry.vertices = vertexRange;
+        entry.indices = indexRange;
+        entry.range.baseVertex = static_cast<int32_t>(vertexRange.offset);
+        entry.range.firstIndex = static_cast<uint32_t>(indexRange.offset);
+    }
+    flushRun(newVertexBuffer.get(), vertexBuffer.get(), vertexRun);
+    flushRun(newIndexBuffer.get(), indexBuffer.get(), indexRun);
+
+    queue->executeCommandList(list);
+
+    // frames in flight (and the copies) still read the old buffers
+    releaseQueue->retire(queue, std::move(vertexBuffer));
+    releaseQueue->retire(queue, std::move(indexBuffer));
+
+    vertexBuffer = std::move(newVertexBuffer);
+    indexBuffer = std::move(newIndexBuffer);
+    vertexRanges = std::move(newVertexRanges);
+    indexRanges = std::move(newIndexRanges);
+    stats.compactions++;
+
+    LOG_INFO(L"GeometryBuffer -> Compacted %u meshes", meshCount);
+}
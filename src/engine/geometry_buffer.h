@@ -0,0 +1,164 @@
+#pragma once
+
+#include "rhi/rhi.h"
+#include "memory/tlsf_allocator.h"
+
+#include <memory>
+#include <vector>
+
+class UploadManager;
+class RhiCommandQueue;
+class RhiDeferredReleaseQueue;
+
+// Where a mesh lives in the shared buffers -> everything a draw needs besides the bound views
+struct MeshRange {
+    int32_t baseVertex = 0;  // added to every index
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    uint32_t vertexCount = 0;
+};
+
+// Stable across compaction (the range behind it moves, the handle doesn't)
+struct GeometryHandle {
+    static constexpr uint32_t INVALID = ~0u;
+
+    uint32_t id = INVALID;
+
+    bool isValid() const {
+        return id != INVALID;
+    }
+};
+
+struct GeometryBufferConfig {
+    uint32_t vertexCapacity = 1u << 20; // vertices
+    uint32_t indexCapacity = 4u << 20;  // 32-bit indices
+    uint32_t vertexStride = 32;         // sizeof(VertexStruct)
+
+    // 1 - largest free range / free space (worse of the two buffers) above which
+    // compactIfFragmented() repacks the live ranges
+    float compactionThreshold = 0.5f;
+};
+
+struct GeometryBufferStats {
+    uint64_t compactions = 0;
+    uint64_t bytesMoved = 0;   // by compaction copies
+    uint64_t copyRegions = 0;  // copy commands those took (adjacent ranges merged)
+};
+
+// Global vertex / index megabuffer: every mesh is a sub-range of one DEFAULT-heap vertex buffer and
+// one index buffer, so the IA views are bound once and any number of meshes draw with only
+// (baseVertex, firstIndex, indexCount) changing -> the layout indirect draws need.
+// Ranges come from two TLSF allocators counting in elements; data streams in through the upload
+// manager's copy queue. Buffers are always simultaneous-access, so uploads into free ranges don't
+// disturb draws reading other ranges.
+// Compaction allocates fresh buffers, copies the live ranges over packed from offset 0 on the
+// consumer queue and retires the old buffers by fence -> frames in flight keep drawing from them.
+class GeometryBuffer {
+    public:
+        // queue -> the queue that draws the geometry (waits for uploads, records compaction copies)
+        GeometryBuffer(
+            RhiDevice* device,
+            RhiCommandQueue* queue,
+            UploadManager* uploads,
+            RhiDeferredReleaseQueue* releaseQueue,
+            const GeometryBufferConfig& config = {}
+        );
+        ~GeometryBuffer();
+
+        // Copies the mesh in (recorded on the upload manager, drawable after commit()).
+        // A fragmented buffer is compacted when that makes the mesh fit; throws when it doesn't.
+        GeometryHandle add(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount);
+
+        // Frees the ranges once lastUse completed (no queue -> the GPU is done with them already)
+        void remove(GeometryHandle handle, const RhiSyncPoint& lastUse = {});
+
+        // Submits the pending uploads and makes the queue wait for them; no-op without new meshes
+        void commit();
+
+        // Current range -> read it when recording, compaction moves it
+        const MeshRange& getRange(GeometryHandle handle) const;
+
+        RhiVertexBufferView getVertexView() const {
+            return { vertexBuffer->getGPUAddress(), vertexBuffer->getSize(), config.vertexStride };
+        }
+
+        RhiIndexBufferView getIndexView() const {
+            return { indexBuffer->getGPUAddress(), indexBuffer->getSize(), RhiFormat::R32Uint };
+        }
+
+        // replaced by compaction (explicit or from add()) -> getRebuildCount() changes with them
+        RhiBuffer* getVertexBuffer() const {
+            return vertexBuffer.get();
+        }
+
+        RhiBuffer* getIndexBuffer() const {
+            return indexBuffer.get();
+        }
+
+        // 0 = free space in one piece (or none free), -> 1 = free space scattered in small holes
+        float getFragmentation() const;
+
+        // Repacks when getFragmentation() exceeds the threshold; true if it did
+        bool compactIfFragmented();
+        void compact();
+
+        uint64_t getRebuildCount() const {
+            return stats.compactions;
+        }
+
+        uint32_t getVertexStride() const {
+            return config.vertexStride;
+        }
+
+        uint32_t getMeshCount() const {
+            return meshCount;
+        }
+
+        uint64_t getUsedVertices() const {
+            return vertexRanges->getUsed();
+        }
+
+        uint64_t getUsedIndices() const {
+            return indexRanges->getUsed();
+        }
+
+        const GeometryBufferStats& getStats() const {
+            return stats;
+        }
+
+    private:
+        struct Entry {
+            TlsfAllocation vertices;
+            TlsfAllocation indices;
+            MeshRange range;
+            bool live = false;
+        };
+
+        struct PendingFree {
+            RhiSyncPoint lastUse;
+            uint32_t id;
+        };
+
+        std::unique_ptr<RhiBuffer> createBuffer(uint64_t size, uint32_t count, uint32_t stride);
+        void collectFrees();
+        void freeEntry(uint32_t id);
+
+    private:
+        RhiDevice* device = nullptr;
+        RhiCommandQueue* queue = nullptr;
+        UploadManager* uploads = nullptr;
+        RhiDeferredReleaseQueue* releaseQueue = nullptr;
+        GeometryBufferConfig config;
+        GeometryBufferStats stats;
+
+        std::unique_ptr<RhiBuffer> vertexBuffer;
+        std::unique_ptr<RhiBuffer> indexBuffer;
+        std::unique_ptr<TlsfAllocator> vertexRanges;
+        std::unique_ptr<TlsfAllocator> indexRanges;
+
+        std::vector<Entry> entries; // by handle id
+        std::vector<uint32_t> freeIds;
+        std::vector<PendingFree> pendingFrees;
+        uint32_t meshCount = 0;
+        bool uncommitted = false;
+};
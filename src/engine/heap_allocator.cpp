@@ -0,0 +1,56 @@
+#include "heap_allocator.h"
+
+HeapAllocator::HeapAllocator(
+    ComPtr<ID3D12Device2> device,
+    D3D12_HEAP_TYPE type,
+    UINT64 blockSize
+) :
+    device(device),
+    type(type),
+    blockSize(blockSize)
+{
+}
+
+HeapAllocation HeapAllocator::allocate(UINT64 size) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    HeapAllocation allocation;
+
+    for (uint32_t i = 0; i < blocks.size(); ++i) {
+        allocation.range = blocks[i].ranges->allocate(size);
+        if (allocation.range.isValid()) {
+            allocation.heap = blocks[i].heap.Get();
+            allocation.offset = allocation.range.offset;
+            allocation.block = i;
+            return allocation;
+        }
+    }
+
+    // no room -> new block (oversized requests get a block of their own size)
+    const UINT64 alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+    UINT64 heapSize = std::max(blockSize, (size + alignment - 1) & ~(alignment - 1));
+
+    CD3DX12_HEAP_DESC heapDesc(heapSize, type, alignment, D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS);
+
+    Block block;
+    throwFailed(device->CreateHeap(&heapDesc, IID_PPV_ARGS(&block.heap)));
+    block.ranges = std::make_unique<TlsfAllocator>(heapSize, alignment);
+    blocks.push_back(std::move(block));
+
+    LOG_INFO(L"HeapAllocator -> Created heap block %zu of %llu MB (heap type %d)", blocks.size() - 1, heapSize >> 20, type);
+
+    allocation.range = blocks.back().ranges->allocate(size);
+    allocation.heap = blocks.back().heap.Get();
+    allocation.offset = allocation.range.offset;
+    allocation.block = static_cast<uint32_t>(blocks.size() - 1);
+    return allocation;
+}
+
+void HeapAllocator::free(const HeapAllocation& allocation) {
+    if (!allocation.isValid()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    blocks[allocation.block].ranges->free(allocation.range);
+}
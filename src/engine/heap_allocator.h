@@ -0,0 +1,57 @@
+#pragma once
+
+#include "utils/pch.h"
+#include "memory/tlsf_allocator.h"
+#include <mutex>
+
+struct HeapAllocation {
+    ID3D12Heap* heap = nullptr;
+    UINT64 offset = 0;
+    uint32_t block = 0;
+    TlsfAllocation range;
+
+    bool isValid() const {
+        return heap != nullptr;
+    }
+};
+
+// Places buffers into large ID3D12Heap blocks of one heap type instead of one
+// committed resource (= one implicit heap + kernel call) per buffer.
+// Ranges inside a block come from a TlsfAllocator at 64 KB placement alignment;
+// a new block is created only when no existing one has room.
+class HeapAllocator {
+    public:
+        static constexpr UINT64 DEFAULT_BLOCK_SIZE = 64ull * 1024 * 1024;
+
+        HeapAllocator(
+            ComPtr<ID3D12Device2> device,
+            D3D12_HEAP_TYPE type,
+            UINT64 blockSize = DEFAULT_BLOCK_SIZE
+        );
+
+        HeapAllocation allocate(UINT64 size);
+
+        // The GPU must be done with the placed resource
+        void free(const HeapAllocation& allocation);
+
+        UINT64 getBlockSize() const {
+            return blockSize;
+        }
+
+        D3D12_HEAP_TYPE getType() const {
+            return type;
+        }
+
+    private:
+        struct Block {
+            ComPtr<ID3D12Heap> heap;
+            std::unique_ptr<TlsfAllocator> ranges;
+        };
+
+        ComPtr<ID3D12Device2> device;
+        D3D12_HEAP_TYPE type;
+        UINT64 blockSize = 0;
+
+        std::mutex mutex;
+        std::vector<Block> blocks;
+};
@@ -0,0 +1,218 @@
+#include "indirect_draws.h"
+#include "job_system.h"
+#include "utils/logger.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+bool IndirectDrawReference::isVisible(const IndirectDrawSource& draw, const CullPlanes& planes) {
+    // same association as the shader: ((x + y) + z) + w, every product rounded on its own
+    for (const float* plane : planes.planes) {
+        float distance = plane[0] * draw.sphere[0] + plane[1] * draw.sphere[1];
+        distance = distance + plane[2] * draw.sphere[2];
+        distance = distance + plane[3];
+        if (distance < -draw.sphere[3]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static IndirectDrawArguments makeArguments(const IndirectDrawSource& draw) {
+    return { draw.constantsIndex, draw.indexCount, 1, draw.startIndex, draw.baseVertex, 0 };
+}
+
+uint32_t IndirectDrawReference::cull(
+    const IndirectDrawSource* draws,
+    uint32_t count,
+    const CullPlanes& planes,
+    IndirectDrawArguments* arguments,
+    JobSystem* jobs
+) {
+    if (count > MAX_DRAWS) {
+        LOG_ERROR(L"IndirectDrawReference -> %u draws, at most %u per batch", count, MAX_DRAWS);
+        throw std::runtime_error("Too many indirect draws");
+    }
+
+    const uint32_t groups = (count + GROUP_SIZE - 1) / GROUP_SIZE;
+    groupOffsets.resize(groups);
+
+    // a range of groups per job -> a few thousand draws each
+    auto forGroups = [&](auto&& function) {
+        if (!jobs) {
+            function(0u, groups);
+            return;
+        }
+        jobs->parallelFor(groups, [&](uint32_t begin, uint32_t end) {
+            function(begin, end);
+        }, 64);
+    };
+
+    // 1. visible draws per group
+    forGroups([&](uint32_t begin, uint32_t end) {
+        for (uint32_t group = begin; group < end; ++group) {
+            uint32_t last = std::min(count, (group + 1) * GROUP_SIZE);
+            uint32_t visible = 0;
+            for (uint32_t i = group * GROUP_SIZE; i < last; ++i) {
+                visible += isVisible(draws[i], planes) ? 1 : 0;
+            }
+            groupOffsets[group] = visible;
+        }
+    });
+
+    // 2. exclusive scan -> first slot of every group
+    uint32_t total = 0;
+    for (uint32_t group = 0; group < groups; ++group) {
+        uint32_t visible = groupOffsets[group];
+        groupOffsets[group] = total;
+        total += visible;
+    }
+
+    // 3. compact in input order
+    forGroups([&](uint32_t begin, uint32_t end) {
+        for (uint32_t group = begin; group < end; ++group) {
+            uint32_t last = std::min(count, (group + 1) * GROUP_SIZE);
+            uint32_t slot = groupOffsets[group];
+            for (uint32_t i = group * GROUP_SIZE; i < last; ++i) {
+                if (isVisible(draws[i], planes)) {
+                    arguments[slot++] = makeArguments(draws[i]);
+                }
+            }
+        }
+    });
+
+    return total;
+}
+
+IndirectDrawCuller::IndirectDrawCuller(
+    RhiDevice* device,
+    RhiPipeline* drawPipeline,
+    uint32_t constantsRoot,
+    uint32_t maxDraws
+) :
+    maxDraws(maxDraws)
+{
+    if (maxDraws == 0 || maxDraws > IndirectDrawReference::MAX_DRAWS) {
+        LOG_ERROR(L"IndirectDrawCuller -> maxDraws %u out of range (1 - %u)", maxDraws, IndirectDrawReference::MAX_DRAWS);
+        throw std::runtime_error("Invalid indirect draw capacity");
+    }
+
+    // b0: CullConstants, t0: draws, u0: arguments, u1: group offsets, u2: count
+    RhiRootParameter constants;
+    constants.type = RhiRootParameterType::Constants;
+    constants.num32BitValues = sizeof(CullConstants) / sizeof(uint32_t);
+
+    RhiRootParameter drawsParam;
+    drawsParam.type = RhiRootParameterType::ShaderResourceView;
+
+    auto uav = [](uint32_t shaderRegister) {
+        RhiRootParameter param;
+        param.type = RhiRootParameterType::UnorderedAccessView;
+        param.shaderRegister = shaderRegister;
+        return param;
+    };
+
+    RhiComputePipelineDesc computeDesc;
+    computeDesc.rootParameters = { constants, drawsParam, uav(0), uav(1), uav(2) };
+
+    computeDesc.computeShader = L"assets/shaders/cull_draws_count.cso";
+    countPipeline = device->createComputePipeline(computeDesc);
+    computeDesc.computeShader = L"assets/shaders/cull_draws_scan.cso";
+    scanPipeline = device->createComputePipeline(computeDesc);
+    computeDesc.computeShader = L"assets/shaders/cull_draws_write.cso";
+    writePipeline = device->createComputePipeline(computeDesc);
+
+    // one command = the draw's constantsIndex (offset 0 of the Constants root parameter) + the draw
+    RhiCommandSignatureDesc signatureDesc;
+    signatureDesc.byteStride = sizeof(IndirectDrawArguments);
+    signatureDesc.arguments = {
+        { RhiIndirectArgumentType::Constant, constantsRoot, 0, 1 },
+        { RhiIndirectArgumentType::DrawIndexed }
+    };
+    signature = device->createCommandSignature(signatureDesc, drawPipeline);
+
+    const uint32_t groups = (maxDraws + IndirectDrawReference::GROUP_SIZE - 1) / IndirectDrawReference::GROUP_SIZE;
+
+    RhiBufferDesc bufferDesc;
+    bufferDesc.heapType = RhiHeapType::Default;
+    bufferDesc.unorderedAccess = true;
+
+    // argument + count buffers idle in IndirectArgument, the state cull() leaves them in
+    bufferDesc.initialState = RhiResourceState::IndirectArgument;
+    bufferDesc.sizeInBytes = uint64_t(maxDraws) * sizeof(IndirectDrawArguments);
+    arguments = device->createBuffer(bufferDesc);
+    bufferDesc.sizeInBytes = sizeof(uint32_t);
+    countBuffer = device->createBuffer(bufferDesc);
+
+    bufferDesc.initialState = RhiResourceState::UnorderedAccess;
+    bufferDesc.sizeInBytes = uint64_t(groups) * sizeof(uint32_t);
+    groupOffsets = device->createBuffer(bufferDesc);
+
+    LOG_INFO(L"IndirectDrawCuller -> up to %u draws per batch", maxDraws);
+}
+
+IndirectDrawCuller::~IndirectDrawCuller() = default;
+
+void IndirectDrawCuller::cull(RhiCommandList* list, uint64_t draws, uint32_t count, const CullPlanes& planes) {
+    if (count > maxDraws) {
+        LOG_ERROR(L"IndirectDrawCuller -> %u draws, capacity %u", count, maxDraws);
+        throw std::runtime_error("Too many indirect draws");
+    }
+
+    CullConstants constants;
+    constants.planes = planes;
+    constants.drawCount = count;
+    constants.groupCount = (count + IndirectDrawReference::GROUP_SIZE - 1) / IndirectDrawReference::GROUP_SIZE;
+    lastCount = count;
+
+    const RhiResourceBarrier toUav[] = {
+        RhiResourceBarrier::transition(arguments->getHandle(), RhiResourceState::IndirectArgument, RhiResourceState::UnorderedAccess),
+        RhiResourceBarrier::transition(countBuffer->getHandle(), RhiResourceState::IndirectArgument, RhiResourceState::UnorderedAccess)
+    };
+    list->transitionResources(toUav, 2);
+
+    // every pipeline has its own (identical) root signature -> the arguments are set again per step
+    auto bind = [&](RhiPipeline* pipeline) {
+        list->setComputePipeline(pipeline);
+        list->setComputeRoot32BitConstants(ROOT_CONSTANTS, sizeof(CullConstants) / sizeof(uint32_t), &constants);
+        list->setComputeRootShaderResourceView(ROOT_DRAWS, draws);
+        list->setComputeRootUnorderedAccessView(ROOT_ARGUMENTS, arguments->getGPUAddress());
+        list->setComputeRootUnorderedAccessView(ROOT_GROUPS, groupOffsets->getGPUAddress());
+        list->setComputeRootUnorderedAccessView(ROOT_COUNT, countBuffer->getGPUAddress());
+    };
+
+    RhiResourceBarrier groupsWritten;
+    groupsWritten.resource = groupOffsets->getHandle();
+    groupsWritten.type = RhiBarrierType::Uav;
+
+    // 1. counts per group
+    bind(countPipeline.get());
+    if (constants.groupCount > 0) {
+        list->dispatch(constants.groupCount);
+    }
+    list->transitionResources(&groupsWritten, 1);
+
+    // 2. scan + total (also zeroes the count of an empty batch)
+    bind(scanPipeline.get());
+    list->dispatch(1);
+    list->transitionResources(&groupsWritten, 1);
+
+    // 3. compaction
+    bind(writePipeline.get());
+    if (constants.groupCount > 0) {
+        list->dispatch(constants.groupCount);
+    }
+
+    const RhiResourceBarrier toIndirect[] = {
+        RhiResourceBarrier::transition(arguments->getHandle(), RhiResourceState::UnorderedAccess, RhiResourceState::IndirectArgument),
+        RhiResourceBarrier::transition(countBuffer->getHandle(), RhiResourceState::UnorderedAccess, RhiResourceState::IndirectArgument)
+    };
+    list->transitionResources(toIndirect, 2);
+}
+
+void IndirectDrawCuller::draw(RhiCommandList* list) const {
+    if (lastCount == 0) {
+        return;
+    }
+    list->executeIndirect(signature.get(), lastCount, arguments->getHandle(), 0, countBuffer->getHandle(), 0);
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "rhi/rhi.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class JobSystem;
+
+// One candidate draw of a GPU-driven batch; every draw of the batch shares the pipeline
+// and the vertex / index buffers bound before the executeIndirect.
+// Matches IndirectDrawSource in cull_draws.hlsl (StructuredBuffer, 32 bytes).
+struct IndirectDrawSource {
+    float sphere[4];          // world-space bounding sphere: center xyz, radius w
+    uint32_t indexCount = 0;
+    uint32_t startIndex = 0;
+    int32_t baseVertex = 0;
+    uint32_t constantsIndex = 0; // bindless index -> the draw's root constant
+};
+
+// One command of the argument buffer -> root constant + D3D12_DRAW_INDEXED_ARGUMENTS (24 bytes)
+struct IndirectDrawArguments {
+    uint32_t constantsIndex;
+    uint32_t indexCountPerInstance;
+    uint32_t instanceCount;
+    uint32_t startIndexLocation;
+    int32_t baseVertexLocation;
+    uint32_t startInstanceLocation;
+};
+
+static_assert(sizeof(IndirectDrawSource) == 32, "IndirectDrawSource must match the shader's struct");
+static_assert(sizeof(IndirectDrawArguments) == 24, "IndirectDrawArguments must match the command signature's stride");
+
+// Frustum as 6 inward-facing planes (xyz normal, w distance): inside <=> dot(n, p) + w >= 0
+struct CullPlanes {
+    float planes[6][4];
+};
+
+// Culling + compaction in groups of 64 draws, in three steps both paths share:
+//   1. count the visible draws of every group
+//   2. exclusive scan of the group counts -> each group's first slot, the total -> count buffer
+//   3. every visible draw writes its arguments at group offset + visible draws before it in the group
+// The output keeps the input order, so it doesn't depend on thread scheduling. The plane test
+// is evaluated in the same order with the same rounding on both sides (no FMA contraction here,
+// `precise` in the shader), which makes the argument buffers byte-identical.
+//
+// IndirectDrawReference is the CPU reference of the GPU path; it keeps its per-group scratch between calls.
+class IndirectDrawReference {
+    public:
+        static constexpr uint32_t GROUP_SIZE = 64;
+
+        // one dispatch dimension of groups -> 65535 * 64 draws per batch
+        static constexpr uint32_t MAX_DRAWS = 65535u * GROUP_SIZE;
+
+        static bool isVisible(const IndirectDrawSource& draw, const CullPlanes& planes);
+
+        // Writes the compacted arguments of the visible draws, returns their count.
+        // With a job system steps 1 and 3 run over blocks of groups in parallel.
+        uint32_t cull(
+            const IndirectDrawSource* draws,
+            uint32_t count,
+            const CullPlanes& planes,
+            IndirectDrawArguments* arguments,
+            JobSystem* jobs = nullptr
+        );
+
+    private:
+        std::vector<uint32_t> groupOffsets;
+};
+
+// GPU path: three compute dispatches fill a default heap argument buffer + count, one
+// executeIndirect draws whatever survived -> no per-draw CPU work at all.
+// The buffers are reused every frame: the cull of frame n+1 runs after frame n's draws on the
+// same queue, so nothing has to be ring-buffered.
+class IndirectDrawCuller {
+    public:
+        // Compute root layout (cull_draws.hlsl)
+        static constexpr uint32_t ROOT_CONSTANTS = 0;  // b0: CullConstants
+        static constexpr uint32_t ROOT_DRAWS = 1;      // t0: IndirectDrawSource[]
+        static constexpr uint32_t ROOT_ARGUMENTS = 2;  // u0: IndirectDrawArguments[]
+        static constexpr uint32_t ROOT_GROUPS = 3;     // u1: per-group count -> offset
+        static constexpr uint32_t ROOT_COUNT = 4;      // u2: visible draw count
+
+        static constexpr uint32_t SCAN_GROUP_SIZE = 1024;
+
+        // drawPipeline / constantsRoot -> where the command's root constant lands
+        // (offset 0 of a Constants root parameter of drawPipeline)
+        IndirectDrawCuller(RhiDevice* device, RhiPipeline* drawPipeline, uint32_t constantsRoot, uint32_t maxDraws);
+        ~IndirectDrawCuller();
+
+        // Records the cull of count draws read from the GPU address draws (structured, 32-byte stride).
+        // Leaves the argument and count buffers in IndirectArgument state.
+        void cull(RhiCommandList* list, uint64_t draws, uint32_t count, const CullPlanes& planes);
+
+        // executeIndirect over the last cull's output; pipeline, vertex / index buffers and the other
+        // root arguments are the caller's
+        void draw(RhiCommandList* list) const;
+
+        RhiBuffer* getArgumentBuffer() const {
+            return arguments.get();
+        }
+
+        RhiBuffer* getCountBuffer() const {
+            return countBuffer.get();
+        }
+
+        RhiCommandSignature* getSignature() const {
+            return signature.get();
+        }
+
+        uint32_t getMaxDraws() const {
+            return maxDraws;
+        }
+
+        // Matches CullConstants in cull_draws.hlsl
+        struct CullConstants {
+            CullPlanes planes;
+            uint32_t drawCount;
+            uint32_t groupCount;
+        };
+
+    private:
+        uint32_t maxDraws = 0;
+        uint32_t lastCount = 0;
+
+        std::unique_ptr<RhiPipeline> countPipeline;
+        std::unique_ptr<RhiPipeline> scanPipeline;
+        std::unique_ptr<RhiPipeline> writePipeline;
+        std::unique_ptr<RhiCommandSignature> signature;
+
+        std::unique_ptr<RhiBuffer> arguments;
+        std::unique_ptr<RhiBuffer> groupOffsets;
+        std::unique_ptr<RhiBuffer> countBuffer;
+};
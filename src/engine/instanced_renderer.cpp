@@ -0,0 +1,100 @@
+#include "instanced_renderer.h"
+#include "mesh.h"
+#include "frame_upload_allocator.h"
+#include "rhi/rhi_command_queue.h"
+#include "utils/logger.h"
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+InstancedMeshRenderer::InstancedMeshRenderer(
+    RhiDevice* device,
+    RhiCommandQueue* queue,
+    uint32_t framesInFlight,
+    uint32_t maxInstancesPerFrame
+) :
+    device(device),
+    queue(queue),
+    maxInstances(maxInstancesPerFrame)
+{
+    setFramesInFlight(framesInFlight);
+
+    RhiPipelineDesc pipelineDesc;
+    pipelineDesc.vertexShader = L"assets/shaders/instanced_vertex.cso";
+    pipelineDesc.pixelShader = L"assets/shaders/pixel.cso";
+    pipelineDesc.inputLayout = getInputLayout();
+    pipelineDesc.rootParameters = { { 0, 0, RhiShaderVisibility::All } }; // b0: the frame's matrix
+    pipeline = device->createPipeline(pipelineDesc);
+
+    LOG_INFO(L"InstancedMeshRenderer -> up to %u instances per frame", maxInstances);
+}
+
+InstancedMeshRenderer::~InstancedMeshRenderer() = default;
+
+std::vector<RhiInputElement> InstancedMeshRenderer::getInputLayout() {
+    const RhiInputClassification perInstance = RhiInputClassification::PerInstance;
+    const uint32_t transform = static_cast<uint32_t>(offsetof(InstanceData, transform));
+    const uint32_t color = static_cast<uint32_t>(offsetof(InstanceData, color));
+
+    return {
+        { "POSITION", 0, RhiFormat::R32G32B32A32Float, 0, 0 },
+        { "COLOR", 0, RhiFormat::R32G32B32A32Float, 0, 16 },
+        // a matrix is four float4 elements -> INSTANCE_TRANSFORM0..3 are its rows
+        { "INSTANCE_TRANSFORM", 0, RhiFormat::R32G32B32A32Float, INSTANCE_SLOT, transform, perInstance, 1 },
+        { "INSTANCE_TRANSFORM", 1, RhiFormat::R32G32B32A32Float, INSTANCE_SLOT, transform + 16, perInstance, 1 },
+        { "INSTANCE_TRANSFORM", 2, RhiFormat::R32G32B32A32Float, INSTANCE_SLOT, transform + 32, perInstance, 1 },
+        { "INSTANCE_TRANSFORM", 3, RhiFormat::R32G32B32A32Float, INSTANCE_SLOT, transform + 48, perInstance, 1 },
+        { "INSTANCE_COLOR", 0, RhiFormat::R32G32B32A32Float, INSTANCE_SLOT, color, perInstance, 1 }
+    };
+}
+
+void InstancedMeshRenderer::setFramesInFlight(uint32_t framesInFlight) {
+    ring = std::make_unique<FrameUploadAllocator>(
+        device, queue, framesInFlight, uint64_t(maxInstances) * sizeof(InstanceData)
+    );
+}
+
+void InstancedMeshRenderer::beginFrame() {
+    ring->beginFrame();
+}
+
+void InstancedMeshRenderer::endFrame(uint64_t fenceValue) {
+    ring->endFrame(fenceValue);
+}
+
+InstanceAllocation InstancedMeshRenderer::allocate(uint32_t count) {
+    InstanceAllocation allocation;
+    if (count == 0) {
+        return allocation;
+    }
+
+    // vertex data only needs its element alignment; the ring throws once the frame's region is full
+    UploadAllocation memory = ring->allocate(uint64_t(count) * sizeof(InstanceData), 16);
+    allocation.instances = static_cast<InstanceData*>(memory.cpu);
+    allocation.count = count;
+    allocation.view = { memory.gpuAddress, static_cast<uint32_t>(memory.size), static_cast<uint32_t>(sizeof(InstanceData)) };
+    return allocation;
+}
+
+InstanceAllocation InstancedMeshRenderer::upload(const InstanceData* instances, uint32_t count) {
+    InstanceAllocation allocation = allocate(count);
+    if (count > 0) {
+        std::memcpy(allocation.instances, instances, size_t(count) * sizeof(InstanceData));
+    }
+    return allocation;
+}
+
+void InstancedMeshRenderer::draw(RhiCommandList* list, const Mesh& mesh, const InstanceAllocation& instances, uint64_t frameConstants) const {
+    if (instances.count == 0) {
+        return;
+    }
+
+    list->setPipeline(pipeline.get());
+    list->setGraphicsRootConstantBufferView(0, frameConstants);
+    list->setPrimitiveTopology(RhiPrimitiveTopology::TriangleList);
+    list->setVertexBuffer(0, mesh.getVertexView());
+    list->setVertexBuffer(INSTANCE_SLOT, instances.view);
+    list->setIndexBuffer(mesh.getIndexView());
+    list->drawIndexedInstanced(mesh.getIndexCount(), instances.count, mesh.getStartIndex(), mesh.getBaseVertex(), 0);
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "rhi/rhi.h"
+
+#include <memory>
+#include <vector>
+
+class Mesh;
+class RhiCommandQueue;
+class FrameUploadAllocator;
+
+// One element of the per-instance vertex stream (slot 1, stepped once per instance)
+struct InstanceData {
+    float transform[16]; // row-major world matrix (DirectXMath layout, not transposed), applied before the frame's matrix
+    float color[4];      // multiplies the vertex color
+};
+
+// Instances of one draw in this frame's upload region
+struct InstanceAllocation {
+    InstanceData* instances = nullptr; // write-combined on D3D12 -> write sequentially, never read back
+    uint32_t count = 0;
+    RhiVertexBufferView view;
+};
+
+// Hardware instancing: any number of copies of a Mesh in one DrawIndexedInstanced.
+// Per-instance transform / color come in as a second vertex stream (PER_INSTANCE_DATA, step rate 1)
+// out of a persistently mapped upload ring with one region per frame in flight, so filling it
+// is a plain write into mapped memory -> no per-object constant buffer or draw call.
+class InstancedMeshRenderer {
+    public:
+        static constexpr uint32_t INSTANCE_SLOT = 1;
+        static constexpr uint32_t DEFAULT_MAX_INSTANCES = 64 * 1024; // per frame
+
+        InstancedMeshRenderer(
+            RhiDevice* device,
+            RhiCommandQueue* queue,
+            uint32_t framesInFlight,
+            uint32_t maxInstancesPerFrame = DEFAULT_MAX_INSTANCES
+        );
+        ~InstancedMeshRenderer();
+
+        // Same cadence as the renderer's frame contexts
+        void beginFrame();
+        void endFrame(uint64_t fenceValue);
+
+        // Between frames, GPU idle -> new ring with one region per frame in flight
+        void setFramesInFlight(uint32_t framesInFlight);
+
+        // count instances valid for this frame; throws past maxInstancesPerFrame
+        InstanceAllocation allocate(uint32_t count);
+        InstanceAllocation upload(const InstanceData* instances, uint32_t count);
+
+        // Binds the instancing pipeline, the frame matrix (b0) and both streams, then one draw
+        void draw(RhiCommandList* list, const Mesh& mesh, const InstanceAllocation& instances, uint64_t frameConstants) const;
+
+        RhiPipeline* getPipeline() const {
+            return pipeline.get();
+        }
+
+        // slot 0: VertexStruct, slot 1: InstanceData
+        static std::vector<RhiInputElement> getInputLayout();
+
+    private:
+        RhiDevice* device = nullptr;
+        RhiCommandQueue* queue = nullptr;
+        uint32_t maxInstances = 0;
+
+        std::unique_ptr<FrameUploadAllocator> ring;
+        std::unique_ptr<RhiPipeline> pipeline;
+};
@@ -0,0 +1,364 @@
+#include "job_system.h"
+
+// before the logger -> its windows.h include must not define min / max
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+#include "utils/logger.h"
+
+#include <algorithm>
+#include <exception>
+
+struct Job {
+    JobSystem::JobFunction function;
+    JobCounter* counter = nullptr;
+};
+
+struct JobSystem::ForState {
+    const RangeFunction* function = nullptr;
+    uint32_t grain = 1;
+    bool automatic = false;
+    JobCounter counter;
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
+
+namespace {
+    // system + index of the calling thread -> several systems can coexist
+    struct CurrentThread {
+        const JobSystem* system = nullptr;
+        uint32_t index = JobSystem::NO_THREAD;
+    };
+
+    thread_local CurrentThread currentThread;
+
+    // empty rounds of stealing before an idle worker goes to sleep
+    constexpr uint32_t SPIN_ROUNDS = 64;
+}
+
+JobCounter::~JobCounter() {
+    // no lock: whoever could still add waiters or drain them must be done with the counter by now
+    if (!waiters.empty()) {
+        LOG_WARNING(L"JobCounter -> Destroyed with %u waiting jobs, dropping them", static_cast<uint32_t>(waiters.size()));
+    }
+    for (Job* job : waiters) {
+        delete job;
+    }
+}
+
+JobSystem::JobSystem(const JobSystemConfig& config) {
+    uint32_t hardware = std::max(std::thread::hardware_concurrency(), 1u);
+    uint32_t workers = config.threads == JobSystemConfig::AUTO_THREADS ? std::max(hardware - 1, 1u) : config.threads;
+
+    for (uint32_t i = 0; i <= workers; ++i) {
+        deques.push_back(std::make_unique<ThreadDeque>());
+        deques.back()->random = 0x9e3779b9u * (i + 1);
+    }
+    currentThread = { this, 0 };
+
+    threads.reserve(workers);
+    for (uint32_t i = 1; i <= workers; ++i) {
+        threads.emplace_back([this, i] { workerLoop(i); });
+        if (config.pinThreads) {
+            pin(threads.back(), i % hardware);
+        }
+    }
+
+    LOG_INFO(L"JobSystem -> %u worker threads (pinned: %d)", workers, config.pinThreads ? 1 : 0);
+}
+
+JobSystem::~JobSystem() {
+    stopping = true;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        wake.notify_all();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto& entry : deques) {
+        while (Job* job = entry->deque.steal()) {
+            delete job;
+        }
+    }
+    for (Job* job : inbox) {
+        delete job;
+    }
+    if (currentThread.system == this) {
+        currentThread = {};
+    }
+}
+
+uint32_t JobSystem::getCurrentThread() const {
+    return currentThread.system == this ? currentThread.index : NO_THREAD;
+}
+
+void JobSystem::run(JobFunction function, JobCounter* counter) {
+    if (counter) {
+        counter->state.fetch_add(1, std::memory_order_relaxed);
+    }
+    push(new Job{ std::move(function), counter });
+}
+
+void JobSystem::run(JobFunction function, JobCounter* counter, JobCounter& dependency) {
+    if (counter) {
+        counter->state.fetch_add(1, std::memory_order_relaxed);
+    }
+    Job* job = new Job{ std::move(function), counter };
+
+    {
+        // the job finishing dependency takes the waiters under the same lock after counting down
+        // -> either it sees this job or this sees zero
+        std::lock_guard<std::mutex> lock(dependency.mutex);
+        if ((dependency.state.load(std::memory_order_acquire) & JobCounter::PENDING_MASK) != 0) {
+            dependency.waiters.push_back(job);
+            return;
+        }
+    }
+    push(job);
+}
+
+void JobSystem::push(Job* job) {
+    // counted before it becomes visible -> a sleeper that sees queued == 0 has nothing to miss
+    queued.fetch_add(1);
+
+    uint32_t thread = getCurrentThread();
+    if (thread != NO_THREAD) {
+        deques[thread]->deque.push(job);
+    } else {
+        {
+            std::lock_guard<std::mutex> lock(inboxMutex);
+            inbox.push_back(job);
+            inboxEmpty.store(false);
+        }
+        // no workers -> a waiting outside thread is the only one that runs it
+        if (threads.empty() && outsideWaiters.load() > 0) {
+            std::lock_guard<std::mutex> lock(doneMutex);
+            done.notify_all();
+        }
+    }
+
+    if (sleepers.load() > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        wake.notify_one();
+    }
+}
+
+Job* JobSystem::findJob(uint32_t thread) {
+    ThreadDeque& own = *deques[thread];
+    if (Job* job = own.deque.take()) {
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        return job;
+    }
+
+    if (Job* job = takeInbox()) {
+        return job;
+    }
+
+    // random first victim -> thieves spread over the deques instead of all hitting the same one
+    uint32_t count = getThreadCount();
+    own.random ^= own.random << 13;
+    own.random ^= own.random >> 17;
+    own.random ^= own.random << 5;
+    uint32_t start = own.random % count;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t victim = (start + i) % count;
+        if (victim == thread) {
+            continue;
+        }
+        if (Job* job = deques[victim]->deque.steal()) {
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+Job* JobSystem::takeInbox() {
+    if (inboxEmpty.load(std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(inboxMutex);
+    if (inbox.empty()) {
+        return nullptr;
+    }
+    Job* job = inbox.front();
+    inbox.pop_front();
+    inboxEmpty.store(inbox.empty(), std::memory_order_relaxed);
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    return job;
+}
+
+void JobSystem::execute(Job* job) {
+    job->function();
+    if (job->counter) {
+        finish(job->counter);
+    }
+    delete job;
+}
+
+void JobSystem::finish(JobCounter* counter) {
+    // the last job keeps the counter alive (DRAINING) while it queues the waiting jobs
+    uint64_t value = counter->state.load(std::memory_order_relaxed);
+    uint64_t next = 0;
+    do {
+        bool last = (value & JobCounter::PENDING_MASK) == 1;
+        next = last ? value - 1 + JobCounter::DRAINING : value - 1;
+    } while (!counter->state.compare_exchange_weak(value, next, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+    if ((next & JobCounter::PENDING_MASK) != 0) {
+        return;
+    }
+
+    std::vector<Job*> ready;
+    {
+        std::lock_guard<std::mutex> lock(counter->mutex);
+        ready.swap(counter->waiters);
+    }
+    // last access -> released before the dependent jobs run, so whoever waits on their
+    // counters may destroy this one as soon as they finish.
+    // seq_cst with the waiter count: either a sleeping waiter is seen here or it sees zero
+    counter->state.fetch_sub(JobCounter::DRAINING);
+    if (outsideWaiters.load() > 0) {
+        std::lock_guard<std::mutex> lock(doneMutex);
+        done.notify_all();
+    }
+
+    for (Job* job : ready) {
+        push(job);
+    }
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    uint32_t thread = getCurrentThread();
+    if (thread == NO_THREAD) {
+        // sleep until a finishing counter notifies (any counter, so re-check). Without workers
+        // nobody else drains the inbox -> run its jobs here, on whatever thread this is
+        bool helps = threads.empty();
+        std::unique_lock<std::mutex> lock(doneMutex);
+        outsideWaiters.fetch_add(1);
+        while (counter.state.load() != 0) {
+            if (helps && !inboxEmpty.load()) {
+                lock.unlock();
+                if (Job* job = takeInbox()) {
+                    execute(job);
+                }
+                lock.lock();
+                continue;
+            }
+            done.wait(lock);
+        }
+        outsideWaiters.fetch_sub(1);
+        return;
+    }
+
+    while (!counter.isDone()) {
+        if (Job* job = findJob(thread)) {
+            execute(job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::workerLoop(uint32_t thread) {
+    currentThread = { this, thread };
+
+    uint32_t idle = 0;
+    while (!stopping.load(std::memory_order_relaxed)) {
+        if (Job* job = findJob(thread)) {
+            execute(job);
+            idle = 0;
+            continue;
+        }
+        if (++idle < SPIN_ROUNDS) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepers.fetch_add(1);
+        wake.wait(lock, [this] { return stopping.load() || queued.load() > 0; });
+        sleepers.fetch_sub(1);
+        idle = 0;
+    }
+}
+
+void JobSystem::parallelFor(uint32_t count, const RangeFunction& function, uint32_t grain) {
+    if (count == 0) {
+        return;
+    }
+
+    uint32_t thread = getCurrentThread();
+    if (thread == NO_THREAD && threads.empty()) {
+        // no thread of the system could pick the range up -> it all runs here
+        function(0, count);
+        return;
+    }
+
+    ForState state;
+    state.function = &function;
+    state.automatic = grain == 0;
+    state.grain = state.automatic ? std::max(count / (getThreadCount() * 64), 1u) : grain;
+
+    if (thread == NO_THREAD) {
+        // can't run jobs here -> the whole range goes to the workers
+        run([this, &state, count] { splitRange(state, 0, count); }, &state.counter);
+    } else {
+        splitRange(state, 0, count);
+    }
+    wait(state.counter);
+
+    if (state.error) {
+        std::rethrow_exception(state.error);
+    }
+}
+
+void JobSystem::splitRange(ForState& state, uint32_t begin, uint32_t end) {
+    uint32_t thread = getCurrentThread();
+
+    while (begin < end) {
+        // hand the upper half to thieves; automatic grain only while nothing else is up for grabs
+        bool split = end - begin > state.grain && (!state.automatic || deques[thread]->deque.isEmpty());
+        if (split) {
+            uint32_t middle = begin + (end - begin) / 2;
+            run([this, &state, middle, end] { splitRange(state, middle, end); }, &state.counter);
+            end = middle;
+            continue;
+        }
+
+        uint32_t pieceEnd = state.automatic ? std::min(end, begin + state.grain) : end;
+        try {
+            (*state.function)(begin, pieceEnd);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(state.errorMutex);
+            if (!state.error) {
+                state.error = std::current_exception();
+            }
+        }
+        begin = pieceEnd;
+    }
+}
+
+void JobSystem::pin(std::thread& thread, uint32_t core) {
+#if defined(_WIN32)
+    if (core >= 64 || SetThreadAffinityMask(static_cast<HANDLE>(thread.native_handle()), DWORD_PTR(1) << core) == 0) {
+        LOG_WARNING(L"JobSystem -> Could not pin a worker to core %u", core);
+    }
+#else
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    if (pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) != 0) {
+        LOG_WARNING(L"JobSystem -> Could not pin a worker to core %u", core);
+    }
+#endif
+}
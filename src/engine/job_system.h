@@ -0,0 +1,139 @@
+#pragma once
+
+#include "work_stealing_deque.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobSystem;
+struct Job;
+
+// Jobs started with a counter add one while queued / running; wait(counter) returns once
+// all of them finished. Other jobs can be queued to start only once a counter reaches zero.
+// Reusable: counting up again after it reached zero starts a new round.
+// Jobs still waiting for the counter when it is destroyed (it never reached zero, e.g. its jobs
+// were dropped with the system) are freed with it and never run.
+class JobCounter {
+    public:
+        JobCounter() = default;
+        ~JobCounter();
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        bool isDone() const {
+            return state.load(std::memory_order_acquire) == 0;
+        }
+
+    private:
+        friend class JobSystem;
+
+        // low 32 bits: unfinished jobs. DRAINING: the job that finished last still hands the
+        // waiting jobs to the scheduler -> the counter must stay alive until it is done
+        static constexpr uint64_t PENDING_MASK = 0xffffffffull;
+        static constexpr uint64_t DRAINING = 1ull << 32;
+
+        std::atomic<uint64_t> state{ 0 };
+        std::mutex mutex;           // waiters
+        std::vector<Job*> waiters;  // queued once the counter reaches zero
+};
+
+struct JobSystemConfig {
+    static constexpr uint32_t AUTO_THREADS = ~0u;
+
+    // worker threads besides the thread creating the system (AUTO -> one per remaining hardware
+    // thread, at least one: the owner may be busy elsewhere while another thread submits work)
+    uint32_t threads = AUTO_THREADS;
+
+    // worker i stays on core i + 1; core 0 is left to the owning (main / render) thread
+    bool pinThreads = false;
+};
+
+// Work-stealing scheduler shared by the engine's parallel work (culling, transforms, command
+// recording, asset decoding). Every thread owns a Chase-Lev deque: jobs queued from inside a job
+// go to the front of the local deque and run next on the same core; idle threads steal the oldest
+// job of a random victim. Idle workers spin briefly, then sleep until something is queued.
+// The creating thread is thread 0 and runs jobs while it waits; other threads may queue jobs
+// (through a locked inbox) and wait (asleep until a counter finishes), but never run any -
+// except in a system without workers, where nobody else would: there they run their own
+// parallelFor inline and drain the inbox while they wait.
+class JobSystem {
+    public:
+        using JobFunction = std::function<void()>;
+        using RangeFunction = std::function<void(uint32_t begin, uint32_t end)>;
+
+        static constexpr uint32_t NO_THREAD = ~0u;
+
+        explicit JobSystem(const JobSystemConfig& config = {});
+        ~JobSystem(); // jobs still queued are dropped
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        // Jobs must not throw (parallelFor catches for its ranges)
+        void run(JobFunction job, JobCounter* counter = nullptr);
+
+        // Queued once dependency reaches zero (immediately if it already is)
+        void run(JobFunction job, JobCounter* counter, JobCounter& dependency);
+
+        // Runs other jobs until counter reaches zero (sleeps on threads outside the system,
+        // or runs inbox jobs there when the system has no workers)
+        void wait(JobCounter& counter);
+
+        // function(begin, end) over [0, count), blocks until done; rethrows the first exception.
+        // grain 0 -> automatic: ranges are split in half only while the local deque is empty,
+        // i.e. while other threads might be starving (lazy binary splitting), down to a floor
+        // of count / (threads * 64) -> few jobs on a busy system, enough on an idle one.
+        void parallelFor(uint32_t count, const RangeFunction& function, uint32_t grain = 0);
+
+        // threads that run jobs: the workers plus the owner
+        uint32_t getThreadCount() const {
+            return static_cast<uint32_t>(deques.size());
+        }
+
+        // [0, getThreadCount()) for the owner (0) and the workers, NO_THREAD elsewhere
+        uint32_t getCurrentThread() const;
+
+    private:
+        struct alignas(64) ThreadDeque {
+            WorkStealingDeque<Job*> deque;
+            uint32_t random = 0; // xorshift state for picking victims
+        };
+
+        struct ForState;
+
+        void workerLoop(uint32_t thread);
+        void push(Job* job);
+        Job* findJob(uint32_t thread);
+        Job* takeInbox();
+        void execute(Job* job);
+        void finish(JobCounter* counter);
+        void splitRange(ForState& state, uint32_t begin, uint32_t end);
+        static void pin(std::thread& thread, uint32_t core);
+
+    private:
+        std::vector<std::unique_ptr<ThreadDeque>> deques; // [0] = owner
+        std::vector<std::thread> threads;
+
+        std::mutex inboxMutex;
+        std::deque<Job*> inbox; // queued by threads outside the system
+        std::atomic<bool> inboxEmpty{ true };
+
+        // sleeping: queued jobs vs. sleepers -> a push only takes the mutex when someone sleeps
+        std::atomic<int64_t> queued{ 0 };
+        std::atomic<uint32_t> sleepers{ 0 };
+        std::mutex sleepMutex;
+        std::condition_variable wake;
+        std::atomic<bool> stopping{ false };
+
+        // threads outside the system sleep in wait() -> finish() (and, without workers, inbox
+        // pushes) only notify when there are any
+        std::atomic<uint32_t> outsideWaiters{ 0 };
+        std::mutex doneMutex;
+        std::condition_variable done;
+};
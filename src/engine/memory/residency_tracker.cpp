@@ -0,0 +1,113 @@
+#include "residency_tracker.h"
+
+void ResidencyTracker::add(uint64_t id, uint64_t size) {
+    auto it = entries.find(id);
+    if (it != entries.end()) {
+        it->second->references++;
+        return;
+    }
+
+    Entry entry;
+    entry.id = id;
+    entry.size = size;
+    entry.references = 1;
+
+    // just created -> about to be used, counts as most recently used
+    lru.push_back(entry);
+    entries[id] = std::prev(lru.end());
+
+    residentBytes += size;
+    trackedBytes += size;
+}
+
+bool ResidencyTracker::remove(uint64_t id) {
+    auto it = entries.find(id);
+    if (it == entries.end()) {
+        return false;
+    }
+
+    Entry& entry = *it->second;
+    if (--entry.references > 0) {
+        return false;
+    }
+
+    if (entry.resident) {
+        residentBytes -= entry.size;
+    }
+    trackedBytes -= entry.size;
+
+    // a queued id stays in pendingResident -> skipped in plan() since it's no longer tracked
+    lru.erase(it->second);
+    entries.erase(it);
+    return true;
+}
+
+void ResidencyTracker::markUsed(uint64_t id, uint64_t fenceValue) {
+    auto it = entries.find(id);
+    if (it == entries.end()) {
+        return;
+    }
+
+    Entry& entry = *it->second;
+    if (fenceValue > entry.lastUsed) {
+        entry.lastUsed = fenceValue;
+    }
+    lru.splice(lru.end(), lru, it->second);
+
+    if (!entry.resident && !entry.queued) {
+        entry.queued = true;
+        pendingResident.push_back(id);
+    }
+}
+
+void ResidencyTracker::plan(uint64_t budget, uint64_t usage, uint64_t completedFence, Plan& result) {
+    result.evict.clear();
+    result.makeResident.clear();
+    result.evictBytes = 0;
+    result.makeResidentBytes = 0;
+    result.overBudgetBytes = 0;
+
+    for (uint64_t id : pendingResident) {
+        auto it = entries.find(id);
+        if (it == entries.end() || !it->second->queued) {
+            continue;
+        }
+
+        Entry& entry = *it->second;
+        entry.queued = false;
+        entry.resident = true;
+        residentBytes += entry.size;
+
+        result.makeResident.push_back(id);
+        result.makeResidentBytes += entry.size;
+    }
+    pendingResident.clear();
+
+    uint64_t projected = usage + result.makeResidentBytes;
+    if (projected <= budget) {
+        return;
+    }
+
+    // oldest first; everything the GPU may still touch (lastUsed > completed) has to stay
+    for (auto it = lru.begin(); it != lru.end() && projected > budget; ++it) {
+        Entry& entry = *it;
+        if (!entry.resident || entry.lastUsed > completedFence) {
+            continue;
+        }
+        entry.resident = false;
+        residentBytes -= entry.size;
+        projected -= entry.size < projected ? entry.size : projected;
+
+        result.evict.push_back(entry.id);
+        result.evictBytes += entry.size;
+    }
+
+    if (projected > budget) {
+        result.overBudgetBytes = projected - budget;
+    }
+}
+
+bool ResidencyTracker::isResident(uint64_t id) const {
+    auto it = entries.find(id);
+    return it != entries.end() && it->second->resident;
+}
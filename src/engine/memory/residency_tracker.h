@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+// Residency policy for a set of pageable objects (heaps, committed resources) keyed by an opaque id.
+// Keeps them in LRU order of the fence value they were last used with and, given the OS budget,
+// decides which objects to evict and which to make resident again. Pure bookkeeping -> the
+// caller issues the Evict / MakeResident batches, so the policy runs against any (simulated) budget.
+class ResidencyTracker {
+public:
+    struct Plan {
+        std::vector<uint64_t> evict;
+        std::vector<uint64_t> makeResident;
+        uint64_t evictBytes = 0;
+        uint64_t makeResidentBytes = 0;
+        uint64_t overBudgetBytes = 0; // still over after evicting everything idle
+    };
+
+    // Objects start resident (that's how D3D12 creates them). Adding an id again only adds a reference.
+    void add(uint64_t id, uint64_t size);
+
+    // Drops a reference; returns true when the object is gone from the tracker
+    bool remove(uint64_t id);
+
+    // The work signalled with fenceValue uses id -> moves it to the most recently used end.
+    // An evicted object is queued to become resident in the next plan.
+    void markUsed(uint64_t id, uint64_t fenceValue);
+
+    // usage = what the OS says this process currently uses (includes everything resident here).
+    // Queued objects always go resident; to make room, least recently used objects whose last
+    // fence already completed are evicted until usage fits into budget.
+    void plan(uint64_t budget, uint64_t usage, uint64_t completedFence, Plan& result);
+
+    uint64_t getResidentBytes() const {
+        return residentBytes;
+    }
+
+    uint64_t getTrackedBytes() const {
+        return trackedBytes;
+    }
+
+    size_t getCount() const {
+        return entries.size();
+    }
+
+    bool isResident(uint64_t id) const;
+
+private:
+    struct Entry {
+        uint64_t id = 0;
+        uint64_t size = 0;
+        uint64_t lastUsed = 0; // fence value
+        uint32_t references = 0;
+        bool resident = true;
+        bool queued = false; // in pendingResident
+    };
+
+    // front = least recently used
+    std::list<Entry> lru;
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> entries;
+
+    std::vector<uint64_t> pendingResident;
+
+    uint64_t residentBytes = 0;
+    uint64_t trackedBytes = 0;
+};
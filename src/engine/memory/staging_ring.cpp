@@ -0,0 +1,79 @@
+#include "staging_ring.h"
+
+static uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+StagingRing::StagingRing(uint64_t capacity)
+    : capacity(capacity)
+{
+}
+
+uint64_t StagingRing::allocate(uint64_t size, uint64_t alignment) {
+    if (size == 0 || size > capacity) {
+        return INVALID_OFFSET;
+    }
+
+    // empty ring -> restart at 0 so big blocks don't have to wrap
+    if (used == 0) {
+        head = 0;
+        tail = 0;
+    }
+
+    uint64_t offset = alignUp(head, alignment);
+    uint64_t consumed = 0;
+
+    if (used > 0 && head == tail) {
+        return INVALID_OFFSET; // completely full
+    }
+
+    if (head >= tail) {
+        // live region is [tail, head) -> free space is [head, capacity) + [0, tail)
+        if (offset + size <= capacity) {
+            consumed = offset + size - head;
+        } else if (size <= tail) {
+            // wrap: the rest of the ring is wasted until this batch retires
+            consumed = (capacity - head) + size;
+            offset = 0;
+        } else {
+            return INVALID_OFFSET;
+        }
+    } else {
+        // wrapped: live region is [tail, capacity) + [0, head) -> free space is [head, tail)
+        if (offset + size <= tail) {
+            consumed = offset + size - head;
+        } else {
+            return INVALID_OFFSET;
+        }
+    }
+
+    head = offset + size;
+    if (head == capacity) {
+        head = 0;
+    }
+
+    used += consumed;
+    currentBatchSize += consumed;
+    return offset;
+}
+
+void StagingRing::finishBatch(uint64_t fenceValue) {
+    if (currentBatchSize == 0) {
+        return;
+    }
+
+    batches.push_back({ fenceValue, head, currentBatchSize });
+    currentBatchSize = 0;
+}
+
+void StagingRing::release(uint64_t completedValue) {
+    while (!batches.empty() && batches.front().fenceValue <= completedValue) {
+        tail = batches.front().end;
+        used -= batches.front().size;
+        batches.pop_front();
+    }
+}
+
+uint64_t StagingRing::getOldestPendingFence() const {
+    return batches.empty() ? 0 : batches.front().fenceValue;
+}
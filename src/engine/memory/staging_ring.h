@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+
+// Offset allocator for a fixed-size ring (the staging buffer of the upload manager).
+// Allocations are handed out in order and retired in batches: everything allocated between two
+// finishBatch() calls is freed together once that batch's fence value completes.
+// Pure bookkeeping -> no GPU objects, no locking.
+class StagingRing {
+public:
+    static constexpr uint64_t INVALID_OFFSET = ~0ull;
+
+    explicit StagingRing(uint64_t capacity);
+
+    // Returns INVALID_OFFSET when the request doesn't fit right now (or ever, if size > capacity).
+    // Skips the tail end of the ring when the block would straddle the wrap point.
+    uint64_t allocate(uint64_t size, uint64_t alignment = 16);
+
+    // Tags everything allocated since the previous call with fenceValue
+    void finishBatch(uint64_t fenceValue);
+
+    // Frees every batch whose fence value is <= completedValue
+    void release(uint64_t completedValue);
+
+    // Fence value of the oldest batch still in flight, 0 when none
+    uint64_t getOldestPendingFence() const;
+
+    bool hasUnfinishedAllocations() const {
+        return currentBatchSize > 0;
+    }
+
+    uint64_t getCapacity() const {
+        return capacity;
+    }
+
+    // bytes in use, including alignment padding and skipped wrap space
+    uint64_t getUsed() const {
+        return used;
+    }
+
+private:
+    struct Batch {
+        uint64_t fenceValue = 0;
+        uint64_t end = 0;
+        uint64_t size = 0;
+    };
+
+    uint64_t capacity = 0;
+    uint64_t head = 0; // next free byte
+    uint64_t tail = 0; // oldest live byte
+    uint64_t used = 0;
+    uint64_t currentBatchSize = 0;
+
+    std::deque<Batch> batches;
+};
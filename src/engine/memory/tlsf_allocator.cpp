@@ -0,0 +1,239 @@
+#include "tlsf_allocator.h"
+#include "utils/logger.h"
+
+#include <bit>
+#include <stdexcept>
+
+static uint32_t highestBit(uint64_t value) {
+    return 63u - static_cast<uint32_t>(std::countl_zero(value));
+}
+
+TlsfAllocator::TlsfAllocator(uint64_t capacity, uint64_t granularity) :
+    granularity(granularity)
+{
+    if (granularity == 0 || (granularity & (granularity - 1)) != 0) {
+        LOG_ERROR(L"TlsfAllocator -> Granularity %llu is not a power of two", static_cast<unsigned long long>(granularity));
+        throw std::runtime_error("TLSF granularity must be a power of two");
+    }
+
+    granularityShift = static_cast<uint32_t>(std::countr_zero(granularity));
+    capacityUnits = capacity >> granularityShift;
+
+    for (auto& fl : heads) {
+        for (auto& head : fl) {
+            head = NIL;
+        }
+    }
+
+    if (capacityUnits > 0) {
+        uint32_t node = createNode();
+        nodes[node].offset = 0;
+        nodes[node].size = capacityUnits;
+        insertFree(node);
+    }
+}
+
+void TlsfAllocator::mapping(uint64_t size, uint32_t& fl, uint32_t& sl) {
+    // small sizes get one list each, above that every power of two splits into SL_COUNT classes
+    if (size < SL_COUNT) {
+        fl = 0;
+        sl = static_cast<uint32_t>(size);
+    } else {
+        uint32_t bit = highestBit(size);
+        fl = bit - SL_BITS + 1;
+        sl = static_cast<uint32_t>(size >> (bit - SL_BITS)) ^ SL_COUNT;
+    }
+}
+
+uint32_t TlsfAllocator::findFree(uint64_t size) {
+    // round up to the next class boundary -> any block in the found list is large enough
+    uint64_t rounded = size;
+    if (rounded >= SL_COUNT) {
+        rounded += (uint64_t(1) << (highestBit(rounded) - SL_BITS)) - 1;
+    }
+
+    uint32_t fl = 0;
+    uint32_t sl = 0;
+    mapping(rounded, fl, sl);
+
+    if (fl < FL_COUNT) {
+        uint32_t slMap = slBitmap[fl] & (~0u << sl);
+        if (slMap == 0) {
+            uint64_t flMap = (fl + 1 < 64) ? flBitmap & (~uint64_t(0) << (fl + 1)) : 0;
+            if (flMap != 0) {
+                fl = static_cast<uint32_t>(std::countr_zero(flMap));
+                slMap = slBitmap[fl];
+            }
+        }
+        if (slMap != 0) {
+            return heads[fl][static_cast<uint32_t>(std::countr_zero(slMap))];
+        }
+    }
+
+    // nothing in the larger classes -> the head of the request's own class may still fit
+    // (e.g. one free block spanning the whole heap); one check keeps this O(1)
+    mapping(size, fl, sl);
+    uint32_t head = heads[fl][sl];
+    if (head != NIL && nodes[head].size >= size) {
+        return head;
+    }
+    return NIL;
+}
+
+void TlsfAllocator::insertFree(uint32_t index) {
+    Node& node = nodes[index];
+    uint32_t fl = 0;
+    uint32_t sl = 0;
+    mapping(node.size, fl, sl);
+
+    node.free = true;
+    node.prevFree = NIL;
+    node.nextFree = heads[fl][sl];
+    if (node.nextFree != NIL) {
+        nodes[node.nextFree].prevFree = index;
+    }
+
+    heads[fl][sl] = index;
+    flBitmap |= uint64_t(1) << fl;
+    slBitmap[fl] |= 1u << sl;
+}
+
+void TlsfAllocator::removeFree(uint32_t index) {
+    Node& node = nodes[index];
+    uint32_t fl = 0;
+    uint32_t sl = 0;
+    mapping(node.size, fl, sl);
+
+    if (node.prevFree != NIL) {
+        nodes[node.prevFree].nextFree = node.nextFree;
+    } else {
+        heads[fl][sl] = node.nextFree;
+    }
+    if (node.nextFree != NIL) {
+        nodes[node.nextFree].prevFree = node.prevFree;
+    }
+
+    if (heads[fl][sl] == NIL) {
+        slBitmap[fl] &= ~(1u << sl);
+        if (slBitmap[fl] == 0) {
+            flBitmap &= ~(uint64_t(1) << fl);
+        }
+    }
+
+    node.free = false;
+    node.prevFree = NIL;
+    node.nextFree = NIL;
+}
+
+uint32_t TlsfAllocator::createNode() {
+    if (!spareNodes.empty()) {
+        uint32_t index = spareNodes.back();
+        spareNodes.pop_back();
+        nodes[index] = Node{};
+        return index;
+    }
+    nodes.emplace_back();
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+void TlsfAllocator::releaseNode(uint32_t index) {
+    spareNodes.push_back(index);
+}
+
+TlsfAllocation TlsfAllocator::allocate(uint64_t size) {
+    TlsfAllocation allocation;
+
+    uint64_t units = (size + granularity - 1) >> granularityShift;
+    if (units == 0) {
+        units = 1;
+    }
+
+    uint32_t index = findFree(units);
+    if (index == NIL) {
+        return allocation;
+    }
+
+    removeFree(index);
+
+    // split off the tail -> it goes straight back to the free lists
+    if (nodes[index].size > units) {
+        uint32_t rest = createNode(); // may reallocate nodes, so index by position from here on
+        nodes[rest].offset = nodes[index].offset + units;
+        nodes[rest].size = nodes[index].size - units;
+        nodes[rest].prevPhysical = index;
+        nodes[rest].nextPhysical = nodes[index].nextPhysical;
+        if (nodes[rest].nextPhysical != NIL) {
+            nodes[nodes[rest].nextPhysical].prevPhysical = rest;
+        }
+
+        nodes[index].size = units;
+        nodes[index].nextPhysical = rest;
+        insertFree(rest);
+    }
+
+    usedUnits += units;
+    allocationCount++;
+
+    allocation.offset = nodes[index].offset << granularityShift;
+    allocation.size = units << granularityShift;
+    allocation.node = index;
+    return allocation;
+}
+
+void TlsfAllocator::free(const TlsfAllocation& allocation) {
+    if (!allocation.isValid()) {
+        return;
+    }
+
+    uint32_t index = allocation.node;
+    if (index >= nodes.size() || nodes[index].free || (nodes[index].offset << granularityShift) != allocation.offset) {
+        LOG_ERROR(L"TlsfAllocator -> Invalid free at offset %llu", static_cast<unsigned long long>(allocation.offset));
+        throw std::runtime_error("Invalid TLSF free");
+    }
+
+    usedUnits -= nodes[index].size;
+    allocationCount--;
+
+    // merge with the physical neighbours if they are free
+    uint32_t prev = nodes[index].prevPhysical;
+    if (prev != NIL && nodes[prev].free) {
+        removeFree(prev);
+        nodes[prev].size += nodes[index].size;
+        nodes[prev].nextPhysical = nodes[index].nextPhysical;
+        if (nodes[prev].nextPhysical != NIL) {
+            nodes[nodes[prev].nextPhysical].prevPhysical = prev;
+        }
+        releaseNode(index);
+        index = prev;
+    }
+
+    uint32_t next = nodes[index].nextPhysical;
+    if (next != NIL && nodes[next].free) {
+        removeFree(next);
+        nodes[index].size += nodes[next].size;
+        nodes[index].nextPhysical = nodes[next].nextPhysical;
+        if (nodes[index].nextPhysical != NIL) {
+            nodes[nodes[index].nextPhysical].prevPhysical = index;
+        }
+        releaseNode(next);
+    }
+
+    insertFree(index);
+}
+
+uint64_t TlsfAllocator::getLargestFreeBlock() const {
+    if (flBitmap == 0) {
+        return 0;
+    }
+
+    uint32_t fl = highestBit(flBitmap);
+    uint32_t sl = highestBit(slBitmap[fl]);
+
+    uint64_t largest = 0;
+    for (uint32_t index = heads[fl][sl]; index != NIL; index = nodes[index].nextFree) {
+        if (nodes[index].size > largest) {
+            largest = nodes[index].size;
+        }
+    }
+    return largest << granularityShift;
+}
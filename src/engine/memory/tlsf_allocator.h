@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+struct TlsfAllocation {
+    static constexpr uint64_t INVALID_OFFSET = ~0ull;
+    static constexpr uint32_t INVALID_NODE = ~0u;
+
+    uint64_t offset = INVALID_OFFSET;
+    uint64_t size = 0; // rounded to the allocator granularity
+    uint32_t node = INVALID_NODE;
+
+    bool isValid() const {
+        return offset != INVALID_OFFSET;
+    }
+};
+
+// Two-level segregated-fit range allocator (Masmano et al.).
+// Manages offsets in [0, capacity) with O(1) allocate and free: free blocks sit in
+// size-class lists picked by two bitmap scans, freed blocks merge with their neighbours.
+// Everything is done in units of `granularity` (power of two), so every offset is
+// granularity-aligned -> 64 KB for placed resources, 256 B for constant sub-ranges.
+// Pure bookkeeping -> no GPU objects, no locking.
+class TlsfAllocator {
+public:
+    TlsfAllocator(uint64_t capacity, uint64_t granularity);
+
+    // Returns an invalid allocation when no free block is large enough
+    TlsfAllocation allocate(uint64_t size);
+    void free(const TlsfAllocation& allocation);
+
+    uint64_t getCapacity() const { return capacityUnits * granularity; }
+    uint64_t getGranularity() const { return granularity; }
+    uint64_t getUsed() const { return usedUnits * granularity; }
+    uint64_t getFree() const { return (capacityUnits - usedUnits) * granularity; }
+    uint32_t getAllocationCount() const { return allocationCount; }
+
+    // Walks the largest non-empty size class -> for stats, not for the hot path
+    uint64_t getLargestFreeBlock() const;
+
+private:
+    static constexpr uint32_t SL_BITS = 5;
+    static constexpr uint32_t SL_COUNT = 1u << SL_BITS;
+    static constexpr uint32_t FL_COUNT = 65 - SL_BITS; // covers every 64-bit size
+    static constexpr uint32_t NIL = ~0u;
+
+    struct Node {
+        uint64_t offset = 0; // in units
+        uint64_t size = 0;   // in units
+        uint32_t prevPhysical = NIL;
+        uint32_t nextPhysical = NIL;
+        uint32_t prevFree = NIL;
+        uint32_t nextFree = NIL;
+        bool free = false;
+    };
+
+    static void mapping(uint64_t size, uint32_t& fl, uint32_t& sl);
+
+    uint32_t findFree(uint64_t size);
+    void insertFree(uint32_t node);
+    void removeFree(uint32_t node);
+
+    uint32_t createNode();
+    void releaseNode(uint32_t node);
+
+private:
+    uint64_t granularity = 0;
+    uint32_t granularityShift = 0;
+    uint64_t capacityUnits = 0;
+    uint64_t usedUnits = 0;
+    uint32_t allocationCount = 0;
+
+    uint64_t flBitmap = 0;
+    uint32_t slBitmap[FL_COUNT] = {};
+    uint32_t heads[FL_COUNT][SL_COUNT];
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> spareNodes;
+};
@@ -0,0 +1,99 @@
+#include "transient_packer.h"
+
+#include <algorithm>
+#include <map>
+
+static uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static bool livesTogether(const TransientPacker::Request& a, const TransientPacker::Request& b) {
+    return a.firstPass <= b.lastPass && b.firstPass <= a.lastPass;
+}
+
+void TransientPacker::pack(const Request* requests, size_t count, Result& result) {
+    result.placements.assign(count, Placement());
+    result.heapSize = 0;
+    result.dedicatedSize = 0;
+    result.peakLiveSize = 0;
+
+    std::vector<uint32_t> order(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        order[i] = i;
+        result.dedicatedSize += alignUp(requests[i].size, requests[i].alignment);
+    }
+
+    // largest first, earlier first on ties -> deterministic layout for the same input
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        if (requests[a].size != requests[b].size) {
+            return requests[a].size > requests[b].size;
+        }
+        return requests[a].firstPass != requests[b].firstPass ? requests[a].firstPass < requests[b].firstPass : a < b;
+    });
+
+    std::vector<uint32_t> placed;
+    placed.reserve(count);
+    std::vector<std::pair<uint64_t, uint64_t>> taken; // [begin, end) of live neighbours
+
+    for (uint32_t index : order) {
+        const Request& request = requests[index];
+
+        taken.clear();
+        for (uint32_t other : placed) {
+            if (livesTogether(request, requests[other])) {
+                uint64_t begin = result.placements[other].offset;
+                taken.push_back({ begin, begin + requests[other].size });
+            }
+        }
+        std::sort(taken.begin(), taken.end());
+
+        // first gap that fits
+        uint64_t offset = 0;
+        for (const auto& [begin, end] : taken) {
+            if (offset + request.size <= begin) {
+                break;
+            }
+            offset = std::max(offset, alignUp(end, request.alignment));
+        }
+
+        result.placements[index].offset = offset;
+        result.heapSize = std::max(result.heapSize, offset + request.size);
+        placed.push_back(index);
+    }
+
+    // aliasing predecessor: an earlier resource sharing some of this one's memory.
+    // More than one -> which of them is still active there isn't tracked, the barrier names none.
+    // Only later ones -> the memory was last used by one of them in the previous frame.
+    for (uint32_t i = 0; i < count; ++i) {
+        const Request& request = requests[i];
+        uint64_t begin = result.placements[i].offset;
+        uint64_t end = begin + request.size;
+
+        uint32_t predecessor = NO_ALIAS;
+        bool shared = false;
+        for (uint32_t j = 0; j < count; ++j) {
+            const Request& other = requests[j];
+            uint64_t otherBegin = result.placements[j].offset;
+            if (j == i || otherBegin >= end || begin >= otherBegin + other.size || livesTogether(request, other)) {
+                continue;
+            }
+            shared = true;
+            if (other.lastPass < request.firstPass) {
+                predecessor = predecessor == NO_ALIAS ? j : ALIAS_ANY;
+            }
+        }
+        result.placements[i].aliasBefore = shared && predecessor == NO_ALIAS ? ALIAS_ANY : predecessor;
+    }
+
+    // bytes alive per pass
+    std::map<uint32_t, int64_t> delta;
+    for (size_t i = 0; i < count; ++i) {
+        delta[requests[i].firstPass] += static_cast<int64_t>(requests[i].size);
+        delta[requests[i].lastPass + 1] -= static_cast<int64_t>(requests[i].size);
+    }
+    int64_t live = 0;
+    for (const auto& [pass, change] : delta) {
+        live += change;
+        result.peakLiveSize = std::max(result.peakLiveSize, static_cast<uint64_t>(live));
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Memory layout for resources that only live during part of a frame.
+// Each resource lives from its first to its last pass (inclusive); resources whose lifetimes don't
+// overlap may share memory. Packing is greedy: largest first, each at the lowest aligned offset that
+// doesn't collide with an already placed resource it is alive together with. Pure bookkeeping ->
+// the caller creates the heap and the placed resources.
+class TransientPacker {
+public:
+    static constexpr uint32_t NO_ALIAS = ~0u;
+    static constexpr uint32_t ALIAS_ANY = ~0u - 1; // several predecessors -> the aliasing barrier names none
+
+    struct Request {
+        uint64_t size = 0;
+        uint64_t alignment = 1; // power of two
+        uint32_t firstPass = 0;
+        uint32_t lastPass = 0;
+    };
+
+    struct Placement {
+        uint64_t offset = 0;
+        // resource that used the memory before this one -> aliasing barrier at firstPass
+        uint32_t aliasBefore = NO_ALIAS;
+    };
+
+    struct Result {
+        std::vector<Placement> placements; // same order as the requests
+        uint64_t heapSize = 0;
+        uint64_t dedicatedSize = 0; // every request in its own allocation
+        uint64_t peakLiveSize = 0;  // most bytes alive in any one pass -> lower bound for heapSize
+
+        uint64_t getSavedBytes() const {
+            return dedicatedSize > heapSize ? dedicatedSize - heapSize : 0;
+        }
+    };
+
+    static void pack(const Request* requests, size_t count, Result& result);
+};
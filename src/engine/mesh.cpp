@@ -1,20 +1,78 @@
 #include "mesh.h"
+#include "upload_manager.h"
+#include "utils/logger.h"
+
+#include <stdexcept>
 
 Mesh::Mesh(
-    ComPtr<ID3D12Device2> device, 
+    RhiDevice* device, 
     const std::vector<VertexStruct>& vertices,
     const std::vector<uint32_t>& indices
-) {
+) :
+    range{ 0, 0, static_cast<uint32_t>(indices.size()), static_cast<uint32_t>(vertices.size()) }
+{
     LOG_INFO(L"MeshBuffer -> Creating vertex and index buffers...");
-    vertex = std::make_unique<VertexBuffer>(
-        device,
-        vertices
+    vertex = device->createVertexBuffer(
+        vertices.data(),
+        static_cast<uint32_t>(vertices.size()),
+        static_cast<uint32_t>(sizeof(VertexStruct))
     );
     
-    index = std::make_unique<IndexBuffer>(
-        device,
-        indices
+    index = device->createIndexBuffer(
+        indices.data(),
+        static_cast<uint32_t>(indices.size())
     );
 
     LOG_INFO(L"MeshBuffer -> Buffers created successfully.");
-}
\ No newline at end of file
+}
+
+Mesh::Mesh(
+    UploadManager* uploads,
+    const std::vector<VertexStruct>& vertices,
+    const std::vector<uint32_t>& indices
+) :
+    range{ 0, 0, static_cast<uint32_t>(indices.size()), static_cast<uint32_t>(vertices.size()) }
+{
+    LOG_INFO(L"MeshBuffer -> Uploading vertex and index buffers...");
+    vertex = uploads->createBuffer(
+        vertices.data(),
+        static_cast<uint32_t>(vertices.size()),
+        static_cast<uint32_t>(sizeof(VertexStruct)),
+        RhiResourceState::VertexAndConstantBuffer
+    );
+
+    index = uploads->createBuffer(
+        indices.data(),
+        static_cast<uint32_t>(indices.size()),
+        static_cast<uint32_t>(sizeof(uint32_t)),
+        RhiResourceState::IndexBuffer
+    );
+
+    LOG_INFO(L"MeshBuffer -> Uploads recorded.");
+}
+
+Mesh::Mesh(
+    GeometryBuffer* geometry,
+    const std::vector<VertexStruct>& vertices,
+    const std::vector<uint32_t>& indices
+) :
+    geometry(geometry)
+{
+    if (geometry->getVertexStride() != sizeof(VertexStruct)) {
+        LOG_ERROR(L"MeshBuffer -> Geometry buffer stride %u, VertexStruct is %u bytes", geometry->getVertexStride(), static_cast<uint32_t>(sizeof(VertexStruct)));
+        throw std::runtime_error("Vertex stride mismatch");
+    }
+
+    handle = geometry->add(
+        vertices.data(),
+        static_cast<uint32_t>(vertices.size()),
+        indices.data(),
+        static_cast<uint32_t>(indices.size())
+    );
+}
+
+Mesh::~Mesh() {
+    if (geometry) {
+        geometry->remove(handle);
+    }
+}
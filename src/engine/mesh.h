@@ -1,25 +1,89 @@
 #pragma once
 
-#include "buffer/vertex.h"
-#include "buffer/index.h"
+#include "rhi/rhi.h"
+#include "geometry_buffer.h"
+
+class UploadManager;
+
+struct alignas(16) VertexStruct {
+    float position[4];
+    float color[4];
+};
 
 class Mesh {
     public:
+        // dynamic path -> geometry stays in upload heap buffers
+        Mesh(
+            RhiDevice* device, 
+            const std::vector<VertexStruct>& vertices,
+            const std::vector<uint32_t>& indices
+        );
+
+        // static path -> DEFAULT-heap buffers filled through the copy queue,
+        // usable once the upload manager handed them off to the consumer queue
+        Mesh(
+            UploadManager* uploads,
+            const std::vector<VertexStruct>& vertices,
+            const std::vector<uint32_t>& indices
+        );
+
+        // shared path -> a range of the geometry megabuffer, drawable after geometry->commit().
+        // The range is freed on destruction -> retire the mesh by fence like any GPU object
         Mesh(
-            ComPtr<ID3D12Device2> device, 
+            GeometryBuffer* geometry,
             const std::vector<VertexStruct>& vertices,
             const std::vector<uint32_t>& indices
         );
-        ~Mesh() = default;
+        ~Mesh();
+
+        bool isShared() const {
+            return geometry != nullptr;
+        }
 
-        VertexBuffer* getVertex() const {
-            return vertex.get();
+        // the megabuffer's buffers for shared meshes
+        RhiBuffer* getVertex() const {
+            return geometry ? geometry->getVertexBuffer() : vertex.get();
         }   
-        IndexBuffer* getIndex() const {
-            return index.get();
+        RhiBuffer* getIndex() const {
+            return geometry ? geometry->getIndexBuffer() : index.get();
         }   
 
+        RhiVertexBufferView getVertexView() const {
+            if (geometry) {
+                return geometry->getVertexView();
+            }
+            return { vertex->getGPUAddress(), vertex->getSize(), vertex->getStride() };
+        }
+
+        RhiIndexBufferView getIndexView() const {
+            if (geometry) {
+                return geometry->getIndexView();
+            }
+            return { index->getGPUAddress(), index->getSize(), RhiFormat::R32Uint };
+        }
+
+        // draw arguments -> (indexCount, 0, 0) for meshes with their own buffers
+        MeshRange getRange() const {
+            return geometry ? geometry->getRange(handle) : range;
+        }
+
+        uint32_t getIndexCount() const {
+            return getRange().indexCount;
+        }
+
+        uint32_t getStartIndex() const {
+            return getRange().firstIndex;
+        }
+
+        int32_t getBaseVertex() const {
+            return getRange().baseVertex;
+        }
+
     private:
-        std::unique_ptr<VertexBuffer> vertex;
-        std::unique_ptr<IndexBuffer> index;
-};
\ No newline at end of file
+        std::unique_ptr<RhiBuffer> vertex;
+        std::unique_ptr<RhiBuffer> index;
+        MeshRange range;
+
+        GeometryBuffer* geometry = nullptr;
+        GeometryHandle handle;
+};
@@ -29,35 +29,7 @@ Pipeline::Pipeline(
     rootDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
 
 
-    ComPtr<ID3DBlob> serializedRootSig;
-    ComPtr<ID3DBlob> errorBlob;
-
-    HRESULT hr = D3D12SerializeRootSignature(
-        &rootDesc,
-        D3D_ROOT_SIGNATURE_VERSION_1,
-        &serializedRootSig,
-        &errorBlob
-    );
-
-    if (FAILED(hr)) {
-        if (errorBlob) {
-            OutputDebugStringA((char*)errorBlob->GetBufferPointer());
-            LOG_ERROR(L"Root signature serialization error: %S", (char*)errorBlob->GetBufferPointer());
-        } else {
-            LOG_ERROR(L"Failed to serialize root signature without error blob.");
-        }
-        throwFailed(hr);
-    }
-    LOG_INFO(L"Root signature serialized successfully.");
-
-    hr = device->CreateRootSignature(
-        0,
-        serializedRootSig->GetBufferPointer(),
-        serializedRootSig->GetBufferSize(),
-        IID_PPV_ARGS(&rootSignature)
-    );
-    throwFailed(hr);
-    LOG_INFO(L"Root signature created successfully.");
+    createRootSignature(device, rootDesc);
 
     // PSO description
     D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc = {};
@@ -115,7 +87,7 @@ Pipeline::Pipeline(
     LOG_INFO(L"Creating PSO with RTVFormat=%d, DSVFormat=%d, NumRenderTargets=%d", psoDesc.RTVFormats[0], psoDesc.DSVFormat, psoDesc.NumRenderTargets);
     LOG_INFO(L"RootSignature=%p, VS=%p, PS=%p", psoDesc.pRootSignature, psoDesc.VS.pShaderBytecode, psoDesc.PS.pShaderBytecode);
 
-    hr = device->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&pipelineState));
+    HRESULT hr = device->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&pipelineState));
     if (FAILED(hr)) {
         LOG_ERROR(L"CreateGraphicsPipelineState failed: HRESULT = 0x%08X", hr);
         std::cerr << "CreateGraphicsPipelineState failed. HRESULT = 0x"
@@ -130,3 +102,71 @@ Pipeline::Pipeline(
 
     LOG_INFO(L"Pipeline creation successful!");
 }
+
+Pipeline::Pipeline(
+    ComPtr<ID3D12Device2> device,
+    const Shader& computeShader,
+    const std::vector<D3D12_ROOT_PARAMETER>& rootParams
+) {
+    LOG_INFO(L"Starting compute Pipeline creation...");
+
+    if (!computeShader.getBytecode()) {
+        LOG_ERROR(L"Compute shader bytecode is null!");
+        return;
+    }
+
+    D3D12_ROOT_SIGNATURE_DESC rootDesc = {};
+    rootDesc.NumParameters = static_cast<UINT>(rootParams.size());
+    rootDesc.pParameters = rootParams.empty() ? nullptr : rootParams.data();
+    rootDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_NONE;
+
+    createRootSignature(device, rootDesc);
+
+    D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc = {};
+    psoDesc.pRootSignature = rootSignature.Get();
+    psoDesc.CS = {
+        computeShader.getBytecode()->GetBufferPointer(),
+        computeShader.getBytecode()->GetBufferSize()
+    };
+
+    HRESULT hr = device->CreateComputePipelineState(&psoDesc, IID_PPV_ARGS(&pipelineState));
+    if (FAILED(hr)) {
+        LOG_ERROR(L"CreateComputePipelineState failed: HRESULT = 0x%08X", hr);
+        LOG_D3D12_MESSAGES(device);
+        throwFailed(hr);
+    }
+
+    LOG_INFO(L"Compute pipeline creation successful!");
+}
+
+void Pipeline::createRootSignature(ComPtr<ID3D12Device2> device, const D3D12_ROOT_SIGNATURE_DESC& rootDesc) {
+    ComPtr<ID3DBlob> serializedRootSig;
+    ComPtr<ID3DBlob> errorBlob;
+
+    HRESULT hr = D3D12SerializeRootSignature(
+        &rootDesc,
+        D3D_ROOT_SIGNATURE_VERSION_1,
+        &serializedRootSig,
+        &errorBlob
+    );
+
+    if (FAILED(hr)) {
+        if (errorBlob) {
+            OutputDebugStringA((char*)errorBlob->GetBufferPointer());
+            LOG_ERROR(L"Root signature serialization error: %S", (char*)errorBlob->GetBufferPointer());
+        } else {
+            LOG_ERROR(L"Failed to serialize root signature without error blob.");
+        }
+        throwFailed(hr);
+    }
+    LOG_INFO(L"Root signature serialized successfully.");
+
+    hr = device->CreateRootSignature(
+        0,
+        serializedRootSig->GetBufferPointer(),
+        serializedRootSig->GetBufferSize(),
+        IID_PPV_ARGS(&rootSignature)
+    );
+    throwFailed(hr);
+    LOG_INFO(L"Root signature created successfully.");
+}
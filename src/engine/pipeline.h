@@ -2,8 +2,9 @@
 
 #include "utils/pch.h"
 #include "shader.h"
+#include "rhi/rhi.h"
 
-class Pipeline {
+class Pipeline : public RhiPipeline {
     public:
         Pipeline(
             ComPtr<ID3D12Device2> device,
@@ -16,7 +17,14 @@ class Pipeline {
             DXGI_FORMAT dsvFormat = DXGI_FORMAT_D24_UNORM_S8_UINT
         );
 
-        ~Pipeline() = default;
+        // compute -> no input layout / render targets
+        Pipeline(
+            ComPtr<ID3D12Device2> device,
+            const Shader& computeShader,
+            const std::vector<D3D12_ROOT_PARAMETER>& rootParams = {}
+        );
+
+        ~Pipeline() override = default;
 
         ComPtr<ID3D12PipelineState> getPipelineState() const { 
             return pipelineState; 
@@ -26,6 +34,9 @@ class Pipeline {
             return rootSignature; 
         }
 
+    private:
+        void createRootSignature(ComPtr<ID3D12Device2> device, const D3D12_ROOT_SIGNATURE_DESC& rootDesc);
+
     private:
         ComPtr<ID3D12PipelineState> pipelineState;
         ComPtr<ID3D12RootSignature> rootSignature;
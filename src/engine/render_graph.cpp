@@ -0,0 +1,563 @@
+#include "render_graph.h"
+#include "transient_resource_pool.h"
+#include "job_system.h"
+#include "rhi/rhi_command_queue.h"
+#include "utils/logger.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+RenderGraphResource RenderGraphBuilder::createTexture(const RhiTextureDesc& desc) {
+    RenderGraphResource handle;
+    auto& resource = graph->addResource(handle);
+    resource.isTexture = true;
+    resource.texture = desc;
+    return handle;
+}
+
+RenderGraphResource RenderGraphBuilder::createBuffer(const RhiBufferDesc& desc) {
+    RenderGraphResource handle;
+    auto& resource = graph->addResource(handle);
+    resource.buffer = desc;
+    return handle;
+}
+
+void RenderGraphBuilder::read(RenderGraphResource resource, RhiResourceState state) {
+    graph->addAccess(pass, resource, state, false);
+}
+
+void RenderGraphBuilder::write(RenderGraphResource resource, RhiResourceState state) {
+    graph->addAccess(pass, resource, state, true);
+}
+
+void RenderGraphBuilder::setSideEffect() {
+    graph->passes[pass].sideEffect = true;
+}
+
+void RenderGraphBuilder::setChunks(uint32_t count) {
+    graph->passes[pass].chunks = std::max(count, 1u);
+}
+
+RhiResourceHandle RenderGraphContext::getHandle(RenderGraphResource resource) const {
+    return graph->getHandle(resource);
+}
+
+RhiTexture* RenderGraphContext::getTexture(RenderGraphResource resource) const {
+    return graph->getTexture(resource);
+}
+
+RhiBuffer* RenderGraphContext::getBuffer(RenderGraphResource resource) const {
+    return graph->getBuffer(resource);
+}
+
+RenderGraph::RenderGraph(
+    RhiCommandQueue* graphicsQueue,
+    RhiCommandQueue* computeQueue,
+    ResourceStateRegistry* registry,
+    TransientResourcePool* pool
+) :
+    graphicsQueue(graphicsQueue),
+    computeQueue(computeQueue),
+    registry(registry),
+    pool(pool)
+{
+}
+
+void RenderGraph::setJobSystem(JobSystem* jobs) {
+    this->jobs = jobs;
+}
+
+void RenderGraph::reset() {
+    passes.clear();
+    accesses.clear();
+    edges.clear();
+    order.clear();
+    resourceCount = 0;
+    batchCount = 0;
+    stats = RenderGraphStats();
+}
+
+RenderGraph::Resource& RenderGraph::addResource(RenderGraphResource& handle) {
+    if (resourceCount == resources.size()) {
+        resources.emplace_back();
+    }
+    handle.index = resourceCount++;
+
+    // reused slot -> keep the reader list's capacity
+    Resource& resource = resources[handle.index];
+    std::vector<uint32_t> readers = std::move(resource.readers);
+    resource = Resource();
+    resource.readers = std::move(readers);
+    resource.readers.clear();
+    return resource;
+}
+
+RenderGraphResource RenderGraph::importResource(RhiResourceHandle handle, RhiResourceState finalState) {
+    RenderGraphResource result;
+    Resource& resource = addResource(result);
+    resource.imported = true;
+    resource.handle = handle;
+    resource.finalState = finalState;
+    return result;
+}
+
+uint32_t RenderGraph::beginPass(const char* name, RenderGraphQueue queue, ExecuteCallback execute) {
+    Pass pass;
+    pass.name = name;
+    pass.queue = queue;
+    pass.execute = std::move(execute);
+    pass.accessBegin = static_cast<uint32_t>(accesses.size());
+    pass.accessEnd = pass.accessBegin;
+    passes.push_back(std::move(pass));
+    return static_cast<uint32_t>(passes.size() - 1);
+}
+
+void RenderGraph::addAccess(uint32_t pass, RenderGraphResource resource, RhiResourceState state, bool write) {
+    if (resource.index >= resourceCount) {
+        LOG_ERROR(L"RenderGraph -> Pass %u uses an undeclared resource", pass);
+        throw std::runtime_error("Invalid render graph resource");
+    }
+
+    Pass& entry = passes[pass];
+    for (uint32_t i = entry.accessBegin; i < entry.accessEnd; ++i) {
+        Access& access = accesses[i];
+        if (access.resource != resource.index) {
+            continue;
+        }
+        if (write) {
+            access.state = state;
+            access.write = true;
+        } else {
+            if (!access.write) {
+                access.state = access.state | state;
+            }
+            access.read = true;
+        }
+        return;
+    }
+
+    accesses.push_back({ resource.index, state, !write, write });
+    entry.accessEnd++;
+}
+
+void RenderGraph::compile() {
+    stats.passes = static_cast<uint32_t>(passes.size());
+
+    buildEdges();
+    cull();
+    schedule();
+    placeTransients();
+}
+
+// Dependencies in declaration order: read after write, write after read, write after write.
+// A pass only sees resources declared before it -> every edge points backwards.
+void RenderGraph::buildEdges() {
+    for (uint32_t i = 0; i < resourceCount; ++i) {
+        resources[i].lastWriter = NONE;
+        resources[i].readers.clear();
+    }
+
+    for (uint32_t index = 0; index < passes.size(); ++index) {
+        Pass& pass = passes[index];
+        pass.edgeBegin = static_cast<uint32_t>(edges.size());
+
+        for (uint32_t i = pass.accessBegin; i < pass.accessEnd; ++i) {
+            const Access& access = accesses[i];
+            Resource& resource = resources[access.resource];
+
+            // write-only -> the previous content is overwritten, its producer only has to run first
+            if (resource.lastWriter != NONE) {
+                edges.push_back({ resource.lastWriter, access.read });
+            }
+            if (access.write) {
+                for (uint32_t reader : resource.readers) {
+                    if (reader != index) {
+                        edges.push_back({ reader, false });
+                    }
+                }
+                resource.readers.clear();
+                resource.lastWriter = index;
+            } else {
+                resource.readers.push_back(index);
+            }
+        }
+
+        pass.edgeEnd = static_cast<uint32_t>(edges.size());
+    }
+}
+
+// Backwards from the passes with visible results (side effects, writes to imported resources):
+// a live pass keeps alive whatever produced the data it reads.
+void RenderGraph::cull() {
+    for (auto& pass : passes) {
+        pass.live = pass.sideEffect;
+        for (uint32_t i = pass.accessBegin; i < pass.accessEnd && !pass.live; ++i) {
+            pass.live = accesses[i].write && resources[accesses[i].resource].imported;
+        }
+    }
+
+    for (size_t index = passes.size(); index-- > 0;) {
+        const Pass& pass = passes[index];
+        if (!pass.live) {
+            continue;
+        }
+        for (uint32_t i = pass.edgeBegin; i < pass.edgeEnd; ++i) {
+            if (edges[i].readAfterWrite) {
+                passes[edges[i].from].live = true;
+            }
+        }
+    }
+
+    stats.culledPasses = 0;
+    for (const auto& pass : passes) {
+        stats.culledPasses += pass.live ? 0 : 1;
+    }
+}
+
+// Order = dependency level (longest chain of live predecessors), then queue, then declaration.
+// Independent passes end up next to each other -> fewer queue switches, longer runs per list.
+void RenderGraph::schedule() {
+    uint32_t maxLevel = 0;
+    for (auto& pass : passes) {
+        if (!computeQueue) {
+            pass.queue = RenderGraphQueue::Graphics;
+        }
+        pass.level = 0;
+        if (!pass.live) {
+            continue;
+        }
+        for (uint32_t i = pass.edgeBegin; i < pass.edgeEnd; ++i) {
+            const Pass& from = passes[edges[i].from];
+            if (from.live) {
+                pass.level = std::max(pass.level, from.level + 1);
+            }
+        }
+        maxLevel = std::max(maxLevel, pass.level);
+    }
+
+    // counting sort by (level, queue); stable -> declaration order inside a bucket
+    levelCounts.assign((maxLevel + 1) * 2 + 1, 0);
+    for (const auto& pass : passes) {
+        if (pass.live) {
+            levelCounts[pass.level * 2 + static_cast<uint32_t>(pass.queue) + 1]++;
+        }
+    }
+    for (size_t i = 1; i < levelCounts.size(); ++i) {
+        levelCounts[i] += levelCounts[i - 1];
+    }
+    order.resize(levelCounts.back());
+    for (uint32_t index = 0; index < passes.size(); ++index) {
+        const Pass& pass = passes[index];
+        if (pass.live) {
+            order[levelCounts[pass.level * 2 + static_cast<uint32_t>(pass.queue)]++] = index;
+        }
+    }
+
+    // one batch per run on the same queue
+    batchCount = 0;
+    auto addBatch = [&](RenderGraphQueue queue, uint32_t position) -> Batch& {
+        if (batchCount == batches.size()) {
+            batches.emplace_back();
+        }
+        Batch& batch = batches[batchCount++];
+        batch.queue = queue;
+        batch.orderBegin = position;
+        batch.orderEnd = position;
+        batch.waitBatch = NONE;
+        batch.unitBegin = 0;
+        batch.unitEnd = 0;
+        batch.done = {};
+        return batch;
+    };
+
+    for (uint32_t position = 0; position < order.size(); ++position) {
+        Pass& pass = passes[order[position]];
+        if (batchCount == 0 || batches[batchCount - 1].queue != pass.queue) {
+            addBatch(pass.queue, position);
+        }
+        Batch& batch = batches[batchCount - 1];
+        batch.orderEnd = position + 1;
+        pass.batch = batchCount - 1;
+
+        for (uint32_t i = pass.edgeBegin; i < pass.edgeEnd; ++i) {
+            const Pass& from = passes[edges[i].from];
+            if (from.live && from.queue != pass.queue) {
+                batch.waitBatch = batch.waitBatch == NONE ? from.batch : std::max(batch.waitBatch, from.batch);
+            }
+        }
+    }
+
+    // the frame ends on graphics: final states (present) and a wait for the last compute batch
+    uint32_t lastCompute = NONE;
+    for (uint32_t i = 0; i < batchCount; ++i) {
+        if (batches[i].queue == RenderGraphQueue::Compute) {
+            lastCompute = i;
+        }
+    }
+    if (batchCount == 0 || batches[batchCount - 1].queue != RenderGraphQueue::Graphics) {
+        addBatch(RenderGraphQueue::Graphics, static_cast<uint32_t>(order.size()));
+    }
+    if (lastCompute != NONE) {
+        Batch& last = batches[batchCount - 1];
+        last.waitBatch = last.waitBatch == NONE ? lastCompute : std::max(last.waitBatch, lastCompute);
+    }
+
+    stats.batches = batchCount;
+    stats.crossQueueWaits = 0;
+    for (uint32_t i = 0; i < batchCount; ++i) {
+        stats.crossQueueWaits += batches[i].waitBatch != NONE ? 1 : 0;
+    }
+}
+
+// Lifetimes in execution positions -> the pool aliases transients that are never alive together.
+// With async compute the queues overlap on the GPU, so anything a compute pass touches is kept
+// out of aliasing (alive for the whole frame).
+void RenderGraph::placeTransients() {
+    for (uint32_t i = 0; i < resourceCount; ++i) {
+        resources[i].firstUse = NONE;
+        resources[i].lastUse = 0;
+        resources[i].usedOnCompute = false;
+        resources[i].poolId = NONE;
+    }
+
+    for (uint32_t position = 0; position < order.size(); ++position) {
+        const Pass& pass = passes[order[position]];
+        for (uint32_t i = pass.accessBegin; i < pass.accessEnd; ++i) {
+            Resource& resource = resources[accesses[i].resource];
+            resource.firstUse = std::min(resource.firstUse, position);
+            resource.lastUse = std::max(resource.lastUse, position);
+            resource.usedOnCompute |= pass.queue == RenderGraphQueue::Compute;
+        }
+    }
+
+    if (!pool) {
+        return;
+    }
+
+    uint32_t lastPosition = order.empty() ? 0 : static_cast<uint32_t>(order.size() - 1);
+    pool->reset();
+    for (uint32_t i = 0; i < resourceCount; ++i) {
+        Resource& resource = resources[i];
+        if (resource.imported || resource.firstUse == NONE) {
+            continue; // culled with its passes -> no memory at all
+        }
+        uint32_t first = resource.usedOnCompute ? 0 : resource.firstUse;
+        uint32_t last = resource.usedOnCompute ? lastPosition : resource.lastUse;
+        resource.poolId = resource.isTexture
+            ? pool->declareTexture(resource.texture, first, last)
+            : pool->declareBuffer(resource.buffer, first, last);
+    }
+    pool->compile();
+}
+
+RhiCommandQueue* RenderGraph::getQueue(RenderGraphQueue queue) const {
+    return queue == RenderGraphQueue::Compute ? computeQueue : graphicsQueue;
+}
+
+// Serial half of recording: walks the batches in order, feeds the trackers and keeps the barriers
+// each pass needs in front of it. Also cuts the batches into units (command lists).
+// A transition whose consumer runs more than one pass after the producer is split: BEGIN right
+// after the producer, END in front of the consumer -> the GPU overlaps it with the passes between.
+// Both halves must be in one command list, so splits only happen within a unit.
+void RenderGraph::deriveBarriers() {
+    items.clear();
+    units.clear();
+    recordedBarriers.clear();
+
+    auto addUnit = [&](uint32_t batch) {
+        Unit unit;
+        unit.batch = batch;
+        unit.itemBegin = static_cast<uint32_t>(items.size());
+        unit.itemEnd = unit.itemBegin;
+        units.push_back(unit);
+    };
+
+    for (uint32_t b = 0; b < batchCount; ++b) {
+        Batch& batch = batches[b];
+        batch.unitBegin = static_cast<uint32_t>(units.size());
+        addUnit(b); // even an empty batch needs a list for its final barriers
+
+        // with a job system every pass chunk is a list of its own -> nothing to split across
+        if (!jobs) {
+            followingAccess.assign(resourceCount, NONE);
+            for (uint32_t position = batch.orderEnd; position-- > batch.orderBegin;) {
+                const Pass& pass = passes[order[position]];
+                for (uint32_t i = pass.accessBegin; i < pass.accessEnd; ++i) {
+                    accesses[i].nextUse = followingAccess[accesses[i].resource];
+                }
+                for (uint32_t i = pass.accessBegin; i < pass.accessEnd; ++i) {
+                    followingAccess[accesses[i].resource] = i;
+                }
+            }
+        }
+
+        for (uint32_t position = batch.orderBegin; position < batch.orderEnd; ++position) {
+            uint32_t index = order[position];
+            const Pass& pass = passes[index];
+
+            if (pool) {
+                pool->aliasResources(position, batch.tracker);
+            }
+
+            // the previous pass produced it, a later one than this consumes it -> begin the transition now
+            if (!jobs && position > batch.orderBegin) {
+                const Pass& producer = passes[order[position - 1]];
+                for (uint32_t i = producer.accessBegin; i < producer.accessEnd; ++i) {
+                    uint32_t next = accesses[i].nextUse;
+                    if (next != NONE && (next < pass.accessBegin || next >= pass.accessEnd)) {
+                        batch.tracker.beginTransition(getHandle({ accesses[i].resource }), accesses[next].state);
+                    }
+                }
+            }
+            for (uint32_t i = pass.accessBegin; i < pass.accessEnd; ++i) {
+                batch.tracker.transition(getHandle({ accesses[i].resource }), accesses[i].state);
+            }
+            uint32_t barrierBegin = static_cast<uint32_t>(recordedBarriers.size());
+            batch.tracker.flush(recordedBarriers);
+            uint32_t barrierEnd = static_cast<uint32_t>(recordedBarriers.size());
+
+            for (uint32_t chunk = 0; chunk < pass.chunks; ++chunk) {
+                // parallel -> every chunk on its own list; the barriers go with the first one,
+                // which the GPU runs before the others
+                if (jobs && units.back().itemEnd != units.back().itemBegin) {
+                    addUnit(b);
+                }
+                Item item;
+                item.pass = index;
+                item.chunk = chunk;
+                item.barrierBegin = chunk == 0 ? barrierBegin : barrierEnd;
+                item.barrierEnd = barrierEnd;
+                items.push_back(item);
+                units.back().itemEnd++;
+            }
+        }
+
+        // last batch -> imported resources go where the owner expects them
+        if (b == batchCount - 1) {
+            for (uint32_t i = 0; i < resourceCount; ++i) {
+                if (resources[i].imported && resources[i].firstUse != NONE) {
+                    batch.tracker.transition(resources[i].handle, resources[i].finalState);
+                }
+            }
+        }
+        Unit& last = units.back();
+        last.finalBegin = static_cast<uint32_t>(recordedBarriers.size());
+        batch.tracker.finish(recordedBarriers);
+        last.finalEnd = static_cast<uint32_t>(recordedBarriers.size());
+        batch.unitEnd = static_cast<uint32_t>(units.size());
+
+        stats.barriers += batch.tracker.getBarrierCount();
+        stats.barrierCalls += batch.tracker.getBarrierCallCount();
+        stats.splitBarriers += batch.tracker.getSplitBarrierCount();
+    }
+
+    stats.commandLists = static_cast<uint32_t>(units.size());
+}
+
+void RenderGraph::recordUnit(Unit& unit, uint32_t thread) {
+    RenderGraphQueue queue = batches[unit.batch].queue;
+    unit.list = jobs
+        ? recordingContexts[static_cast<uint32_t>(queue)][thread]->getCommandList()
+        : getQueue(queue)->getCommandList();
+
+    for (uint32_t i = unit.itemBegin; i < unit.itemEnd; ++i) {
+        const Item& item = items[i];
+        if (item.barrierEnd != item.barrierBegin) {
+            unit.list->transitionResources(&recordedBarriers[item.barrierBegin], item.barrierEnd - item.barrierBegin);
+        }
+
+        const Pass& pass = passes[item.pass];
+        RenderGraphContext context(this, unit.list, item.chunk, pass.chunks);
+        pass.execute(context);
+    }
+
+    if (unit.finalEnd != unit.finalBegin) {
+        unit.list->transitionResources(&recordedBarriers[unit.finalBegin], unit.finalEnd - unit.finalBegin);
+    }
+}
+
+void RenderGraph::record() {
+    deriveBarriers();
+
+    if (!jobs) {
+        for (auto& unit : units) {
+            recordUnit(unit, 0);
+        }
+        return;
+    }
+
+    // one recording context per thread and queue -> list acquisition never contends
+    uint32_t threads = jobs->getThreadCount();
+    for (RenderGraphQueue queue : { RenderGraphQueue::Graphics, RenderGraphQueue::Compute }) {
+        RhiCommandQueue* commandQueue = getQueue(queue);
+        auto& contexts = recordingContexts[static_cast<uint32_t>(queue)];
+        while (commandQueue && contexts.size() < threads) {
+            contexts.push_back(commandQueue->createRecordingContext());
+        }
+    }
+
+    // a unit is a whole pass (chunk) -> one per job
+    jobs->parallelFor(static_cast<uint32_t>(units.size()), [this](uint32_t begin, uint32_t end) {
+        uint32_t thread = jobs->getCurrentThread();
+        for (uint32_t i = begin; i < end; ++i) {
+            recordUnit(units[i], thread);
+        }
+    }, 1);
+}
+
+uint64_t RenderGraph::submit(const std::vector<RhiSyncPoint>& dependencies) {
+    uint64_t fenceValue = 0;
+    bool firstGraphics = true;
+    std::vector<RhiSyncPoint> waits;
+
+    for (uint32_t b = 0; b < batchCount; ++b) {
+        Batch& batch = batches[b];
+        RhiCommandQueue* queue = getQueue(batch.queue);
+
+        waits.clear();
+        if (batch.queue == RenderGraphQueue::Graphics && firstGraphics) {
+            waits = dependencies;
+            firstGraphics = false;
+        }
+        if (batch.waitBatch != NONE) {
+            waits.push_back(batches[batch.waitBatch].done);
+        }
+
+        // the batch tracker describes all of its lists: first uses resolve in front of the first,
+        // final states are published for the submission as a whole
+        submitLists.clear();
+        submitTrackers.clear();
+        for (uint32_t u = batch.unitBegin; u < batch.unitEnd; ++u) {
+            submitLists.push_back(units[u].list);
+            submitTrackers.push_back(u == batch.unitBegin ? &batch.tracker : &emptyTracker);
+            units[u].list = nullptr;
+        }
+
+        fenceValue = registry->execute(queue, submitLists.data(), submitTrackers.data(), submitLists.size(), waits);
+        batch.done = queue->getSyncPoint(fenceValue);
+    }
+
+    return fenceValue;
+}
+
+RhiResourceHandle RenderGraph::getHandle(RenderGraphResource resource) const {
+    const Resource& entry = resources[resource.index];
+    if (entry.imported) {
+        return entry.handle;
+    }
+    if (entry.poolId == NONE) {
+        LOG_ERROR(L"RenderGraph -> Transient resource has no memory (culled or no pool)");
+        throw std::runtime_error("Unplaced render graph resource");
+    }
+    return pool->getHandle(entry.poolId);
+}
+
+RhiTexture* RenderGraph::getTexture(RenderGraphResource resource) const {
+    const Resource& entry = resources[resource.index];
+    return entry.poolId == NONE ? nullptr : pool->getTexture(entry.poolId);
+}
+
+RhiBuffer* RenderGraph::getBuffer(RenderGraphResource resource) const {
+    const Resource& entry = resources[resource.index];
+    return entry.poolId == NONE ? nullptr : pool->getBuffer(entry.poolId);
+}
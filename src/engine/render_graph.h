@@ -0,0 +1,289 @@
+#pragma once
+
+#include "rhi/rhi.h"
+#include "resource_state_tracker.h"
+#include <functional>
+#include <vector>
+
+class RhiCommandQueue;
+class RhiRecordingContext;
+class TransientResourcePool;
+class JobSystem;
+class RenderGraph;
+
+enum class RenderGraphQueue : uint32_t {
+    Graphics = 0,
+    Compute = 1
+};
+
+struct RenderGraphResource {
+    static constexpr uint32_t INVALID = ~0u;
+
+    uint32_t index = INVALID;
+
+    bool isValid() const {
+        return index != INVALID;
+    }
+};
+
+// Handed to a pass's setup callback -> declares what the pass touches
+class RenderGraphBuilder {
+    public:
+        // Transient -> placed in the pool for exactly the passes that use it
+        RenderGraphResource createTexture(const RhiTextureDesc& desc);
+        RenderGraphResource createBuffer(const RhiBufferDesc& desc);
+
+        // Reading and writing the same resource in one pass keeps the write state;
+        // several reads combine their (read-only) states
+        void read(RenderGraphResource resource, RhiResourceState state = RhiResourceState::PixelShaderResource);
+        void write(RenderGraphResource resource, RhiResourceState state = RhiResourceState::RenderTarget);
+
+        // Never culled, even when nothing reads its output (readbacks, debug captures)
+        void setSideEffect();
+
+        // execute runs count times (RenderGraphContext::getChunk). With a job system every chunk
+        // records its own command list on whichever thread is free -> big passes split across threads
+        void setChunks(uint32_t count);
+
+    private:
+        friend class RenderGraph;
+
+        RenderGraphBuilder(RenderGraph* graph, uint32_t pass) : graph(graph), pass(pass) {}
+
+        RenderGraph* graph = nullptr;
+        uint32_t pass = 0;
+};
+
+// Handed to a pass's execute callback; the pass's resources are already in their declared states
+class RenderGraphContext {
+    public:
+        RhiCommandList* getCommandList() const {
+            return list;
+        }
+
+        // which part of the pass to record, in [0, getChunkCount()); each chunk starts on a fresh list state
+        uint32_t getChunk() const {
+            return chunk;
+        }
+
+        uint32_t getChunkCount() const {
+            return chunkCount;
+        }
+
+        RhiResourceHandle getHandle(RenderGraphResource resource) const;
+        RhiTexture* getTexture(RenderGraphResource resource) const;
+        RhiBuffer* getBuffer(RenderGraphResource resource) const;
+
+    private:
+        friend class RenderGraph;
+
+        RenderGraphContext(const RenderGraph* graph, RhiCommandList* list, uint32_t chunk, uint32_t chunkCount) :
+            graph(graph), list(list), chunk(chunk), chunkCount(chunkCount) {}
+
+        const RenderGraph* graph = nullptr;
+        RhiCommandList* list = nullptr;
+        uint32_t chunk = 0;
+        uint32_t chunkCount = 1;
+};
+
+struct RenderGraphStats {
+    uint32_t passes = 0;
+    uint32_t culledPasses = 0;
+    uint32_t batches = 0;         // runs of passes on the same queue, one submission each
+    uint32_t commandLists = 0;    // one per batch when recording serially, one per pass chunk with a job system
+    uint32_t crossQueueWaits = 0; // GPU waits between the graphics and compute batches
+    uint64_t barriers = 0;
+    uint64_t barrierCalls = 0;
+    uint64_t splitBarriers = 0;   // BEGIN halves; their END lands in front of the consumer
+};
+
+// Frame described as passes that declare their reads and writes instead of a hand-written
+// sequence of barriers. Rebuilt every frame:
+//   reset -> addPass... -> compile -> record -> submit
+// compile culls passes whose outputs nobody reads, orders the rest by dependency level,
+// assigns queues (compute passes run on the compute queue when there is one), splits them
+// into one command list per run on the same queue and places the transient resources.
+// record runs the pass callbacks with the barriers derived from the declarations (in parallel
+// with a worker pool); submit executes the lists in order with the cross-queue waits.
+// Passes reference resources declared before them -> declaration order is always a valid order.
+class RenderGraph {
+    public:
+        using ExecuteCallback = std::function<void(RenderGraphContext&)>;
+
+        // computeQueue / pool may be null: everything on graphics / no transient resources
+        RenderGraph(
+            RhiCommandQueue* graphicsQueue,
+            RhiCommandQueue* computeQueue,
+            ResourceStateRegistry* registry,
+            TransientResourcePool* pool
+        );
+
+        void reset();
+
+        // record runs passes as jobs, one command list per pass chunk (a caller outside the
+        // system's threads only waits for them). Barriers are still derived serially first, so
+        // the result matches serial recording. null -> everything on the calling thread, one list per batch
+        void setJobSystem(JobSystem* jobs);
+
+        // Resource owned elsewhere (back buffer, persistent targets); its state comes from the registry.
+        // Writing it keeps the pass alive; the graph leaves it in finalState.
+        RenderGraphResource importResource(RhiResourceHandle handle, RhiResourceState finalState);
+
+        template <typename Setup>
+        void addPass(const char* name, RenderGraphQueue queue, Setup&& setup, ExecuteCallback execute) {
+            uint32_t index = beginPass(name, queue, std::move(execute));
+            RenderGraphBuilder builder(this, index);
+            setup(builder);
+        }
+
+        void compile();
+
+        // Records every batch; call before submit (residency updates go in between).
+        // With a job system, execute callbacks run concurrently -> they may only touch their own list
+        void record();
+
+        // dependencies -> the first graphics batch waits for them.
+        // Returns the fence value of the last graphics batch, which waits for everything else.
+        uint64_t submit(const std::vector<RhiSyncPoint>& dependencies = {});
+
+        const RenderGraphStats& getStats() const {
+            return stats;
+        }
+
+        // live passes (declaration indices) in execution order
+        const std::vector<uint32_t>& getExecutionOrder() const {
+            return order;
+        }
+
+        bool isCulled(uint32_t pass) const {
+            return !passes[pass].live;
+        }
+
+        // queue the pass runs on (after compile)
+        RenderGraphQueue getPassQueue(uint32_t pass) const {
+            return passes[pass].queue;
+        }
+
+        RhiResourceHandle getHandle(RenderGraphResource resource) const;
+        RhiTexture* getTexture(RenderGraphResource resource) const;
+        RhiBuffer* getBuffer(RenderGraphResource resource) const;
+
+    private:
+        friend class RenderGraphBuilder;
+
+        static constexpr uint32_t NONE = ~0u;
+
+        struct Access {
+            uint32_t resource = 0;
+            RhiResourceState state = RhiResourceState::Common;
+            bool read = false;
+            bool write = false;
+            uint32_t nextUse = NONE;  // the resource's next access in the same batch (deriveBarriers)
+        };
+
+        struct Pass {
+            const char* name = nullptr;
+            RenderGraphQueue queue = RenderGraphQueue::Graphics;
+            ExecuteCallback execute;
+            uint32_t accessBegin = 0; // accesses of a pass are contiguous (declared during its setup)
+            uint32_t accessEnd = 0;
+            uint32_t edgeBegin = 0;   // edges into this pass, also contiguous
+            uint32_t edgeEnd = 0;
+            uint32_t level = 0;
+            uint32_t batch = NONE;
+            uint32_t chunks = 1;
+            bool sideEffect = false;
+            bool live = false;
+        };
+
+        struct Resource {
+            bool imported = false;
+            bool isTexture = false;
+            RhiTextureDesc texture;
+            RhiBufferDesc buffer;
+            RhiResourceHandle handle;         // imported
+            RhiResourceState finalState = RhiResourceState::Common;
+            uint32_t poolId = NONE;           // transient
+            uint32_t firstUse = NONE;         // execution positions, live passes only
+            uint32_t lastUse = 0;
+            bool usedOnCompute = false;
+            uint32_t lastWriter = NONE;       // while building edges
+            std::vector<uint32_t> readers;    // since lastWriter
+        };
+
+        struct Edge {
+            uint32_t from = 0;
+            bool readAfterWrite = false;      // from produces data this pass reads -> keeps from alive
+        };
+
+        struct Batch {
+            RenderGraphQueue queue = RenderGraphQueue::Graphics;
+            uint32_t orderBegin = 0;
+            uint32_t orderEnd = 0;
+            uint32_t waitBatch = NONE;        // latest batch on the other queue this one depends on
+            uint32_t unitBegin = 0;
+            uint32_t unitEnd = 0;
+            ResourceStateTracker tracker;
+            RhiSyncPoint done;
+        };
+
+        // One execute call, after the barriers the tracker derived in front of it
+        struct Item {
+            uint32_t pass = 0;
+            uint32_t chunk = 0;
+            uint32_t barrierBegin = 0;        // into recordedBarriers
+            uint32_t barrierEnd = 0;
+        };
+
+        // Items recorded into one command list by one thread; the batch's last unit also carries
+        // the barriers that end the batch
+        struct Unit {
+            uint32_t batch = 0;
+            uint32_t itemBegin = 0;
+            uint32_t itemEnd = 0;
+            uint32_t finalBegin = 0;
+            uint32_t finalEnd = 0;
+            RhiCommandList* list = nullptr;
+        };
+
+        uint32_t beginPass(const char* name, RenderGraphQueue queue, ExecuteCallback execute);
+        Resource& addResource(RenderGraphResource& handle);
+        void addAccess(uint32_t pass, RenderGraphResource resource, RhiResourceState state, bool write);
+
+        void buildEdges();
+        void cull();
+        void schedule();
+        void placeTransients();
+
+        void deriveBarriers();
+        void recordUnit(Unit& unit, uint32_t thread);
+
+        RhiCommandQueue* getQueue(RenderGraphQueue queue) const;
+
+    private:
+        RhiCommandQueue* graphicsQueue = nullptr;
+        RhiCommandQueue* computeQueue = nullptr;
+        ResourceStateRegistry* registry = nullptr;
+        TransientResourcePool* pool = nullptr;
+        JobSystem* jobs = nullptr;
+        std::vector<RhiRecordingContext*> recordingContexts[2]; // per queue, one per job system thread
+
+        std::vector<Pass> passes;
+        std::vector<Resource> resources; // kept across frames (reader lists keep their capacity)
+        uint32_t resourceCount = 0;
+        std::vector<Access> accesses;
+        std::vector<Edge> edges;
+        std::vector<uint32_t> order;
+        std::vector<uint32_t> levelCounts;
+        std::vector<Batch> batches;
+        uint32_t batchCount = 0; // batches keeps its trackers across frames -> only the first batchCount are used
+        std::vector<Item> items;
+        std::vector<Unit> units;
+        std::vector<RhiResourceBarrier> recordedBarriers;
+        std::vector<uint32_t> followingAccess; // per resource, while looking ahead for split barriers
+        std::vector<RhiCommandList*> submitLists;
+        std::vector<ResourceStateTracker*> submitTrackers;
+        ResourceStateTracker emptyTracker; // lists after a batch's first one: their barriers are in the batch tracker
+
+        RenderGraphStats stats;
+};
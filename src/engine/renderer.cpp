@@ -0,0 +1,479 @@
+#include "renderer.h"
+#include "mesh.h"
+#include "upload_manager.h"
+#include "frame_upload_allocator.h"
+#include "bindless_heap.h"
+#include "rhi/rhi_fence_waiter.h"
+#include "rhi/rhi_deferred_release.h"
+#include "residency_manager.h"
+#include "transient_resource_pool.h"
+#include "draw_list.h"
+#include "utils/logger.h"
+
+#include <stdexcept>
+
+Renderer::Renderer(
+    RhiDevice* device,
+    const RendererConfig& config
+) :
+    device(device),
+    config(config)
+{
+    LOG_INFO(L"Renderer -> Initializing...");
+
+    if (config.framesInFlight < 1 || config.framesInFlight > MAX_FRAMES_IN_FLIGHT) {
+        LOG_ERROR(L"Renderer -> framesInFlight must be 1 - %u (got %u)", MAX_FRAMES_IN_FLIGHT, config.framesInFlight);
+        throw std::runtime_error("Invalid frames in flight");
+    }
+
+    scissorRect = { 0, 0, static_cast<int32_t>(config.width), static_cast<int32_t>(config.height) };
+    viewport = { 0.0f, 0.0f, static_cast<float>(config.width), static_cast<float>(config.height), 0.0f, 1.0f };
+
+    directCommandQueue = device->createCommandQueue(RhiCommandListType::Direct);
+    LOG_INFO(L"Renderer -> directCommandQueue initialized!");
+
+    computeCommandQueue = device->createCommandQueue(RhiCommandListType::Compute, config.computePriority);
+    LOG_INFO(L"Renderer -> computeCommandQueue initialized!");
+
+    RhiSwapchainDesc swapchainDesc;
+    swapchainDesc.window = config.window;
+    swapchainDesc.width = config.width;
+    swapchainDesc.height = config.height;
+    swapchainDesc.bufferCount = config.bufferCount;
+    swapchainDesc.frameLatency = config.framesInFlight;
+
+    swapchain = device->createSwapchain(swapchainDesc, directCommandQueue.get());
+    LOG_INFO(L"Renderer -> swapchain initialized!");
+
+    currentBackBufferIndex = swapchain->getCurrentBackBufferIndex();
+
+    resourceStates = std::make_unique<ResourceStateRegistry>();
+    registerBackBuffers();
+
+    fenceWaiter = std::make_unique<RhiFenceWaiter>(device);
+    LOG_INFO(L"Renderer -> fenceWaiter initialized!");
+
+    releaseQueue = std::make_unique<RhiDeferredReleaseQueue>();
+    residencyManager = std::make_unique<ResidencyManager>(device, directCommandQueue.get());
+
+    transientPool = std::make_unique<TransientResourcePool>(
+        device, directCommandQueue.get(), releaseQueue.get(), resourceStates.get(), residencyManager.get()
+    );
+    dsv = device->getDescriptorAllocator(RhiDescriptorHeapType::Dsv)->allocate(1);
+
+    renderGraph = std::make_unique<RenderGraph>(
+        directCommandQueue.get(), computeCommandQueue.get(), resourceStates.get(), transientPool.get()
+    );
+    renderGraph->setJobSystem(config.jobs);
+
+    uploadManager = std::make_unique<UploadManager>(device);
+    LOG_INFO(L"Renderer -> uploadManager initialized!");
+
+    geometry = std::make_unique<GeometryBuffer>(
+        device, directCommandQueue.get(), uploadManager.get(), releaseQueue.get(), config.geometry
+    );
+    trackedGeometry[0] = geometry->getVertexBuffer();
+    trackedGeometry[1] = geometry->getIndexBuffer();
+    residencyManager->track(trackedGeometry[0]);
+    residencyManager->track(trackedGeometry[1]);
+    geometryBuild = geometry->getRebuildCount();
+    LOG_INFO(L"Renderer -> geometry initialized!");
+
+    createResources();
+}
+
+Renderer::~Renderer() {
+    LOG_INFO(L"Renderer cleanup started.");
+
+    if (directCommandQueue) {
+        directCommandQueue->flush(); // ensure GPU has finished all work
+    }
+    if (computeCommandQueue) {
+        computeCommandQueue->flush();
+    }
+
+    // Reset resources in reverse creation order
+    // (the waiter goes first -> it must not outlive the queues it watches)
+    fenceWaiter.reset();
+    drawList.reset();
+    renderGraph.reset();
+    transientPool.reset();
+    device->getDescriptorAllocator(RhiDescriptorHeapType::Dsv)->free(dsv);
+    releaseQueue.reset();
+    residencyManager.reset();
+    instancedRenderer.reset();
+    pipeline1.reset();
+    bindlessHeap.reset();
+    frameAllocator.reset();
+    mesh.reset();
+    geometry.reset(); // after every mesh holding a range of it (the release queue's included)
+    uploadManager.reset();
+    swapchain.reset();
+    computeCommandQueue.reset();
+    directCommandQueue.reset();
+
+    LOG_INFO(L"Renderer cleanup finished.");
+}
+
+void Renderer::createResources() {
+    LOG_INFO(L"-- Resources --");
+
+    std::vector<VertexStruct> vertices = {
+        { { -1.0f, -1.0f, -1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f, 1.0f } }, // 0
+        { { -1.0f,  1.0f, -1.0f, 1.0f }, { 0.0f, 1.0f, 0.0f, 1.0f } }, // 1
+        { {  1.0f,  1.0f, -1.0f, 1.0f }, { 1.0f, 1.0f, 0.0f, 1.0f } }, // 2
+        { {  1.0f, -1.0f, -1.0f, 1.0f }, { 1.0f, 0.0f, 0.0f, 1.0f } }, // 3
+        { { -1.0f, -1.0f,  1.0f, 1.0f }, { 0.0f, 0.0f, 1.0f, 1.0f } }, // 4
+        { { -1.0f,  1.0f,  1.0f, 1.0f }, { 0.0f, 1.0f, 1.0f, 1.0f } }, // 5
+        { {  1.0f,  1.0f,  1.0f, 1.0f }, { 1.0f, 1.0f, 1.0f, 1.0f } }, // 6
+        { {  1.0f, -1.0f,  1.0f, 1.0f }, { 1.0f, 0.0f, 1.0f, 1.0f } }  // 7
+    };
+
+    // 36 indices for cube (12 triangles)
+    std::vector<uint32_t> indices =
+    {
+        0, 1, 2, 0, 2, 3,
+        4, 6, 5, 4, 7, 6,
+        4, 5, 1, 4, 1, 0,
+        3, 2, 6, 3, 6, 7,
+        1, 5, 6, 1, 6, 2,
+        4, 0, 3, 4, 3, 7
+    };
+
+    // static geometry -> a range of the megabuffer, filled through the copy queue
+    mesh = std::make_unique<Mesh>(
+        geometry.get(),
+        vertices,
+        indices
+    );
+
+    // direct queue waits for the copies on the GPU
+    geometry->commit();
+    LOG_INFO(L"Mesh Resource initialized!");
+
+    // per-frame constants -> one region per frame in flight
+    createFrameContexts(config.framesInFlight);
+    LOG_INFO(L"FrameUploadAllocator initialized!");
+
+    bindlessHeap = std::make_unique<BindlessHeap>(device, directCommandQueue.get());
+    LOG_INFO(L"BindlessHeap initialized!");
+
+    // pipeline
+    RhiPipelineDesc pipelineDesc;
+    pipelineDesc.vertexShader = L"assets/shaders/vertex.cso";
+    pipelineDesc.pixelShader = L"assets/shaders/pixel.cso";
+    pipelineDesc.inputLayout = {
+        { "POSITION", 0, RhiFormat::R32G32B32A32Float, 0, 0 },
+        { "COLOR", 0, RhiFormat::R32G32B32A32Float, 0, 16 }
+    };
+
+    // 0: per-draw DrawConstants at b0 -> constantsIndex selects the frame constants
+    // 1, 2: unbounded CBV / SRV tables over the whole bindless heap (space1)
+    RhiRootParameter drawParam;
+    drawParam.shaderRegister = 0;
+    drawParam.type = RhiRootParameterType::Constants;
+    drawParam.num32BitValues = sizeof(DrawConstants) / sizeof(uint32_t);
+
+    RhiRootParameter cbvTable;
+    cbvTable.registerSpace = 1;
+    cbvTable.type = RhiRootParameterType::DescriptorTable;
+    cbvTable.rangeType = RhiDescriptorRangeType::Cbv;
+
+    RhiRootParameter srvTable = cbvTable;
+    srvTable.rangeType = RhiDescriptorRangeType::Srv;
+
+    pipelineDesc.rootParameters = { drawParam, cbvTable, srvTable };
+    pipelineDesc.rtvFormat = RhiFormat::R8G8B8A8Unorm;
+    pipelineDesc.dsvFormat = RhiFormat::D24UnormS8Uint;
+
+    pipeline1 = device->createPipeline(pipelineDesc);
+    LOG_INFO(L"Pipeline initialized!");
+
+    drawList = std::make_unique<DrawList>();
+    pipeline1Id = drawList->addPipeline(pipeline1.get());
+
+    instancedRenderer = std::make_unique<InstancedMeshRenderer>(
+        device, directCommandQueue.get(), config.framesInFlight, config.maxInstances
+    );
+    LOG_INFO(L"InstancedMeshRenderer initialized!");
+}
+
+void Renderer::createFrameContexts(uint32_t count) {
+    // sized by the config alone -> same ring on every backend, whatever the swapchain's buffer count
+    frames.assign(count, FrameContext{});
+    frameIndex = count - 1; // first beginFrame lands on context 0
+    frameAllocator = std::make_unique<FrameUploadAllocator>(device, directCommandQueue.get(), count);
+}
+
+void Renderer::waitForNextFrame() {
+    if (!swapchain->waitForNextFrame()) {
+        LOG_WARNING(L"Renderer -> Frame latency wait timed out");
+    }
+}
+
+void Renderer::beginFrame() {
+    if (frameOpen) {
+        LOG_ERROR(L"Renderer -> beginFrame without render for the previous frame");
+        throw std::runtime_error("Frame already open");
+    }
+
+    frameIndex = (frameIndex + 1) % static_cast<uint32_t>(frames.size());
+
+    // waitForNextFrame throttled on this frame's present already -> normally complete
+    directCommandQueue->fenceWait(frames[frameIndex].fenceValue);
+    frameAllocator->beginFrame();
+    instancedRenderer->beginFrame();
+    frameOpen = true;
+}
+
+void Renderer::setFramesInFlight(uint32_t count) {
+    if (count < 1 || count > MAX_FRAMES_IN_FLIGHT) {
+        LOG_ERROR(L"Renderer -> framesInFlight must be 1 - %u (got %u)", MAX_FRAMES_IN_FLIGHT, count);
+        throw std::runtime_error("Invalid frames in flight");
+    }
+    if (frameOpen) {
+        LOG_ERROR(L"Renderer -> setFramesInFlight inside a frame");
+        throw std::runtime_error("Frame open");
+    }
+    if (count == frames.size()) {
+        return;
+    }
+
+    // every region idle -> the upload buffer can go right away
+    directCommandQueue->flush();
+    createFrameContexts(count);
+    instancedRenderer->setFramesInFlight(count);
+    swapchain->setFrameLatency(count);
+    config.framesInFlight = count;
+
+    LOG_INFO(L"Renderer -> %u frames in flight", count);
+}
+
+void Renderer::update(const void* constants, size_t size) {
+    if (!frameOpen) {
+        LOG_ERROR(L"Renderer -> update outside beginFrame / render");
+        throw std::runtime_error("No frame open");
+    }
+
+    // fresh block every frame -> frames still in flight keep reading their own copy
+    uint64_t viewSize = (size + FrameUploadAllocator::CONSTANT_ALIGNMENT - 1) & ~(FrameUploadAllocator::CONSTANT_ALIGNMENT - 1);
+    frameConstants = frameAllocator->upload(constants, size).gpuAddress;
+
+    // same block as a transient bindless CBV -> the index goes to the shaders in the draw constants
+    drawConstants.constantsIndex = bindlessHeap->allocateTransient();
+    device->createConstantBufferView(
+        frameConstants,
+        static_cast<uint32_t>(viewSize),
+        bindlessHeap->getCpuDescriptor(drawConstants.constantsIndex)
+    );
+}
+
+InstanceAllocation Renderer::allocateInstances(uint32_t count) {
+    if (!frameOpen) {
+        LOG_ERROR(L"Renderer -> allocateInstances outside beginFrame / render");
+        throw std::runtime_error("No frame open");
+    }
+
+    // one instanced draw per frame -> a second call replaces the first
+    frameInstances = instancedRenderer->allocate(count);
+    return frameInstances;
+}
+
+void Renderer::updateGeometry() {
+    // meshes added since the last frame -> the direct queue waits for their copies
+    geometry->commit();
+
+    geometry->compactIfFragmented();
+
+    // compaction swaps both buffers, here or inside an add() since the last frame. The retired
+    // ones are only released by the collect() at the end of render() -> still alive to untrack
+    if (geometry->getRebuildCount() != geometryBuild) {
+        residencyManager->untrack(trackedGeometry[0]);
+        residencyManager->untrack(trackedGeometry[1]);
+        trackedGeometry[0] = geometry->getVertexBuffer();
+        trackedGeometry[1] = geometry->getIndexBuffer();
+        residencyManager->track(trackedGeometry[0]);
+        residencyManager->track(trackedGeometry[1]);
+        geometryBuild = geometry->getRebuildCount();
+    }
+}
+
+void Renderer::buildDrawList() {
+    drawList->clear();
+
+    DrawCommand cube;
+    cube.pipeline = pipeline1Id;
+    cube.constantsIndex = drawConstants.constantsIndex;
+    cube.materialIndex = drawConstants.materialIndex;
+    cube.vertexBuffer = mesh->getVertexView();
+    cube.indexBuffer = mesh->getIndexView();
+    cube.indexCount = mesh->getIndexCount();
+    cube.startIndex = mesh->getStartIndex();
+    cube.baseVertex = mesh->getBaseVertex();
+    drawList->add(0, DrawBlend::Opaque, 0.0f, cube);
+
+    drawList->sort(config.jobs);
+}
+
+void Renderer::buildGraph() {
+    renderGraph->reset();
+
+    RenderGraphResource backBuffer = renderGraph->importResource(
+        swapchain->getBackBufferHandle(currentBackBufferIndex), RhiResourceState::Present
+    );
+
+    RhiTextureDesc depthDesc;
+    depthDesc.width = config.width;
+    depthDesc.height = config.height;
+    depthDesc.format = RhiFormat::D24UnormS8Uint;
+    depthDesc.usage = RhiTextureUsage::DepthStencil;
+    depthDesc.initialState = RhiResourceState::DepthWrite;
+    depthDesc.clearDepth = 1.0f;
+
+    renderGraph->addPass("scene", RenderGraphQueue::Graphics,
+        [&](RenderGraphBuilder& builder) {
+            depthTarget = builder.createTexture(depthDesc);
+            builder.write(backBuffer, RhiResourceState::RenderTarget);
+            builder.write(depthTarget, RhiResourceState::DepthWrite);
+        },
+        [this](RenderGraphContext& context) {
+            recordScene(context.getCommandList());
+        }
+    );
+
+    renderGraph->compile();
+
+    // new depth texture (first frame, resize) -> rewrite its view
+    if (transientPool->getRebuildCount() != depthViewBuild) {
+        device->createDepthStencilView(renderGraph->getTexture(depthTarget), dsv.get());
+        depthViewBuild = transientPool->getRebuildCount();
+    }
+}
+
+void Renderer::recordScene(RhiCommandList* commandList) {
+    commandList->setViewport(viewport);
+    commandList->setScissorRect(scissorRect);
+
+    // Set render target and depth-stencil (already transitioned by the graph)
+    RhiCpuDescriptor rtvHandle = swapchain->getRenderTargetView(currentBackBufferIndex);
+    RhiCpuDescriptor dsvHandle = dsv.get();
+    commandList->setRenderTargets(&rtvHandle, &dsvHandle);
+
+    const float clearColor[] = {0.1f, 0.1f, 0.1f, 1.0f};
+    commandList->clearRenderTarget(rtvHandle, clearColor);
+    commandList->clearDepth(dsvHandle, 1.0f);
+
+    // Draws in key order; pipeline and DrawConstants (b0) only change between groups.
+    // The bindless tables go with every pipeline (its root signature drops them)
+    commandList->setPrimitiveTopology(RhiPrimitiveTopology::TriangleList);
+    drawList->record(commandList, drawList->getPassRange(0), [this](RhiCommandList* list) {
+        static const uint32_t bindlessTables[] = { 1, 2 };
+        bindlessHeap->bind(list, bindlessTables, 2);
+    });
+
+    // the copies: one call, transforms / colors from the instance stream
+    instancedRenderer->draw(commandList, *mesh, frameInstances, frameConstants);
+
+    residencyManager->markUsed(mesh->getVertex());
+    residencyManager->markUsed(mesh->getIndex());
+}
+
+void Renderer::render() {
+    if (!frameOpen) {
+        LOG_ERROR(L"Renderer -> render without beginFrame");
+        throw std::runtime_error("No frame open");
+    }
+
+    // draws -> keyed and sorted; passes -> culled, ordered, transients placed, barriers derived
+    updateGeometry();
+    buildDrawList();
+    buildGraph();
+    renderGraph->record();
+
+    const RenderGraphStats& graphStats = renderGraph->getStats();
+    frameBarriers.barriers = graphStats.barriers;
+    frameBarriers.barrierCalls = graphStats.barrierCalls;
+    frameBarriers.splitBarriers = graphStats.splitBarriers;
+
+    // page in what this frame uses (and evict idle memory) before the GPU sees it
+    transientPool->markUsed();
+    residencyManager->update();
+
+    // Execute (after the compute work the frame consumes)
+    FrameContext& frame = frames[frameIndex];
+    frame.fenceValue = renderGraph->submit(frameDependencies);
+    frameBarriers.fixups = resourceStates->takeFixupBarrierCount();
+    frameDependencies.clear();
+    frameAllocator->endFrame(frame.fenceValue);
+    bindlessHeap->endFrame(frame.fenceValue);
+    instancedRenderer->endFrame(frame.fenceValue);
+    frameInstances = {};
+
+    // Present; no wait here -> the next frame throttles in waitForNextFrame / beginFrame
+    swapchain->present();
+    frameOpen = false;
+
+    currentBackBufferIndex = swapchain->getCurrentBackBufferIndex();
+
+    // drop whatever was retired by frames that have completed by now
+    releaseQueue->collect();
+}
+
+void Renderer::resize(uint32_t width, uint32_t height) {
+    config.width = width;
+    config.height = height;
+
+    // DXGI needs the back buffers idle before ResizeBuffers -> wait for the last frame
+    // that presented them. Nothing on the compute queue touches the swapchain, so it keeps running.
+    directCommandQueue->fenceWait(directCommandQueue->getFenceValue());
+
+    // Resize swap chain buffers (new buffers -> new handles on D3D12)
+    unregisterBackBuffers();
+    swapchain->resize(width, height);
+    registerBackBuffers();
+
+    // Reset back buffer index after resize
+    currentBackBufferIndex = swapchain->getCurrentBackBufferIndex();
+
+    // Update viewport + scissor rect
+    viewport = { 0.0f, 0.0f, float(width), float(height), 0.0f, 1.0f };
+    scissorRect = { 0, 0, static_cast<int32_t>(width), static_cast<int32_t>(height) };
+}
+
+void Renderer::setMesh(std::unique_ptr<Mesh> newMesh) {
+    // shared meshes -> the geometry buffers are tracked once for all of them
+    if (mesh && !mesh->isShared()) {
+        residencyManager->untrack(mesh->getVertex());
+        residencyManager->untrack(mesh->getIndex());
+    }
+
+    // every frame that drew the old mesh has been submitted to the direct queue already
+    releaseQueue->retire(directCommandQueue.get(), std::move(mesh));
+    mesh = std::move(newMesh);
+
+    if (mesh && !mesh->isShared()) {
+        residencyManager->track(mesh->getVertex());
+        residencyManager->track(mesh->getIndex());
+    }
+}
+
+void Renderer::registerBackBuffers() {
+    for (uint32_t i = 0; i < swapchain->getBufferCount(); ++i) {
+        resourceStates->add(swapchain->getBackBufferHandle(i), RhiResourceState::Present);
+    }
+}
+
+void Renderer::unregisterBackBuffers() {
+    for (uint32_t i = 0; i < swapchain->getBufferCount(); ++i) {
+        resourceStates->remove(swapchain->getBackBufferHandle(i));
+    }
+}
+
+void Renderer::addFrameDependency(const RhiSyncPoint& dependency) {
+    frameDependencies.push_back(dependency);
+}
+
+void Renderer::flush() {
+    directCommandQueue->flush();
+    computeCommandQueue->flush();
+}
@@ -0,0 +1,229 @@
+#pragma once
+
+#include "rhi/rhi_command_queue.h"
+#include "render_graph.h"
+#include "descriptor_allocator.h"
+#include "instanced_renderer.h"
+#include "geometry_buffer.h"
+
+class Mesh;
+class UploadManager;
+class RhiFenceWaiter;
+class FrameUploadAllocator;
+class BindlessHeap;
+class RhiDeferredReleaseQueue;
+class ResidencyManager;
+class TransientResourcePool;
+class JobSystem;
+class DrawList;
+
+struct RendererConfig {
+    void* window = nullptr; // native window handle, nullptr when headless
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t bufferCount = 3; // swapchain back buffers
+
+    // frames the CPU may run ahead of the GPU (1 - 4), independent of bufferCount.
+    // Sizes the ring of per-frame contexts and the swapchain's frame latency
+    uint32_t framesInFlight = 2;
+
+    // per-frame capacity of the instance stream (allocateInstances)
+    uint32_t maxInstances = InstancedMeshRenderer::DEFAULT_MAX_INSTANCES;
+
+    // shared vertex / index megabuffer for static meshes (vertexStride = sizeof(VertexStruct))
+    GeometryBufferConfig geometry;
+
+    // async compute (culling, skinning, post) overlaps graphics on its own queue
+    RhiQueuePriority computePriority = RhiQueuePriority::Normal;
+
+    // shared engine job system -> render graph passes record in parallel (null -> serial recording)
+    JobSystem* jobs = nullptr;
+};
+
+// Per-draw root constants -> bindless heap indices (absolute, INVALID_INDEX when unused)
+struct DrawConstants {
+    uint32_t constantsIndex = ~0u; // CBV of the frame constants
+    uint32_t materialIndex = ~0u;
+};
+
+// Barriers of the last rendered frame (fixups = transitions the registry added at submit)
+struct FrameBarrierStats {
+    uint64_t barriers = 0;
+    uint64_t barrierCalls = 0;
+    uint64_t splitBarriers = 0;
+    uint64_t fixups = 0;
+};
+
+// Backend-independent frame path: owns the queue, swapchain and scene resources
+// and records / submits a frame through the RHI. Application drives it with the
+// D3D12 device, the headless runner with the null device.
+class Renderer
+{
+    public:
+        static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 4;
+
+        Renderer(RhiDevice* device, const RendererConfig& config);
+        ~Renderer();
+
+        // Frame loop: waitForNextFrame -> sample input / update -> beginFrame -> update -> render.
+        // Throttle: blocks until the swapchain takes another frame (framesInFlight presents queued).
+        // Only touches the swapchain's waitable object -> may run on the update thread of a pipelined loop
+        void waitForNextFrame();
+
+        // Next per-frame context: waits for the frame that used it last (normally done by now)
+        // and opens its upload region
+        void beginFrame();
+
+        // per-frame constants (MVP) -> copied into this frame's upload region, call before every render()
+        void update(const void* constants, size_t size);
+
+        // count copies of the scene mesh for this frame, drawn in one instanced call after the
+        // sorted draws; fill the returned instances before render()
+        InstanceAllocation allocateInstances(uint32_t count);
+        void render(); // submits, presents and closes the frame
+        void resize(uint32_t width, uint32_t height);
+        void flush();
+
+        // Between frames only; drains the direct queue and rebuilds the per-frame ring
+        void setFramesInFlight(uint32_t count);
+
+        uint32_t getFramesInFlight() const {
+            return static_cast<uint32_t>(frames.size());
+        }
+
+        // Swaps the drawn mesh; the old one is released once the frames using it completed
+        void setMesh(std::unique_ptr<Mesh> newMesh);
+
+        RhiCommandQueue* getDirectQueue() const {
+            return directCommandQueue.get();
+        }
+
+        RhiCommandQueue* getComputeQueue() const {
+            return computeCommandQueue.get();
+        }
+
+        // The next frame's graphics submission consumes the output of this (compute) submission
+        void addFrameDependency(const RhiSyncPoint& dependency);
+
+        RhiSwapchain* getSwapchain() const {
+            return swapchain.get();
+        }
+
+        // background fence watcher for every queue -> onFenceComplete / co_await instead of fenceWait
+        RhiFenceWaiter* getFenceWaiter() const {
+            return fenceWaiter.get();
+        }
+
+        // transient per-frame upload memory, recycled by fence
+        FrameUploadAllocator* getFrameAllocator() const {
+            return frameAllocator.get();
+        }
+
+        UploadManager* getUploadManager() const {
+            return uploadManager.get();
+        }
+
+        // retired objects wait here for their last frame's fence -> replace resources without a flush
+        RhiDeferredReleaseQueue* getReleaseQueue() const {
+            return releaseQueue.get();
+        }
+
+        // global resource states -> submissions resolve their first uses against it
+        ResourceStateRegistry* getResourceStates() const {
+            return resourceStates.get();
+        }
+
+        const FrameBarrierStats& getFrameBarrierStats() const {
+            return frameBarriers;
+        }
+
+        // keeps scene memory under the OS budget (LRU eviction by fence)
+        ResidencyManager* getResidencyManager() const {
+            return residencyManager.get();
+        }
+
+        // the frame's passes, rebuilt and compiled every render()
+        RenderGraph* getRenderGraph() const {
+            return renderGraph.get();
+        }
+
+        // per-frame render targets (depth, intermediates) aliased in shared heaps
+        TransientResourcePool* getTransientPool() const {
+            return transientPool.get();
+        }
+
+        // this frame's draws, sorted by state / depth before recording
+        DrawList* getDrawList() const {
+            return drawList.get();
+        }
+
+        // static meshes live here -> Mesh(getGeometryBuffer(), ...), drawable from the next render()
+        GeometryBuffer* getGeometryBuffer() const {
+            return geometry.get();
+        }
+
+        InstancedMeshRenderer* getInstancedRenderer() const {
+            return instancedRenderer.get();
+        }
+
+        // shader-visible CBV_SRV_UAV heap every draw indexes into
+        BindlessHeap* getBindlessHeap() const {
+            return bindlessHeap.get();
+        }
+
+    private:
+        // what one frame in flight holds on to until the GPU is done with it
+        struct FrameContext {
+            uint64_t fenceValue = 0; // direct queue submission of the frame
+        };
+
+        void createResources();
+        void createFrameContexts(uint32_t count);
+        void updateGeometry();
+        void buildDrawList();
+        void buildGraph();
+        void recordScene(RhiCommandList* commandList);
+        void registerBackBuffers();
+        void unregisterBackBuffers();
+
+    private:
+        RhiDevice* device = nullptr;
+        RendererConfig config;
+
+        uint32_t currentBackBufferIndex = 0;
+        std::vector<FrameContext> frames;
+        uint32_t frameIndex = 0;
+        bool frameOpen = false;
+        std::vector<RhiSyncPoint> frameDependencies;
+
+        RhiViewport viewport;
+        RhiRect scissorRect;
+
+        std::unique_ptr<RhiCommandQueue> directCommandQueue;
+        std::unique_ptr<RhiCommandQueue> computeCommandQueue;
+        std::unique_ptr<RhiSwapchain> swapchain;
+        std::unique_ptr<RhiFenceWaiter> fenceWaiter;
+        std::unique_ptr<RhiDeferredReleaseQueue> releaseQueue;
+        std::unique_ptr<ResidencyManager> residencyManager;
+        std::unique_ptr<ResourceStateRegistry> resourceStates;
+        std::unique_ptr<TransientResourcePool> transientPool;
+        std::unique_ptr<RenderGraph> renderGraph;
+        RenderGraphResource depthTarget;
+        uint64_t depthViewBuild = 0; // pool rebuild the DSV was written for
+        DescriptorAllocation dsv;
+        FrameBarrierStats frameBarriers;
+        std::unique_ptr<UploadManager> uploadManager;
+        std::unique_ptr<GeometryBuffer> geometry;
+        uint64_t geometryBuild = 0;               // geometry rebuild the residency tracking matches
+        RhiBuffer* trackedGeometry[2] = {};       // vertex / index buffer of that rebuild
+        std::unique_ptr<Mesh> mesh;
+        std::unique_ptr<FrameUploadAllocator> frameAllocator;
+        uint64_t frameConstants = 0; // GPU address of this frame's MVP block
+        std::unique_ptr<BindlessHeap> bindlessHeap;
+        DrawConstants drawConstants;
+        std::unique_ptr<RhiPipeline> pipeline1;
+        std::unique_ptr<DrawList> drawList;
+        uint32_t pipeline1Id = 0; // sort id in drawList
+        std::unique_ptr<InstancedMeshRenderer> instancedRenderer;
+        InstanceAllocation frameInstances;
+};
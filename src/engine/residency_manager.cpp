@@ -0,0 +1,94 @@
+#include "residency_manager.h"
+#include "rhi/rhi_command_queue.h"
+#include "utils/logger.h"
+
+static uint64_t toId(RhiPageable pageable) {
+    return reinterpret_cast<uint64_t>(pageable.native);
+}
+
+ResidencyManager::ResidencyManager(RhiDevice* device, RhiCommandQueue* queue) :
+    device(device),
+    queue(queue)
+{
+    RhiMemoryBudget budget = device->getMemoryBudget();
+    LOG_INFO(L"ResidencyManager -> Budget %llu MB, usage %llu MB",
+        static_cast<unsigned long long>(budget.budget >> 20), static_cast<unsigned long long>(budget.usage >> 20));
+}
+
+void ResidencyManager::track(RhiBuffer* buffer) {
+    track(buffer->getPageable(), buffer->getPageableSize());
+}
+
+void ResidencyManager::untrack(RhiBuffer* buffer) {
+    untrack(buffer->getPageable());
+}
+
+void ResidencyManager::track(RhiPageable pageable, uint64_t size) {
+    std::lock_guard<std::mutex> lock(mutex);
+    tracker.add(toId(pageable), size);
+}
+
+void ResidencyManager::untrack(RhiPageable pageable) {
+    std::lock_guard<std::mutex> lock(mutex);
+    tracker.remove(toId(pageable));
+}
+
+void ResidencyManager::markUsed(RhiBuffer* buffer) {
+    markUsed(buffer->getPageable());
+}
+
+void ResidencyManager::markUsed(RhiPageable pageable) {
+    // the value the next signal on the queue will get
+    uint64_t fenceValue = queue->getFenceValue() + 1;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    tracker.markUsed(toId(pageable), fenceValue);
+}
+
+void ResidencyManager::update() {
+    RhiMemoryBudget budget = device->getMemoryBudget();
+    uint64_t completed = queue->getCompletedFenceValue();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    tracker.plan(budget.budget, budget.usage, completed, plan);
+
+    // evict first -> the memory is free by the time MakeResident pages the rest in
+    if (!plan.evict.empty()) {
+        batch.clear();
+        for (uint64_t id : plan.evict) {
+            batch.push_back({ reinterpret_cast<void*>(id) });
+        }
+        device->evict(batch.data(), static_cast<uint32_t>(batch.size()));
+        evictedBytes += plan.evictBytes;
+    }
+
+    if (!plan.makeResident.empty()) {
+        batch.clear();
+        for (uint64_t id : plan.makeResident) {
+            batch.push_back({ reinterpret_cast<void*>(id) });
+        }
+        device->makeResident(batch.data(), static_cast<uint32_t>(batch.size()));
+        madeResidentBytes += plan.makeResidentBytes;
+    }
+
+    // everything idle is already out -> the OS pages for us; only worth one warning per episode
+    if (plan.overBudgetBytes > 0) {
+        if (!warnedOverBudget) {
+            LOG_WARNING(L"ResidencyManager -> %llu KB over budget with nothing left to evict",
+                static_cast<unsigned long long>(plan.overBudgetBytes >> 10));
+            warnedOverBudget = true;
+        }
+    } else {
+        warnedOverBudget = false;
+    }
+}
+
+uint64_t ResidencyManager::getResidentBytes() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return tracker.getResidentBytes();
+}
+
+uint64_t ResidencyManager::getTrackedBytes() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return tracker.getTrackedBytes();
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "rhi/rhi.h"
+#include "memory/residency_tracker.h"
+#include <mutex>
+
+class RhiCommandQueue;
+
+// Keeps the tracked heaps / resources under the OS video memory budget.
+// Everything a frame draws with is marked used while recording; update() runs right before
+// the frame is submitted and issues at most one MakeResident and one Evict batch, evicting the
+// least recently used objects the GPU is done with. Fence values come from one queue's timeline.
+class ResidencyManager {
+    public:
+        ResidencyManager(RhiDevice* device, RhiCommandQueue* queue);
+
+        // Buffers placed in the same heap share one pageable -> tracked once, reference counted
+        void track(RhiBuffer* buffer);
+        void untrack(RhiBuffer* buffer);
+
+        void track(RhiPageable pageable, uint64_t size);
+        void untrack(RhiPageable pageable);
+
+        // Used by the next submission on the queue
+        void markUsed(RhiBuffer* buffer);
+        void markUsed(RhiPageable pageable);
+
+        // Call before executing the lists that use the marked objects
+        void update();
+
+        uint64_t getResidentBytes();
+        uint64_t getTrackedBytes();
+
+        // totals since creation
+        uint64_t getEvictedBytes() const {
+            return evictedBytes;
+        }
+
+        uint64_t getMadeResidentBytes() const {
+            return madeResidentBytes;
+        }
+
+    private:
+        RhiDevice* device = nullptr;
+        RhiCommandQueue* queue = nullptr;
+
+        std::mutex mutex;
+        ResidencyTracker tracker;
+        ResidencyTracker::Plan plan; // reused -> no allocations per frame
+        std::vector<RhiPageable> batch;
+
+        uint64_t evictedBytes = 0;
+        uint64_t madeResidentBytes = 0;
+        bool warnedOverBudget = false;
+};
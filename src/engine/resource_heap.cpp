@@ -0,0 +1,18 @@
+#include "resource_heap.h"
+
+ResourceHeap::ResourceHeap(ComPtr<ID3D12Device2> device, UINT64 size, RhiHeapUsage usage) :
+    size(size),
+    usage(usage)
+{
+    D3D12_HEAP_FLAGS flags = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+    if (usage == RhiHeapUsage::RenderTargets) {
+        flags = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+    } else if (usage == RhiHeapUsage::Textures) {
+        flags = D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+    }
+
+    CD3DX12_HEAP_DESC heapDesc(size, D3D12_HEAP_TYPE_DEFAULT, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT, flags);
+    throwFailed(device->CreateHeap(&heapDesc, IID_PPV_ARGS(&heap)));
+
+    LOG_INFO(L"ResourceHeap -> Created %llu KB (usage %u)", size >> 10, static_cast<UINT>(usage));
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "utils/pch.h"
+#include "rhi/rhi.h"
+
+// Explicit default-heap memory for placed resources that alias each other.
+// Restricted to one resource category so it works on resource heap tier 1.
+class ResourceHeap : public RhiHeap {
+    public:
+        ResourceHeap(ComPtr<ID3D12Device2> device, UINT64 size, RhiHeapUsage usage);
+
+        uint64_t getSize() const override {
+            return size;
+        }
+
+        RhiHeapUsage getUsage() const override {
+            return usage;
+        }
+
+        RhiPageable getPageable() const override {
+            return { heap.Get() };
+        }
+
+        ID3D12Heap* getHeap() const {
+            return heap.Get();
+        }
+
+    private:
+        ComPtr<ID3D12Heap> heap;
+        UINT64 size = 0;
+        RhiHeapUsage usage;
+};
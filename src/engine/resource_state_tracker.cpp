@@ -0,0 +1,198 @@
+#include "resource_state_tracker.h"
+#include "rhi/rhi_command_queue.h"
+#include "utils/logger.h"
+
+#include <stdexcept>
+
+static const RhiResourceState READ_STATES = RhiResourceState::GenericRead | RhiResourceState::DepthRead;
+
+// a read-only state that already includes every bit of next -> no barrier needed
+static bool covers(RhiResourceState current, RhiResourceState next) {
+    if (current == next) {
+        return true;
+    }
+    bool readOnly = current != RhiResourceState::Common && (current & READ_STATES) == current;
+    return readOnly && next != RhiResourceState::Common && (current & next) == next;
+}
+
+void ResourceStateTracker::push(RhiResourceHandle resource, RhiResourceState before, RhiResourceState after, RhiBarrierFlags flags) {
+    batch.push_back(RhiResourceBarrier::transition(resource, before, after, flags));
+    barrierCount++;
+    if (flags == RhiBarrierFlags::BeginOnly) {
+        splitBarrierCount++;
+    }
+}
+
+void ResourceStateTracker::transition(RhiResourceHandle resource, RhiResourceState state) {
+    auto it = states.find(resource.native);
+    if (it == states.end()) {
+        // first use in this list -> the before-state is only known at submit
+        firstUses.push_back(RhiResourceBarrier::transition(resource, RhiResourceState::Common, state));
+        states[resource.native].current = state;
+        return;
+    }
+
+    State& entry = it->second;
+    if (entry.splitPending) {
+        entry.splitPending = false;
+        push(resource, entry.current, entry.splitTarget, RhiBarrierFlags::EndOnly);
+        entry.current = entry.splitTarget;
+    }
+
+    if (!covers(entry.current, state)) {
+        push(resource, entry.current, state, RhiBarrierFlags::None);
+        entry.current = state;
+    }
+}
+
+void ResourceStateTracker::beginTransition(RhiResourceHandle resource, RhiResourceState state) {
+    auto it = states.find(resource.native);
+    if (it == states.end() || it->second.splitPending) {
+        // nothing known to split from (or already splitting) -> plain transition at first use
+        transition(resource, state);
+        return;
+    }
+
+    State& entry = it->second;
+    if (covers(entry.current, state)) {
+        return;
+    }
+    push(resource, entry.current, state, RhiBarrierFlags::BeginOnly);
+    entry.splitTarget = state;
+    entry.splitPending = true;
+}
+
+void ResourceStateTracker::alias(RhiResourceHandle before, RhiResourceHandle resource) {
+    RhiResourceBarrier barrier;
+    barrier.type = RhiBarrierType::Aliasing;
+    barrier.aliasBefore = before;
+    barrier.resource = resource;
+    batch.push_back(barrier);
+    barrierCount++;
+}
+
+void ResourceStateTracker::flush(RhiCommandList* list) {
+    if (batch.empty()) {
+        return;
+    }
+    list->transitionResources(batch.data(), static_cast<uint32_t>(batch.size()));
+    barrierCallCount++;
+    batch.clear();
+}
+
+void ResourceStateTracker::flush(std::vector<RhiResourceBarrier>& out) {
+    if (batch.empty()) {
+        return;
+    }
+    out.insert(out.end(), batch.begin(), batch.end());
+    barrierCallCount++;
+    batch.clear();
+}
+
+void ResourceStateTracker::endSplits() {
+    for (auto& [native, entry] : states) {
+        if (entry.splitPending) {
+            entry.splitPending = false;
+            push({ native }, entry.current, entry.splitTarget, RhiBarrierFlags::EndOnly);
+            entry.current = entry.splitTarget;
+        }
+    }
+}
+
+void ResourceStateTracker::finish(RhiCommandList* list) {
+    endSplits();
+    flush(list);
+}
+
+void ResourceStateTracker::finish(std::vector<RhiResourceBarrier>& out) {
+    endSplits();
+    flush(out);
+}
+
+void ResourceStateTracker::reset() {
+    states.clear();
+    firstUses.clear();
+    batch.clear();
+    barrierCount = 0;
+    barrierCallCount = 0;
+    splitBarrierCount = 0;
+}
+
+void ResourceStateRegistry::add(RhiResourceHandle resource, RhiResourceState state) {
+    std::lock_guard<std::mutex> lock(mutex);
+    states[resource.native] = state;
+}
+
+void ResourceStateRegistry::remove(RhiResourceHandle resource) {
+    std::lock_guard<std::mutex> lock(mutex);
+    states.erase(resource.native);
+}
+
+RhiResourceState ResourceStateRegistry::getState(RhiResourceHandle resource) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = states.find(resource.native);
+    return it == states.end() ? RhiResourceState::Common : it->second;
+}
+
+uint64_t ResourceStateRegistry::execute(
+    RhiCommandQueue* queue,
+    RhiCommandList* const* lists,
+    ResourceStateTracker* const* trackers,
+    size_t count,
+    const std::vector<RhiSyncPoint>& dependencies
+) {
+    // held through the execute -> the global states are published in GPU submission order
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::vector<RhiCommandList*> submission;
+    submission.reserve(count * 2);
+
+    for (size_t i = 0; i < count; ++i) {
+        ResourceStateTracker* tracker = trackers[i];
+
+        if (!tracker->batch.empty()) {
+            LOG_ERROR(L"ResourceStateRegistry -> Submitting a list with unflushed barriers");
+            throw std::runtime_error("Unflushed resource barriers");
+        }
+
+        fixups.clear();
+        for (const auto& use : tracker->firstUses) {
+            auto it = states.find(use.resource.native);
+            if (it == states.end()) {
+                LOG_ERROR(L"ResourceStateRegistry -> Resource is not registered");
+                throw std::runtime_error("Untracked resource");
+            }
+            // exact match only -> the list recorded its later barriers from use.after
+            if (it->second != use.after) {
+                fixups.push_back(RhiResourceBarrier::transition(use.resource, it->second, use.after));
+            }
+        }
+
+        // missing transitions go into one small list in front
+        if (!fixups.empty()) {
+            RhiCommandList* fixupList = queue->getCommandList();
+            fixupList->transitionResources(fixups.data(), static_cast<uint32_t>(fixups.size()));
+            submission.push_back(fixupList);
+            fixupBarrierCount += fixups.size();
+        }
+        submission.push_back(lists[i]);
+
+        // publish where this list leaves its resources
+        for (const auto& [native, entry] : tracker->states) {
+            auto it = states.find(native);
+            if (it != states.end()) {
+                it->second = entry.current;
+            }
+        }
+        tracker->reset();
+    }
+
+    return queue->executeCommandLists(submission, dependencies);
+}
+
+uint64_t ResourceStateRegistry::takeFixupBarrierCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t count = fixupBarrierCount;
+    fixupBarrierCount = 0;
+    return count;
+}
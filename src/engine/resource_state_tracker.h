@@ -0,0 +1,104 @@
+#pragma once
+
+#include "rhi/rhi.h"
+#include <mutex>
+#include <unordered_map>
+
+class RhiCommandQueue;
+class ResourceStateRegistry;
+
+// Resource states as seen by one command list while it records.
+// Callers only say which state they need next; the tracker knows the before-state, drops
+// redundant transitions and batches everything up to the next pass boundary (flush) into
+// one transitionResources call. The state a resource must be in when the list starts is
+// unknown while recording -> remembered and resolved by the registry at submit time.
+// Not thread-safe: one tracker per recording list.
+class ResourceStateTracker {
+    public:
+        // Next use of resource needs state
+        void transition(RhiResourceHandle resource, RhiResourceState state);
+
+        // Starts a split barrier: the GPU may move resource to state any time until the matching
+        // transition(resource, state), recorded passes later. Only for resources this list already touched.
+        void beginTransition(RhiResourceHandle resource, RhiResourceState state);
+
+        // resource starts using memory that before (null -> whichever resource) used; batched like transitions
+        void alias(RhiResourceHandle before, RhiResourceHandle resource);
+
+        // Pass boundary -> every batched barrier in one native call
+        void flush(RhiCommandList* list);
+
+        // Ends split barriers still open and flushes; call last before the list is submitted
+        void finish(RhiCommandList* list);
+
+        // Same, but the barriers are appended to out -> recorded later, possibly on another thread
+        void flush(std::vector<RhiResourceBarrier>& out);
+        void finish(std::vector<RhiResourceBarrier>& out);
+
+        // Reuse for the next recording
+        void reset();
+
+        // barriers / native barrier calls recorded since the last reset (resolve fixups not included)
+        uint64_t getBarrierCount() const {
+            return barrierCount;
+        }
+
+        uint64_t getBarrierCallCount() const {
+            return barrierCallCount;
+        }
+
+        uint64_t getSplitBarrierCount() const {
+            return splitBarrierCount;
+        }
+
+    private:
+        friend class ResourceStateRegistry;
+
+        struct State {
+            RhiResourceState current = RhiResourceState::Common;
+            RhiResourceState splitTarget = RhiResourceState::Common;
+            bool splitPending = false;
+        };
+
+        void push(RhiResourceHandle resource, RhiResourceState before, RhiResourceState after, RhiBarrierFlags flags);
+        void endSplits();
+
+    private:
+        std::unordered_map<void*, State> states;
+        std::vector<RhiResourceBarrier> firstUses; // state needed when the list starts (after = needed)
+        std::vector<RhiResourceBarrier> batch;
+
+        uint64_t barrierCount = 0;
+        uint64_t barrierCallCount = 0;
+        uint64_t splitBarrierCount = 0;
+};
+
+// Global (between submissions) state of every tracked resource.
+// Submitting through the registry resolves each list's first uses against the global state,
+// records the missing transitions into one fixup list in front of it and publishes the list's
+// final states -> all in submission order.
+class ResourceStateRegistry {
+    public:
+        void add(RhiResourceHandle resource, RhiResourceState state);
+        void remove(RhiResourceHandle resource);
+
+        RhiResourceState getState(RhiResourceHandle resource);
+
+        // lists[i] was recorded with trackers[i]; the trackers are reset afterwards
+        uint64_t execute(
+            RhiCommandQueue* queue,
+            RhiCommandList* const* lists,
+            ResourceStateTracker* const* trackers,
+            size_t count,
+            const std::vector<RhiSyncPoint>& dependencies = {}
+        );
+
+        // transitions recorded into fixup lists since the last call
+        uint64_t takeFixupBarrierCount();
+
+    private:
+        std::mutex mutex;
+        std::unordered_map<void*, RhiResourceState> states;
+        std::vector<RhiResourceBarrier> fixups;
+        uint64_t fixupBarrierCount = 0;
+};
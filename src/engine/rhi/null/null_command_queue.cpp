@@ -0,0 +1,356 @@
+#include "null_command_queue.h"
+#include "null_device.h"
+#include "utils/logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+NullCommandList::NullCommandList(NullDevice* device, RhiCommandAllocator* allocator)
+    : device(device), allocator(allocator)
+{
+}
+
+void NullCommandList::reset(RhiCommandAllocator* newAllocator) {
+    if (open) {
+        LOG_ERROR(L"NullCommandList -> Reset called on an open command list");
+        throw std::runtime_error("Command list reset while open");
+    }
+
+    allocator = newAllocator;
+    open = true;
+
+    commands.clear();
+    copies.clear();
+    indirects.clear();
+    commandCount = 0;
+    drawCount = 0;
+    dispatchCount = 0;
+    barrierCount = 0;
+    barrierCallCount = 0;
+    splitBarrierCount = 0;
+    aliasingBarrierCount = 0;
+}
+
+void NullCommandList::close() {
+    if (!open) {
+        LOG_ERROR(L"NullCommandList -> Close called on a closed command list");
+        throw std::runtime_error("Command list closed twice");
+    }
+    open = false;
+}
+
+void NullCommandList::record(NullCommandType type, uint64_t a, uint64_t b, uint64_t c) {
+    commandCount++;
+    if (device->getConfig().recordCommands) {
+        commands.push_back({ type, { a, b, c } });
+    }
+}
+
+void NullCommandList::setPipeline(RhiPipeline* pipeline) {
+    record(NullCommandType::SetPipeline, reinterpret_cast<uint64_t>(pipeline));
+}
+
+void NullCommandList::setGraphicsRootConstantBufferView(uint32_t rootIndex, uint64_t gpuAddress) {
+    record(NullCommandType::SetRootConstantBufferView, rootIndex, gpuAddress);
+}
+
+void NullCommandList::setGraphicsRoot32BitConstants(uint32_t rootIndex, uint32_t count, const void* data, uint32_t offset) {
+    // first value only -> enough to tell draws apart when inspecting
+    uint32_t first = 0;
+    if (count > 0) {
+        memcpy(&first, data, sizeof(first));
+    }
+    record(NullCommandType::SetRoot32BitConstants, rootIndex, (uint64_t(offset) << 32) | count, first);
+}
+
+void NullCommandList::setDescriptorHeap(RhiDescriptorHeap* heap) {
+    record(NullCommandType::SetDescriptorHeap, reinterpret_cast<uint64_t>(heap));
+}
+
+void NullCommandList::setGraphicsRootDescriptorTable(uint32_t rootIndex, RhiGpuDescriptor base) {
+    if (base.ptr == 0) {
+        LOG_ERROR(L"NullCommandList -> Descriptor table from a heap that is not shader visible");
+        throw std::runtime_error("Descriptor table not shader visible");
+    }
+    record(NullCommandType::SetRootDescriptorTable, rootIndex, base.ptr);
+}
+
+void NullCommandList::setViewport(const RhiViewport& viewport) {
+    record(NullCommandType::SetViewport, static_cast<uint64_t>(viewport.width), static_cast<uint64_t>(viewport.height));
+}
+
+void NullCommandList::setScissorRect(const RhiRect& rect) {
+    record(NullCommandType::SetScissorRect, static_cast<uint64_t>(rect.right), static_cast<uint64_t>(rect.bottom));
+}
+
+void NullCommandList::transitionResource(
+    RhiResourceHandle resource,
+    RhiResourceState beforeState,
+    RhiResourceState afterState
+) {
+    barrierCount++;
+    barrierCallCount++;
+    record(
+        NullCommandType::ResourceBarrier,
+        reinterpret_cast<uint64_t>(resource.native),
+        static_cast<uint64_t>(beforeState),
+        static_cast<uint64_t>(afterState)
+    );
+}
+
+void NullCommandList::transitionResources(const RhiResourceBarrier* barriers, uint32_t count) {
+    barrierCount += count;
+    barrierCallCount++;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (barriers[i].flags == RhiBarrierFlags::BeginOnly) {
+            splitBarrierCount++;
+        }
+        if (barriers[i].type == RhiBarrierType::Aliasing) {
+            aliasingBarrierCount++;
+        }
+    }
+    record(NullCommandType::ResourceBarrier, count > 0 ? reinterpret_cast<uint64_t>(barriers[0].resource.native) : 0, count);
+}
+
+void NullCommandList::copyBufferRegion(
+    RhiResourceHandle destination,
+    uint64_t destinationOffset,
+    RhiResourceHandle source,
+    uint64_t sourceOffset,
+    uint64_t size
+) {
+    auto dst = static_cast<NullResource*>(destination.native);
+    auto src = static_cast<NullResource*>(source.native);
+
+    if (destinationOffset + size > dst->sizeInBytes || sourceOffset + size > src->sizeInBytes) {
+        LOG_ERROR(L"NullCommandList -> CopyBufferRegion out of bounds");
+        throw std::runtime_error("Copy out of bounds");
+    }
+
+    copies.push_back({ dst, destinationOffset, src, sourceOffset, size });
+    record(NullCommandType::CopyBufferRegion, reinterpret_cast<uint64_t>(dst), destinationOffset, size);
+}
+
+void NullCommandList::setRenderTargets(const RhiCpuDescriptor* rtv, const RhiCpuDescriptor* dsv) {
+    record(NullCommandType::SetRenderTargets, rtv ? rtv->ptr : 0, dsv ? dsv->ptr : 0);
+}
+
+void NullCommandList::clearRenderTarget(RhiCpuDescriptor rtv, const float color[4]) {
+    record(NullCommandType::ClearRenderTarget, rtv.ptr);
+}
+
+void NullCommandList::clearDepth(RhiCpuDescriptor dsv, float depth) {
+    record(NullCommandType::ClearDepth, dsv.ptr);
+}
+
+void NullCommandList::setPrimitiveTopology(RhiPrimitiveTopology topology) {
+    record(NullCommandType::SetPrimitiveTopology, static_cast<uint64_t>(topology));
+}
+
+void NullCommandList::setVertexBuffer(uint32_t slot, const RhiVertexBufferView& view) {
+    record(NullCommandType::SetVertexBuffer, slot, view.gpuAddress, view.sizeInBytes);
+}
+
+void NullCommandList::setIndexBuffer(const RhiIndexBufferView& view) {
+    record(NullCommandType::SetIndexBuffer, view.gpuAddress, view.sizeInBytes);
+}
+
+void NullCommandList::drawIndexedInstanced(
+    uint32_t indexCount,
+    uint32_t instanceCount,
+    uint32_t startIndex,
+    int32_t baseVertex,
+    uint32_t startInstance
+) {
+    drawCount++;
+    record(
+        NullCommandType::DrawIndexedInstanced,
+        (uint64_t(indexCount) << 32) | instanceCount,
+        (uint64_t(startIndex) << 32) | static_cast<uint32_t>(baseVertex),
+        startInstance
+    );
+}
+
+void NullCommandList::setComputePipeline(RhiPipeline* pipeline) {
+    record(NullCommandType::SetComputePipeline, reinterpret_cast<uint64_t>(pipeline));
+}
+
+void NullCommandList::setComputeRoot32BitConstants(uint32_t rootIndex, uint32_t count, const void* data, uint32_t offset) {
+    uint32_t first = 0;
+    if (count > 0) {
+        memcpy(&first, data, sizeof(first));
+    }
+    record(NullCommandType::SetComputeRoot32BitConstants, rootIndex, (uint64_t(offset) << 32) | count, first);
+}
+
+void NullCommandList::setComputeRootShaderResourceView(uint32_t rootIndex, uint64_t gpuAddress) {
+    record(NullCommandType::SetComputeRootShaderResourceView, rootIndex, gpuAddress);
+}
+
+void NullCommandList::setComputeRootUnorderedAccessView(uint32_t rootIndex, uint64_t gpuAddress) {
+    record(NullCommandType::SetComputeRootUnorderedAccessView, rootIndex, gpuAddress);
+}
+
+void NullCommandList::dispatch(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) {
+    dispatchCount++;
+    record(NullCommandType::Dispatch, groupsX, groupsY, groupsZ);
+}
+
+void NullCommandList::executeIndirect(
+    RhiCommandSignature* signature,
+    uint32_t maxCommandCount,
+    RhiResourceHandle arguments,
+    uint64_t argumentOffset,
+    RhiResourceHandle countBuffer,
+    uint64_t countOffset
+) {
+    auto nullSignature = static_cast<NullCommandSignature*>(signature);
+    auto argumentResource = static_cast<NullResource*>(arguments.native);
+    auto countResource = static_cast<NullResource*>(countBuffer.native);
+
+    // the runtime validates the worst case, whatever the count turns out to be
+    if (argumentOffset + uint64_t(maxCommandCount) * signature->getByteStride() > argumentResource->sizeInBytes ||
+        (countResource && countOffset + sizeof(uint32_t) > countResource->sizeInBytes)) {
+        LOG_ERROR(L"NullCommandList -> ExecuteIndirect arguments out of bounds");
+        throw std::runtime_error("ExecuteIndirect out of bounds");
+    }
+
+    indirects.push_back({ nullSignature, maxCommandCount, argumentResource, argumentOffset, countResource, countOffset });
+    record(NullCommandType::ExecuteIndirect, reinterpret_cast<uint64_t>(argumentResource), argumentOffset, maxCommandCount);
+}
+
+NullCommandQueue::NullCommandQueue(NullDevice* device, RhiCommandListType type, RhiQueuePriority priority)
+    : RhiCommandQueue(type, priority), device(device)
+{
+    LOG_INFO(L"NullCommandQueue -> Initialized (type %d, priority %d)", static_cast<int>(type), static_cast<int>(priority));
+}
+
+NullCommandQueue::~NullCommandQueue() {
+    flush();
+}
+
+std::unique_ptr<RhiCommandAllocator> NullCommandQueue::createCommandAllocator() {
+    return std::make_unique<NullCommandAllocator>();
+}
+
+std::unique_ptr<RhiCommandList> NullCommandQueue::createCommandList(RhiCommandAllocator* allocator) {
+    return std::make_unique<NullCommandList>(device, allocator);
+}
+
+void NullCommandQueue::executeNative(uint32_t count, RhiCommandList* const* lists) {
+    auto& stats = device->getStats();
+    stats.executeCalls++;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        auto list = static_cast<NullCommandList*>(lists[i]);
+        if (list->isOpen()) {
+            LOG_ERROR(L"NullCommandQueue -> Executing an open command list");
+            throw std::runtime_error("Executing an open command list");
+        }
+
+        stats.commandListsExecuted++;
+        stats.commandsExecuted += list->getCommandCount();
+        stats.drawCalls += list->getDrawCount();
+        stats.dispatches += list->getDispatchCount();
+        stats.barriers += list->getBarrierCount();
+        stats.barrierCalls += list->getBarrierCallCount();
+        stats.splitBarriers += list->getSplitBarrierCount();
+        stats.aliasingBarriers += list->getAliasingBarrierCount();
+
+        // copies land at execute time; the fence latency only delays when the CPU gets to know
+        for (const auto& copy : list->getCopies()) {
+            if (copy.destination->data && copy.source->data) {
+                memcpy(copy.destination->data + copy.destinationOffset, copy.source->data + copy.sourceOffset, copy.size);
+            }
+            stats.bytesCopied += copy.size;
+        }
+
+        // after the copies -> a count copied in by this list is the one its executeIndirect reads
+        for (const auto& indirect : list->getIndirects()) {
+            uint32_t commands = indirect.maxCommandCount;
+            if (indirect.countBuffer && indirect.countBuffer->data) {
+                uint32_t count = 0;
+                memcpy(&count, indirect.countBuffer->data + indirect.countOffset, sizeof(count));
+                commands = std::min(commands, count);
+            }
+            stats.indirectCommands += commands;
+            if (indirect.signature->isDispatch()) {
+                stats.dispatches += commands;
+            } else {
+                stats.drawCalls += commands;
+            }
+        }
+    }
+}
+
+void NullCommandQueue::signal(uint64_t value) {
+    // under the queue's submit mutex -> values only grow
+    device->getStats().fenceSignals++;
+    signaledValue = value;
+
+    // the simulated GPU finishes work `fenceLatency` signals behind the CPU
+    uint64_t latency = device->getConfig().fenceLatency;
+    if (value > latency) {
+        complete(value - latency);
+    }
+}
+
+uint64_t NullCommandQueue::getCompletedValue() {
+    return completedValue.load(std::memory_order_acquire);
+}
+
+void NullCommandQueue::waitForValue(uint64_t value) {
+    device->getStats().fenceWaits++;
+    complete(value);
+}
+
+void NullCommandQueue::waitOnGpu(RhiCommandQueue* producer, uint64_t value) {
+    device->getStats().queueWaits++;
+
+    // the simulated GPU executes in order, so the consumer can only run past this point
+    // once the producer got there -> advance the producer instead of stalling anyone
+    static_cast<NullCommandQueue*>(producer)->complete(value);
+}
+
+void NullCommandQueue::drain() {
+    complete(signaledValue.load());
+}
+
+void NullCommandQueue::complete(uint64_t value) {
+    uint64_t current = completedValue.load(std::memory_order_relaxed);
+    while (current < value) {
+        if (completedValue.compare_exchange_weak(current, value, std::memory_order_release, std::memory_order_relaxed)) {
+            device->notifyProgress();
+            return;
+        }
+    }
+}
+
+void NullFenceEvent::arm(const RhiSyncPoint* points, size_t count) {
+    armed.assign(points, points + count);
+}
+
+void NullFenceEvent::wait() {
+    std::unique_lock<std::mutex> lock(device->getProgressMutex());
+    device->getProgressCondition().wait(lock, [this] {
+        if (woken) {
+            return true;
+        }
+        for (const auto& point : armed) {
+            if (point.queue->isFenceComplete(point.value)) {
+                return true;
+            }
+        }
+        return false;
+    });
+    woken = false;
+}
+
+void NullFenceEvent::wake() {
+    {
+        std::lock_guard<std::mutex> lock(device->getProgressMutex());
+        woken = true;
+    }
+    device->getProgressCondition().notify_all();
+}
@@ -0,0 +1,242 @@
+#pragma once
+
+#include "engine/rhi/rhi_command_queue.h"
+#include <atomic>
+
+class NullDevice;
+class NullCommandSignature;
+struct NullResource;
+
+enum class NullCommandType : uint8_t {
+    SetPipeline,
+    SetRootConstantBufferView,
+    SetRoot32BitConstants,
+    SetDescriptorHeap,
+    SetRootDescriptorTable,
+    SetViewport,
+    SetScissorRect,
+    ResourceBarrier,
+    CopyBufferRegion,
+    SetRenderTargets,
+    ClearRenderTarget,
+    ClearDepth,
+    SetPrimitiveTopology,
+    SetVertexBuffer,
+    SetIndexBuffer,
+    DrawIndexedInstanced,
+    SetComputePipeline,
+    SetComputeRoot32BitConstants,
+    SetComputeRootShaderResourceView,
+    SetComputeRootUnorderedAccessView,
+    Dispatch,
+    ExecuteIndirect
+};
+
+struct NullCommand {
+    NullCommandType type;
+    uint64_t args[3];
+};
+
+class NullCommandAllocator : public RhiCommandAllocator {
+    public:
+        void reset() override {
+            resetCount++;
+        }
+
+        uint64_t getResetCount() const {
+            return resetCount;
+        }
+
+    private:
+        uint64_t resetCount = 0;
+};
+
+class NullCommandList : public RhiCommandList {
+    public:
+        NullCommandList(NullDevice* device, RhiCommandAllocator* allocator);
+
+        void reset(RhiCommandAllocator* allocator) override;
+        void close() override;
+
+        void setPipeline(RhiPipeline* pipeline) override;
+        void setGraphicsRootConstantBufferView(uint32_t rootIndex, uint64_t gpuAddress) override;
+        void setGraphicsRoot32BitConstants(uint32_t rootIndex, uint32_t count, const void* data, uint32_t offset = 0) override;
+
+        void setDescriptorHeap(RhiDescriptorHeap* heap) override;
+        void setGraphicsRootDescriptorTable(uint32_t rootIndex, RhiGpuDescriptor base) override;
+
+        void setViewport(const RhiViewport& viewport) override;
+        void setScissorRect(const RhiRect& rect) override;
+
+        void transitionResource(
+            RhiResourceHandle resource,
+            RhiResourceState beforeState,
+            RhiResourceState afterState
+        ) override;
+
+        void transitionResources(const RhiResourceBarrier* barriers, uint32_t count) override;
+
+        void copyBufferRegion(
+            RhiResourceHandle destination,
+            uint64_t destinationOffset,
+            RhiResourceHandle source,
+            uint64_t sourceOffset,
+            uint64_t size
+        ) override;
+
+        void setRenderTargets(const RhiCpuDescriptor* rtv, const RhiCpuDescriptor* dsv) override;
+        void clearRenderTarget(RhiCpuDescriptor rtv, const float color[4]) override;
+        void clearDepth(RhiCpuDescriptor dsv, float depth) override;
+
+        void setPrimitiveTopology(RhiPrimitiveTopology topology) override;
+        void setVertexBuffer(uint32_t slot, const RhiVertexBufferView& view) override;
+        void setIndexBuffer(const RhiIndexBufferView& view) override;
+
+        void drawIndexedInstanced(
+            uint32_t indexCount,
+            uint32_t instanceCount,
+            uint32_t startIndex,
+            int32_t baseVertex,
+            uint32_t startInstance
+        ) override;
+
+        void setComputePipeline(RhiPipeline* pipeline) override;
+        void setComputeRoot32BitConstants(uint32_t rootIndex, uint32_t count, const void* data, uint32_t offset = 0) override;
+        void setComputeRootShaderResourceView(uint32_t rootIndex, uint64_t gpuAddress) override;
+        void setComputeRootUnorderedAccessView(uint32_t rootIndex, uint64_t gpuAddress) override;
+        void dispatch(uint32_t groupsX, uint32_t groupsY = 1, uint32_t groupsZ = 1) override;
+
+        void executeIndirect(
+            RhiCommandSignature* signature,
+            uint32_t maxCommandCount,
+            RhiResourceHandle arguments,
+            uint64_t argumentOffset,
+            RhiResourceHandle countBuffer = {},
+            uint64_t countOffset = 0
+        ) override;
+
+        bool isOpen() const {
+            return open;
+        }
+
+        const std::vector<NullCommand>& getCommands() const {
+            return commands;
+        }
+
+        uint64_t getCommandCount() const {
+            return commandCount;
+        }
+
+        uint64_t getDrawCount() const {
+            return drawCount;
+        }
+
+        uint64_t getDispatchCount() const {
+            return dispatchCount;
+        }
+
+        uint64_t getBarrierCount() const {
+            return barrierCount;
+        }
+
+        // native ResourceBarrier calls (one per transitionResource / transitionResources)
+        uint64_t getBarrierCallCount() const {
+            return barrierCallCount;
+        }
+
+        uint64_t getSplitBarrierCount() const {
+            return splitBarrierCount;
+        }
+
+        uint64_t getAliasingBarrierCount() const {
+            return aliasingBarrierCount;
+        }
+
+        struct Copy {
+            NullResource* destination;
+            uint64_t destinationOffset;
+            NullResource* source;
+            uint64_t sourceOffset;
+            uint64_t size;
+        };
+
+        // kept regardless of recordCommands -> the queue replays them on execute
+        const std::vector<Copy>& getCopies() const {
+            return copies;
+        }
+
+        struct Indirect {
+            const NullCommandSignature* signature;
+            uint32_t maxCommandCount;
+            NullResource* arguments;
+            uint64_t argumentOffset;
+            NullResource* countBuffer; // nullptr -> maxCommandCount
+            uint64_t countOffset;
+        };
+
+        // the count lives in GPU memory -> only known once the queue executes the list
+        const std::vector<Indirect>& getIndirects() const {
+            return indirects;
+        }
+
+    private:
+        void record(NullCommandType type, uint64_t a = 0, uint64_t b = 0, uint64_t c = 0);
+
+    private:
+        NullDevice* device = nullptr;
+        RhiCommandAllocator* allocator = nullptr;
+        bool open = true;
+
+        std::vector<NullCommand> commands;
+        std::vector<Copy> copies;
+        std::vector<Indirect> indirects;
+        uint64_t commandCount = 0;
+        uint64_t drawCount = 0;
+        uint64_t dispatchCount = 0;
+        uint64_t barrierCount = 0;
+        uint64_t barrierCallCount = 0;
+        uint64_t splitBarrierCount = 0;
+        uint64_t aliasingBarrierCount = 0;
+};
+
+// Sleeps on the device's progress condition until an armed fence value completes
+class NullFenceEvent : public RhiFenceEvent {
+    public:
+        explicit NullFenceEvent(NullDevice* device) : device(device) {}
+
+        void arm(const RhiSyncPoint* points, size_t count) override;
+        void wait() override;
+        void wake() override;
+
+    private:
+        NullDevice* device = nullptr;
+        std::vector<RhiSyncPoint> armed;
+        bool woken = false; // guarded by the device's progress mutex
+};
+
+class NullCommandQueue : public RhiCommandQueue {
+    public:
+        NullCommandQueue(NullDevice* device, RhiCommandListType type, RhiQueuePriority priority);
+        ~NullCommandQueue() override;
+
+        // Lets the simulated GPU catch up with everything signalled so far
+        void drain();
+
+    protected:
+        std::unique_ptr<RhiCommandAllocator> createCommandAllocator() override;
+        std::unique_ptr<RhiCommandList> createCommandList(RhiCommandAllocator* allocator) override;
+        void executeNative(uint32_t count, RhiCommandList* const* lists) override;
+        void signal(uint64_t value) override;
+        uint64_t getCompletedValue() override;
+        void waitForValue(uint64_t value) override;
+        void waitOnGpu(RhiCommandQueue* producer, uint64_t value) override;
+
+    private:
+        void complete(uint64_t value);
+
+    private:
+        NullDevice* device = nullptr;
+
+        std::atomic<uint64_t> signaledValue{ 0 };
+        std::atomic<uint64_t> completedValue{ 0 };
+};
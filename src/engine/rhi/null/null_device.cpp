@@ -0,0 +1,458 @@
+#include "null_device.h"
+#include "null_command_queue.h"
+#include "utils/logger.h"
+
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+void NullDeviceStats::reset() {
+    executeCalls = 0;
+    commandListsExecuted = 0;
+    commandsExecuted = 0;
+    drawCalls = 0;
+    dispatches = 0;
+    indirectCommands = 0;
+    barriers = 0;
+    barrierCalls = 0;
+    splitBarriers = 0;
+    aliasingBarriers = 0;
+    fenceSignals = 0;
+    fenceWaits = 0;
+    presents = 0;
+    latencyWaits = 0;
+    resourcesCreated = 0;
+    queueWaits = 0;
+    bytesCopied = 0;
+    descriptorsWritten = 0;
+    residencyCalls = 0;
+    evictions = 0;
+    makeResidents = 0;
+}
+
+NullDevice::NullDevice(const NullDeviceConfig& config)
+    : config(config)
+{
+    for (uint32_t type = 0; type < 4; ++type) {
+        descriptorAllocators[type] = std::make_unique<DescriptorAllocator>(this, static_cast<RhiDescriptorHeapType>(type));
+    }
+
+    LOG_INFO(L"NullDevice -> initialized (fence latency %u)", config.fenceLatency);
+}
+
+NullDevice::~NullDevice() = default;
+
+uint64_t NullDevice::allocateAddressRange(uint64_t size) {
+    uint64_t aligned = (size + 255) & ~uint64_t(255);
+    return nextAddress.fetch_add(aligned == 0 ? 256 : aligned);
+}
+
+std::unique_ptr<RhiCommandQueue> NullDevice::createCommandQueue(
+    RhiCommandListType type,
+    RhiQueuePriority priority
+) {
+    return std::make_unique<NullCommandQueue>(this, type, priority);
+}
+
+std::unique_ptr<RhiSwapchain> NullDevice::createSwapchain(
+    const RhiSwapchainDesc& desc,
+    RhiCommandQueue* presentQueue
+) {
+    return std::make_unique<NullSwapchain>(this, desc, presentQueue);
+}
+
+std::unique_ptr<RhiDescriptorHeap> NullDevice::createDescriptorHeap(
+    RhiDescriptorHeapType type,
+    uint32_t numDescriptors,
+    bool shaderVisible
+) {
+    return std::make_unique<NullDescriptorHeap>(this, type, numDescriptors, shaderVisible);
+}
+
+void NullDevice::copyDescriptors(
+    RhiCpuDescriptor destination,
+    RhiCpuDescriptor source,
+    uint32_t count,
+    RhiDescriptorHeapType type
+) {
+    if (destination.ptr == 0 || source.ptr == 0) {
+        LOG_ERROR(L"NullDevice -> CopyDescriptors with a null handle");
+        throw std::runtime_error("Null descriptor handle");
+    }
+    stats.descriptorsWritten += count;
+}
+
+void NullDevice::createConstantBufferView(uint64_t gpuAddress, uint32_t sizeInBytes, RhiCpuDescriptor destination) {
+    if (sizeInBytes % 256 != 0) {
+        LOG_ERROR(L"NullDevice -> CBV size %u is not a multiple of 256", sizeInBytes);
+        throw std::runtime_error("Misaligned constant buffer view");
+    }
+    stats.descriptorsWritten++;
+}
+
+std::unique_ptr<RhiPipeline> NullDevice::createPipeline(const RhiPipelineDesc& desc) {
+    stats.resourcesCreated++;
+    return std::make_unique<NullPipeline>(desc);
+}
+
+std::unique_ptr<RhiPipeline> NullDevice::createComputePipeline(const RhiComputePipelineDesc& desc) {
+    stats.resourcesCreated++;
+    return std::make_unique<NullComputePipeline>(desc);
+}
+
+std::unique_ptr<RhiCommandSignature> NullDevice::createCommandSignature(const RhiCommandSignatureDesc& desc, RhiPipeline* pipeline) {
+    if (desc.arguments.empty() || desc.byteStride == 0) {
+        LOG_ERROR(L"NullDevice -> Command signature without arguments or stride");
+        throw std::runtime_error("Invalid command signature");
+    }
+
+    uint32_t size = 0;
+    bool changesRoot = false;
+    for (const auto& argument : desc.arguments) {
+        switch (argument.type) {
+            case RhiIndirectArgumentType::Draw:
+                size += 16;
+                break;
+            case RhiIndirectArgumentType::DrawIndexed:
+                size += 20;
+                break;
+            case RhiIndirectArgumentType::Dispatch:
+                size += 12;
+                break;
+            case RhiIndirectArgumentType::Constant:
+                size += argument.num32BitValues * 4;
+                changesRoot = true;
+                break;
+        }
+    }
+
+    // same rules the D3D12 runtime enforces
+    RhiIndirectArgumentType last = desc.arguments.back().type;
+    if (last == RhiIndirectArgumentType::Constant || desc.byteStride < size || (changesRoot && !pipeline)) {
+        LOG_ERROR(L"NullDevice -> Command signature must end in a draw / dispatch, fit its stride and name a root signature for root arguments");
+        throw std::runtime_error("Invalid command signature");
+    }
+
+    stats.resourcesCreated++;
+    return std::make_unique<NullCommandSignature>(desc);
+}
+
+std::unique_ptr<RhiFenceEvent> NullDevice::createFenceEvent() {
+    return std::make_unique<NullFenceEvent>(this);
+}
+
+void NullDevice::notifyProgress() {
+    // empty critical section -> a waiter between its predicate check and its sleep can't miss this
+    { std::lock_guard<std::mutex> lock(progressMutex); }
+    progressCondition.notify_all();
+}
+
+std::unique_ptr<RhiBuffer> NullDevice::createVertexBuffer(const void* data, uint32_t count, uint32_t stride) {
+    auto buffer = std::make_unique<NullBuffer>(this, count * stride, count, stride, false);
+    memcpy(buffer->getData(), data, count * stride);
+    return buffer;
+}
+
+std::unique_ptr<RhiBuffer> NullDevice::createIndexBuffer(const uint32_t* indices, uint32_t count) {
+    uint32_t size = count * static_cast<uint32_t>(sizeof(uint32_t));
+    auto buffer = std::make_unique<NullBuffer>(this, size, count, static_cast<uint32_t>(sizeof(uint32_t)), false);
+    memcpy(buffer->getData(), indices, size);
+    return buffer;
+}
+
+std::unique_ptr<RhiBuffer> NullDevice::createConstantBuffer(uint32_t size) {
+    return std::make_unique<NullBuffer>(this, (size + 255) & ~255u, 0, 0, true);
+}
+
+std::unique_ptr<RhiBuffer> NullDevice::createBuffer(const RhiBufferDesc& desc) {
+    if (desc.unorderedAccess && desc.heapType != RhiHeapType::Default) {
+        LOG_ERROR(L"NullDevice -> Unordered access buffers must live in the default heap");
+        throw std::runtime_error("UAV buffer outside the default heap");
+    }
+
+    // only upload heaps are CPU visible, like on the real thing
+    bool cpuWritable = desc.heapType == RhiHeapType::Upload;
+    return std::make_unique<NullBuffer>(this, desc.sizeInBytes, desc.count, desc.stride, cpuWritable);
+}
+
+static const uint64_t PLACEMENT_ALIGNMENT = 64 * 1024;
+
+static uint32_t bytesPerPixel(RhiFormat format) {
+    switch (format) {
+        case RhiFormat::R32G32B32A32Float:
+            return 16;
+        case RhiFormat::R16Uint:
+            return 2;
+        default:
+            return 4;
+    }
+}
+
+static bool isRenderTargetUsage(RhiTextureUsage usage) {
+    return (usage & (RhiTextureUsage::RenderTarget | RhiTextureUsage::DepthStencil)) != RhiTextureUsage::None;
+}
+
+// placed resources must fit the heap and keep to its resource category (heap tier 1 rules)
+static void validatePlacement(RhiHeap* heap, uint64_t offset, uint64_t size, RhiHeapUsage usage) {
+    if (offset % PLACEMENT_ALIGNMENT != 0 || offset + size > heap->getSize()) {
+        LOG_ERROR(L"NullDevice -> Placed resource [%llu, %llu) does not fit heap of %llu bytes", offset, offset + size, heap->getSize());
+        throw std::runtime_error("Invalid placement");
+    }
+    if (heap->getUsage() != usage) {
+        LOG_ERROR(L"NullDevice -> Placed resource in a heap of the wrong category");
+        throw std::runtime_error("Invalid heap category");
+    }
+}
+
+std::unique_ptr<RhiHeap> NullDevice::createHeap(uint64_t size, RhiHeapUsage usage) {
+    return std::make_unique<NullHeap>(this, size, usage);
+}
+
+RhiAllocationInfo NullDevice::getTextureAllocationInfo(const RhiTextureDesc& desc) {
+    uint64_t size = 0;
+    uint64_t width = desc.width;
+    uint64_t height = desc.height;
+    for (uint32_t mip = 0; mip < desc.mipLevels; ++mip) {
+        size += width * height * bytesPerPixel(desc.format);
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    return { (size + PLACEMENT_ALIGNMENT - 1) & ~(PLACEMENT_ALIGNMENT - 1), PLACEMENT_ALIGNMENT };
+}
+
+std::unique_ptr<RhiTexture> NullDevice::createPlacedTexture(RhiHeap* heap, uint64_t offset, const RhiTextureDesc& desc) {
+    RhiAllocationInfo info = getTextureAllocationInfo(desc);
+    validatePlacement(heap, offset, info.size, isRenderTargetUsage(desc.usage) ? RhiHeapUsage::RenderTargets : RhiHeapUsage::Textures);
+
+    stats.resourcesCreated++;
+    return std::make_unique<NullTexture>(desc, static_cast<NullHeap*>(heap)->getGPUAddress() + offset, info.size);
+}
+
+std::unique_ptr<RhiBuffer> NullDevice::createPlacedBuffer(RhiHeap* heap, uint64_t offset, const RhiBufferDesc& desc) {
+    validatePlacement(heap, offset, desc.sizeInBytes, RhiHeapUsage::Buffers);
+    return std::make_unique<NullBuffer>(this, static_cast<NullHeap*>(heap), offset, desc.sizeInBytes, desc.count, desc.stride);
+}
+
+void NullDevice::createRenderTargetView(RhiTexture* texture, RhiCpuDescriptor destination) {
+    if ((texture->getDesc().usage & RhiTextureUsage::RenderTarget) == RhiTextureUsage::None) {
+        LOG_ERROR(L"NullDevice -> RTV for a texture without render target usage");
+        throw std::runtime_error("Invalid render target view");
+    }
+    stats.descriptorsWritten++;
+}
+
+void NullDevice::createDepthStencilView(RhiTexture* texture, RhiCpuDescriptor destination) {
+    if ((texture->getDesc().usage & RhiTextureUsage::DepthStencil) == RhiTextureUsage::None) {
+        LOG_ERROR(L"NullDevice -> DSV for a texture without depth stencil usage");
+        throw std::runtime_error("Invalid depth stencil view");
+    }
+    stats.descriptorsWritten++;
+}
+
+RhiMemoryBudget NullDevice::getMemoryBudget() {
+    return { config.videoMemoryBudget, residentBytes.load() };
+}
+
+void NullDevice::evict(const RhiPageable* pageables, uint32_t count) {
+    stats.residencyCalls++;
+    for (uint32_t i = 0; i < count; ++i) {
+        auto resource = static_cast<NullResource*>(pageables[i].native);
+        if (resource->resident) {
+            resource->resident = false;
+            residentBytes -= resource->sizeInBytes;
+            stats.evictions++;
+        }
+    }
+}
+
+void NullDevice::makeResident(const RhiPageable* pageables, uint32_t count) {
+    stats.residencyCalls++;
+    for (uint32_t i = 0; i < count; ++i) {
+        auto resource = static_cast<NullResource*>(pageables[i].native);
+        if (!resource->resident) {
+            resource->resident = true;
+            residentBytes += resource->sizeInBytes;
+            stats.makeResidents++;
+        }
+    }
+}
+
+NullBuffer::NullBuffer(
+    NullDevice* device,
+    uint64_t size,
+    uint32_t count,
+    uint32_t stride,
+    bool cpuWritable
+) :
+    device(device),
+    storage(size),
+    count(count),
+    stride(stride),
+    cpuWritable(cpuWritable)
+{
+    resource.sizeInBytes = size;
+    resource.data = storage.data();
+    resource.gpuAddress = device->allocateAddressRange(size);
+    device->getStats().resourcesCreated++;
+    device->addResidentBytes(size);
+}
+
+NullBuffer::NullBuffer(
+    NullDevice* device,
+    NullHeap* heap,
+    uint64_t offset,
+    uint64_t size,
+    uint32_t count,
+    uint32_t stride
+) :
+    device(device),
+    heap(heap),
+    count(count),
+    stride(stride)
+{
+    resource.sizeInBytes = size;
+    resource.data = heap->getData() + offset;
+    resource.gpuAddress = heap->getGPUAddress() + offset;
+    device->getStats().resourcesCreated++;
+}
+
+NullBuffer::~NullBuffer() {
+    if (!heap && resource.resident) {
+        device->removeResidentBytes(resource.sizeInBytes);
+    }
+}
+
+void NullBuffer::update(const void* data, size_t size) {
+    if (!cpuWritable) {
+        LOG_ERROR(L"NullBuffer -> Buffer is not CPU writable");
+        return;
+    }
+    if (size > resource.sizeInBytes) {
+        LOG_ERROR(L"NullBuffer -> Update size %zu exceeds buffer size %llu", size, resource.sizeInBytes);
+        return;
+    }
+    memcpy(resource.data, data, size);
+}
+
+NullHeap::NullHeap(NullDevice* device, uint64_t size, RhiHeapUsage usage) :
+    device(device),
+    usage(usage)
+{
+    if (usage == RhiHeapUsage::Buffers) {
+        storage.resize(size);
+        resource.data = storage.data();
+    }
+    resource.sizeInBytes = size;
+    resource.gpuAddress = device->allocateAddressRange(size);
+    device->getStats().resourcesCreated++;
+    device->addResidentBytes(size);
+}
+
+NullHeap::~NullHeap() {
+    if (resource.resident) {
+        device->removeResidentBytes(resource.sizeInBytes);
+    }
+}
+
+NullDescriptorHeap::NullDescriptorHeap(
+    NullDevice* device,
+    RhiDescriptorHeapType type,
+    uint32_t numDescriptors,
+    bool shaderVisible
+) :
+    type(type),
+    numDescriptors(numDescriptors),
+    shaderVisible(shaderVisible)
+{
+    base = device->allocateAddressRange(uint64_t(numDescriptors) * descriptorSize);
+}
+
+RhiCpuDescriptor NullDescriptorHeap::getCPUDescriptor(uint32_t index) const {
+    return { static_cast<size_t>(base + uint64_t(index) * descriptorSize) };
+}
+
+RhiGpuDescriptor NullDescriptorHeap::getGPUDescriptor(uint32_t index) const {
+    if (!shaderVisible) {
+        return {};
+    }
+    return { base + uint64_t(index) * descriptorSize };
+}
+
+NullSwapchain::NullSwapchain(NullDevice* device, const RhiSwapchainDesc& desc, RhiCommandQueue* presentQueue) :
+    device(device),
+    width(desc.width),
+    height(desc.height),
+    bufferCount(desc.bufferCount),
+    presentQueue(presentQueue),
+    frameLatency(desc.frameLatency < 1 ? 1 : desc.frameLatency),
+    backBuffers(desc.bufferCount)
+{
+    rtvs = device->getDescriptorAllocator(RhiDescriptorHeapType::Rtv)->allocate(bufferCount);
+
+    resize(width, height);
+
+    LOG_INFO(L"NullSwapchain -> Created %ux%u with %u buffers", width, height, bufferCount);
+}
+
+NullSwapchain::~NullSwapchain() {
+    device->getDescriptorAllocator(RhiDescriptorHeapType::Rtv)->free(rtvs);
+}
+
+void NullSwapchain::present() {
+    device->getStats().presents++;
+    currentIndex = (currentIndex + 1) % bufferCount;
+
+    // the simulated flip retires once the frame's last submission completes
+    {
+        std::lock_guard<std::mutex> lock(latencyMutex);
+        presentFences[presentCount % PRESENT_HISTORY] = presentQueue->getFenceValue();
+        presentCount++;
+    }
+    presented.notify_all();
+}
+
+bool NullSwapchain::waitForNextFrame(uint32_t timeoutMs) {
+    std::unique_lock<std::mutex> lock(latencyMutex);
+    if (waitCount < frameLatency) {
+        waitCount++;
+        return true;
+    }
+
+    // present this wait depends on; a pipelined loop may get here before the render thread presented it
+    uint64_t present = waitCount - frameLatency;
+    if (!presented.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&] { return presentCount > present; })) {
+        return false;
+    }
+    waitCount++;
+
+    // older than the history -> a later present already retired it
+    if (presentCount - present > PRESENT_HISTORY) {
+        return true;
+    }
+
+    uint64_t fence = presentFences[present % PRESENT_HISTORY];
+    lock.unlock();
+    if (!presentQueue->isFenceComplete(fence)) {
+        device->getStats().latencyWaits++;
+        presentQueue->fenceWait(fence);
+    }
+    return true;
+}
+
+void NullSwapchain::setFrameLatency(uint32_t latency) {
+    std::lock_guard<std::mutex> lock(latencyMutex);
+    frameLatency = latency < 1 ? 1 : latency;
+}
+
+void NullSwapchain::resize(uint32_t newWidth, uint32_t newHeight) {
+    width = newWidth;
+    height = newHeight;
+
+    uint64_t colorSize = uint64_t(width) * height * 4;
+    for (auto& bb : backBuffers) {
+        bb.sizeInBytes = colorSize;
+        bb.gpuAddress = device->allocateAddressRange(colorSize);
+    }
+
+    currentIndex = 0;
+}
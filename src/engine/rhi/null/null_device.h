@@ -0,0 +1,390 @@
+#pragma once
+
+#include "engine/rhi/rhi.h"
+#include "engine/descriptor_allocator.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+// Null backend: no GPU, no window.
+// Every object behaves like its D3D12 counterpart as far as the CPU can tell
+// (lists record, queues signal fences that complete later, swapchains rotate back buffers)
+// so the whole update / record / submit path can be run and timed headless.
+
+struct NullDeviceConfig {
+    // How many signals the simulated GPU trails behind the CPU.
+    // 0 -> every fence value completes as soon as it is signalled.
+    uint32_t fenceLatency = 1;
+
+    // Keep the recorded commands around for inspection (costs a vector push per call)
+    bool recordCommands = true;
+
+    // Simulated local video memory budget; usage = bytes of resident buffers
+    uint64_t videoMemoryBudget = 4ull * 1024 * 1024 * 1024;
+};
+
+struct NullDeviceStats {
+    std::atomic<uint64_t> executeCalls{ 0 };
+    std::atomic<uint64_t> commandListsExecuted{ 0 };
+    std::atomic<uint64_t> commandsExecuted{ 0 };
+    std::atomic<uint64_t> drawCalls{ 0 };       // direct + issued through executeIndirect
+    std::atomic<uint64_t> dispatches{ 0 };
+    std::atomic<uint64_t> indirectCommands{ 0 }; // commands executeIndirect issued (count buffer applied)
+    std::atomic<uint64_t> barriers{ 0 };
+    std::atomic<uint64_t> barrierCalls{ 0 };
+    std::atomic<uint64_t> splitBarriers{ 0 }; // begin / end pairs
+    std::atomic<uint64_t> aliasingBarriers{ 0 };
+    std::atomic<uint64_t> fenceSignals{ 0 };
+    std::atomic<uint64_t> fenceWaits{ 0 };
+    std::atomic<uint64_t> queueWaits{ 0 };
+    std::atomic<uint64_t> presents{ 0 };
+    std::atomic<uint64_t> latencyWaits{ 0 }; // waitForNextFrame calls that had to block
+    std::atomic<uint64_t> resourcesCreated{ 0 };
+    std::atomic<uint64_t> bytesCopied{ 0 };
+    std::atomic<uint64_t> descriptorsWritten{ 0 }; // views created + descriptors copied
+    std::atomic<uint64_t> residencyCalls{ 0 };     // Evict / MakeResident batches
+    std::atomic<uint64_t> evictions{ 0 };
+    std::atomic<uint64_t> makeResidents{ 0 };
+
+    void reset();
+};
+
+// Stand-in for a GPU allocation; its address doubles as the resource handle
+struct NullResource {
+    uint64_t gpuAddress = 0;
+    uint64_t sizeInBytes = 0;
+    uint8_t* data = nullptr; // backing memory for buffers -> copies really move bytes
+    bool resident = true;
+};
+
+class NullDevice : public RhiDevice {
+    public:
+        explicit NullDevice(const NullDeviceConfig& config = {});
+        ~NullDevice() override;
+
+        std::unique_ptr<RhiCommandQueue> createCommandQueue(
+            RhiCommandListType type,
+            RhiQueuePriority priority = RhiQueuePriority::Normal
+        ) override;
+
+        std::unique_ptr<RhiSwapchain> createSwapchain(
+            const RhiSwapchainDesc& desc,
+            RhiCommandQueue* presentQueue
+        ) override;
+
+        std::unique_ptr<RhiDescriptorHeap> createDescriptorHeap(
+            RhiDescriptorHeapType type,
+            uint32_t numDescriptors,
+            bool shaderVisible = false
+        ) override;
+
+        DescriptorAllocator* getDescriptorAllocator(RhiDescriptorHeapType type) override {
+            return descriptorAllocators[static_cast<uint32_t>(type)].get();
+        }
+
+        void copyDescriptors(
+            RhiCpuDescriptor destination,
+            RhiCpuDescriptor source,
+            uint32_t count,
+            RhiDescriptorHeapType type
+        ) override;
+
+        void createConstantBufferView(uint64_t gpuAddress, uint32_t sizeInBytes, RhiCpuDescriptor destination) override;
+
+        std::unique_ptr<RhiPipeline> createPipeline(const RhiPipelineDesc& desc) override;
+        std::unique_ptr<RhiPipeline> createComputePipeline(const RhiComputePipelineDesc& desc) override;
+        std::unique_ptr<RhiCommandSignature> createCommandSignature(
+            const RhiCommandSignatureDesc& desc,
+            RhiPipeline* pipeline = nullptr
+        ) override;
+        std::unique_ptr<RhiFenceEvent> createFenceEvent() override;
+
+        std::unique_ptr<RhiBuffer> createVertexBuffer(const void* data, uint32_t count, uint32_t stride) override;
+        std::unique_ptr<RhiBuffer> createIndexBuffer(const uint32_t* indices, uint32_t count) override;
+        std::unique_ptr<RhiBuffer> createConstantBuffer(uint32_t size) override;
+        std::unique_ptr<RhiBuffer> createBuffer(const RhiBufferDesc& desc) override;
+
+        // textures have no backing memory, buffer heaps do -> aliased buffers really share bytes
+        std::unique_ptr<RhiHeap> createHeap(uint64_t size, RhiHeapUsage usage) override;
+        RhiAllocationInfo getTextureAllocationInfo(const RhiTextureDesc& desc) override;
+        std::unique_ptr<RhiTexture> createPlacedTexture(RhiHeap* heap, uint64_t offset, const RhiTextureDesc& desc) override;
+        std::unique_ptr<RhiBuffer> createPlacedBuffer(RhiHeap* heap, uint64_t offset, const RhiBufferDesc& desc) override;
+
+        void createRenderTargetView(RhiTexture* texture, RhiCpuDescriptor destination) override;
+        void createDepthStencilView(RhiTexture* texture, RhiCpuDescriptor destination) override;
+
+        // usage = resident bytes of every live buffer
+        RhiMemoryBudget getMemoryBudget() override;
+        void evict(const RhiPageable* pageables, uint32_t count) override;
+        void makeResident(const RhiPageable* pageables, uint32_t count) override;
+
+        // buffers report their memory here
+        void addResidentBytes(uint64_t size) {
+            residentBytes += size;
+        }
+
+        void removeResidentBytes(uint64_t size) {
+            residentBytes -= size;
+        }
+
+        // Hands out fake, 256-byte aligned GPU virtual addresses
+        uint64_t allocateAddressRange(uint64_t size);
+
+        const NullDeviceConfig& getConfig() const {
+            return config;
+        }
+
+        NullDeviceStats& getStats() {
+            return stats;
+        }
+
+        // Simulated fences report progress here so fence events can sleep instead of polling
+        void notifyProgress();
+
+        std::mutex& getProgressMutex() {
+            return progressMutex;
+        }
+
+        std::condition_variable& getProgressCondition() {
+            return progressCondition;
+        }
+
+    private:
+        NullDeviceConfig config;
+        NullDeviceStats stats;
+
+        std::atomic<uint64_t> nextAddress{ 0x10000 };
+        std::atomic<uint64_t> residentBytes{ 0 };
+
+        std::mutex progressMutex;
+        std::condition_variable progressCondition;
+
+        // last -> released first, their pages allocate addresses from this device
+        std::unique_ptr<DescriptorAllocator> descriptorAllocators[4];
+};
+
+class NullHeap : public RhiHeap {
+    public:
+        NullHeap(NullDevice* device, uint64_t size, RhiHeapUsage usage);
+        ~NullHeap() override;
+
+        uint64_t getSize() const override {
+            return resource.sizeInBytes;
+        }
+
+        RhiHeapUsage getUsage() const override {
+            return usage;
+        }
+
+        RhiPageable getPageable() const override {
+            return { const_cast<NullResource*>(&resource) };
+        }
+
+        uint64_t getGPUAddress() const {
+            return resource.gpuAddress;
+        }
+
+        uint8_t* getData() {
+            return resource.data;
+        }
+
+    private:
+        NullDevice* device = nullptr;
+        NullResource resource;
+        RhiHeapUsage usage;
+        std::vector<uint8_t> storage;
+};
+
+class NullTexture : public RhiTexture {
+    public:
+        NullTexture(const RhiTextureDesc& desc, uint64_t gpuAddress, uint64_t size) : desc(desc) {
+            resource.gpuAddress = gpuAddress;
+            resource.sizeInBytes = size;
+        }
+
+        RhiResourceHandle getHandle() const override {
+            return { const_cast<NullResource*>(&resource) };
+        }
+
+        const RhiTextureDesc& getDesc() const override {
+            return desc;
+        }
+
+    private:
+        RhiTextureDesc desc;
+        NullResource resource;
+};
+
+class NullBuffer : public RhiBuffer {
+    public:
+        NullBuffer(NullDevice* device, uint64_t size, uint32_t count, uint32_t stride, bool cpuWritable);
+
+        // placed -> lives in the heap's memory, the heap counts as resident
+        NullBuffer(NullDevice* device, NullHeap* heap, uint64_t offset, uint64_t size, uint32_t count, uint32_t stride);
+
+        ~NullBuffer() override;
+
+        RhiResourceHandle getHandle() const override {
+            return { const_cast<NullResource*>(&resource) };
+        }
+
+        uint64_t getGPUAddress() const override {
+            return resource.gpuAddress;
+        }
+
+        uint32_t getSize() const override {
+            return static_cast<uint32_t>(resource.sizeInBytes);
+        }
+
+        uint32_t getCount() const override {
+            return count;
+        }
+
+        uint32_t getStride() const override {
+            return stride;
+        }
+
+        void update(const void* data, size_t size) override;
+
+        void* getMappedData() const override {
+            return cpuWritable ? resource.data : nullptr;
+        }
+
+        // placed -> the heap, shared with every buffer placed in it
+        RhiPageable getPageable() const override {
+            return heap ? heap->getPageable() : RhiPageable{ const_cast<NullResource*>(&resource) };
+        }
+
+        uint64_t getPageableSize() const override {
+            return heap ? heap->getSize() : resource.sizeInBytes;
+        }
+
+        uint8_t* getData() {
+            return resource.data;
+        }
+
+    private:
+        NullDevice* device = nullptr;
+        NullHeap* heap = nullptr; // placed buffers only
+        NullResource resource;
+        std::vector<uint8_t> storage;
+        uint32_t count = 0;
+        uint32_t stride = 0;
+        bool cpuWritable = false;
+};
+
+class NullDescriptorHeap : public RhiDescriptorHeap {
+    public:
+        NullDescriptorHeap(NullDevice* device, RhiDescriptorHeapType type, uint32_t numDescriptors, bool shaderVisible);
+
+        RhiCpuDescriptor getCPUDescriptor(uint32_t index) const override;
+        RhiGpuDescriptor getGPUDescriptor(uint32_t index) const override;
+
+        uint32_t getDescriptorSize() const override {
+            return descriptorSize;
+        }
+
+        uint32_t getNumDescriptors() const override {
+            return numDescriptors;
+        }
+
+    private:
+        static constexpr uint32_t descriptorSize = 32;
+
+        RhiDescriptorHeapType type;
+        uint32_t numDescriptors = 0;
+        bool shaderVisible = false;
+        uint64_t base = 0;
+};
+
+class NullPipeline : public RhiPipeline {
+    public:
+        explicit NullPipeline(const RhiPipelineDesc& desc) : desc(desc) {}
+
+        const RhiPipelineDesc& getDesc() const {
+            return desc;
+        }
+
+    private:
+        RhiPipelineDesc desc;
+};
+
+// No shader runs on the null device -> compute dispatches only count
+class NullComputePipeline : public RhiPipeline {
+    public:
+        explicit NullComputePipeline(const RhiComputePipelineDesc& desc) : desc(desc) {}
+
+        const RhiComputePipelineDesc& getDesc() const {
+            return desc;
+        }
+
+    private:
+        RhiComputePipelineDesc desc;
+};
+
+class NullCommandSignature : public RhiCommandSignature {
+    public:
+        explicit NullCommandSignature(const RhiCommandSignatureDesc& desc) : desc(desc) {}
+
+        uint32_t getByteStride() const override {
+            return desc.byteStride;
+        }
+
+        // last argument is the draw / dispatch every command ends in
+        bool isDispatch() const {
+            return desc.arguments.back().type == RhiIndirectArgumentType::Dispatch;
+        }
+
+    private:
+        RhiCommandSignatureDesc desc;
+};
+
+class NullSwapchain : public RhiSwapchain {
+    public:
+        NullSwapchain(NullDevice* device, const RhiSwapchainDesc& desc, RhiCommandQueue* presentQueue);
+        ~NullSwapchain() override;
+
+        void present() override;
+        void resize(uint32_t width, uint32_t height) override;
+
+        bool waitForNextFrame(uint32_t timeoutMs = 1000) override;
+        void setFrameLatency(uint32_t frameLatency) override;
+
+        uint32_t getCurrentBackBufferIndex() const override {
+            return currentIndex;
+        }
+
+        uint32_t getBufferCount() const override {
+            return bufferCount;
+        }
+
+        RhiResourceHandle getBackBufferHandle(uint32_t index) const override {
+            return { const_cast<NullResource*>(&backBuffers[index]) };
+        }
+
+        RhiCpuDescriptor getRenderTargetView(uint32_t index) const override {
+            return rtvs.get(index);
+        }
+
+    private:
+        NullDevice* device = nullptr;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t bufferCount = 0;
+        uint32_t currentIndex = 0;
+
+        // frame-latency semaphore: wait n may pass once present n - frameLatency completed on the GPU.
+        // present and wait may come from different threads (pipelined frame loop)
+        static constexpr uint32_t PRESENT_HISTORY = 16;
+
+        RhiCommandQueue* presentQueue = nullptr;
+        std::mutex latencyMutex;
+        std::condition_variable presented;
+        uint32_t frameLatency = 2;
+        uint64_t presentCount = 0;
+        uint64_t waitCount = 0;
+        uint64_t presentFences[PRESENT_HISTORY] = {}; // fence of the work each present followed
+
+        std::vector<NullResource> backBuffers;
+        DescriptorAllocation rtvs;
+};
@@ -0,0 +1,576 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Thin render-hardware interface.
+// The D3D12 classes (Device, CommandQueue, Swapchain, ...) implement it on Windows,
+// the null backend (rhi/null) implements it everywhere so the frame loop can run headless.
+//
+// Enum values mirror their D3D12 / DXGI counterparts so the D3D12 backend can static_cast.
+
+class RhiCommandQueue;
+class DescriptorAllocator;
+
+enum class RhiCommandListType : uint32_t {
+    Direct = 0,
+    Compute = 2,
+    Copy = 3
+};
+
+enum class RhiQueuePriority : uint32_t {
+    Normal = 0,
+    High = 100,
+    GlobalRealtime = 10000
+};
+
+enum class RhiDescriptorHeapType : uint32_t {
+    CbvSrvUav = 0,
+    Sampler = 1,
+    Rtv = 2,
+    Dsv = 3
+};
+
+enum class RhiHeapType : uint32_t {
+    Default = 1,
+    Upload = 2,
+    Readback = 3
+};
+
+enum class RhiFormat : uint32_t {
+    Unknown = 0,
+    R32G32B32A32Float = 2,
+    R8G8B8A8Unorm = 28,
+    R32Uint = 42,
+    D24UnormS8Uint = 45,
+    R16Uint = 57
+};
+
+enum class RhiResourceState : uint32_t {
+    Common = 0,
+    VertexAndConstantBuffer = 0x1,
+    IndexBuffer = 0x2,
+    RenderTarget = 0x4,
+    UnorderedAccess = 0x8,
+    DepthWrite = 0x10,
+    DepthRead = 0x20,
+    NonPixelShaderResource = 0x40,
+    PixelShaderResource = 0x80,
+    IndirectArgument = 0x200,
+    CopyDest = 0x400,
+    CopySource = 0x800,
+    GenericRead = 0x1 | 0x2 | 0x40 | 0x80 | 0x200 | 0x800,
+    Present = 0
+};
+
+inline RhiResourceState operator|(RhiResourceState a, RhiResourceState b) {
+    return static_cast<RhiResourceState>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+}
+
+inline RhiResourceState operator&(RhiResourceState a, RhiResourceState b) {
+    return static_cast<RhiResourceState>(static_cast<uint32_t>(a) & static_cast<uint32_t>(b));
+}
+
+// D3D12_RESOURCE_FLAGS subset
+enum class RhiTextureUsage : uint32_t {
+    None = 0,
+    RenderTarget = 0x1,
+    DepthStencil = 0x2,
+    UnorderedAccess = 0x4
+};
+
+inline RhiTextureUsage operator|(RhiTextureUsage a, RhiTextureUsage b) {
+    return static_cast<RhiTextureUsage>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+}
+
+inline RhiTextureUsage operator&(RhiTextureUsage a, RhiTextureUsage b) {
+    return static_cast<RhiTextureUsage>(static_cast<uint32_t>(a) & static_cast<uint32_t>(b));
+}
+
+// What an explicit heap may hold (resource heap tier 1 can't mix these)
+enum class RhiHeapUsage : uint32_t {
+    Buffers = 0,
+    RenderTargets = 1, // render target / depth stencil textures
+    Textures = 2
+};
+
+enum class RhiPrimitiveTopology : uint32_t {
+    TriangleList = 4
+};
+
+enum class RhiInputClassification : uint32_t {
+    PerVertex = 0,
+    PerInstance = 1
+};
+
+enum class RhiShaderVisibility : uint32_t {
+    All = 0,
+    Vertex = 1,
+    Pixel = 5
+};
+
+// Opaque resource identity (ID3D12Resource* on D3D12)
+struct RhiResourceHandle {
+    void* native = nullptr;
+
+    bool operator==(const RhiResourceHandle& other) const {
+        return native == other.native;
+    }
+};
+
+// Unit of residency (ID3D12Pageable* on D3D12 -> the heap of placed resources, the resource itself otherwise)
+struct RhiPageable {
+    void* native = nullptr;
+};
+
+// Local video memory as reported by the OS for this process
+struct RhiMemoryBudget {
+    uint64_t budget = 0;
+    uint64_t usage = 0;
+};
+
+// Split barriers: BeginOnly where the old state's last use ends, EndOnly right before the
+// first use of the new state -> the GPU can do the transition in between
+enum class RhiBarrierFlags : uint32_t {
+    None = 0,
+    BeginOnly = 0x1,
+    EndOnly = 0x2
+};
+
+enum class RhiBarrierType : uint32_t {
+    Transition = 0,
+    Aliasing = 1,
+    Uav = 2
+};
+
+// Aliasing: resource starts using memory that aliasBefore used (null aliasBefore -> any resource)
+// Uav: unordered-access writes to resource finish before the next access to it (states ignored)
+struct RhiResourceBarrier {
+    RhiResourceHandle resource;
+    RhiResourceState before = RhiResourceState::Common;
+    RhiResourceState after = RhiResourceState::Common;
+    RhiBarrierFlags flags = RhiBarrierFlags::None;
+    RhiBarrierType type = RhiBarrierType::Transition;
+    RhiResourceHandle aliasBefore;
+
+    // Transition barrier, every other member at its default
+    static RhiResourceBarrier transition(
+        RhiResourceHandle resource,
+        RhiResourceState before,
+        RhiResourceState after,
+        RhiBarrierFlags flags = RhiBarrierFlags::None
+    ) {
+        RhiResourceBarrier barrier;
+        barrier.resource = resource;
+        barrier.before = before;
+        barrier.after = after;
+        barrier.flags = flags;
+        return barrier;
+    }
+};
+
+struct RhiCpuDescriptor {
+    size_t ptr = 0;
+};
+
+struct RhiGpuDescriptor {
+    uint64_t ptr = 0;
+};
+
+struct RhiViewport {
+    float x = 0.0f;
+    float y = 0.0f;
+    float width = 0.0f;
+    float height = 0.0f;
+    float minDepth = 0.0f;
+    float maxDepth = 1.0f;
+};
+
+struct RhiRect {
+    int32_t left = 0;
+    int32_t top = 0;
+    int32_t right = 0;
+    int32_t bottom = 0;
+};
+
+struct RhiVertexBufferView {
+    uint64_t gpuAddress = 0;
+    uint32_t sizeInBytes = 0;
+    uint32_t strideInBytes = 0;
+};
+
+struct RhiIndexBufferView {
+    uint64_t gpuAddress = 0;
+    uint32_t sizeInBytes = 0;
+    RhiFormat format = RhiFormat::R32Uint;
+};
+
+struct RhiInputElement {
+    const char* semanticName;
+    uint32_t semanticIndex;
+    RhiFormat format;
+    uint32_t inputSlot;
+    uint32_t alignedByteOffset;
+    RhiInputClassification classification = RhiInputClassification::PerVertex;
+    uint32_t instanceStepRate = 0;
+};
+
+enum class RhiRootParameterType : uint32_t {
+    DescriptorTable = 0,
+    Constants = 1,
+    ConstantBufferView = 2,
+    ShaderResourceView = 3,
+    UnorderedAccessView = 4
+};
+
+enum class RhiDescriptorRangeType : uint32_t {
+    Srv = 0,
+    Uav = 1,
+    Cbv = 2
+};
+
+// Root CBV by default.
+// Constants -> num32BitValues inline values at (shaderRegister, registerSpace).
+// DescriptorTable -> one range of rangeType starting at shaderRegister; numDescriptors 0 = unbounded (bindless).
+// ShaderResourceView / UnorderedAccessView -> root descriptor, buffers only (structured / raw).
+struct RhiRootParameter {
+    uint32_t shaderRegister = 0;
+    uint32_t registerSpace = 0;
+    RhiShaderVisibility visibility = RhiShaderVisibility::All;
+    RhiRootParameterType type = RhiRootParameterType::ConstantBufferView;
+    uint32_t num32BitValues = 0;
+    RhiDescriptorRangeType rangeType = RhiDescriptorRangeType::Srv;
+    uint32_t numDescriptors = 0;
+};
+
+struct RhiPipelineDesc {
+    std::wstring vertexShader;
+    std::wstring pixelShader;
+    std::vector<RhiInputElement> inputLayout;
+    std::vector<RhiRootParameter> rootParameters;
+    RhiFormat rtvFormat = RhiFormat::R8G8B8A8Unorm;
+    RhiFormat dsvFormat = RhiFormat::D24UnormS8Uint;
+};
+
+struct RhiComputePipelineDesc {
+    std::wstring computeShader;
+    std::vector<RhiRootParameter> rootParameters;
+};
+
+// D3D12_INDIRECT_ARGUMENT_TYPE subset
+enum class RhiIndirectArgumentType : uint32_t {
+    Draw = 0,
+    DrawIndexed = 1,
+    Dispatch = 2,
+    Constant = 5
+};
+
+// One field of an indirect command, in buffer order.
+// Constant -> num32BitValues root constants at (rootIndex, destOffsetIn32BitValues).
+struct RhiIndirectArgument {
+    RhiIndirectArgumentType type = RhiIndirectArgumentType::DrawIndexed;
+    uint32_t rootIndex = 0;
+    uint32_t destOffsetIn32BitValues = 0;
+    uint32_t num32BitValues = 0;
+};
+
+// Layout of one command in an executeIndirect argument buffer (the draw / dispatch must come last)
+struct RhiCommandSignatureDesc {
+    uint32_t byteStride = 0;
+    std::vector<RhiIndirectArgument> arguments;
+};
+
+struct RhiBufferDesc {
+    uint64_t sizeInBytes = 0;
+    RhiHeapType heapType = RhiHeapType::Default;
+    RhiResourceState initialState = RhiResourceState::Common;
+
+    // element layout for vertex / index views (0 for raw buffers)
+    uint32_t count = 0;
+    uint32_t stride = 0;
+
+    // default heap only -> may be bound as a UAV (written by compute shaders)
+    bool unorderedAccess = false;
+
+    bool operator==(const RhiBufferDesc& other) const = default;
+};
+
+struct RhiTextureDesc {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    RhiFormat format = RhiFormat::R8G8B8A8Unorm;
+    uint32_t mipLevels = 1;
+    RhiTextureUsage usage = RhiTextureUsage::None;
+    RhiResourceState initialState = RhiResourceState::Common;
+
+    // optimized clear value for render target / depth stencil textures
+    float clearColor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float clearDepth = 1.0f;
+
+    bool operator==(const RhiTextureDesc& other) const = default;
+};
+
+struct RhiAllocationInfo {
+    uint64_t size = 0;
+    uint64_t alignment = 0;
+};
+
+// A point on some queue's timeline -> "the work signalled with value on queue".
+// Submissions on other queues declare it as a dependency to consume that work's output.
+struct RhiSyncPoint {
+    RhiCommandQueue* queue = nullptr;
+    uint64_t value = 0;
+};
+
+struct RhiSwapchainDesc {
+    void* window = nullptr; // HWND on D3D12, ignored by the null backend
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t bufferCount = 0;
+    uint32_t frameLatency = 2; // presents the CPU may queue ahead of the display (waitForNextFrame)
+};
+
+class RhiCommandAllocator {
+    public:
+        virtual ~RhiCommandAllocator() = default;
+
+        virtual void reset() = 0;
+};
+
+class RhiPipeline {
+    public:
+        virtual ~RhiPipeline() = default;
+};
+
+class RhiCommandSignature {
+    public:
+        virtual ~RhiCommandSignature() = default;
+
+        virtual uint32_t getByteStride() const = 0;
+};
+
+class RhiBuffer {
+    public:
+        virtual ~RhiBuffer() = default;
+
+        virtual RhiResourceHandle getHandle() const = 0;
+        virtual uint64_t getGPUAddress() const = 0;
+        virtual uint32_t getSize() const = 0;
+
+        // element count / stride -> 0 for raw (constant) buffers
+        virtual uint32_t getCount() const = 0;
+        virtual uint32_t getStride() const = 0;
+
+        // only CPU-visible buffers accept updates
+        virtual void update(const void* data, size_t size) = 0;
+
+        // persistently mapped pointer for upload heap buffers, nullptr otherwise
+        virtual void* getMappedData() const = 0;
+
+        // what has to be resident for the buffer to be usable (shared by buffers placed in one heap)
+        virtual RhiPageable getPageable() const = 0;
+
+        // bytes the pageable accounts for in the budget
+        virtual uint64_t getPageableSize() const = 0;
+};
+
+class RhiTexture {
+    public:
+        virtual ~RhiTexture() = default;
+
+        virtual RhiResourceHandle getHandle() const = 0;
+        virtual const RhiTextureDesc& getDesc() const = 0;
+};
+
+// Explicit memory heap for placed resources
+class RhiHeap {
+    public:
+        virtual ~RhiHeap() = default;
+
+        virtual uint64_t getSize() const = 0;
+        virtual RhiHeapUsage getUsage() const = 0;
+        virtual RhiPageable getPageable() const = 0;
+};
+
+class RhiDescriptorHeap {
+    public:
+        virtual ~RhiDescriptorHeap() = default;
+
+        virtual RhiCpuDescriptor getCPUDescriptor(uint32_t index) const = 0;
+        virtual RhiGpuDescriptor getGPUDescriptor(uint32_t index) const = 0;
+        virtual uint32_t getDescriptorSize() const = 0;
+        virtual uint32_t getNumDescriptors() const = 0;
+};
+
+class RhiCommandList {
+    public:
+        virtual ~RhiCommandList() = default;
+
+        virtual void reset(RhiCommandAllocator* allocator) = 0;
+        virtual void close() = 0;
+
+        // Pipeline state + root signature
+        virtual void setPipeline(RhiPipeline* pipeline) = 0;
+        virtual void setGraphicsRootConstantBufferView(uint32_t rootIndex, uint64_t gpuAddress) = 0;
+        virtual void setGraphicsRoot32BitConstants(uint32_t rootIndex, uint32_t count, const void* data, uint32_t offset = 0) = 0;
+
+        // shader-visible CBV_SRV_UAV heap the descriptor tables point into
+        virtual void setDescriptorHeap(RhiDescriptorHeap* heap) = 0;
+        virtual void setGraphicsRootDescriptorTable(uint32_t rootIndex, RhiGpuDescriptor base) = 0;
+
+        virtual void setViewport(const RhiViewport& viewport) = 0;
+        virtual void setScissorRect(const RhiRect& rect) = 0;
+
+        virtual void transitionResource(
+            RhiResourceHandle resource,
+            RhiResourceState beforeState,
+            RhiResourceState afterState
+        ) = 0;
+
+        // all transitions in one native barrier call
+        virtual void transitionResources(const RhiResourceBarrier* barriers, uint32_t count) = 0;
+
+        virtual void copyBufferRegion(
+            RhiResourceHandle destination,
+            uint64_t destinationOffset,
+            RhiResourceHandle source,
+            uint64_t sourceOffset,
+            uint64_t size
+        ) = 0;
+
+        virtual void setRenderTargets(const RhiCpuDescriptor* rtv, const RhiCpuDescriptor* dsv) = 0;
+        virtual void clearRenderTarget(RhiCpuDescriptor rtv, const float color[4]) = 0;
+        virtual void clearDepth(RhiCpuDescriptor dsv, float depth) = 0;
+
+        virtual void setPrimitiveTopology(RhiPrimitiveTopology topology) = 0;
+        virtual void setVertexBuffer(uint32_t slot, const RhiVertexBufferView& view) = 0;
+        virtual void setIndexBuffer(const RhiIndexBufferView& view) = 0;
+
+        virtual void drawIndexedInstanced(
+            uint32_t indexCount,
+            uint32_t instanceCount,
+            uint32_t startIndex,
+            int32_t baseVertex,
+            uint32_t startInstance
+        ) = 0;
+
+        // Compute -> pipeline from createComputePipeline, its own root arguments
+        virtual void setComputePipeline(RhiPipeline* pipeline) = 0;
+        virtual void setComputeRoot32BitConstants(uint32_t rootIndex, uint32_t count, const void* data, uint32_t offset = 0) = 0;
+        virtual void setComputeRootShaderResourceView(uint32_t rootIndex, uint64_t gpuAddress) = 0;
+        virtual void setComputeRootUnorderedAccessView(uint32_t rootIndex, uint64_t gpuAddress) = 0;
+        virtual void dispatch(uint32_t groupsX, uint32_t groupsY = 1, uint32_t groupsZ = 1) = 0;
+
+        // min(maxCommandCount, the uint32 at countBuffer + countOffset) commands out of arguments
+        // (null countBuffer -> exactly maxCommandCount); both buffers in IndirectArgument state
+        virtual void executeIndirect(
+            RhiCommandSignature* signature,
+            uint32_t maxCommandCount,
+            RhiResourceHandle arguments,
+            uint64_t argumentOffset,
+            RhiResourceHandle countBuffer = {},
+            uint64_t countOffset = 0
+        ) = 0;
+};
+
+// OS-level wait object for fence progress on any number of queues.
+// Only used by RhiFenceWaiter's thread; wake() may be called from anywhere.
+class RhiFenceEvent {
+    public:
+        virtual ~RhiFenceEvent() = default;
+
+        // the next wait() returns once any of the points has been reached
+        virtual void arm(const RhiSyncPoint* points, size_t count) = 0;
+        virtual void wait() = 0;
+        virtual void wake() = 0;
+};
+
+class RhiSwapchain {
+    public:
+        virtual ~RhiSwapchain() = default;
+
+        virtual void present() = 0;
+        virtual void resize(uint32_t width, uint32_t height) = 0;
+
+        // Blocks until fewer than frameLatency presents are queued (DXGI frame-latency waitable object).
+        // Once per frame, before the frame samples its input; false on timeout.
+        virtual bool waitForNextFrame(uint32_t timeoutMs = 1000) = 0;
+        virtual void setFrameLatency(uint32_t frameLatency) = 0;
+
+        virtual uint32_t getCurrentBackBufferIndex() const = 0;
+        virtual uint32_t getBufferCount() const = 0;
+
+        virtual RhiResourceHandle getBackBufferHandle(uint32_t index) const = 0;
+        virtual RhiCpuDescriptor getRenderTargetView(uint32_t index) const = 0;
+};
+
+class RhiDevice {
+    public:
+        virtual ~RhiDevice() = default;
+
+        virtual std::unique_ptr<RhiCommandQueue> createCommandQueue(
+            RhiCommandListType type,
+            RhiQueuePriority priority = RhiQueuePriority::Normal
+        ) = 0;
+
+        virtual std::unique_ptr<RhiSwapchain> createSwapchain(
+            const RhiSwapchainDesc& desc,
+            RhiCommandQueue* presentQueue
+        ) = 0;
+
+        virtual std::unique_ptr<RhiDescriptorHeap> createDescriptorHeap(
+            RhiDescriptorHeapType type,
+            uint32_t numDescriptors,
+            bool shaderVisible = false
+        ) = 0;
+
+        // growable CPU descriptor allocator per heap type, owned by the device
+        virtual DescriptorAllocator* getDescriptorAllocator(RhiDescriptorHeapType type) = 0;
+
+        // destination may live in a shader-visible heap, sources must not
+        virtual void copyDescriptors(
+            RhiCpuDescriptor destination,
+            RhiCpuDescriptor source,
+            uint32_t count,
+            RhiDescriptorHeapType type
+        ) = 0;
+
+        // sizeInBytes must be a multiple of 256
+        virtual void createConstantBufferView(uint64_t gpuAddress, uint32_t sizeInBytes, RhiCpuDescriptor destination) = 0;
+
+        virtual std::unique_ptr<RhiPipeline> createPipeline(const RhiPipelineDesc& desc) = 0;
+        virtual std::unique_ptr<RhiPipeline> createComputePipeline(const RhiComputePipelineDesc& desc) = 0;
+
+        // pipeline -> the graphics pipeline whose root signature Constant arguments write into
+        // (nullptr when the signature only draws / dispatches)
+        virtual std::unique_ptr<RhiCommandSignature> createCommandSignature(
+            const RhiCommandSignatureDesc& desc,
+            RhiPipeline* pipeline = nullptr
+        ) = 0;
+
+        virtual std::unique_ptr<RhiFenceEvent> createFenceEvent() = 0;
+
+        virtual std::unique_ptr<RhiBuffer> createVertexBuffer(const void* data, uint32_t count, uint32_t stride) = 0;
+        virtual std::unique_ptr<RhiBuffer> createIndexBuffer(const uint32_t* indices, uint32_t count) = 0;
+        virtual std::unique_ptr<RhiBuffer> createConstantBuffer(uint32_t size) = 0;
+
+        // generic committed buffer in any heap (upload heap buffers stay mapped)
+        virtual std::unique_ptr<RhiBuffer> createBuffer(const RhiBufferDesc& desc) = 0;
+
+        // Placed resources -> several may share (alias) the same heap memory
+        virtual std::unique_ptr<RhiHeap> createHeap(uint64_t size, RhiHeapUsage usage) = 0;
+        virtual RhiAllocationInfo getTextureAllocationInfo(const RhiTextureDesc& desc) = 0;
+        virtual std::unique_ptr<RhiTexture> createPlacedTexture(RhiHeap* heap, uint64_t offset, const RhiTextureDesc& desc) = 0;
+        virtual std::unique_ptr<RhiBuffer> createPlacedBuffer(RhiHeap* heap, uint64_t offset, const RhiBufferDesc& desc) = 0;
+
+        virtual void createRenderTargetView(RhiTexture* texture, RhiCpuDescriptor destination) = 0;
+        virtual void createDepthStencilView(RhiTexture* texture, RhiCpuDescriptor destination) = 0;
+
+        // Residency -> the GPU must not reference an evicted pageable until it is made resident again
+        virtual RhiMemoryBudget getMemoryBudget() = 0;
+        virtual void evict(const RhiPageable* pageables, uint32_t count) = 0;
+        virtual void makeResident(const RhiPageable* pageables, uint32_t count) = 0;
+};
@@ -0,0 +1,236 @@
+#include "rhi_command_queue.h"
+#include "utils/logger.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+RhiRecordingContext::RhiRecordingContext(RhiCommandQueue* queue)
+    : queue(queue)
+{
+}
+
+RhiRecordingContext::~RhiRecordingContext() = default;
+
+RhiCommandList* RhiRecordingContext::getCommandList() {
+    std::unique_ptr<RhiCommandAllocator> alloc;
+    std::unique_ptr<RhiCommandList> cmdList;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Oldest retired allocator first -> the only one that can have completed
+        if (!allocatorQueue.empty() && queue->isFenceComplete(allocatorQueue.front().fenceValue)) {
+            alloc = std::move(allocatorQueue.front().allocator);
+            allocatorQueue.pop_front();
+        }
+
+        if (!listPool.empty()) {
+            cmdList = std::move(listPool.back());
+            listPool.pop_back();
+        }
+    }
+
+    // Acquire allocator
+    if (alloc) {
+        alloc->reset();
+    } else {
+        alloc = queue->createCommandAllocator();
+        LOG_INFO(L"Created new CommandAllocator (type %d)", static_cast<int>(queue->getType()));
+    }
+
+    // Acquire command list
+    if (cmdList) {
+        cmdList->reset(alloc.get());
+    } else {
+        cmdList = queue->createCommandList(alloc.get());
+        queue->registerList(cmdList.get(), this);
+        LOG_INFO(L"Created new CommandList (type %d)", static_cast<int>(queue->getType()));
+    }
+
+    RhiCommandList* raw = cmdList.get();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    liveLists[raw] = { std::move(cmdList), std::move(alloc) };
+    return raw;
+}
+
+void RhiRecordingContext::retire(RhiCommandList* list, uint64_t fenceValue) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = liveLists.find(list);
+    if (it == liveLists.end()) {
+        LOG_ERROR(L"Retired command list is not live in its recording context!");
+        throw std::runtime_error("Command list retired twice");
+    }
+
+    // The list can be reset right away, its allocator only once the GPU passed fenceValue
+    allocatorQueue.push_back({ fenceValue, std::move(it->second.allocator) });
+    listPool.push_back(std::move(it->second.list));
+    liveLists.erase(it);
+}
+
+RhiCommandQueue::RhiCommandQueue(RhiCommandListType type, RhiQueuePriority priority)
+    : type(type), priority(priority)
+{
+    defaultContext = createRecordingContext();
+}
+
+// Derived queues flush before their native objects go away,
+// so the pooled allocators / lists are idle by the time they are released here.
+RhiCommandQueue::~RhiCommandQueue() = default;
+
+RhiRecordingContext* RhiCommandQueue::createRecordingContext() {
+    std::lock_guard<std::mutex> lock(contextMutex);
+    contexts.push_back(std::unique_ptr<RhiRecordingContext>(new RhiRecordingContext(this)));
+    return contexts.back().get();
+}
+
+void RhiCommandQueue::registerList(RhiCommandList* list, RhiRecordingContext* owner) {
+    std::lock_guard<std::mutex> lock(contextMutex);
+    listOwners[list] = owner;
+}
+
+RhiCommandList* RhiCommandQueue::getCommandList() {
+    return defaultContext->getCommandList();
+}
+
+uint64_t RhiCommandQueue::executeCommandList(RhiCommandList* cmdList) {
+    return executeCommandLists({ cmdList });
+}
+
+uint64_t RhiCommandQueue::executeCommandLists(const std::vector<RhiCommandList*>& commandLists) {
+    return submitLists(commandLists.data(), commandLists.size(), true);
+}
+
+uint64_t RhiCommandQueue::executeCommandLists(
+    const std::vector<RhiCommandList*>& commandLists,
+    const std::vector<RhiSyncPoint>& dependencies
+) {
+    // one GPU wait per producer queue -> only the latest value matters
+    std::vector<RhiSyncPoint> waits;
+    for (const auto& dependency : dependencies) {
+        auto it = std::find_if(waits.begin(), waits.end(), [&](const RhiSyncPoint& wait) {
+            return wait.queue == dependency.queue;
+        });
+        if (it == waits.end()) {
+            waits.push_back(dependency);
+        } else if (dependency.value > it->value) {
+            it->value = dependency.value;
+        }
+    }
+
+    return submitLists(commandLists.data(), commandLists.size(), true, &waits);
+}
+
+uint64_t RhiCommandQueue::submitLists(
+    RhiCommandList* const* commandLists,
+    size_t count,
+    bool closeLists,
+    const std::vector<RhiSyncPoint>* waits
+) {
+    if (count == 0) {
+        std::lock_guard<std::mutex> lock(submitMutex);
+        for (size_t i = 0; waits && i < waits->size(); ++i) {
+            waitForLocked((*waits)[i]);
+        }
+        return fenceValue.load();
+    }
+
+    std::vector<RhiRecordingContext*> owners(count);
+    {
+        std::lock_guard<std::mutex> lock(contextMutex);
+        for (size_t i = 0; i < count; ++i) {
+            auto it = listOwners.find(commandLists[i]);
+            if (it == listOwners.end()) {
+                LOG_ERROR(L"Executed command list was not acquired from this queue!");
+                throw std::runtime_error("Unknown command list");
+            }
+            owners[i] = it->second;
+        }
+    }
+
+    if (closeLists) {
+        for (size_t i = 0; i < count; ++i) {
+            commandLists[i]->close();
+        }
+    }
+
+    // waits, execute and signal in one step -> another thread's submission can't slip in between
+    // (its signal would land first and the fence would move backwards)
+    uint64_t val = 0;
+    {
+        std::lock_guard<std::mutex> lock(submitMutex);
+        for (size_t i = 0; waits && i < waits->size(); ++i) {
+            waitForLocked((*waits)[i]);
+        }
+        executeNative(static_cast<uint32_t>(count), commandLists);
+        val = signalLocked();
+    }
+
+    // Return lists + allocators to their pools
+    for (size_t i = 0; i < count; ++i) {
+        owners[i]->retire(commandLists[i], val);
+    }
+
+    return val;
+}
+
+uint64_t RhiCommandQueue::signalFence() {
+    std::lock_guard<std::mutex> lock(submitMutex);
+    return signalLocked();
+}
+
+uint64_t RhiCommandQueue::signalLocked() {
+    // under submitMutex -> values reach the native fence in increasing order
+    uint64_t value = fenceValue.fetch_add(1) + 1;
+    signal(value);
+    return value;
+}
+
+bool RhiCommandQueue::isFenceComplete(uint64_t value) {
+    return getCompletedValue() >= value;
+}
+
+uint64_t RhiCommandQueue::getCompletedFenceValue() {
+    return getCompletedValue();
+}
+
+void RhiCommandQueue::fenceWait(uint64_t value) {
+    if (!isFenceComplete(value)) {
+        waitForValue(value);
+    }
+}
+
+void RhiCommandQueue::flush() {
+    fenceWait(signalFence());
+}
+
+void RhiCommandQueue::waitForQueue(RhiCommandQueue* producer, uint64_t value) {
+    std::lock_guard<std::mutex> lock(submitMutex);
+    waitForQueueLocked(producer, value);
+}
+
+void RhiCommandQueue::waitForQueueLocked(RhiCommandQueue* producer, uint64_t value) {
+    // nothing to wait for when the producer already got there
+    if (producer == this || producer->isFenceComplete(value)) {
+        return;
+    }
+    waitOnGpu(producer, value);
+}
+
+void RhiCommandQueue::waitFor(const RhiSyncPoint& dependency) {
+    std::lock_guard<std::mutex> lock(submitMutex);
+    waitForLocked(dependency);
+}
+
+void RhiCommandQueue::waitForLocked(const RhiSyncPoint& dependency) {
+    if (!dependency.queue) {
+        return;
+    }
+    if (dependency.value > dependency.queue->getFenceValue()) {
+        // the producer hasn't signalled it yet -> the GPU would wait forever if it never does
+        LOG_WARNING(L"Waiting on fence value %llu that queue type %d has not signalled yet",
+            static_cast<unsigned long long>(dependency.value), static_cast<int>(dependency.queue->getType()));
+    }
+    waitForQueueLocked(dependency.queue, dependency.value);
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "rhi.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+class RhiCommandQueue;
+class RhiSubmissionBatch;
+
+// Allocator / list pool owned by one recording thread.
+// getCommandList only touches this context, so N threads can record in parallel
+// without contending; the submitting thread hands allocators back once they are retired.
+class RhiRecordingContext {
+public:
+    ~RhiRecordingContext();
+
+    RhiCommandList* getCommandList();
+
+    RhiCommandQueue* getQueue() const { return queue; }
+
+private:
+    friend class RhiCommandQueue;
+
+    explicit RhiRecordingContext(RhiCommandQueue* queue);
+
+    // Called by the submitting thread after the list went to the GPU with fenceValue
+    void retire(RhiCommandList* list, uint64_t fenceValue);
+
+private:
+    struct AllocatorEntry {
+        uint64_t fenceValue = 0;
+        std::unique_ptr<RhiCommandAllocator> allocator;
+    };
+
+    struct ListEntry {
+        std::unique_ptr<RhiCommandList> list;
+        std::unique_ptr<RhiCommandAllocator> allocator;
+    };
+
+    RhiCommandQueue* queue = nullptr;
+
+    // only contended between the owning thread and the submitting thread
+    std::mutex mutex;
+    std::deque<AllocatorEntry> allocatorQueue; // ordered by fence value
+    std::vector<std::unique_ptr<RhiCommandList>> listPool;
+    std::unordered_map<RhiCommandList*, ListEntry> liveLists;
+};
+
+// Backend-independent half of a command queue: allocator / list pooling and fence bookkeeping.
+// Backends only provide the native create / execute / signal / wait hooks.
+// Any thread may submit: GPU waits, execute and signal of one submission happen under one
+// mutex, so fence values reach the native fence in order and always follow their lists.
+class RhiCommandQueue {
+public:
+    RhiCommandQueue(RhiCommandListType type, RhiQueuePriority priority);
+    virtual ~RhiCommandQueue();
+
+    // Command List (single threaded convenience -> default recording context)
+    RhiCommandList* getCommandList();
+    uint64_t executeCommandList(RhiCommandList* commandList);
+
+    // One pool per recording thread; owned by the queue
+    RhiRecordingContext* createRecordingContext();
+
+    // Closes and submits lists in order with one native execute and one fence signal.
+    // Lists may come from any recording context of this queue.
+    uint64_t executeCommandLists(const std::vector<RhiCommandList*>& commandLists);
+
+    // Same, but the GPU only starts the lists once every dependency has been reached
+    uint64_t executeCommandLists(
+        const std::vector<RhiCommandList*>& commandLists,
+        const std::vector<RhiSyncPoint>& dependencies
+    );
+
+    // Fence
+    uint64_t signalFence();
+    void fenceWait(uint64_t value);
+    bool isFenceComplete(uint64_t value);
+    uint64_t getCompletedFenceValue();
+    void flush();
+
+    // GPU-side wait: work submitted to this queue afterwards starts only once
+    // producer's fence reaches value. The CPU does not block.
+    void waitForQueue(RhiCommandQueue* producer, uint64_t value);
+    void waitFor(const RhiSyncPoint& dependency);
+
+    // Sync point for a value returned by execute / signalFence on this queue
+    RhiSyncPoint getSyncPoint(uint64_t value) {
+        return { this, value };
+    }
+
+    // Getters
+    RhiCommandListType getType() const { return type; }
+    RhiQueuePriority getPriority() const { return priority; }
+    uint64_t getFenceValue() const { return fenceValue.load(); }
+
+protected:
+    friend class RhiRecordingContext;
+    friend class RhiSubmissionBatch;
+
+    // Native hooks
+    virtual std::unique_ptr<RhiCommandAllocator> createCommandAllocator() = 0;
+    virtual std::unique_ptr<RhiCommandList> createCommandList(RhiCommandAllocator* allocator) = 0; // returned open
+    virtual void executeNative(uint32_t count, RhiCommandList* const* lists) = 0;
+    virtual void signal(uint64_t value) = 0;
+    virtual uint64_t getCompletedValue() = 0;
+    virtual void waitForValue(uint64_t value) = 0; // blocks until the fence reaches value
+    virtual void waitOnGpu(RhiCommandQueue* producer, uint64_t value) = 0;
+
+private:
+    void registerList(RhiCommandList* list, RhiRecordingContext* owner);
+
+    // closeLists = false when the recorders already closed them (submission batches);
+    // waits -> GPU waits issued right before the execute
+    uint64_t submitLists(
+        RhiCommandList* const* lists,
+        size_t count,
+        bool closeLists,
+        const std::vector<RhiSyncPoint>* waits = nullptr
+    );
+
+    // callers hold submitMutex
+    uint64_t signalLocked();
+    void waitForLocked(const RhiSyncPoint& dependency);
+    void waitForQueueLocked(RhiCommandQueue* producer, uint64_t value);
+
+private:
+    RhiCommandListType type;
+    RhiQueuePriority priority;
+
+    std::mutex contextMutex;
+    std::vector<std::unique_ptr<RhiRecordingContext>> contexts;
+    RhiRecordingContext* defaultContext = nullptr;
+
+    // lists never migrate between contexts -> written once when a list is created
+    std::unordered_map<RhiCommandList*, RhiRecordingContext*> listOwners;
+
+    // one submission (waits + execute + signal) at a time
+    std::mutex submitMutex;
+
+    // read without the mutex by other queues (waitFor on a producer) and getFenceValue
+    std::atomic<uint64_t> fenceValue{ 0 };
+};
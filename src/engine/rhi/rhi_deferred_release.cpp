@@ -0,0 +1,96 @@
+#include "rhi_deferred_release.h"
+#include "utils/logger.h"
+
+#include <algorithm>
+
+RhiDeferredReleaseQueue::~RhiDeferredReleaseQueue() {
+    flush();
+}
+
+void RhiDeferredReleaseQueue::retire(const RhiSyncPoint& point, std::function<void()> release) {
+    // no queue / value 0 -> never used by the GPU
+    if (!point.queue || point.value == 0) {
+        release();
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = std::find_if(queues.begin(), queues.end(), [&](const QueueTimeline& entry) {
+        return entry.queue == point.queue;
+    });
+    if (it == queues.end()) {
+        queues.push_back({ point.queue, {} });
+        it = queues.end() - 1;
+    }
+    it->timeline.add(point.value, std::move(release));
+}
+
+size_t RhiDeferredReleaseQueue::collect() {
+    std::vector<std::function<void()>> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& entry : queues) {
+            if (!entry.timeline.empty()) {
+                entry.timeline.collect(entry.queue->getCompletedFenceValue(), ready);
+            }
+        }
+    }
+
+    // outside the lock -> a release may retire something else
+    for (auto& release : ready) {
+        release();
+    }
+    return ready.size();
+}
+
+void RhiDeferredReleaseQueue::flush() {
+    // a release callback may retire more -> repeat until nothing is left
+    for (;;) {
+        std::vector<RhiSyncPoint> waits;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const auto& entry : queues) {
+                if (!entry.timeline.empty()) {
+                    waits.push_back({ entry.queue, entry.timeline.getLastValue() });
+                }
+            }
+        }
+
+        if (waits.empty()) {
+            return;
+        }
+
+        for (auto& wait : waits) {
+            uint64_t signalled = wait.queue->getFenceValue();
+            if (wait.value > signalled) {
+                // would block forever -> release at what has been signalled
+                LOG_WARNING(L"RhiDeferredReleaseQueue -> Flushing objects tagged with unsignalled fence value %llu",
+                    static_cast<unsigned long long>(wait.value));
+                wait.value = signalled;
+            }
+            wait.queue->fenceWait(wait.value);
+        }
+
+        std::vector<std::function<void()>> ready;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto& entry : queues) {
+                entry.timeline.collect(~0ull, ready);
+            }
+        }
+        for (auto& release : ready) {
+            release();
+        }
+    }
+}
+
+size_t RhiDeferredReleaseQueue::getPendingCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    size_t count = 0;
+    for (const auto& entry : queues) {
+        count += entry.timeline.size();
+    }
+    return count;
+}
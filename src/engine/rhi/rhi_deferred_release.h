@@ -0,0 +1,50 @@
+#pragma once
+
+#include "rhi_fence_waiter.h"
+
+// Keeps retired GPU objects alive until the last submission that used them has completed,
+// so replacing a resource doesn't need a flush. Objects (or any release callback: descriptor
+// ranges, heap ranges, bindless indices) are tagged with a sync point and dropped by collect()
+// on the thread that calls it -> destruction happens at a well-defined spot in the frame.
+class RhiDeferredReleaseQueue {
+public:
+    RhiDeferredReleaseQueue() = default;
+
+    // Waits for every tagged fence, then releases everything still pending
+    ~RhiDeferredReleaseQueue();
+
+    // point = the sync point of the last submission that references the object
+    void retire(const RhiSyncPoint& point, std::function<void()> release);
+
+    template <typename T>
+    void retire(const RhiSyncPoint& point, std::unique_ptr<T> object) {
+        if (!object) {
+            return;
+        }
+        std::shared_ptr<T> held(std::move(object)); // std::function needs a copyable capture
+        retire(point, [held]() mutable { held.reset(); });
+    }
+
+    // Tagged with the last value signalled on queue -> for objects only used by work already submitted
+    template <typename T>
+    void retire(RhiCommandQueue* queue, std::unique_ptr<T> object) {
+        retire(queue->getSyncPoint(queue->getFenceValue()), std::move(object));
+    }
+
+    // Releases everything whose fence has completed; returns how many were released
+    size_t collect();
+
+    // Blocks until every tagged fence completed and releases everything
+    void flush();
+
+    size_t getPendingCount();
+
+private:
+    struct QueueTimeline {
+        RhiCommandQueue* queue = nullptr;
+        RhiFenceTimeline timeline;
+    };
+
+    std::mutex mutex;
+    std::vector<QueueTimeline> queues;
+};
@@ -0,0 +1,136 @@
+#include "rhi_fence_waiter.h"
+#include "rhi_command_queue.h"
+#include "utils/logger.h"
+
+#include <algorithm>
+
+void RhiFenceTimeline::add(uint64_t value, std::function<void()> callback) {
+    pending.emplace(value, std::move(callback));
+}
+
+void RhiFenceTimeline::collect(uint64_t completedValue, std::vector<std::function<void()>>& ready) {
+    auto end = pending.upper_bound(completedValue);
+    for (auto it = pending.begin(); it != end; ++it) {
+        ready.push_back(std::move(it->second));
+    }
+    pending.erase(pending.begin(), end);
+}
+
+uint64_t RhiFenceTimeline::getNextValue() const {
+    return pending.empty() ? 0 : pending.begin()->first;
+}
+
+uint64_t RhiFenceTimeline::getLastValue() const {
+    return pending.empty() ? 0 : pending.rbegin()->first;
+}
+
+RhiFenceWaiter::RhiFenceWaiter(RhiDevice* device) {
+    event = device->createFenceEvent();
+    thread = std::thread(&RhiFenceWaiter::run, this);
+    LOG_INFO(L"RhiFenceWaiter -> Waiter thread started");
+}
+
+RhiFenceWaiter::~RhiFenceWaiter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    event->wake();
+    thread.join();
+
+    size_t dropped = 0;
+    for (const auto& entry : timelines) {
+        dropped += entry.timeline.size();
+    }
+    if (dropped > 0) {
+        LOG_WARNING(L"RhiFenceWaiter -> %zu fence callbacks dropped on shutdown", dropped);
+    }
+}
+
+void RhiFenceWaiter::onFenceComplete(const RhiSyncPoint& point, std::function<void()> fn) {
+    if (point.queue->isFenceComplete(point.value)) {
+        fn();
+        return;
+    }
+    if (!enqueue(point, fn)) {
+        fn(); // completed between the check and the registration
+    }
+}
+
+bool RhiFenceWaiter::enqueue(const RhiSyncPoint& point, std::function<void()> fn) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // checked under the lock -> the waiter thread can't have missed it
+        if (point.queue->isFenceComplete(point.value)) {
+            return false;
+        }
+
+        auto it = std::find_if(timelines.begin(), timelines.end(), [&](const QueueTimeline& entry) {
+            return entry.queue == point.queue;
+        });
+        if (it == timelines.end()) {
+            timelines.push_back({ point.queue, {} });
+            it = timelines.end() - 1;
+        }
+
+        // only a new earliest value changes what the thread has to wait for
+        bool wake = it->timeline.empty() || point.value < it->timeline.getNextValue();
+        it->timeline.add(point.value, std::move(fn));
+        if (!wake) {
+            return true;
+        }
+    }
+
+    event->wake();
+    return true;
+}
+
+size_t RhiFenceWaiter::getPendingCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    size_t count = 0;
+    for (const auto& entry : timelines) {
+        count += entry.timeline.size();
+    }
+    return count;
+}
+
+void RhiFenceWaiter::run() {
+    std::vector<std::function<void()>> ready;
+    std::vector<RhiSyncPoint> points;
+
+    while (true) {
+        ready.clear();
+        points.clear();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping) {
+                break;
+            }
+
+            for (auto& entry : timelines) {
+                if (entry.timeline.empty()) {
+                    continue;
+                }
+                entry.timeline.collect(entry.queue->getCompletedFenceValue(), ready);
+                if (!entry.timeline.empty()) {
+                    points.push_back({ entry.queue, entry.timeline.getNextValue() });
+                }
+            }
+        }
+
+        // outside the lock -> callbacks may register new waits
+        for (auto& callback : ready) {
+            callback();
+        }
+
+        if (!ready.empty()) {
+            continue; // recheck before sleeping, the callbacks may have queued more
+        }
+
+        event->arm(points.data(), points.size());
+        event->wait();
+    }
+}
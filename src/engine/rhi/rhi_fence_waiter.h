@@ -0,0 +1,99 @@
+#pragma once
+
+#include "rhi_command_queue.h"
+#include <coroutine>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+// Pending callbacks of one queue, ordered by fence value.
+// Pure bookkeeping -> no threads, no GPU, so it can be driven by any timeline.
+class RhiFenceTimeline {
+public:
+    void add(uint64_t value, std::function<void()> callback);
+
+    // Moves every callback with value <= completedValue into ready (in value order)
+    void collect(uint64_t completedValue, std::vector<std::function<void()>>& ready);
+
+    // Smallest pending value, 0 when empty
+    uint64_t getNextValue() const;
+
+    // Largest pending value, 0 when empty
+    uint64_t getLastValue() const;
+
+    bool empty() const { return pending.empty(); }
+    size_t size() const { return pending.size(); }
+
+private:
+    // multimap keeps insertion order for equal values
+    std::multimap<uint64_t, std::function<void()>> pending;
+};
+
+// One background thread that watches the fences of every queue and runs callbacks
+// once their value completes -> nobody has to block in fenceWait or poll isFenceComplete.
+//
+// Callbacks run on the waiter thread (or inline, see onFenceComplete) and should stay short.
+// The waiter must be destroyed before the queues it watches; callbacks still pending then are dropped.
+class RhiFenceWaiter {
+public:
+    explicit RhiFenceWaiter(RhiDevice* device);
+    ~RhiFenceWaiter();
+
+    // Runs fn once point.queue reaches point.value.
+    // Already complete -> runs immediately on the calling thread.
+    void onFenceComplete(const RhiSyncPoint& point, std::function<void()> fn);
+
+    // Queues fn without the inline shortcut; returns false (and drops fn) when point already completed
+    bool enqueue(const RhiSyncPoint& point, std::function<void()> fn);
+
+    size_t getPendingCount();
+
+private:
+    void run();
+
+private:
+    struct QueueTimeline {
+        RhiCommandQueue* queue = nullptr;
+        RhiFenceTimeline timeline;
+    };
+
+    std::unique_ptr<RhiFenceEvent> event;
+
+    std::mutex mutex;
+    std::vector<QueueTimeline> timelines;
+    bool stopping = false;
+
+    std::thread thread;
+};
+
+// co_await support: suspends until the fence value completes, resumes on the waiter thread.
+//
+//     co_await RhiFenceAwaitable{ waiter, queue->getSyncPoint(value) };
+struct RhiFenceAwaitable {
+    RhiFenceWaiter* waiter = nullptr;
+    RhiSyncPoint point;
+
+    bool await_ready() const {
+        return point.queue->isFenceComplete(point.value);
+    }
+
+    // false -> completed in the meantime, carry on without suspending
+    bool await_suspend(std::coroutine_handle<> handle) const {
+        return waiter->enqueue(point, [handle] { handle.resume(); });
+    }
+
+    void await_resume() const {}
+};
+
+// Minimal fire-and-forget coroutine type for fence-driven work (loaders, readbacks).
+// Starts eagerly, frees itself when it finishes.
+struct RhiDetachedTask {
+    struct promise_type {
+        RhiDetachedTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
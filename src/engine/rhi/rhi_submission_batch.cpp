@@ -0,0 +1,40 @@
+#include "rhi_submission_batch.h"
+#include "rhi_command_queue.h"
+
+#include <algorithm>
+
+RhiSubmissionBatch::RhiSubmissionBatch(RhiCommandQueue* queue)
+    : queue(queue)
+{
+}
+
+void RhiSubmissionBatch::add(RhiCommandList* list, uint32_t order) {
+    // close outside the lock -> recording threads pay for their own validation in parallel
+    list->close();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.push_back({ order, sequence++, list });
+}
+
+uint64_t RhiSubmissionBatch::submit() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.order != b.order ? a.order < b.order : a.sequence < b.sequence;
+    });
+
+    submitLists.clear();
+    for (const auto& entry : entries) {
+        submitLists.push_back(entry.list);
+    }
+
+    entries.clear();
+    sequence = 0;
+
+    return queue->submitLists(submitLists.data(), submitLists.size(), false);
+}
+
+size_t RhiSubmissionBatch::size() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "rhi.h"
+#include <mutex>
+
+class RhiCommandQueue;
+
+// Collects closed command lists (from any recording thread) and submits them with
+// one native execute and one fence signal; every allocator in the batch retires against that value.
+//
+// Lists run in ascending `order`; lists added with the same order keep their add order.
+class RhiSubmissionBatch {
+public:
+    explicit RhiSubmissionBatch(RhiCommandQueue* queue);
+
+    // Closes the list on the calling thread and queues it. Thread-safe.
+    void add(RhiCommandList* list, uint32_t order = 0);
+
+    // Submits everything added so far and empties the batch.
+    // Returns the fence value the batch completes at (the current value when empty).
+    uint64_t submit();
+
+    size_t size();
+
+private:
+    struct Entry {
+        uint32_t order = 0;
+        uint32_t sequence = 0;
+        RhiCommandList* list = nullptr;
+    };
+
+    RhiCommandQueue* queue = nullptr;
+
+    std::mutex mutex;
+    std::vector<Entry> entries;
+    std::vector<RhiCommandList*> submitLists;
+    uint32_t sequence = 0;
+};
@@ -51,6 +51,12 @@ void Camera::updateViewMatrix() {
     view = XMMatrixLookAtLH(pos, tgt, up);
 }
 
+CullPlanes Camera::getFrustumPlanes() const {
+    XMFLOAT4X4 viewProjection;
+    XMStoreFloat4x4(&viewProjection, getViewProjectionMatrix());
+    return FrustumCuller::extractPlanes(viewProjection.m);
+}
+
 void Camera::update(float delta) {
     updateViewMatrix();
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "utils/pch.h"
+#include "engine/frustum_culler.h"
 
 class Camera {
 public:
@@ -52,6 +53,9 @@ public:
         return XMMatrixMultiply(view, projection);
     }
 
+    // world-space view frustum (inward, normalized) -> FrustumCuller / IndirectDrawCuller input
+    CullPlanes getFrustumPlanes() const;
+
     float getFov() const { 
         return fov; 
     }
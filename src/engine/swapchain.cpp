@@ -6,11 +6,14 @@ Swapchain::Swapchain(
     ComPtr<ID3D12CommandQueue> commandQueue, 
     UINT width, UINT height,
     uint32_t bufferCount, 
-    bool tearingSupport
+    uint32_t frameLatency,
+    bool tearingSupport,
+    DescriptorAllocator* rtvAllocator
 ) :
     device(device),
     bufferCount(bufferCount),
-    tearingSupport(tearingSupport)
+    tearingSupport(tearingSupport),
+    rtvAllocator(rtvAllocator)
 {
     swapchain = createSwapchain(
         hwnd,
@@ -21,15 +24,24 @@ Swapchain::Swapchain(
         tearingSupport
     );
 
-    rtvHeap = std::make_unique<DescriptorHeap>(device, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, bufferCount);
-    dsvHeap = std::make_unique<DescriptorHeap>(device, D3D12_DESCRIPTOR_HEAP_TYPE_DSV, 1);
+    // waitable swapchain -> the CPU throttles before a frame starts instead of inside Present
+    setFrameLatency(frameLatency);
+    frameLatencyWaitable = swapchain->GetFrameLatencyWaitableObject();
+
+    rtvs = rtvAllocator->allocate(bufferCount);
 
     createRTVs();
-    createDepthBuffer(width, height);
     
     LOG_INFO(L"Swapchain->Created Swapchain");
 }
 
+Swapchain::~Swapchain() {
+    if (frameLatencyWaitable) {
+        CloseHandle(frameLatencyWaitable);
+    }
+    rtvAllocator->free(rtvs);
+}
+
 ComPtr<IDXGISwapChain4> Swapchain::createSwapchain(
     HWND& hwnd, 
     ComPtr<ID3D12CommandQueue> commandQueue, 
@@ -61,7 +73,7 @@ ComPtr<IDXGISwapChain4> Swapchain::createSwapchain(
     swapChainDesc.AlphaMode = DXGI_ALPHA_MODE_IGNORE;
 
     // It is recommended to always allow tearing if tearing support is available.
-    swapChainDesc.Flags = tearingSupport ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING : 0;
+    swapChainDesc.Flags = getFlags();
 
     LOG_INFO(L"Swapchain -> Creating SwapChainForHwnd...");
     ComPtr<IDXGISwapChain1> tempSwapChain;
@@ -85,54 +97,13 @@ ComPtr<IDXGISwapChain4> Swapchain::createSwapchain(
 }
 
 
-void Swapchain::createDepthBuffer(UINT width, UINT height)
-{
-    D3D12_RESOURCE_DESC depthDesc = {};
-    depthDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-    depthDesc.Width = width;
-    depthDesc.Height = height;
-    depthDesc.DepthOrArraySize = 1;
-    depthDesc.MipLevels = 1;
-    depthDesc.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
-    depthDesc.SampleDesc.Count = 1;
-    depthDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
-
-    D3D12_CLEAR_VALUE clearValue = {};
-    clearValue.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
-    clearValue.DepthStencil.Depth = 1.0f;
-    clearValue.DepthStencil.Stencil = 0;
-
-    CD3DX12_HEAP_PROPERTIES defaultHeapProps(D3D12_HEAP_TYPE_DEFAULT);
-
-    throwFailed(device->CreateCommittedResource(
-        &defaultHeapProps,
-        D3D12_HEAP_FLAG_NONE,
-        &depthDesc,
-        D3D12_RESOURCE_STATE_DEPTH_WRITE,
-        &clearValue,
-        IID_PPV_ARGS(&depthBuffer)
-    ));
-    
-    D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc = {};
-    dsvDesc.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
-    dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
-    dsvDesc.Flags = D3D12_DSV_FLAG_NONE;
-
-    device->CreateDepthStencilView(depthBuffer.Get(), &dsvDesc, dsvHeap->getCPUHandle(0));
-}
-
 // For each back buffer of the swap chain, 
 // a single RTV is used to describe the resource.
 void Swapchain::createRTVs() {
-    auto rtvSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
- 
-    CD3DX12_CPU_DESCRIPTOR_HANDLE rtvHandle(rtvHeap->getHeap()->GetCPUDescriptorHandleForHeapStart());
-
     backBuffers.resize(bufferCount);
     for (UINT i = 0; i < bufferCount; ++i) {
         throwFailed(swapchain->GetBuffer(i, IID_PPV_ARGS(&backBuffers[i])));
-        device->CreateRenderTargetView(backBuffers[i].Get(), nullptr, rtvHandle);
-        rtvHandle.Offset(1, rtvSize);
+        device->CreateRenderTargetView(backBuffers[i].Get(), nullptr, { rtvs.get(i).ptr });
     }
 }
 
@@ -140,22 +111,45 @@ void Swapchain::resize(UINT width, UINT height)
 {
     for (auto& bb : backBuffers) 
         bb.Reset();
-    depthBuffer.Reset();
-
-    // Resize swapchain buffers
-    UINT swapchainFlags = tearingSupport ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING : 0;
 
+    // Resize swapchain buffers (same flags as at creation -> the waitable object stays valid)
     throwFailed(swapchain->ResizeBuffers(
         bufferCount,
         width,
         height,
         DXGI_FORMAT_R8G8B8A8_UNORM,
-        swapchainFlags
+        getFlags()
     ));
 
-    // Recreate RTVs + depth buffer
+    // Recreate RTVs
     createRTVs();
-    createDepthBuffer(width, height);
 
     LOG_INFO(L"Swapchain -> Resize complete");
 }
+
+void Swapchain::present()
+{
+    INT syncInterval = tearingSupport ? 1 : 0;
+    UINT presentFlags = !tearingSupport ? DXGI_PRESENT_ALLOW_TEARING : 0;
+    throwFailed(swapchain->Present(syncInterval, presentFlags));
+}
+
+bool Swapchain::waitForNextFrame(uint32_t timeoutMs)
+{
+    // alertable -> queued APCs (e.g. async I/O completions) still run while the thread sleeps
+    return WaitForSingleObjectEx(frameLatencyWaitable, timeoutMs, TRUE) == WAIT_OBJECT_0;
+}
+
+void Swapchain::setFrameLatency(uint32_t frameLatency)
+{
+    throwFailed(swapchain->SetMaximumFrameLatency(frameLatency));
+}
+
+UINT Swapchain::getFlags() const
+{
+    UINT flags = DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+    if (tearingSupport) {
+        flags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
+    }
+    return flags;
+}
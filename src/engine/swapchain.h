@@ -1,9 +1,10 @@
 #pragma once
 
 #include "utils/pch.h"
-#include "descriptor_heap.h"
+#include "descriptor_allocator.h"
+#include "rhi/rhi.h"
 
-class Swapchain {
+class Swapchain : public RhiSwapchain {
     public:
         Swapchain(
             HWND hwnd, 
@@ -11,10 +12,12 @@ class Swapchain {
             ComPtr<ID3D12CommandQueue> commandQueue, 
             UINT width, UINT height, 
             uint32_t bufferCount, 
-            bool tearingSupport
+            uint32_t frameLatency,
+            bool tearingSupport,
+            DescriptorAllocator* rtvAllocator
         );
 
-        ~Swapchain() = default;
+        ~Swapchain() override;
 
         ComPtr<IDXGISwapChain4> createSwapchain(
             HWND& hwnd, 
@@ -25,31 +28,40 @@ class Swapchain {
             bool tearingSupport
         );
 
-        void resize(UINT width, UINT height);
+        void resize(UINT width, UINT height) override;
+        void present() override;
 
-        ComPtr<IDXGISwapChain4> getSwapchain() const {
-            return swapchain;
+        bool waitForNextFrame(uint32_t timeoutMs = 1000) override;
+        void setFrameLatency(uint32_t frameLatency) override;
+
+        UINT getCurrentBackBufferIndex() const override {
+            return swapchain->GetCurrentBackBufferIndex();
         }
 
-        ComPtr<ID3D12Resource> getBackBuffer(size_t index) const {
-            return backBuffers[index];
+        UINT getBufferCount() const override {
+            return bufferCount;
         }
 
-        ComPtr<ID3D12Resource> getDepthBuffer() const { 
-            return depthBuffer; 
+        RhiResourceHandle getBackBufferHandle(uint32_t index) const override {
+            return { backBuffers[index].Get() };
         }
 
-        DescriptorHeap* getRTVHeap() const {
-            return rtvHeap.get();
+        RhiCpuDescriptor getRenderTargetView(uint32_t index) const override {
+            return rtvs.get(index);
         }
-        
-        DescriptorHeap* getDSVHeap() const {
-            return dsvHeap.get();
+
+        ComPtr<IDXGISwapChain4> getSwapchain() const {
+            return swapchain;
+        }
+
+        ComPtr<ID3D12Resource> getBackBuffer(size_t index) const {
+            return backBuffers[index];
         }
 
+
     private:
         void createRTVs(); // render target views -> yes that's what it means :)
-        void createDepthBuffer(UINT width, UINT height);
+        UINT getFlags() const;
 
     private:
         ComPtr<IDXGISwapChain4> swapchain;
@@ -57,10 +69,14 @@ class Swapchain {
         UINT bufferCount;
         bool tearingSupport;
 
+        // signalled whenever the present queue drops below the maximum frame latency
+        HANDLE frameLatencyWaitable = nullptr;
+
+        // depth lives in the renderer's transient pool
         std::vector<ComPtr<ID3D12Resource>> backBuffers;
-        ComPtr<ID3D12Resource> depthBuffer;
 
-        std::unique_ptr<DescriptorHeap> rtvHeap;
-        std::unique_ptr<DescriptorHeap> dsvHeap;
+        // views come from the device's descriptor allocator
+        DescriptorAllocator* rtvAllocator = nullptr;
+        DescriptorAllocation rtvs;
         
 };
\ No newline at end of file
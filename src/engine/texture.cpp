@@ -0,0 +1,51 @@
+#include "texture.h"
+
+static_assert(static_cast<UINT>(RhiTextureUsage::RenderTarget) == D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET);
+static_assert(static_cast<UINT>(RhiTextureUsage::DepthStencil) == D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL);
+static_assert(static_cast<UINT>(RhiTextureUsage::UnorderedAccess) == D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+
+Texture::Texture(
+    ComPtr<ID3D12Device2> device,
+    ID3D12Heap* heap,
+    UINT64 offset,
+    const RhiTextureDesc& desc
+) :
+    desc(desc)
+{
+    D3D12_RESOURCE_DESC textureDesc = getResourceDesc(desc);
+
+    // optimized clear value only for targets -> anything else must pass nullptr
+    D3D12_CLEAR_VALUE clearValue = {};
+    clearValue.Format = textureDesc.Format;
+    D3D12_CLEAR_VALUE* optimizedClear = nullptr;
+    if ((desc.usage & RhiTextureUsage::DepthStencil) != RhiTextureUsage::None) {
+        clearValue.DepthStencil.Depth = desc.clearDepth;
+        clearValue.DepthStencil.Stencil = 0;
+        optimizedClear = &clearValue;
+    } else if ((desc.usage & RhiTextureUsage::RenderTarget) != RhiTextureUsage::None) {
+        memcpy(clearValue.Color, desc.clearColor, sizeof(clearValue.Color));
+        optimizedClear = &clearValue;
+    }
+
+    throwFailed(device->CreatePlacedResource(
+        heap,
+        offset,
+        &textureDesc,
+        static_cast<D3D12_RESOURCE_STATES>(desc.initialState),
+        optimizedClear,
+        IID_PPV_ARGS(&texture)
+    ));
+}
+
+D3D12_RESOURCE_DESC Texture::getResourceDesc(const RhiTextureDesc& desc) {
+    return CD3DX12_RESOURCE_DESC::Tex2D(
+        static_cast<DXGI_FORMAT>(desc.format),
+        desc.width,
+        desc.height,
+        1,
+        static_cast<UINT16>(desc.mipLevels),
+        1,
+        0,
+        static_cast<D3D12_RESOURCE_FLAGS>(desc.usage)
+    );
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "utils/pch.h"
+#include "rhi/rhi.h"
+
+// 2D texture placed in an explicit heap (transient render targets, depth)
+class Texture : public RhiTexture {
+    public:
+        Texture(
+            ComPtr<ID3D12Device2> device,
+            ID3D12Heap* heap,
+            UINT64 offset,
+            const RhiTextureDesc& desc
+        );
+
+        static D3D12_RESOURCE_DESC getResourceDesc(const RhiTextureDesc& desc);
+
+        RhiResourceHandle getHandle() const override {
+            return { texture.Get() };
+        }
+
+        const RhiTextureDesc& getDesc() const override {
+            return desc;
+        }
+
+        ComPtr<ID3D12Resource> getTexture() const {
+            return texture;
+        }
+
+    private:
+        ComPtr<ID3D12Resource> texture;
+        RhiTextureDesc desc;
+};
@@ -0,0 +1,243 @@
+#include "transient_resource_pool.h"
+#include "residency_manager.h"
+#include "resource_state_tracker.h"
+#include "rhi/rhi_command_queue.h"
+#include "rhi/rhi_deferred_release.h"
+#include "utils/logger.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+// placed buffers go at 64 KB granularity like every other resource
+static const uint64_t BUFFER_PLACEMENT_ALIGNMENT = 64 * 1024;
+
+TransientResourcePool::TransientResourcePool(
+    RhiDevice* device,
+    RhiCommandQueue* queue,
+    RhiDeferredReleaseQueue* releaseQueue,
+    ResourceStateRegistry* registry,
+    ResidencyManager* residency
+) :
+    device(device),
+    queue(queue),
+    releaseQueue(releaseQueue),
+    registry(registry),
+    residency(residency)
+{
+}
+
+TransientResourcePool::~TransientResourcePool() {
+    release();
+}
+
+void TransientResourcePool::reset() {
+    declarations.clear();
+}
+
+uint32_t TransientResourcePool::declareTexture(const RhiTextureDesc& desc, uint32_t firstPass, uint32_t lastPass) {
+    Declaration declaration;
+    declaration.isTexture = true;
+    declaration.texture = desc;
+    declaration.firstPass = firstPass;
+    declaration.lastPass = std::max(firstPass, lastPass);
+    declarations.push_back(declaration);
+    return static_cast<uint32_t>(declarations.size() - 1);
+}
+
+uint32_t TransientResourcePool::declareBuffer(const RhiBufferDesc& desc, uint32_t firstPass, uint32_t lastPass) {
+    if (desc.heapType != RhiHeapType::Default) {
+        LOG_ERROR(L"TransientResourcePool -> Only default heap buffers can be transient");
+        throw std::runtime_error("Invalid transient buffer");
+    }
+
+    Declaration declaration;
+    declaration.buffer = desc;
+    declaration.firstPass = firstPass;
+    declaration.lastPass = std::max(firstPass, lastPass);
+    declarations.push_back(declaration);
+    return static_cast<uint32_t>(declarations.size() - 1);
+}
+
+bool TransientResourcePool::compile() {
+    if (declarations == built && resources.size() == declarations.size()) {
+        return false;
+    }
+
+    release();
+    build();
+    built = declarations;
+    rebuildCount++;
+    return true;
+}
+
+RhiTexture* TransientResourcePool::getTexture(uint32_t id) const {
+    return resources[id].texture.get();
+}
+
+RhiBuffer* TransientResourcePool::getBuffer(uint32_t id) const {
+    return resources[id].buffer.get();
+}
+
+RhiResourceHandle TransientResourcePool::getHandle(uint32_t id) const {
+    return resources[id].handle;
+}
+
+void TransientResourcePool::aliasResources(uint32_t pass, ResourceStateTracker& tracker) const {
+    // aliasOrder is sorted by first pass
+    auto it = std::lower_bound(aliasOrder.begin(), aliasOrder.end(), pass, [&](uint32_t id, uint32_t value) {
+        return resources[id].firstPass < value;
+    });
+    for (; it != aliasOrder.end() && resources[*it].firstPass == pass; ++it) {
+        const Resource& resource = resources[*it];
+        RhiResourceHandle before;
+        if (resource.aliasBefore != TransientPacker::ALIAS_ANY) {
+            before = resources[resource.aliasBefore].handle;
+        }
+        tracker.alias(before, resource.handle);
+    }
+}
+
+void TransientResourcePool::markUsed() {
+    if (!residency) {
+        return;
+    }
+    for (const auto& heap : heaps) {
+        if (heap) {
+            residency->markUsed(heap->getPageable());
+        }
+    }
+}
+
+RhiHeapUsage TransientResourcePool::getHeapUsage(const Declaration& declaration) {
+    if (!declaration.isTexture) {
+        return RhiHeapUsage::Buffers;
+    }
+    RhiTextureUsage targets = RhiTextureUsage::RenderTarget | RhiTextureUsage::DepthStencil;
+    return (declaration.texture.usage & targets) != RhiTextureUsage::None ? RhiHeapUsage::RenderTargets : RhiHeapUsage::Textures;
+}
+
+void TransientResourcePool::build() {
+    resources.resize(declarations.size());
+    heapBytes = 0;
+    dedicatedBytes = 0;
+    peakLiveBytes = 0;
+
+    std::vector<uint32_t> ids;
+    std::vector<TransientPacker::Request> requests;
+    TransientPacker::Result result;
+
+    for (uint32_t category = 0; category < 3; ++category) {
+        RhiHeapUsage usage = static_cast<RhiHeapUsage>(category);
+
+        ids.clear();
+        requests.clear();
+        for (uint32_t id = 0; id < declarations.size(); ++id) {
+            const Declaration& declaration = declarations[id];
+            if (getHeapUsage(declaration) != usage) {
+                continue;
+            }
+
+            TransientPacker::Request request;
+            if (declaration.isTexture) {
+                RhiAllocationInfo info = device->getTextureAllocationInfo(declaration.texture);
+                request.size = info.size;
+                request.alignment = info.alignment;
+            } else {
+                request.size = (declaration.buffer.sizeInBytes + BUFFER_PLACEMENT_ALIGNMENT - 1) & ~(BUFFER_PLACEMENT_ALIGNMENT - 1);
+                request.alignment = BUFFER_PLACEMENT_ALIGNMENT;
+            }
+            request.firstPass = declaration.firstPass;
+            request.lastPass = declaration.lastPass;
+
+            ids.push_back(id);
+            requests.push_back(request);
+        }
+        if (ids.empty()) {
+            continue;
+        }
+
+        TransientPacker::pack(requests.data(), requests.size(), result);
+        heapBytes += result.heapSize;
+        dedicatedBytes += result.dedicatedSize;
+        peakLiveBytes += result.peakLiveSize;
+
+        heaps[category] = device->createHeap(result.heapSize, usage);
+        if (residency) {
+            residency->track(heaps[category]->getPageable(), result.heapSize);
+        }
+
+        for (size_t i = 0; i < ids.size(); ++i) {
+            const Declaration& declaration = declarations[ids[i]];
+            const TransientPacker::Placement& placement = result.placements[i];
+            Resource& resource = resources[ids[i]];
+
+            RhiResourceState initialState;
+            if (declaration.isTexture) {
+                resource.texture = device->createPlacedTexture(heaps[category].get(), placement.offset, declaration.texture);
+                resource.handle = resource.texture->getHandle();
+                initialState = declaration.texture.initialState;
+            } else {
+                resource.buffer = device->createPlacedBuffer(heaps[category].get(), placement.offset, declaration.buffer);
+                resource.handle = resource.buffer->getHandle();
+                initialState = declaration.buffer.initialState;
+            }
+
+            resource.firstPass = declaration.firstPass;
+            resource.aliasBefore = placement.aliasBefore < TransientPacker::ALIAS_ANY ? ids[placement.aliasBefore] : placement.aliasBefore;
+
+            if (registry) {
+                registry->add(resource.handle, initialState);
+            }
+        }
+    }
+
+    aliasOrder.clear();
+    for (uint32_t id = 0; id < resources.size(); ++id) {
+        if (resources[id].aliasBefore != TransientPacker::NO_ALIAS) {
+            aliasOrder.push_back(id);
+        }
+    }
+    std::stable_sort(aliasOrder.begin(), aliasOrder.end(), [&](uint32_t a, uint32_t b) {
+        return resources[a].firstPass < resources[b].firstPass;
+    });
+
+    LOG_INFO(L"TransientResourcePool -> %zu resources in %llu KB (%llu KB dedicated, %llu KB saved)",
+        resources.size(),
+        static_cast<unsigned long long>(heapBytes >> 10),
+        static_cast<unsigned long long>(dedicatedBytes >> 10),
+        static_cast<unsigned long long>(getSavedBytes() >> 10));
+}
+
+void TransientResourcePool::release() {
+    built.clear();
+    if (resources.empty()) {
+        return;
+    }
+
+    // heaps first -> destroyed after the resources placed in them
+    struct Retired {
+        std::unique_ptr<RhiHeap> heaps[3];
+        std::vector<Resource> resources;
+    };
+    auto retired = std::make_shared<Retired>();
+
+    for (auto& resource : resources) {
+        if (registry && resource.handle.native) {
+            registry->remove(resource.handle);
+        }
+    }
+    retired->resources = std::move(resources);
+    resources.clear();
+    aliasOrder.clear();
+
+    for (uint32_t category = 0; category < 3; ++category) {
+        if (heaps[category] && residency) {
+            residency->untrack(heaps[category]->getPageable());
+        }
+        retired->heaps[category] = std::move(heaps[category]);
+    }
+
+    if (releaseQueue) {
+        releaseQueue->retire(queue->getSyncPoint(queue->getFenceValue()), [retired]() mutable { retired.reset(); });
+    }
+}
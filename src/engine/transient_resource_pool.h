@@ -0,0 +1,112 @@
+#pragma once
+
+#include "rhi/rhi.h"
+#include "memory/transient_packer.h"
+
+class RhiCommandQueue;
+class RhiDeferredReleaseQueue;
+class ResidencyManager;
+class ResourceStateRegistry;
+class ResourceStateTracker;
+
+// Per-frame render targets and scratch buffers placed into shared heaps.
+// Every frame declares its transient resources with the pass range they are used in; compile()
+// packs them with TransientPacker so resources that are never alive at the same time share memory.
+// The layout only changes when the declarations do -> a steady frame reuses heaps and resources,
+// a changed one (resize, new pass) retires the old set through the deferred release queue.
+// One heap per RhiHeapUsage category, since heap tier 1 can't mix them.
+class TransientResourcePool {
+    public:
+        // registry / residency are optional: when given, the resources and heaps are registered there
+        TransientResourcePool(
+            RhiDevice* device,
+            RhiCommandQueue* queue,
+            RhiDeferredReleaseQueue* releaseQueue,
+            ResourceStateRegistry* registry = nullptr,
+            ResidencyManager* residency = nullptr
+        );
+        ~TransientResourcePool();
+
+        // Starts a new set of declarations; ids handed out before are invalid afterwards
+        void reset();
+
+        // Lives from firstPass to lastPass (inclusive); returns the id for the getters below
+        uint32_t declareTexture(const RhiTextureDesc& desc, uint32_t firstPass, uint32_t lastPass);
+        uint32_t declareBuffer(const RhiBufferDesc& desc, uint32_t firstPass, uint32_t lastPass);
+
+        // Places the declared resources; true when the layout was (re)built
+        bool compile();
+
+        RhiTexture* getTexture(uint32_t id) const;
+        RhiBuffer* getBuffer(uint32_t id) const;
+        RhiResourceHandle getHandle(uint32_t id) const;
+
+        // Aliasing barriers for the resources that start using shared memory in pass
+        void aliasResources(uint32_t pass, ResourceStateTracker& tracker) const;
+
+        // Heaps are used by the next submission -> keeps them resident
+        void markUsed();
+
+        // bytes of the current layout, summed over the heaps
+        uint64_t getHeapBytes() const {
+            return heapBytes;
+        }
+
+        uint64_t getDedicatedBytes() const {
+            return dedicatedBytes;
+        }
+
+        uint64_t getSavedBytes() const {
+            return dedicatedBytes > heapBytes ? dedicatedBytes - heapBytes : 0;
+        }
+
+        uint64_t getPeakLiveBytes() const {
+            return peakLiveBytes;
+        }
+
+        uint64_t getRebuildCount() const {
+            return rebuildCount;
+        }
+
+    private:
+        struct Declaration {
+            bool isTexture = false;
+            RhiTextureDesc texture;
+            RhiBufferDesc buffer;
+            uint32_t firstPass = 0;
+            uint32_t lastPass = 0;
+
+            bool operator==(const Declaration& other) const = default;
+        };
+
+        struct Resource {
+            std::unique_ptr<RhiTexture> texture;
+            std::unique_ptr<RhiBuffer> buffer;
+            RhiResourceHandle handle;
+            uint32_t firstPass = 0;
+            uint32_t aliasBefore = TransientPacker::NO_ALIAS; // resource id
+        };
+
+        static RhiHeapUsage getHeapUsage(const Declaration& declaration);
+
+        void build();
+        void release();
+
+    private:
+        RhiDevice* device = nullptr;
+        RhiCommandQueue* queue = nullptr;
+        RhiDeferredReleaseQueue* releaseQueue = nullptr;
+        ResourceStateRegistry* registry = nullptr;
+        ResidencyManager* residency = nullptr;
+
+        std::vector<Declaration> declarations;
+        std::vector<Declaration> built; // declarations the current resources were made for
+        std::vector<Resource> resources;
+        std::vector<uint32_t> aliasOrder; // ids of resources that need an aliasing barrier, by first pass
+        std::unique_ptr<RhiHeap> heaps[3];
+
+        uint64_t heapBytes = 0;
+        uint64_t dedicatedBytes = 0;
+        uint64_t peakLiveBytes = 0;
+        uint64_t rebuildCount = 0;
+};
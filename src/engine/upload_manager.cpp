@@ -0,0 +1,152 @@
+#include "upload_manager.h"
+#include "rhi/rhi_command_queue.h"
+#include "utils/logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// copy offsets only need 4-byte alignment, 16 keeps memcpy happy for vector data
+static const uint64_t STAGING_ALIGNMENT = 16;
+
+UploadManager::UploadManager(RhiDevice* device, uint64_t stagingSize) :
+    device(device),
+    ring(stagingSize)
+{
+    copyQueue = device->createCommandQueue(RhiCommandListType::Copy);
+
+    RhiBufferDesc desc;
+    desc.sizeInBytes = stagingSize;
+    desc.heapType = RhiHeapType::Upload;
+    desc.initialState = RhiResourceState::GenericRead;
+
+    stagingBuffer = device->createBuffer(desc);
+    stagingData = static_cast<uint8_t*>(stagingBuffer->getMappedData());
+
+    if (!stagingData) {
+        LOG_ERROR(L"UploadManager -> Staging buffer is not mapped");
+        throw std::runtime_error("Staging buffer is not mapped");
+    }
+
+    LOG_INFO(L"UploadManager -> Initialized with %llu KB staging ring", static_cast<unsigned long long>(stagingSize / 1024));
+}
+
+UploadManager::~UploadManager() {
+    flush();
+}
+
+std::unique_ptr<RhiBuffer> UploadManager::createBuffer(
+    const void* data,
+    uint32_t count,
+    uint32_t stride,
+    RhiResourceState finalState
+) {
+    RhiBufferDesc desc;
+    desc.sizeInBytes = uint64_t(count) * stride;
+    desc.heapType = RhiHeapType::Default;
+    desc.initialState = RhiResourceState::Common; // promoted to COPY_DEST by the copy, decays back afterwards
+    desc.count = count;
+    desc.stride = stride;
+
+    auto buffer = device->createBuffer(desc);
+    upload(buffer.get(), 0, data, desc.sizeInBytes);
+
+    if (finalState != RhiResourceState::Common) {
+        std::lock_guard<std::mutex> lock(mutex);
+        pendingBarriers.push_back(RhiResourceBarrier::transition(buffer->getHandle(), RhiResourceState::Common, finalState));
+    }
+    return buffer;
+}
+
+void UploadManager::upload(RhiBuffer* destination, uint64_t destinationOffset, const void* data, uint64_t size) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // half the ring per chunk -> the next chunk can be written while the previous one copies
+    const uint64_t maxChunk = std::max<uint64_t>(ring.getCapacity() / 2, STAGING_ALIGNMENT);
+    const uint8_t* src = static_cast<const uint8_t*>(data);
+
+    while (size > 0) {
+        uint64_t chunk = std::min(size, maxChunk);
+        uint64_t offset = allocateStaging(chunk);
+
+        memcpy(stagingData + offset, src, chunk);
+
+        if (!commandList) {
+            commandList = copyQueue->getCommandList();
+        }
+        commandList->copyBufferRegion(destination->getHandle(), destinationOffset, stagingBuffer->getHandle(), offset, chunk);
+
+        src += chunk;
+        destinationOffset += chunk;
+        size -= chunk;
+    }
+}
+
+uint64_t UploadManager::allocateStaging(uint64_t size) {
+    for (;;) {
+        ring.release(copyQueue->getCompletedFenceValue());
+
+        uint64_t offset = ring.allocate(size, STAGING_ALIGNMENT);
+        if (offset != StagingRing::INVALID_OFFSET) {
+            return offset;
+        }
+
+        // Ring full -> the space held by recorded-but-unsubmitted copies can only come back after a submit
+        if (ring.hasUnfinishedAllocations()) {
+            submitLocked();
+        }
+
+        uint64_t oldest = ring.getOldestPendingFence();
+        if (oldest == 0) {
+            LOG_ERROR(L"UploadManager -> %llu bytes do not fit in the staging ring", static_cast<unsigned long long>(size));
+            throw std::runtime_error("Staging allocation too large");
+        }
+        copyQueue->fenceWait(oldest);
+    }
+}
+
+uint64_t UploadManager::submit() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return submitLocked();
+}
+
+uint64_t UploadManager::submitLocked() {
+    if (!commandList) {
+        return lastSubmitted;
+    }
+
+    lastSubmitted = copyQueue->executeCommandList(commandList);
+    commandList = nullptr;
+
+    ring.finishBatch(lastSubmitted);
+
+    submittedBarriers.insert(submittedBarriers.end(), pendingBarriers.begin(), pendingBarriers.end());
+    pendingBarriers.clear();
+    return lastSubmitted;
+}
+
+void UploadManager::handOff(RhiCommandQueue* consumer) {
+    uint64_t value = 0;
+    std::vector<RhiResourceBarrier> barriers;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        value = lastSubmitted;
+        barriers.swap(submittedBarriers);
+    }
+
+    if (value > 0) {
+        consumer->waitForQueue(copyQueue.get(), value);
+    }
+
+    // copy queue access decayed the buffers back to COMMON -> one batch for the whole upload
+    if (!barriers.empty()) {
+        auto list = consumer->getCommandList();
+        list->transitionResources(barriers.data(), static_cast<uint32_t>(barriers.size()));
+        consumer->executeCommandList(list);
+    }
+}
+
+void UploadManager::flush() {
+    uint64_t value = submit();
+    copyQueue->fenceWait(value);
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "rhi/rhi.h"
+#include "memory/staging_ring.h"
+#include <mutex>
+
+// Streams data into DEFAULT-heap buffers through a dedicated copy queue.
+// Source bytes go into one persistently mapped upload buffer managed as a ring;
+// a ring block is reused once the copy that read it has completed, so the CPU only
+// blocks when the ring is full. Consumers take the buffers over on the GPU (handOff).
+class UploadManager {
+    public:
+        static constexpr uint64_t DEFAULT_STAGING_SIZE = 16ull * 1024 * 1024;
+
+        UploadManager(RhiDevice* device, uint64_t stagingSize = DEFAULT_STAGING_SIZE);
+        ~UploadManager();
+
+        // DEFAULT-heap buffer filled with data (static geometry).
+        // finalState != Common -> transitioned there by the handOff that follows the upload,
+        // Common -> left to implicit promotion on first use.
+        std::unique_ptr<RhiBuffer> createBuffer(
+            const void* data,
+            uint32_t count,
+            uint32_t stride,
+            RhiResourceState finalState = RhiResourceState::Common
+        );
+
+        // Records a copy into destination; large uploads are split into ring-sized chunks
+        void upload(RhiBuffer* destination, uint64_t destinationOffset, const void* data, uint64_t size);
+
+        // Executes the pending copies, returns the copy fence value that covers them
+        uint64_t submit();
+
+        // Makes consumer's GPU timeline wait for everything submitted so far, then moves the
+        // uploaded buffers to their final states with one barrier batch executed on consumer.
+        // (copy queues can't transition into vertex / index states themselves)
+        // The buffers must stay alive until then.
+        void handOff(RhiCommandQueue* consumer);
+
+        // Submits and blocks until the copies are done
+        void flush();
+
+        RhiCommandQueue* getCopyQueue() const {
+            return copyQueue.get();
+        }
+
+    private:
+        uint64_t allocateStaging(uint64_t size);
+        uint64_t submitLocked();
+
+    private:
+        RhiDevice* device = nullptr;
+
+        std::mutex mutex;
+        std::unique_ptr<RhiCommandQueue> copyQueue;
+        std::unique_ptr<RhiBuffer> stagingBuffer;
+        uint8_t* stagingData = nullptr;
+        StagingRing ring;
+
+        RhiCommandList* commandList = nullptr; // opened lazily by the first copy after a submit
+        uint64_t lastSubmitted = 0;
+
+        std::vector<RhiResourceBarrier> pendingBarriers;   // copies recorded, not submitted
+        std::vector<RhiResourceBarrier> submittedBarriers; // copies submitted, not handed off
+};
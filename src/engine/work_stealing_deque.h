@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Chase-Lev work-stealing deque (the C11 formulation of Le et al., "Correct and Efficient
+// Work-Stealing for Weak Memory Models"). The owning thread pushes and takes at the bottom
+// (LIFO -> hot caches), any other thread steals from the top (FIFO -> the oldest, usually
+// biggest work). Only a take racing a steal for the last element needs a CAS.
+// T is a pointer; nullptr means empty. Grows when full; outgrown arrays are kept until the deque
+// dies because a thief may still be reading from one.
+template <typename T>
+class WorkStealingDeque {
+    public:
+        explicit WorkStealingDeque(uint32_t capacity = 1024) {
+            uint64_t size = 1;
+            while (size < capacity) {
+                size <<= 1;
+            }
+            arrays.push_back(std::make_unique<Array>(size));
+            array.store(arrays.back().get(), std::memory_order_relaxed);
+        }
+
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        // owner only
+        void push(T item) {
+            int64_t b = bottom.load(std::memory_order_relaxed);
+            int64_t t = top.load(std::memory_order_acquire);
+            Array* a = array.load(std::memory_order_relaxed);
+            if (b - t > static_cast<int64_t>(a->mask)) {
+                a = grow(a, t, b);
+            }
+            a->put(b, item);
+            bottom.store(b + 1, std::memory_order_release); // publishes the item to thieves
+        }
+
+        // owner only; newest item
+        T take() {
+            int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+            Array* a = array.load(std::memory_order_relaxed);
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = top.load(std::memory_order_relaxed);
+
+            if (t > b) {
+                bottom.store(b + 1, std::memory_order_relaxed); // was empty
+                return nullptr;
+            }
+
+            T item = a->get(b);
+            if (t == b) {
+                // last element -> whoever moves top first gets it
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    item = nullptr;
+                }
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return item;
+        }
+
+        // any thread; oldest item, nullptr when empty or lost a race
+        T steal() {
+            int64_t t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t b = bottom.load(std::memory_order_acquire);
+            if (t >= b) {
+                return nullptr;
+            }
+
+            Array* a = array.load(std::memory_order_acquire);
+            T item = a->get(t);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            return item;
+        }
+
+        // approximate when called from a thief
+        bool isEmpty() const {
+            int64_t b = bottom.load(std::memory_order_relaxed);
+            int64_t t = top.load(std::memory_order_relaxed);
+            return b <= t;
+        }
+
+    private:
+        struct Array {
+            explicit Array(uint64_t size) : mask(size - 1), items(new std::atomic<T>[size]) {}
+
+            T get(int64_t index) const {
+                return items[index & mask].load(std::memory_order_relaxed);
+            }
+
+            void put(int64_t index, T item) {
+                items[index & mask].store(item, std::memory_order_relaxed);
+            }
+
+            uint64_t mask;
+            std::unique_ptr<std::atomic<T>[]> items;
+        };
+
+        Array* grow(Array* old, int64_t t, int64_t b) {
+            arrays.push_back(std::make_unique<Array>((old->mask + 1) * 2));
+            Array* grown = arrays.back().get();
+            for (int64_t i = t; i < b; ++i) {
+                grown->put(i, old->get(i));
+            }
+            array.store(grown, std::memory_order_release);
+            return grown;
+        }
+
+    private:
+        // top and bottom on their own cache lines -> thieves don't bounce the owner's line
+        alignas(64) std::atomic<int64_t> top{ 0 };
+        alignas(64) std::atomic<int64_t> bottom{ 0 };
+        alignas(64) std::atomic<Array*> array{ nullptr };
+        std::vector<std::unique_ptr<Array>> arrays; // owner only
+};
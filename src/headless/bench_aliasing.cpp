@@ -0,0 +1,205 @@
+#include "benchmarks.h"
+#include "bench_common.h"
+#include "engine/transient_resource_pool.h"
+#include "engine/resource_state_tracker.h"
+#include "engine/rhi/rhi_deferred_release.h"
+#include "engine/rhi/null/null_device.h"
+#include "engine/rhi/null/null_command_queue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Transient memory of a synthetic frame, dedicated vs. aliased.
+// Every pass writes a few render targets (full / half / quarter resolution, mixed formats) and
+// some scratch buffers; each output is read by a pass up to four steps later and dead after that.
+// Checks the packed layout (no two resources alive together may share bytes), then runs frames
+// through TransientResourcePool on the null device to count aliasing barriers and rebuilds.
+
+struct AliasingBenchConfig {
+    uint32_t frames = 200;
+    uint32_t width = 1920;
+    uint32_t height = 1080;
+    uint32_t seed = 1234;
+};
+
+static AliasingBenchConfig parseAliasingArgs(int argc, char** argv) {
+    AliasingBenchConfig config;
+    parseOptions(argc, argv, {
+        { "--frames", &config.frames },
+        { "--width", &config.width },
+        { "--height", &config.height },
+        { "--seed", &config.seed }
+    });
+    return config;
+}
+
+struct TransientDecl {
+    bool isTexture = true;
+    RhiTextureDesc texture;
+    RhiBufferDesc buffer;
+    uint32_t firstPass = 0;
+    uint32_t lastPass = 0;
+};
+
+static std::vector<TransientDecl> makeFrame(const AliasingBenchConfig& config, uint32_t passes) {
+    std::mt19937 rng(config.seed);
+    static const RhiFormat formats[] = { RhiFormat::R8G8B8A8Unorm, RhiFormat::R32G32B32A32Float, RhiFormat::R32Uint };
+
+    std::vector<TransientDecl> decls;
+    for (uint32_t pass = 0; pass < passes; ++pass) {
+        uint32_t targets = 1 + rng() % 3;
+        for (uint32_t i = 0; i < targets; ++i) {
+            uint32_t scale = 1u << (rng() % 3);
+            TransientDecl decl;
+            decl.texture.width = config.width / scale;
+            decl.texture.height = config.height / scale;
+            decl.texture.format = formats[rng() % 3];
+            decl.texture.usage = RhiTextureUsage::RenderTarget;
+            decl.texture.initialState = RhiResourceState::RenderTarget;
+            decl.firstPass = pass;
+            decl.lastPass = std::min(passes - 1, pass + 1 + static_cast<uint32_t>(rng() % 4));
+            decls.push_back(decl);
+        }
+
+        if (rng() % 2 == 0) {
+            TransientDecl decl;
+            decl.isTexture = false;
+            decl.buffer.sizeInBytes = (1ull << (16 + rng() % 6));
+            decl.buffer.initialState = RhiResourceState::UnorderedAccess;
+            decl.firstPass = pass;
+            decl.lastPass = std::min(passes - 1, pass + 1 + static_cast<uint32_t>(rng() % 4));
+            decls.push_back(decl);
+        }
+    }
+    return decls;
+}
+
+// resources alive in the same pass must not share a single byte
+static bool checkLayout(const std::vector<TransientPacker::Request>& requests, const TransientPacker::Result& result) {
+    for (size_t i = 0; i < requests.size(); ++i) {
+        for (size_t j = i + 1; j < requests.size(); ++j) {
+            bool together = requests[i].firstPass <= requests[j].lastPass && requests[j].firstPass <= requests[i].lastPass;
+            uint64_t a = result.placements[i].offset;
+            uint64_t b = result.placements[j].offset;
+            bool shared = a < b + requests[j].size && b < a + requests[i].size;
+            if (together && shared) {
+                return false;
+            }
+        }
+        if (result.placements[i].offset % requests[i].alignment != 0 ||
+            result.placements[i].offset + requests[i].size > result.heapSize) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void runPasses(const AliasingBenchConfig& config, uint32_t passes) {
+    std::vector<TransientDecl> decls = makeFrame(config, passes);
+
+    NullDeviceConfig deviceConfig;
+    deviceConfig.fenceLatency = 0;
+    deviceConfig.recordCommands = false;
+    NullDevice device(deviceConfig);
+
+    // the packer alone, all categories in one layout -> checked and timed
+    std::vector<TransientPacker::Request> requests;
+    for (const auto& decl : decls) {
+        TransientPacker::Request request;
+        if (decl.isTexture) {
+            RhiAllocationInfo info = device.getTextureAllocationInfo(decl.texture);
+            request.size = info.size;
+            request.alignment = info.alignment;
+        } else {
+            request.size = (decl.buffer.sizeInBytes + 0xFFFF) & ~0xFFFFull;
+            request.alignment = 0x10000;
+        }
+        request.firstPass = decl.firstPass;
+        request.lastPass = decl.lastPass;
+        requests.push_back(request);
+    }
+
+    TransientPacker::Result result;
+    auto t0 = Clock::now();
+    TransientPacker::pack(requests.data(), requests.size(), result);
+    std::chrono::duration<double> packTime = Clock::now() - t0;
+    bool valid = checkLayout(requests, result);
+
+    // the pool over a frame loop (one heap per category)
+    auto queue = device.createCommandQueue(RhiCommandListType::Direct);
+    uint64_t rebuilds = 0;
+    uint64_t aliasingBarriers = 0;
+    {
+        RhiDeferredReleaseQueue releaseQueue;
+        ResourceStateRegistry registry;
+        TransientResourcePool pool(&device, queue.get(), &releaseQueue, &registry);
+        ResourceStateTracker tracker;
+        ResourceStateTracker* trackerPointer = &tracker;
+
+        device.getStats().reset();
+        for (uint32_t frame = 0; frame < config.frames; ++frame) {
+            pool.reset();
+            for (const auto& decl : decls) {
+                if (decl.isTexture) {
+                    pool.declareTexture(decl.texture, decl.firstPass, decl.lastPass);
+                } else {
+                    pool.declareBuffer(decl.buffer, decl.firstPass, decl.lastPass);
+                }
+            }
+            pool.compile();
+
+            RhiCommandList* list = queue->getCommandList();
+            for (uint32_t pass = 0; pass < passes; ++pass) {
+                pool.aliasResources(pass, tracker);
+                for (uint32_t id = 0; id < decls.size(); ++id) {
+                    if (decls[id].firstPass == pass) {
+                        bool isTexture = decls[id].isTexture;
+                        tracker.transition(pool.getHandle(id), isTexture ? RhiResourceState::RenderTarget : RhiResourceState::UnorderedAccess);
+                    } else if (decls[id].firstPass < pass && decls[id].lastPass >= pass) {
+                        tracker.transition(pool.getHandle(id), RhiResourceState::PixelShaderResource);
+                    }
+                }
+                tracker.flush(list);
+            }
+            tracker.finish(list);
+            registry.execute(queue.get(), &list, &trackerPointer, 1);
+            releaseQueue.collect();
+        }
+        queue->flush();
+
+        rebuilds = pool.getRebuildCount();
+        aliasingBarriers = device.getStats().aliasingBarriers.load();
+
+        std::printf(
+            "%6u %6zu %10.1f %10.1f %10.1f %10.1f %7.1f%% %9.1f %10.2f %8llu %6s\n",
+            passes,
+            decls.size(),
+            result.dedicatedSize / double(1 << 20),
+            result.heapSize / double(1 << 20),
+            pool.getHeapBytes() / double(1 << 20),
+            result.peakLiveSize / double(1 << 20),
+            100.0 * result.getSavedBytes() / result.dedicatedSize,
+            packTime.count() * 1e6,
+            aliasingBarriers / double(config.frames),
+            static_cast<unsigned long long>(rebuilds),
+            valid ? "ok" : "FAIL"
+        );
+    }
+}
+
+int runAliasingBenchmark(int argc, char** argv) {
+    AliasingBenchConfig config = parseAliasingArgs(argc, argv);
+
+    std::printf("aliasing: %ux%u targets, %u frames per pass count\n", config.width, config.height, config.frames);
+    std::printf("%6s %6s %10s %10s %10s %10s %8s %9s %10s %8s %6s\n",
+        "passes", "res", "dedic. MB", "heap MB", "pool MB", "peak MB", "saved", "pack us", "alias/f", "rebuilds", "layout");
+
+    for (uint32_t passes : { 8u, 32u, 128u }) {
+        runPasses(config, passes);
+    }
+
+    return 0;
+}
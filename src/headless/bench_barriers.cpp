@@ -0,0 +1,142 @@
+#include "benchmarks.h"
+#include "bench_common.h"
+#include "engine/resource_state_tracker.h"
+#include "engine/rhi/null/null_device.h"
+#include "engine/rhi/null/null_command_queue.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// Barrier counts of a pass chain, hand-written vs. tracked.
+// Every pass renders into its own targets and samples the targets of the pass two steps back:
+//   manual  -> one transitionResource per transition, the caller keeps track of before-states
+//   tracked -> ResourceStateTracker, one batched call per pass boundary, submit through the registry
+//   split   -> tracked, plus a split barrier started right after the producer pass, so the
+//              RenderTarget -> PixelShaderResource transition overlaps the pass in between
+
+struct BarrierBenchConfig {
+    uint32_t frames = 1000;
+    uint32_t passes = 64;
+    uint32_t targets = 4; // render targets written per pass
+};
+
+static BarrierBenchConfig parseBarrierArgs(int argc, char** argv) {
+    BarrierBenchConfig config;
+    parseOptions(argc, argv, {
+        { "--frames", &config.frames },
+        { "--passes", &config.passes },
+        { "--targets", &config.targets }
+    });
+    return config;
+}
+
+enum class BarrierMode {
+    Manual,
+    Tracked,
+    Split
+};
+
+static void runMode(const BarrierBenchConfig& config, BarrierMode mode, const char* name) {
+    NullDeviceConfig deviceConfig;
+    deviceConfig.fenceLatency = 0;
+    deviceConfig.recordCommands = false;
+    NullDevice device(deviceConfig);
+
+    auto queue = device.createCommandQueue(RhiCommandListType::Direct);
+
+    // stand-ins for the render targets, only their identity matters
+    std::vector<NullResource> resources(config.passes * config.targets);
+    std::vector<RhiResourceState> manualStates(resources.size(), RhiResourceState::PixelShaderResource);
+
+    ResourceStateRegistry registry;
+    for (auto& resource : resources) {
+        registry.add({ &resource }, RhiResourceState::PixelShaderResource);
+    }
+    ResourceStateTracker tracker;
+    ResourceStateTracker* trackerPointer = &tracker;
+
+    auto handle = [&](uint32_t pass, uint32_t target) -> RhiResourceHandle {
+        return { &resources[pass * config.targets + target] };
+    };
+
+    device.getStats().reset();
+    uint64_t fixups = 0;
+
+    auto start = Clock::now();
+
+    for (uint32_t frame = 0; frame < config.frames; ++frame) {
+        RhiCommandList* list = queue->getCommandList();
+
+        for (uint32_t pass = 0; pass < config.passes; ++pass) {
+            for (uint32_t target = 0; target < config.targets; ++target) {
+                if (mode == BarrierMode::Manual) {
+                    if (pass >= 2) {
+                        uint32_t index = (pass - 2) * config.targets + target;
+                        if (manualStates[index] != RhiResourceState::PixelShaderResource) {
+                            list->transitionResource(handle(pass - 2, target), manualStates[index], RhiResourceState::PixelShaderResource);
+                            manualStates[index] = RhiResourceState::PixelShaderResource;
+                        }
+                    }
+                    uint32_t index = pass * config.targets + target;
+                    list->transitionResource(handle(pass, target), manualStates[index], RhiResourceState::RenderTarget);
+                    manualStates[index] = RhiResourceState::RenderTarget;
+                } else {
+                    if (pass >= 2) {
+                        tracker.transition(handle(pass - 2, target), RhiResourceState::PixelShaderResource);
+                    }
+                    tracker.transition(handle(pass, target), RhiResourceState::RenderTarget);
+                }
+            }
+
+            if (mode != BarrierMode::Manual) {
+                tracker.flush(list);
+            }
+
+            // ... the pass's draws ...
+
+            // outputs are sampled two passes later -> let the transition run during the next pass
+            if (mode == BarrierMode::Split) {
+                for (uint32_t target = 0; target < config.targets; ++target) {
+                    tracker.beginTransition(handle(pass, target), RhiResourceState::PixelShaderResource);
+                }
+            }
+        }
+
+        if (mode == BarrierMode::Manual) {
+            queue->executeCommandList(list);
+        } else {
+            tracker.finish(list);
+            registry.execute(queue.get(), &list, &trackerPointer, 1);
+            fixups += registry.takeFixupBarrierCount();
+        }
+    }
+
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    const auto& stats = device.getStats();
+    double frames = static_cast<double>(config.frames);
+
+    std::printf(
+        "%-8s %12.2f %12.1f %12.1f %12.1f %12.1f\n",
+        name,
+        elapsed.count() * 1e6 / frames,
+        stats.barriers.load() / frames,
+        stats.barrierCalls.load() / frames,
+        stats.splitBarriers.load() / frames,
+        fixups / frames
+    );
+}
+
+int runBarrierBenchmark(int argc, char** argv) {
+    BarrierBenchConfig config = parseBarrierArgs(argc, argv);
+
+    std::printf("barriers: %u frames, %u passes x %u targets, each pass samples the pass two back\n",
+        config.frames, config.passes, config.targets);
+    std::printf("%-8s %12s %12s %12s %12s %12s\n", "mode", "us/frame", "barriers/f", "calls/f", "split/f", "fixups/f");
+
+    runMode(config, BarrierMode::Manual, "manual");
+    runMode(config, BarrierMode::Tracked, "tracked");
+    runMode(config, BarrierMode::Split, "split");
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+
+// Helpers shared by the headless benchmarks: option parsing, a deterministic RNG and timing.
+
+using Clock = std::chrono::steady_clock;
+
+// One "--name value" option. Numbers are clamped to [minimum, maximum]; flags are value != 0
+struct BenchOption {
+    BenchOption(const char* name, uint32_t* value, uint32_t minimum = 0, uint32_t maximum = ~0u) :
+        name(name), value(value), minimum(minimum), maximum(maximum) {}
+
+    BenchOption(const char* name, bool* flag) :
+        name(name), flag(flag) {}
+
+    const char* name = nullptr;
+    uint32_t* value = nullptr;
+    bool* flag = nullptr;
+    uint32_t minimum = 0;
+    uint32_t maximum = ~0u;
+};
+
+// argv -> "--name value" pairs (unsigned decimal values); unknown names are reported and skipped
+inline void parseOptions(int argc, char** argv, std::initializer_list<BenchOption> options) {
+    for (int i = 0; i + 1 < argc; i += 2) {
+        uint32_t value = static_cast<uint32_t>(std::strtoul(argv[i + 1], nullptr, 10));
+
+        const BenchOption* match = nullptr;
+        for (const BenchOption& option : options) {
+            if (std::strcmp(argv[i], option.name) == 0) {
+                match = &option;
+                break;
+            }
+        }
+
+        if (!match) {
+            std::fprintf(stderr, "Unknown option %s\n", argv[i]);
+        } else if (match->flag) {
+            *match->flag = value != 0;
+        } else {
+            *match->value = std::min(std::max(value, match->minimum), match->maximum);
+        }
+    }
+}
+
+// xorshift32 -> the same sequence on every platform and run
+inline uint32_t nextRandom(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+inline float randomRange(uint32_t& state, float low, float high) {
+    return low + (high - low) * static_cast<float>(nextRandom(state) % 65536) / 65535.0f;
+}
+
+// Average milliseconds of function() over runs
+template <typename Function>
+double timeMs(uint32_t runs, Function&& function) {
+    std::chrono::duration<double, std::milli> total{ 0 };
+    for (uint32_t i = 0; i < runs; ++i) {
+        auto t0 = Clock::now();
+        function();
+        total += Clock::now() - t0;
+    }
+    return total.count() / runs;
+}
+
+// Same, but function returns the part of its time that counts (setup / submission excluded)
+template <typename Function>
+double averageMs(uint32_t runs, Function&& function) {
+    std::chrono::duration<double, std::milli> total{ 0 };
+    for (uint32_t i = 0; i < runs; ++i) {
+        total += function();
+    }
+    return total.count() / runs;
+}
@@ -0,0 +1,131 @@
+#include "benchmarks.h"
+#include "bench_common.h"
+#include "engine/descriptor_allocator.h"
+#include "engine/rhi/null/null_device.h"
+
+#include <barrier>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+// CPU descriptor allocator throughput vs. thread count, on the null device's fake heaps.
+// Every thread churns a live set of mostly single descriptors with some small ranges
+// (SRV tables, mip chains); "locked" calls the shared allocator directly,
+// "cached" goes through a per-thread DescriptorCache.
+
+struct DescriptorBenchConfig {
+    uint32_t operations = 200000; // per thread
+    uint32_t liveSet = 512;       // per thread
+    uint32_t maxThreads = 8;
+};
+
+static DescriptorBenchConfig parseDescriptorArgs(int argc, char** argv) {
+    DescriptorBenchConfig config;
+    parseOptions(argc, argv, {
+        { "--ops", &config.operations },
+        { "--live", &config.liveSet },
+        { "--threads", &config.maxThreads }
+    });
+    return config;
+}
+
+static void churn(
+    DescriptorAllocator* allocator,
+    DescriptorCache* cache,
+    const DescriptorBenchConfig& config,
+    uint32_t seed
+) {
+    std::mt19937 rng(seed);
+    std::vector<DescriptorAllocation> live;
+    live.reserve(config.liveSet);
+
+    for (uint32_t i = 0; i < config.operations; ++i) {
+        uint32_t roll = rng();
+        if (live.size() < config.liveSet && (live.empty() || (roll & 1))) {
+            // 1 in 8 is a small range, the rest single views
+            uint32_t count = (roll & 0xE) == 0 ? 2 + (roll >> 8) % 15 : 1;
+            if (count == 1 && cache) {
+                live.push_back(cache->allocate());
+            } else {
+                live.push_back(allocator->allocate(count));
+            }
+        } else {
+            size_t victim = (roll >> 4) % live.size();
+            if (cache) {
+                cache->free(live[victim]);
+            } else {
+                allocator->free(live[victim]);
+            }
+            live[victim] = live.back();
+            live.pop_back();
+        }
+    }
+
+    for (const auto& allocation : live) {
+        if (cache) {
+            cache->free(allocation);
+        } else {
+            allocator->free(allocation);
+        }
+    }
+    if (cache) {
+        cache->flush();
+    }
+}
+
+static double measure(uint32_t threadCount, bool cached, const DescriptorBenchConfig& config, uint32_t& pages) {
+    NullDeviceConfig deviceConfig;
+    NullDevice device(deviceConfig);
+    DescriptorAllocator* allocator = device.getDescriptorAllocator(RhiDescriptorHeapType::CbvSrvUav);
+
+    std::vector<DescriptorCache*> caches(threadCount, nullptr);
+    if (cached) {
+        for (auto& cache : caches) {
+            cache = allocator->createCache();
+        }
+    }
+
+    std::barrier start(threadCount + 1);
+    std::vector<std::thread> workers;
+    for (uint32_t t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&, t] {
+            start.arrive_and_wait();
+            churn(allocator, caches[t], config, 77 + t);
+        });
+    }
+
+    start.arrive_and_wait();
+    auto t0 = Clock::now();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - t0;
+
+    pages = allocator->getPageCount();
+    return elapsed.count() * 1e9 / (double(config.operations) * threadCount);
+}
+
+int runDescriptorBenchmark(int argc, char** argv) {
+    DescriptorBenchConfig config = parseDescriptorArgs(argc, argv);
+
+    std::printf(
+        "descriptors: %u ops/thread, live set %u/thread, page %u, %u hardware threads\n",
+        config.operations,
+        config.liveSet,
+        DescriptorAllocator::DEFAULT_PAGE_SIZE,
+        std::thread::hardware_concurrency()
+    );
+    std::printf("%8s %14s %8s %14s %8s\n", "threads", "locked ns/op", "pages", "cached ns/op", "pages");
+
+    for (uint32_t threads = 1; threads <= config.maxThreads; threads *= 2) {
+        uint32_t lockedPages = 0;
+        uint32_t cachedPages = 0;
+        double locked = measure(threads, false, config, lockedPages);
+        double cached = measure(threads, true, config, cachedPages);
+
+        std::printf("%8u %14.1f %8u %14.1f %8u\n", threads, locked, lockedPages, cached, cachedPages);
+    }
+
+    return 0;
+}
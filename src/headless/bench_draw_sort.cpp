@@ -0,0 +1,173 @@
+#include "benchmarks.h"
+#include "bench_common.h"
+#include "engine/draw_list.h"
+#include "engine/job_system.h"
+#include "engine/rhi/null/null_device.h"
+#include "engine/rhi/rhi_command_queue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+// Draw list sort + record at 10k / 100k / 1M draws.
+// Draws are spread over 4 passes, 64 pipelines, 4096 materials and 256 meshes at random depths,
+// 15% transparent, added in random order (as a scene walk would). Columns:
+//   build     -> clear + key every draw
+//   std::sort -> the same keys through std::sort (reference)
+//   radix     -> DrawList::sort on one thread / on the job system (key sort + gathering the
+//                commands into key order, so it is not a like-for-like match with std::sort)
+//   record    -> one command list of every draw, unsorted vs. sorted, with the pipeline changes it set
+//                (the sorted floor is ~1 per transparent draw: those stay in depth order)
+
+struct DrawSortBenchConfig {
+    uint32_t runs = 5;
+    uint32_t maxDraws = 1000000;
+    uint32_t threads = JobSystemConfig::AUTO_THREADS;
+};
+
+static DrawSortBenchConfig parseDrawSortArgs(int argc, char** argv) {
+    DrawSortBenchConfig config;
+    parseOptions(argc, argv, {
+        { "--runs", &config.runs, 1u },
+        { "--max-draws", &config.maxDraws },
+        { "--threads", &config.threads }
+    });
+    return config;
+}
+
+struct SceneDraw {
+    uint32_t pass;
+    DrawBlend blend;
+    float depth;
+    DrawCommand command;
+};
+
+static std::vector<SceneDraw> makeScene(uint32_t draws) {
+    constexpr uint32_t PIPELINES = 64;
+    constexpr uint32_t MATERIALS = 4096;
+    constexpr uint32_t MESHES = 256;
+
+    std::vector<SceneDraw> scene(draws);
+    uint32_t random = 0x9e3779b9u;
+    for (uint32_t i = 0; i < draws; ++i) {
+        SceneDraw& draw = scene[i];
+        uint32_t mesh = nextRandom(random) % MESHES;
+        draw.pass = nextRandom(random) % 4;
+        draw.blend = nextRandom(random) % 100 < 15 ? DrawBlend::Transparent : DrawBlend::Opaque;
+        draw.depth = static_cast<float>(nextRandom(random) % 100000) * 0.001f; // 0 - 100
+
+        DrawCommand& command = draw.command;
+        command.pipeline = nextRandom(random) % PIPELINES;
+        command.materialIndex = nextRandom(random) % MATERIALS;
+        command.constantsIndex = command.materialIndex;
+        command.vertexBuffer = { 0x10000000 + uint64_t(mesh) * 0x10000, 8 * 32, 32 };
+        command.indexBuffer = { 0x20000000 + uint64_t(mesh) * 0x10000, 36 * 4, RhiFormat::R32Uint };
+        command.indexCount = 36;
+    }
+    return scene;
+}
+
+static void buildList(DrawList& list, const std::vector<SceneDraw>& scene) {
+    list.clear();
+    for (const SceneDraw& draw : scene) {
+        list.add(draw.pass, draw.blend, draw.depth, draw.command);
+    }
+}
+
+static void runDraws(const DrawSortBenchConfig& config, uint32_t draws, JobSystem& jobs) {
+    NullDeviceConfig deviceConfig;
+    deviceConfig.fenceLatency = 0;
+    deviceConfig.recordCommands = false;
+    NullDevice device(deviceConfig);
+    auto queue = device.createCommandQueue(RhiCommandListType::Direct);
+
+    DrawList list;
+    std::vector<std::unique_ptr<RhiPipeline>> pipelines;
+    for (uint32_t i = 0; i < 64; ++i) {
+        pipelines.push_back(device.createPipeline({}));
+        list.addPipeline(pipelines.back().get());
+    }
+    list.setDepthRange(0.0f, 100.0f);
+
+    std::vector<SceneDraw> scene = makeScene(draws);
+
+    double buildMs = averageMs(config.runs, [&] {
+        auto t0 = Clock::now();
+        buildList(list, scene);
+        return Clock::now() - t0;
+    });
+
+    // reference: the same keys (with their draw index) through std::sort
+    std::vector<std::pair<uint64_t, uint32_t>> reference(draws);
+    double stdSortMs = averageMs(config.runs, [&] {
+        for (uint32_t i = 0; i < draws; ++i) {
+            reference[i] = { list.getKey(i), i };
+        }
+        auto t0 = Clock::now();
+        std::sort(reference.begin(), reference.end());
+        return Clock::now() - t0;
+    });
+
+    double serialMs = averageMs(config.runs, [&] {
+        buildList(list, scene);
+        auto t0 = Clock::now();
+        list.sort();
+        return Clock::now() - t0;
+    });
+    double parallelMs = averageMs(config.runs, [&] {
+        buildList(list, scene);
+        auto t0 = Clock::now();
+        list.sort(&jobs);
+        return Clock::now() - t0;
+    });
+
+    bool sorted = true;
+    for (uint32_t i = 0; i < draws; ++i) {
+        sorted &= list.getKey(i) == reference[i].first;
+    }
+
+    auto timeRecord = [&](bool sort, DrawListStats& stats) {
+        return averageMs(config.runs, [&] {
+            buildList(list, scene);
+            if (sort) {
+                list.sort(&jobs);
+            }
+            RhiCommandList* commandList = queue->getCommandList();
+            auto t0 = Clock::now();
+            stats = list.record(commandList);
+            auto elapsed = Clock::now() - t0;
+            queue->executeCommandList(commandList);
+            queue->flush();
+            return elapsed;
+        });
+    };
+    DrawListStats unsortedStats;
+    DrawListStats sortedStats;
+    double unsortedMs = timeRecord(false, unsortedStats);
+    double sortedMs = timeRecord(true, sortedStats);
+
+    std::printf("%8u %9.3f %10.3f %9.3f %9.3f %10.3f %9llu %10.3f %9llu%s\n",
+        draws, buildMs, stdSortMs, serialMs, parallelMs,
+        unsortedMs, static_cast<unsigned long long>(unsortedStats.pipelineChanges),
+        sortedMs, static_cast<unsigned long long>(sortedStats.pipelineChanges),
+        sorted ? "" : "   ORDER MISMATCH");
+}
+
+int runDrawSortBenchmark(int argc, char** argv) {
+    DrawSortBenchConfig config = parseDrawSortArgs(argc, argv);
+
+    JobSystemConfig jobConfig;
+    jobConfig.threads = config.threads;
+    JobSystem jobs(jobConfig);
+
+    std::printf("draw-sort: %u runs each, radix sort on 1 / %u threads\n", config.runs, jobs.getThreadCount());
+    std::printf("%8s %9s %10s %9s %9s %10s %9s %10s %9s\n",
+        "draws", "build ms", "std::sort", "radix 1T", "radix NT", "unsorted", "psos", "sorted", "psos");
+
+    for (uint32_t draws = 10000; draws <= config.maxDraws; draws *= 10) {
+        runDraws(config, draws, jobs);
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include "benchmarks.h"
+#include "bench_common.h"
+#include "engine/rhi/null/null_device.h"
+#include "engine/rhi/null/null_command_queue.h"
+#include "engine/rhi/rhi_command_queue.h"
+#include "engine/rhi/rhi_fence_waiter.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+// Fence waiter throughput on the simulated timeline.
+// Two queues submit every frame; each submission gets N callbacks and one coroutine
+// co_awaits every direct-queue value. The simulated GPU trails by --latency signals,
+// so callbacks fire on the waiter thread while the submitting thread keeps going.
+
+struct FenceWaiterBenchConfig {
+    uint32_t frames = 10000;
+    uint32_t callbacks = 8;
+    uint32_t latency = 2;
+};
+
+static FenceWaiterBenchConfig parseFenceWaiterArgs(int argc, char** argv) {
+    FenceWaiterBenchConfig config;
+    parseOptions(argc, argv, {
+        { "--frames", &config.frames },
+        { "--callbacks", &config.callbacks },
+        { "--latency", &config.latency }
+    });
+    return config;
+}
+
+// resumes once per frame, in order, on the waiter thread
+static RhiDetachedTask followTimeline(
+    RhiFenceWaiter* waiter,
+    RhiCommandQueue* queue,
+    uint32_t frames,
+    std::atomic<uint32_t>& resumes
+) {
+    for (uint64_t value = 1; value <= frames; ++value) {
+        co_await RhiFenceAwaitable{ waiter, queue->getSyncPoint(value) };
+        resumes++;
+    }
+}
+
+int runFenceWaiterBenchmark(int argc, char** argv) {
+    FenceWaiterBenchConfig config = parseFenceWaiterArgs(argc, argv);
+
+    NullDeviceConfig deviceConfig;
+    deviceConfig.fenceLatency = config.latency;
+    deviceConfig.recordCommands = false;
+    NullDevice device(deviceConfig);
+
+    auto direct = device.createCommandQueue(RhiCommandListType::Direct);
+    auto copy = device.createCommandQueue(RhiCommandListType::Copy);
+
+    std::atomic<uint64_t> fired{ 0 };
+    std::atomic<uint32_t> resumes{ 0 };
+
+    std::chrono::duration<double> registerTime{ 0 };
+
+    auto t0 = Clock::now();
+    {
+        RhiFenceWaiter waiter(&device);
+        followTimeline(&waiter, direct.get(), config.frames, resumes);
+
+        for (uint32_t frame = 0; frame < config.frames; ++frame) {
+            for (RhiCommandQueue* queue : { direct.get(), copy.get() }) {
+                uint64_t value = queue->executeCommandList(queue->getCommandList());
+
+                auto r0 = Clock::now();
+                for (uint32_t i = 0; i < config.callbacks; ++i) {
+                    waiter.onFenceComplete(queue->getSyncPoint(value), [&fired] { fired++; });
+                }
+                registerTime += Clock::now() - r0;
+            }
+        }
+
+        // let the simulated GPU finish and wait for the waiter thread to catch up
+        static_cast<NullCommandQueue*>(direct.get())->drain();
+        static_cast<NullCommandQueue*>(copy.get())->drain();
+        while (waiter.getPendingCount() > 0) {
+            std::this_thread::yield();
+        }
+    }
+    std::chrono::duration<double> total = Clock::now() - t0;
+
+    uint64_t expected = uint64_t(config.frames) * 2 * config.callbacks;
+    std::printf("fence waiter: %u frames, 2 queues, %u callbacks/submit, latency %u\n",
+        config.frames, config.callbacks, config.latency);
+    std::printf("callbacks fired   %llu / %llu\n",
+        static_cast<unsigned long long>(fired.load()), static_cast<unsigned long long>(expected));
+    std::printf("coroutine resumes %u / %u\n", resumes.load(), config.frames);
+    std::printf("register (ns/cb)  %.1f\n", registerTime.count() * 1e9 / double(expected ? expected : 1));
+    std::printf("total    (ms)     %.3f\n", total.count() * 1e3);
+
+    return fired.load() == expected && resumes.load() == config.frames ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+#include "benchmarks.h"
+#include "bench_common.h"
+#include "engine/frustum_culler.h"
+#include "engine/job_system.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// CPU frustum culling of 100k / 1M / 10M bounding volumes (SoA, random in a 200^3 box, camera
+// 120 units behind it with a 60 degree field of view -> about half visible). One table for spheres,
+// one for boxes. Columns: milliseconds per cull on one thread for every kernel the CPU has,
+// the widest kernel on the job system, speedups over scalar, and whether every kernel and the
+// threaded run returned the scalar list exactly.
+
+struct FrustumBenchConfig {
+    uint32_t runs = 5;
+    uint32_t maxObjects = 10000000;
+    uint32_t threads = JobSystemConfig::AUTO_THREADS;
+};
+
+static FrustumBenchConfig parseFrustumArgs(int argc, char** argv) {
+    FrustumBenchConfig config;
+    parseOptions(argc, argv, {
+        { "--runs", &config.runs, 1u },
+        { "--max-objects", &config.maxObjects },
+        { "--threads", &config.threads }
+    });
+    return config;
+}
+
+// what Camera does with XMMatrixLookAtLH / XMMatrixPerspectiveFovLH, written out:
+// eye at (0, 0, -120) looking down +z, row vectors
+static CullPlanes makeCameraPlanes() {
+    const float fov = 1.0471976f;
+    const float nearZ = 0.1f;
+    const float farZ = 400.0f;
+    const float yScale = 1.0f / std::tan(fov * 0.5f);
+    const float xScale = yScale; // aspect 1
+    const float range = farZ / (farZ - nearZ);
+
+    const float view[4][4] = {
+        { 1.0f, 0.0f, 0.0f, 0.0f },
+        { 0.0f, 1.0f, 0.0f, 0.0f },
+        { 0.0f, 0.0f, 1.0f, 0.0f },
+        { 0.0f, 0.0f, 120.0f, 1.0f }
+    };
+    const float projection[4][4] = {
+        { xScale, 0.0f, 0.0f, 0.0f },
+        { 0.0f, yScale, 0.0f, 0.0f },
+        { 0.0f, 0.0f, range, 1.0f },
+        { 0.0f, 0.0f, -range * nearZ, 0.0f }
+    };
+
+    float viewProjection[4][4] = {};
+    for (uint32_t r = 0; r < 4; ++r) {
+        for (uint32_t c = 0; c < 4; ++c) {
+            for (uint32_t k = 0; k < 4; ++k) {
+                viewProjection[r][c] += view[r][k] * projection[k][c];
+            }
+        }
+    }
+    return FrustumCuller::extractPlanes(viewProjection);
+}
+
+template <typename Volumes>
+static void runFrustum(const FrustumBenchConfig& config, const Volumes& volumes, const CullPlanes& planes, JobSystem& jobs) {
+    const uint32_t count = volumes.size();
+    static const CullKernel kernels[] = { CullKernel::Scalar, CullKernel::Sse, CullKernel::Avx2 };
+
+    std::vector<uint32_t> reference(count);
+    std::vector<uint32_t> output(count);
+    uint32_t visible = 0;
+    double ms[3] = {};
+    bool match = true;
+
+    for (uint32_t k = 0; k < 3; ++k) {
+        if (!FrustumCuller::isSupported(kernels[k])) {
+            ms[k] = -1.0;
+            continue;
+        }
+        FrustumCuller culler(kernels[k]);
+        uint32_t* target = k == 0 ? reference.data() : output.data();
+        uint32_t written = 0;
+        ms[k] = timeMs(config.runs, [&] {
+            written = culler.cull(volumes, planes, target);
+        });
+        if (k == 0) {
+            visible = written;
+        } else {
+            match = match && written == visible && std::memcmp(target, reference.data(), size_t(visible) * sizeof(uint32_t)) == 0;
+        }
+    }
+
+    FrustumCuller best;
+    uint32_t written = 0;
+    double threadedMs = timeMs(config.runs, [&] {
+        written = best.cull(volumes, planes, output.data(), &jobs);
+    });
+    match = match && written == visible && std::memcmp(output.data(), reference.data(), size_t(visible) * sizeof(uint32_t)) == 0;
+
+    double fastest = ms[0];
+    for (double time : ms) {
+        if (time > 0.0) {
+            fastest = std::min(fastest, time);
+        }
+    }
+
+    std::printf("%9u %8.1f%%", count, 100.0 * visible / std::max(count, 1u));
+    for (double time : ms) {
+        if (time < 0.0) {
+            std::printf(" %9s", "-");
+        } else {
+            std::printf(" %9.3f", time);
+        }
+    }
+    std::printf(" %9.3f %8.1fx %8.1fx %6s\n",
+        threadedMs, ms[0] / fastest, ms[0] / threadedMs, match ? "yes" : "NO");
+}
+
+static void printHeader(const char* volumes) {
+    std::printf("%s\n%9s %9s %9s %9s %9s %9s %9s %9s %6s\n", volumes,
+        "objects", "visible", "scalar", "SSE", "AVX2", "best NT", "SIMD", "SIMD+NT", "match");
+}
+
+int runFrustumBenchmark(int argc, char** argv) {
+    FrustumBenchConfig config = parseFrustumArgs(argc, argv);
+
+    JobSystemConfig jobConfig;
+    jobConfig.threads = config.threads;
+    JobSystem jobs(jobConfig);
+
+    const CullPlanes planes = makeCameraPlanes();
+    std::printf("frustum: %u runs each, best kernel %s, %u threads (ms per cull)\n",
+        config.runs, FrustumCuller::getKernelName(FrustumCuller().getKernel()), jobs.getThreadCount());
+
+    printHeader("spheres");
+    for (uint32_t count = 100000; count <= config.maxObjects; count *= 10) {
+        BoundingSpheres spheres;
+        spheres.resize(count);
+        uint32_t random = 0x2545f491u;
+        for (uint32_t i = 0; i < count; ++i) {
+            float x = randomRange(random, -100.0f, 100.0f);
+            float y = randomRange(random, -100.0f, 100.0f);
+            float z = randomRange(random, -100.0f, 100.0f);
+            spheres.set(i, x, y, z, randomRange(random, 0.5f, 2.0f));
+        }
+        runFrustum(config, spheres, planes, jobs);
+    }
+
+    printHeader("boxes");
+    for (uint32_t count = 100000; count <= config.maxObjects; count *= 10) {
+        BoundingBoxes boxes;
+        boxes.resize(count);
+        uint32_t random = 0x9e3779b9u;
+        for (uint32_t i = 0; i < count; ++i) {
+            const float center[3] = {
+                randomRange(random, -100.0f, 100.0f),
+                randomRange(random, -100.0f, 100.0f),
+                randomRange(random, -100.0f, 100.0f)
+            };
+            const float extent[3] = {
+                randomRange(random, 0.25f, 2.0f),
+                randomRange(random, 0.25f, 2.0f),
+                randomRange(random, 0.25f, 2.0f)
+            };
+            boxes.set(i, center, extent);
+        }
+        runFrustum(config, boxes, planes, jobs);
+    }
+    return 0;
+}
@@ -0,0 +1,252 @@
+#include "benchmarks.h"
+#include "bench_common.h"
+#include "engine/geometry_buffer.h"
+#include "engine/draw_list.h"
+#include "engine/upload_manager.h"
+#include "engine/rhi/null/null_device.h"
+#include "engine/rhi/rhi_command_queue.h"
+#include "engine/rhi/rhi_deferred_release.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Global geometry megabuffer.
+// binds -> D draws over M distinct meshes (random mesh and material per draw, sorted by the draw list),
+//          meshes in buffers of their own vs. ranges of the megabuffer:
+//          IA binds the recording set and recording time
+// churn -> the megabuffer filled to ~7/8, then rounds of "remove a random half, compactIfFragmented,
+//          refill with new random sizes": fragmentation before / after the compaction check,
+//          bytes the compactions copied and their CPU cost; every live mesh's vertices and
+//          indices are checked against their source data at the end (moves must preserve them)
+
+struct GeometryBenchConfig {
+    uint32_t runs = 5;
+    uint32_t draws = 100000;
+    uint32_t rounds = 8;
+};
+
+static GeometryBenchConfig parseGeometryArgs(int argc, char** argv) {
+    GeometryBenchConfig config;
+    parseOptions(argc, argv, {
+        { "--runs", &config.runs, 1u },
+        { "--draws", &config.draws, 1u },
+        { "--rounds", &config.rounds }
+    });
+    return config;
+}
+
+static const uint32_t VERTEX_STRIDE = 32;
+
+// vertex words / indices derived from the mesh's tag -> verifiable wherever the mesh ends up
+static void fillMesh(uint32_t tag, uint32_t vertexCount, uint32_t indexCount, std::vector<uint32_t>& vertices, std::vector<uint32_t>& indices) {
+    vertices.resize(size_t(vertexCount) * (VERTEX_STRIDE / sizeof(uint32_t)));
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        vertices[i] = tag * 2654435761u + static_cast<uint32_t>(i);
+    }
+    indices.resize(indexCount);
+    for (uint32_t i = 0; i < indexCount; ++i) {
+        indices[i] = (tag + i) % vertexCount;
+    }
+}
+
+static void runBinds(const GeometryBenchConfig& config, uint32_t meshes) {
+    NullDeviceConfig deviceConfig;
+    deviceConfig.fenceLatency = 0;
+    deviceConfig.recordCommands = false;
+    NullDevice device(deviceConfig);
+    auto queue = device.createCommandQueue(RhiCommandListType::Direct);
+    auto pipeline = device.createPipeline({});
+    UploadManager uploads(&device);
+    RhiDeferredReleaseQueue releaseQueue;
+
+    GeometryBufferConfig geometryConfig;
+    geometryConfig.vertexCapacity = meshes * 24;
+    geometryConfig.indexCapacity = meshes * 36;
+    GeometryBuffer geometry(&device, queue.get(), &uploads, &releaseQueue, geometryConfig);
+
+    // 24 vertices / 36 indices each (a cube with split normals)
+    std::vector<std::unique_ptr<RhiBuffer>> ownBuffers;
+    std::vector<GeometryHandle> handles;
+    std::vector<uint32_t> vertices;
+    std::vector<uint32_t> indices;
+    for (uint32_t mesh = 0; mesh < meshes; ++mesh) {
+        fillMesh(mesh, 24, 36, vertices, indices);
+        ownBuffers.push_back(uploads.createBuffer(vertices.data(), 24, VERTEX_STRIDE));
+        ownBuffers.push_back(uploads.createBuffer(indices.data(), 36, sizeof(uint32_t)));
+        handles.push_back(geometry.add(vertices.data(), 24, indices.data(), 36));
+    }
+    geometry.commit();
+
+    DrawList separate;
+    DrawList shared;
+    uint32_t separateId = separate.addPipeline(pipeline.get());
+    uint32_t sharedId = shared.addPipeline(pipeline.get());
+
+    uint32_t random = 0x9e3779b9u;
+    for (uint32_t i = 0; i < config.draws; ++i) {
+        uint32_t mesh = nextRandom(random) % meshes;
+        uint32_t material = nextRandom(random) % 256;
+        float depth = static_cast<float>(nextRandom(random) % 65536) / 65535.0f;
+
+        DrawCommand draw;
+        draw.pipeline = separateId;
+        draw.materialIndex = material;
+        const RhiBuffer* vertexBuffer = ownBuffers[mesh * 2].get();
+        const RhiBuffer* indexBuffer = ownBuffers[mesh * 2 + 1].get();
+        draw.vertexBuffer = { vertexBuffer->getGPUAddress(), vertexBuffer->getSize(), VERTEX_STRIDE };
+        draw.indexBuffer = { indexBuffer->getGPUAddress(), indexBuffer->getSize(), RhiFormat::R32Uint };
+        draw.indexCount = 36;
+        separate.add(0, DrawBlend::Opaque, depth, draw);
+
+        const MeshRange& range = geometry.getRange(handles[mesh]);
+        draw.pipeline = sharedId;
+        draw.vertexBuffer = geometry.getVertexView();
+        draw.indexBuffer = geometry.getIndexView();
+        draw.startIndex = range.firstIndex;
+        draw.baseVertex = range.baseVertex;
+        shared.add(0, DrawBlend::Opaque, depth, draw);
+    }
+    separate.sort();
+    shared.sort();
+
+    auto record = [&](const DrawList& drawList, DrawListStats& stats) {
+        std::chrono::duration<double, std::milli> total{ 0 };
+        for (uint32_t run = 0; run < config.runs; ++run) {
+            RhiCommandList* list = queue->getCommandList();
+            auto t0 = Clock::now();
+            stats = drawList.record(list);
+            total += Clock::now() - t0;
+            queue->executeCommandList(list);
+        }
+        return total.count() / config.runs;
+    };
+
+    DrawListStats separateStats;
+    DrawListStats sharedStats;
+    double separateMs = record(separate, separateStats);
+    double sharedMs = record(shared, sharedStats);
+    queue->flush();
+
+    std::printf("%8u %8u %12llu %10.3f %12llu %10.3f\n",
+        meshes, config.draws,
+        static_cast<unsigned long long>(separateStats.bufferChanges), separateMs,
+        static_cast<unsigned long long>(sharedStats.bufferChanges), sharedMs);
+}
+
+struct LiveMesh {
+    GeometryHandle handle;
+    uint32_t tag;
+};
+
+static void runChurn(const GeometryBenchConfig& config) {
+    NullDeviceConfig deviceConfig;
+    deviceConfig.fenceLatency = 0;
+    deviceConfig.recordCommands = false;
+    NullDevice device(deviceConfig);
+    auto queue = device.createCommandQueue(RhiCommandListType::Direct);
+    UploadManager uploads(&device);
+    RhiDeferredReleaseQueue releaseQueue;
+
+    GeometryBufferConfig geometryConfig;
+    geometryConfig.vertexCapacity = 1u << 20;
+    geometryConfig.indexCapacity = 3u << 20;
+    GeometryBuffer geometry(&device, queue.get(), &uploads, &releaseQueue, geometryConfig);
+
+    std::vector<LiveMesh> live;
+    std::vector<uint32_t> vertices;
+    std::vector<uint32_t> indices;
+    uint32_t random = 0x1234567u;
+    uint32_t nextTag = 0;
+
+    // 64 - 8191 vertices, 1.5 indices per vertex
+    auto addMesh = [&]() {
+        uint32_t vertexCount = 64u << (nextRandom(random) % 7);
+        vertexCount += nextRandom(random) % vertexCount;
+        uint32_t indexCount = vertexCount * 3 / 2;
+        if (geometry.getUsedVertices() + vertexCount > geometryConfig.vertexCapacity * 7 / 8) {
+            return false;
+        }
+        fillMesh(nextTag, vertexCount, indexCount, vertices, indices);
+        live.push_back({ geometry.add(vertices.data(), vertexCount, indices.data(), indexCount), nextTag });
+        nextTag++;
+        return true;
+    };
+
+    while (addMesh()) {
+    }
+    geometry.commit();
+
+    std::printf("%6s %7s %10s %10s %12s %12s %12s\n",
+        "round", "meshes", "frag", "frag after", "compactions", "MB moved", "compact ms");
+
+    for (uint32_t round = 0; round < config.rounds; ++round) {
+        // remove a random half
+        for (size_t i = live.size(); i > 1; --i) {
+            std::swap(live[i - 1], live[nextRandom(random) % i]);
+        }
+        size_t keep = live.size() / 2;
+        for (size_t i = keep; i < live.size(); ++i) {
+            geometry.remove(live[i].handle);
+        }
+        live.resize(keep);
+
+        // holes all over the buffer -> compacted when they scatter the free space enough
+        const GeometryBufferStats before = geometry.getStats();
+        float fragmentation = geometry.getFragmentation();
+        auto t0 = Clock::now();
+        geometry.compactIfFragmented();
+        std::chrono::duration<double, std::milli> compactMs = Clock::now() - t0;
+        const GeometryBufferStats& after = geometry.getStats();
+
+        std::printf("%6u %7u %10.3f %10.3f %12llu %12.2f %12.3f\n",
+            round, geometry.getMeshCount(), fragmentation, geometry.getFragmentation(),
+            static_cast<unsigned long long>(after.compactions),
+            static_cast<double>(after.bytesMoved - before.bytesMoved) / (1024.0 * 1024.0),
+            after.compactions == before.compactions ? 0.0 : compactMs.count());
+
+        // refill with new sizes
+        while (addMesh()) {
+        }
+        geometry.commit();
+        releaseQueue.collect();
+    }
+
+    // every copy executed -> the null buffers hold what the GPU would
+    uploads.flush();
+    queue->flush();
+
+    auto vertexData = static_cast<NullBuffer*>(geometry.getVertexBuffer())->getData();
+    auto indexData = static_cast<NullBuffer*>(geometry.getIndexBuffer())->getData();
+    uint32_t mismatches = 0;
+    for (const LiveMesh& mesh : live) {
+        const MeshRange& range = geometry.getRange(mesh.handle);
+        fillMesh(mesh.tag, range.vertexCount, range.indexCount, vertices, indices);
+        if (std::memcmp(vertexData + uint64_t(range.baseVertex) * VERTEX_STRIDE, vertices.data(), size_t(range.vertexCount) * VERTEX_STRIDE) != 0 ||
+            std::memcmp(indexData + uint64_t(range.firstIndex) * sizeof(uint32_t), indices.data(), size_t(range.indexCount) * sizeof(uint32_t)) != 0) {
+            mismatches++;
+        }
+    }
+
+    const GeometryBufferStats& stats = geometry.getStats();
+    std::printf("%u live meshes verified: %s (%llu compactions, %llu copy regions)\n",
+        static_cast<uint32_t>(live.size()), mismatches == 0 ? "data intact" : "DATA MISMATCH",
+        static_cast<unsigned long long>(stats.compactions), static_cast<unsigned long long>(stats.copyRegions));
+}
+
+int runGeometryBenchmark(int argc, char** argv) {
+    GeometryBenchConfig config = parseGeometryArgs(argc, argv);
+
+    std::printf("geometry: %u runs each\n", config.runs);
+    std::printf("%8s %8s %12s %10s %12s %10s\n",
+        "meshes", "draws", "own binds", "own ms", "shared binds", "shared ms");
+    for (uint32_t meshes = 16; meshes <= 4096; meshes *= 16) {
+        runBinds(config, meshes);
+    }
+
+    std::printf("\n");
+    runChurn(config);
+    return 0;
+}
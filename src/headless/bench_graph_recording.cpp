@@ -0,0 +1,217 @@
+#include "benchmarks.h"
+#include "bench_common.h"
+#include "engine/render_graph.h"
+#include "engine/transient_resource_pool.h"
+#include "engine/job_system.h"
+#include "engine/rhi/rhi_deferred_release.h"
+#include "engine/rhi/null/null_device.h"
+#include "engine/rhi/null/null_command_queue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Render graph recording vs. thread count.
+// Frame of four passes: shadow (30% of the draws), depth prepass (20%), main (50%) and a
+// one-draw composite into the back buffer. The three draw passes are split into chunks, two per
+// thread; with a job system every chunk records its own list. "serial" is the graph without
+// one: one list per batch, everything on the calling thread.
+
+struct GraphRecordingBenchConfig {
+    uint32_t draws = 50000;
+    uint32_t frames = 50;
+    uint32_t maxThreads = 16;
+};
+
+static GraphRecordingBenchConfig parseGraphRecordingArgs(int argc, char** argv) {
+    GraphRecordingBenchConfig config;
+    parseOptions(argc, argv, {
+        { "--draws", &config.draws },
+        { "--frames", &config.frames },
+        { "--threads", &config.maxThreads }
+    });
+    return config;
+}
+
+// this chunk's share of a pass's draws, each bound like a real mesh draw
+static void recordChunk(RenderGraphContext& context, RhiPipeline* pipeline, uint32_t firstDraw, uint32_t draws) {
+    const RhiVertexBufferView vbView = { 0x10000, 8 * 32, 32 };
+    const RhiIndexBufferView ibView = { 0x20000, 36 * 4, RhiFormat::R32Uint };
+
+    uint32_t chunkSize = (draws + context.getChunkCount() - 1) / context.getChunkCount();
+    uint32_t first = std::min(draws, context.getChunk() * chunkSize);
+    uint32_t count = std::min(draws - first, chunkSize);
+
+    RhiCommandList* list = context.getCommandList();
+    list->setPipeline(pipeline);
+    list->setPrimitiveTopology(RhiPrimitiveTopology::TriangleList);
+    list->setVertexBuffer(0, vbView);
+    list->setIndexBuffer(ibView);
+
+    for (uint32_t i = firstDraw + first; i < firstDraw + first + count; ++i) {
+        list->setGraphicsRootConstantBufferView(0, 0x30000 + uint64_t(i) * 256);
+        list->drawIndexedInstanced(36, 1, 0, 0, 0);
+    }
+}
+
+// threads == 0 -> no pool
+static void runThreads(const GraphRecordingBenchConfig& config, uint32_t threads, double& baseline) {
+    NullDeviceConfig deviceConfig;
+    deviceConfig.fenceLatency = 0;
+    NullDevice device(deviceConfig);
+
+    auto graphics = device.createCommandQueue(RhiCommandListType::Direct);
+    auto pipeline = device.createPipeline({});
+
+    NullResource backBuffer;
+    RhiDeferredReleaseQueue releaseQueue;
+    ResourceStateRegistry registry;
+    registry.add({ &backBuffer }, RhiResourceState::Present);
+
+    TransientResourcePool pool(&device, graphics.get(), &releaseQueue, &registry);
+    RenderGraph graph(graphics.get(), nullptr, &registry, &pool);
+
+    std::unique_ptr<JobSystem> jobs;
+    if (threads > 0) {
+        JobSystemConfig jobConfig;
+        jobConfig.threads = threads - 1; // the caller records too
+        jobs = std::make_unique<JobSystem>(jobConfig);
+        graph.setJobSystem(jobs.get());
+    }
+    uint32_t chunks = std::max(threads, 1u) * 2;
+
+    RhiTextureDesc shadowDesc;
+    shadowDesc.width = 2048;
+    shadowDesc.height = 2048;
+    shadowDesc.format = RhiFormat::D24UnormS8Uint;
+    shadowDesc.usage = RhiTextureUsage::DepthStencil;
+    shadowDesc.initialState = RhiResourceState::DepthWrite;
+
+    RhiTextureDesc depthDesc = shadowDesc;
+    depthDesc.width = 1920;
+    depthDesc.height = 1080;
+
+    RhiTextureDesc colorDesc;
+    colorDesc.width = 1920;
+    colorDesc.height = 1080;
+    colorDesc.format = RhiFormat::R8G8B8A8Unorm;
+    colorDesc.usage = RhiTextureUsage::RenderTarget;
+    colorDesc.initialState = RhiResourceState::RenderTarget;
+
+    uint32_t shadowDraws = config.draws * 3 / 10;
+    uint32_t prepassDraws = config.draws * 2 / 10;
+    uint32_t mainDraws = config.draws - shadowDraws - prepassDraws;
+    RhiPipeline* pso = pipeline.get();
+
+    std::chrono::duration<double> recordTime{ 0 };
+    std::chrono::duration<double> submitTime{ 0 };
+
+    device.getStats().reset();
+
+    for (uint32_t frame = 0; frame < config.frames; ++frame) {
+        graph.reset();
+        RenderGraphResource output = graph.importResource({ &backBuffer }, RhiResourceState::Present);
+        RenderGraphResource shadow;
+        RenderGraphResource depth;
+        RenderGraphResource color;
+
+        graph.addPass("shadow", RenderGraphQueue::Graphics,
+            [&](RenderGraphBuilder& builder) {
+                shadow = builder.createTexture(shadowDesc);
+                builder.write(shadow, RhiResourceState::DepthWrite);
+                builder.setChunks(chunks);
+            },
+            [=](RenderGraphContext& context) {
+                recordChunk(context, pso, 0, shadowDraws);
+            }
+        );
+        graph.addPass("prepass", RenderGraphQueue::Graphics,
+            [&](RenderGraphBuilder& builder) {
+                depth = builder.createTexture(depthDesc);
+                builder.write(depth, RhiResourceState::DepthWrite);
+                builder.setChunks(chunks);
+            },
+            [=](RenderGraphContext& context) {
+                recordChunk(context, pso, shadowDraws, prepassDraws);
+            }
+        );
+        graph.addPass("main", RenderGraphQueue::Graphics,
+            [&](RenderGraphBuilder& builder) {
+                color = builder.createTexture(colorDesc);
+                builder.read(shadow, RhiResourceState::PixelShaderResource);
+                builder.read(depth, RhiResourceState::DepthRead);
+                builder.write(color, RhiResourceState::RenderTarget);
+                builder.setChunks(chunks);
+            },
+            [=](RenderGraphContext& context) {
+                recordChunk(context, pso, shadowDraws + prepassDraws, mainDraws);
+            }
+        );
+        graph.addPass("composite", RenderGraphQueue::Graphics,
+            [&](RenderGraphBuilder& builder) {
+                builder.read(color, RhiResourceState::PixelShaderResource);
+                builder.write(output, RhiResourceState::RenderTarget);
+            },
+            [](RenderGraphContext& context) {
+                context.getCommandList()->drawIndexedInstanced(3, 1, 0, 0, 0);
+            }
+        );
+        graph.compile();
+
+        auto t0 = Clock::now();
+        graph.record();
+        auto t1 = Clock::now();
+        graph.submit();
+        auto t2 = Clock::now();
+
+        recordTime += t1 - t0;
+        submitTime += t2 - t1;
+
+        releaseQueue.collect();
+    }
+    graphics->flush();
+
+    double frames = static_cast<double>(config.frames);
+    double record = recordTime.count() / frames;
+    double submit = submitTime.count() / frames;
+    if (threads == 0) {
+        baseline = record + submit;
+    }
+
+    char label[16];
+    std::snprintf(label, sizeof(label), threads == 0 ? "serial" : "%u", threads);
+    std::printf(
+        "%8s %6u %8.1f %10.3f %10.3f %10.3f %10.2f %8.2fx\n",
+        label,
+        graph.getStats().commandLists,
+        device.getStats().barriers.load() / frames,
+        record * 1e3,
+        submit * 1e3,
+        (record + submit) * 1e3,
+        device.getStats().drawCalls.load() / frames / (record + submit) / 1e6,
+        baseline / (record + submit)
+    );
+}
+
+int runGraphRecordingBenchmark(int argc, char** argv) {
+    GraphRecordingBenchConfig config = parseGraphRecordingArgs(argc, argv);
+
+    std::printf(
+        "graph-record: %u draws/frame over 3 passes, %u frames, %u hardware threads\n",
+        config.draws,
+        config.frames,
+        std::thread::hardware_concurrency()
+    );
+    std::printf("%8s %6s %8s %10s %10s %10s %10s %9s\n", "threads", "lists", "barr./f", "record ms", "submit ms", "total ms", "Mdraws/s", "speedup");
+
+    double baseline = 0.0;
+    runThreads(config, 0, baseline);
+    for (uint32_t threads = 1; threads <= config.maxThreads; threads *= 2) {
+        runThreads(config, threads, baseline);
+    }
+
+    return 0;
+}
@@ -0,0 +1,204 @@
+#include "benchmarks.h"
+#include "bench_common.h"
+#include "engine/indirect_draws.h"
+#include "engine/job_system.h"
+#include "engine/rhi/null/null_device.h"
+#include "engine/rhi/rhi_command_queue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// GPU-driven draws at 10k / 100k / 1M candidates (random spheres in a 200^3 box, 60 degree frustum
+// looking down +z -> ~6% visible). Columns:
+//   ref 1T / NT -> CPU reference cull + compaction on one thread / on the job system
+//   match       -> job system output == one thread output == a plain filter loop, byte for byte
+//   direct      -> what the CPU pays without the GPU path: reference cull + a root constant and a draw per visible draw
+//   indirect    -> recording IndirectDrawCuller::cull + draw (3 dispatches, 1 executeIndirect), independent of N
+//   replayed    -> draws the null queue issued for the executeIndirect, with the reference output copied into
+//                  the argument / count buffers in place of the compute shaders (must equal visible)
+
+struct IndirectBenchConfig {
+    uint32_t runs = 5;
+    uint32_t maxDraws = 1000000;
+    uint32_t threads = JobSystemConfig::AUTO_THREADS;
+};
+
+static IndirectBenchConfig parseIndirectArgs(int argc, char** argv) {
+    IndirectBenchConfig config;
+    parseOptions(argc, argv, {
+        { "--runs", &config.runs, 1u },
+        { "--max-draws", &config.maxDraws, 0, IndirectDrawReference::MAX_DRAWS },
+        { "--threads", &config.threads }
+    });
+    return config;
+}
+
+static std::vector<IndirectDrawSource> makeDraws(uint32_t count) {
+    std::vector<IndirectDrawSource> draws(count);
+    uint32_t random = 0x2545f491u;
+    for (uint32_t i = 0; i < count; ++i) {
+        IndirectDrawSource& draw = draws[i];
+        draw.sphere[0] = randomRange(random, -100.0f, 100.0f);
+        draw.sphere[1] = randomRange(random, -100.0f, 100.0f);
+        draw.sphere[2] = randomRange(random, -100.0f, 100.0f);
+        draw.sphere[3] = randomRange(random, 0.5f, 2.0f);
+
+        uint32_t mesh = nextRandom(random) % 256;
+        draw.indexCount = 36;
+        draw.startIndex = mesh * 36;
+        draw.baseVertex = static_cast<int32_t>(mesh * 8);
+        draw.constantsIndex = i;
+    }
+    return draws;
+}
+
+// camera at the origin looking down +z, 60 degree vertical / horizontal field of view
+static CullPlanes makeFrustum() {
+    const float c = std::cos(0.5235988f);
+    const float s = std::sin(0.5235988f);
+    return { {
+        { c, 0.0f, s, 0.0f },      // left
+        { -c, 0.0f, s, 0.0f },     // right
+        { 0.0f, c, s, 0.0f },      // bottom
+        { 0.0f, -c, s, 0.0f },     // top
+        { 0.0f, 0.0f, 1.0f, -0.1f }, // near
+        { 0.0f, 0.0f, -1.0f, 150.0f } // far
+    } };
+}
+
+static void runIndirect(const IndirectBenchConfig& config, uint32_t count, JobSystem& jobs) {
+    NullDeviceConfig deviceConfig;
+    deviceConfig.fenceLatency = 0;
+    deviceConfig.recordCommands = false;
+    NullDevice device(deviceConfig);
+    auto queue = device.createCommandQueue(RhiCommandListType::Direct);
+
+    // the renderer's root layout: 0 = DrawConstants (constantsIndex, materialIndex)
+    RhiRootParameter drawConstants;
+    drawConstants.type = RhiRootParameterType::Constants;
+    drawConstants.shaderRegister = 0;
+    drawConstants.num32BitValues = 2;
+    RhiPipelineDesc pipelineDesc;
+    pipelineDesc.rootParameters = { drawConstants };
+    auto pipeline = device.createPipeline(pipelineDesc);
+
+    std::vector<IndirectDrawSource> draws = makeDraws(count);
+    const CullPlanes planes = makeFrustum();
+
+    IndirectDrawReference reference;
+    std::vector<IndirectDrawArguments> serial(count);
+    std::vector<IndirectDrawArguments> parallel(count);
+    uint32_t visible = 0;
+    uint32_t parallelVisible = 0;
+
+    double serialMs = averageMs(config.runs, [&] {
+        auto t0 = Clock::now();
+        visible = reference.cull(draws.data(), count, planes, serial.data());
+        return Clock::now() - t0;
+    });
+    double parallelMs = averageMs(config.runs, [&] {
+        auto t0 = Clock::now();
+        parallelVisible = reference.cull(draws.data(), count, planes, parallel.data(), &jobs);
+        return Clock::now() - t0;
+    });
+
+    // plain filter -> what the grouped compaction has to reproduce
+    std::vector<IndirectDrawArguments> filtered;
+    for (const IndirectDrawSource& draw : draws) {
+        if (IndirectDrawReference::isVisible(draw, planes)) {
+            filtered.push_back({ draw.constantsIndex, draw.indexCount, 1, draw.startIndex, draw.baseVertex, 0 });
+        }
+    }
+    size_t bytes = size_t(visible) * sizeof(IndirectDrawArguments);
+    bool match = visible == parallelVisible && visible == filtered.size() &&
+        std::memcmp(serial.data(), parallel.data(), bytes) == 0 &&
+        std::memcmp(serial.data(), filtered.data(), bytes) == 0;
+
+    // CPU-driven: cull + one root constant and draw per visible draw
+    device.getStats().reset();
+    double directMs = averageMs(config.runs, [&] {
+        RhiCommandList* list = queue->getCommandList();
+        auto t0 = Clock::now();
+        uint32_t survivors = reference.cull(draws.data(), count, planes, serial.data(), &jobs);
+        list->setPipeline(pipeline.get());
+        for (uint32_t i = 0; i < survivors; ++i) {
+            const IndirectDrawArguments& command = serial[i];
+            list->setGraphicsRoot32BitConstants(0, 1, &command.constantsIndex);
+            list->drawIndexedInstanced(command.indexCountPerInstance, 1, command.startIndexLocation, command.baseVertexLocation, 0);
+        }
+        auto elapsed = Clock::now() - t0;
+        queue->executeCommandList(list);
+        return elapsed;
+    });
+    queue->flush();
+    uint64_t directCommands = device.getStats().commandsExecuted.load() / config.runs;
+
+    // GPU-driven: the sources would sit in a default heap buffer, uploaded once
+    IndirectDrawCuller culler(&device, pipeline.get(), 0, count);
+    RhiBufferDesc sourceDesc;
+    sourceDesc.sizeInBytes = uint64_t(count) * sizeof(IndirectDrawSource);
+    auto sources = device.createBuffer(sourceDesc);
+
+    device.getStats().reset();
+    double indirectMs = averageMs(config.runs, [&] {
+        RhiCommandList* list = queue->getCommandList();
+        auto t0 = Clock::now();
+        culler.cull(list, sources->getGPUAddress(), count, planes);
+        list->setPipeline(pipeline.get());
+        culler.draw(list);
+        auto elapsed = Clock::now() - t0;
+        queue->executeCommandList(list);
+        return elapsed;
+    });
+    queue->flush();
+    uint64_t indirectCommands = device.getStats().commandsExecuted.load() / config.runs;
+
+    // replay: the reference output stands in for the compute shaders' output
+    RhiBufferDesc uploadDesc;
+    uploadDesc.heapType = RhiHeapType::Upload;
+    uploadDesc.sizeInBytes = bytes + sizeof(uint32_t);
+    auto upload = device.createBuffer(uploadDesc);
+    auto mapped = static_cast<uint8_t*>(upload->getMappedData());
+    std::memcpy(mapped, &visible, sizeof(uint32_t));
+    std::memcpy(mapped + sizeof(uint32_t), serial.data(), bytes);
+
+    device.getStats().reset();
+    RhiCommandList* list = queue->getCommandList();
+    list->copyBufferRegion(culler.getCountBuffer()->getHandle(), 0, upload->getHandle(), 0, sizeof(uint32_t));
+    if (bytes > 0) {
+        list->copyBufferRegion(culler.getArgumentBuffer()->getHandle(), 0, upload->getHandle(), sizeof(uint32_t), bytes);
+    }
+    list->setPipeline(pipeline.get());
+    culler.draw(list);
+    queue->executeCommandList(list);
+    queue->flush();
+    uint64_t replayed = device.getStats().drawCalls.load();
+
+    std::printf("%8u %8u %9.3f %9.3f %6s %10.3f %9llu %10.3f %9llu %9llu%s\n",
+        count, visible, serialMs, parallelMs, match ? "yes" : "NO",
+        directMs, static_cast<unsigned long long>(directCommands),
+        indirectMs, static_cast<unsigned long long>(indirectCommands),
+        static_cast<unsigned long long>(replayed),
+        replayed == visible ? "" : "   REPLAY MISMATCH");
+}
+
+int runIndirectBenchmark(int argc, char** argv) {
+    IndirectBenchConfig config = parseIndirectArgs(argc, argv);
+
+    JobSystemConfig jobConfig;
+    jobConfig.threads = config.threads;
+    JobSystem jobs(jobConfig);
+
+    std::printf("indirect: %u runs each, reference on 1 / %u threads\n", config.runs, jobs.getThreadCount());
+    std::printf("%8s %8s %9s %9s %6s %10s %9s %10s %9s %9s\n",
+        "draws", "visible", "ref 1T", "ref NT", "match", "direct ms", "commands", "indirect", "commands", "replayed");
+
+    for (uint32_t draws = 10000; draws <= config.maxDraws; draws *= 10) {
+        runIndirect(config, draws, jobs);
+    }
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include "benchmarks.h"
+#include "bench_common.h"
+#include "engine/instanced_renderer.h"
+#include "engine/frame_upload_allocator.h"
+#include "engine/mesh.h"
+#include "engine/rhi/null/null_device.h"
+#include "engine/rhi/rhi_command_queue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// N copies of one mesh, CPU cost per frame (write the per-object data + record):
+//   per-object -> one 256-byte constant block (MVP) per object and one draw each, the way the
+//                 single-cube path draws today
+//   instanced  -> N InstanceData written into the mapped instance stream, one draw
+// Both run on the null device; commands = what the GPU front end would have to chew through.
+
+struct InstancingBenchConfig {
+    uint32_t frames = 20;
+    uint32_t maxObjects = 100000;
+};
+
+static InstancingBenchConfig parseInstancingArgs(int argc, char** argv) {
+    InstancingBenchConfig config;
+    parseOptions(argc, argv, {
+        { "--frames", &config.frames, 1u },
+        { "--max-objects", &config.maxObjects }
+    });
+    return config;
+}
+
+struct InstancingResult {
+    double ms = 0.0;
+    uint64_t draws = 0;
+    uint64_t commands = 0;
+    uint64_t bytes = 0;
+};
+
+// object i's world matrix -> translation on a grid, the rest identity
+static void objectTransform(uint32_t i, float* transform) {
+    static const float identity[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+    std::memcpy(transform, identity, sizeof(identity));
+    transform[12] = static_cast<float>(i % 256) * 3.0f;
+    transform[14] = static_cast<float>(i / 256) * 3.0f;
+}
+
+static std::unique_ptr<Mesh> makeCube(RhiDevice* device) {
+    std::vector<VertexStruct> vertices(8);
+    for (uint32_t i = 0; i < 8; ++i) {
+        vertices[i] = { { (i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f, 1.0f }, { 1.0f, 1.0f, 1.0f, 1.0f } };
+    }
+    std::vector<uint32_t> indices(36);
+    for (uint32_t i = 0; i < 36; ++i) {
+        indices[i] = i % 8;
+    }
+    return std::make_unique<Mesh>(device, vertices, indices);
+}
+
+static InstancingResult runPerObject(const InstancingBenchConfig& config, uint32_t objects) {
+    NullDeviceConfig deviceConfig;
+    deviceConfig.recordCommands = false;
+    NullDevice device(deviceConfig);
+    auto queue = device.createCommandQueue(RhiCommandListType::Direct);
+    auto pipeline = device.createPipeline({});
+    auto mesh = makeCube(&device);
+
+    FrameUploadAllocator constants(&device, queue.get(), 2, uint64_t(objects) * FrameUploadAllocator::CONSTANT_ALIGNMENT);
+    device.getStats().reset();
+
+    std::chrono::duration<double, std::milli> elapsed{ 0 };
+    for (uint32_t frame = 0; frame < config.frames; ++frame) {
+        constants.beginFrame();
+        RhiCommandList* list = queue->getCommandList();
+
+        auto t0 = Clock::now();
+        list->setPipeline(pipeline.get());
+        list->setPrimitiveTopology(RhiPrimitiveTopology::TriangleList);
+        list->setVertexBuffer(0, mesh->getVertexView());
+        list->setIndexBuffer(mesh->getIndexView());
+        for (uint32_t i = 0; i < objects; ++i) {
+            float mvp[16];
+            objectTransform(i, mvp);
+            UploadAllocation block = constants.upload(mvp, sizeof(mvp));
+            list->setGraphicsRootConstantBufferView(0, block.gpuAddress);
+            list->drawIndexedInstanced(mesh->getIndexCount(), 1, 0, 0, 0);
+        }
+        elapsed += Clock::now() - t0;
+
+        constants.endFrame(queue->executeCommandList(list));
+    }
+    queue->flush();
+
+    InstancingResult result;
+    result.ms = elapsed.count() / config.frames;
+    result.draws = device.getStats().drawCalls.load() / config.frames;
+    result.commands = device.getStats().commandsExecuted.load() / config.frames;
+    result.bytes = uint64_t(objects) * FrameUploadAllocator::CONSTANT_ALIGNMENT;
+    return result;
+}
+
+static InstancingResult runInstanced(const InstancingBenchConfig& config, uint32_t objects) {
+    NullDeviceConfig deviceConfig;
+    deviceConfig.recordCommands = false;
+    NullDevice device(deviceConfig);
+    auto queue = device.createCommandQueue(RhiCommandListType::Direct);
+    auto mesh = makeCube(&device);
+
+    InstancedMeshRenderer instancing(&device, queue.get(), 2, objects);
+    const uint64_t frameConstants = 0x1000; // the frame's matrix, not part of the comparison
+    device.getStats().reset();
+
+    std::chrono::duration<double, std::milli> elapsed{ 0 };
+    for (uint32_t frame = 0; frame < config.frames; ++frame) {
+        instancing.beginFrame();
+        RhiCommandList* list = queue->getCommandList();
+
+        auto t0 = Clock::now();
+        InstanceAllocation instances = instancing.allocate(objects);
+        for (uint32_t i = 0; i < objects; ++i) {
+            InstanceData instance;
+            objectTransform(i, instance.transform);
+            instance.color[0] = instance.color[1] = instance.color[2] = instance.color[3] = 1.0f;
+            instances.instances[i] = instance;
+        }
+        instancing.draw(list, *mesh, instances, frameConstants);
+        elapsed += Clock::now() - t0;
+
+        instancing.endFrame(queue->executeCommandList(list));
+    }
+    queue->flush();
+
+    InstancingResult result;
+    result.ms = elapsed.count() / config.frames;
+    result.draws = device.getStats().drawCalls.load() / config.frames;
+    result.commands = device.getStats().commandsExecuted.load() / config.frames;
+    result.bytes = uint64_t(objects) * sizeof(InstanceData);
+    return result;
+}
+
+static void printInstancingRow(const char* mode, uint32_t objects, const InstancingResult& result, double baseline) {
+    std::printf("%-11s %8u %10.3f %8llu %10llu %10llu %8.2fx\n",
+        mode, objects, result.ms,
+        static_cast<unsigned long long>(result.draws),
+        static_cast<unsigned long long>(result.commands),
+        static_cast<unsigned long long>(result.bytes >> 10),
+        baseline / result.ms);
+}
+
+int runInstancingBenchmark(int argc, char** argv) {
+    InstancingBenchConfig config = parseInstancingArgs(argc, argv);
+
+    std::printf("instancing: %u frames each, one cube mesh\n", config.frames);
+    std::printf("%-11s %8s %10s %8s %10s %10s %9s\n", "mode", "objects", "cpu ms", "draws", "commands", "upload KB", "speedup");
+
+    for (uint32_t objects = 1000; objects <= config.maxObjects; objects *= 10) {
+        InstancingResult perObject = runPerObject(config, objects);
+        InstancingResult instanced = runInstanced(config, objects);
+        printInstancingRow("per-object", objects, perObject, perObject.ms);
+        printInstancingRow("instanced", objects, instanced, perObject.ms);
+    }
+    return 0;
+}
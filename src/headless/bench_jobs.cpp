@@ -0,0 +1,265 @@
+#include "benchmarks.h"
+#include "bench_common.h"
+#include "engine/job_system.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <future>
+#include <thread>
+#include <vector>
+
+// Job system vs. std::async (one thread per task) vs. serial, same work in each:
+//   fork-join -> recursive fibonacci, forking down to a serial cutoff (~1.2k tasks per run)
+//   fine      -> N independent ~1 us tasks queued from the main thread
+//   for       -> per-element math over an array: parallelFor (automatic grain) vs. one
+//                std::async per hardware thread
+//   staged    -> 8 stages of 64 tasks, each stage starting once the previous one finished
+//                (counter dependencies vs. waiting on the futures)
+// Every variant computes a checksum; a mismatch means the scheduler lost or repeated work.
+
+struct JobBenchConfig {
+    uint32_t threads = JobSystemConfig::AUTO_THREADS;
+    uint32_t runs = 5;
+    uint32_t fibonacci = 32;
+    uint32_t cutoff = 18;    // below -> serial
+    uint32_t tasks = 10000;  // fine-grained tasks
+    uint32_t elements = 1 << 22;
+    bool pin = false;
+};
+
+static JobBenchConfig parseJobArgs(int argc, char** argv) {
+    JobBenchConfig config;
+    parseOptions(argc, argv, {
+        { "--threads", &config.threads },
+        { "--runs", &config.runs, 1u },
+        { "--fib", &config.fibonacci },
+        { "--cutoff", &config.cutoff },
+        { "--tasks", &config.tasks },
+        { "--elements", &config.elements },
+        { "--pin", &config.pin }
+    });
+    return config;
+}
+
+// average milliseconds of config.runs calls; result of the last one in checksum
+template <typename Function>
+static double timeRuns(uint32_t runs, uint64_t& checksum, Function&& function) {
+    auto start = Clock::now();
+    for (uint32_t i = 0; i < runs; ++i) {
+        checksum = function();
+    }
+    std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+    return elapsed.count() / runs;
+}
+
+static void printRow(const char* name, double serial, double async, double jobs, bool valid) {
+    std::printf("%-10s %10.3f %10.3f %10.3f %9.2fx %9.2fx%s\n",
+        name, serial, async, jobs, async / jobs, serial / jobs, valid ? "" : "   CHECKSUM MISMATCH");
+}
+
+// ~1 us of arithmetic the compiler can't fold away
+static uint64_t smallTask(uint64_t seed) {
+    uint64_t x = seed * 0x9e3779b97f4a7c15ull + 1;
+    for (uint32_t i = 0; i < 256; ++i) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+    }
+    return x;
+}
+
+static uint64_t fibSerial(uint32_t n) {
+    return n < 2 ? n : fibSerial(n - 1) + fibSerial(n - 2);
+}
+
+static uint64_t fibAsync(uint32_t n, uint32_t cutoff) {
+    if (n <= cutoff) {
+        return fibSerial(n);
+    }
+    auto left = std::async(std::launch::async, fibAsync, n - 1, cutoff);
+    uint64_t right = fibAsync(n - 2, cutoff);
+    return left.get() + right;
+}
+
+static uint64_t fibJobs(JobSystem& jobs, uint32_t n, uint32_t cutoff) {
+    if (n <= cutoff) {
+        return fibSerial(n);
+    }
+    uint64_t left = 0;
+    JobCounter counter;
+    jobs.run([&jobs, &left, n, cutoff] { left = fibJobs(jobs, n - 1, cutoff); }, &counter);
+    uint64_t right = fibJobs(jobs, n - 2, cutoff);
+    jobs.wait(counter);
+    return left + right;
+}
+
+static void runForkJoin(const JobBenchConfig& config, JobSystem& jobs) {
+    uint64_t serial = 0, async = 0, job = 0;
+    double serialMs = timeRuns(config.runs, serial, [&] { return fibSerial(config.fibonacci); });
+    double asyncMs = timeRuns(config.runs, async, [&] { return fibAsync(config.fibonacci, config.cutoff); });
+    double jobMs = timeRuns(config.runs, job, [&] { return fibJobs(jobs, config.fibonacci, config.cutoff); });
+    printRow("fork-join", serialMs, asyncMs, jobMs, serial == async && serial == job);
+}
+
+static void runFine(const JobBenchConfig& config, JobSystem& jobs) {
+    std::vector<uint64_t> results(config.tasks);
+    auto sum = [&] {
+        uint64_t total = 0;
+        for (uint64_t value : results) {
+            total += value;
+        }
+        return total;
+    };
+
+    uint64_t serial = 0, async = 0, job = 0;
+    double serialMs = timeRuns(config.runs, serial, [&] {
+        for (uint32_t i = 0; i < config.tasks; ++i) {
+            results[i] = smallTask(i);
+        }
+        return sum();
+    });
+    double asyncMs = timeRuns(config.runs, async, [&] {
+        std::vector<std::future<void>> futures;
+        futures.reserve(config.tasks);
+        for (uint32_t i = 0; i < config.tasks; ++i) {
+            futures.push_back(std::async(std::launch::async, [&results, i] { results[i] = smallTask(i); }));
+        }
+        for (auto& future : futures) {
+            future.get();
+        }
+        return sum();
+    });
+    double jobMs = timeRuns(config.runs, job, [&] {
+        JobCounter counter;
+        for (uint32_t i = 0; i < config.tasks; ++i) {
+            jobs.run([&results, i] { results[i] = smallTask(i); }, &counter);
+        }
+        jobs.wait(counter);
+        return sum();
+    });
+    printRow("fine", serialMs, asyncMs, jobMs, serial == async && serial == job);
+}
+
+static void runFor(const JobBenchConfig& config, JobSystem& jobs) {
+    std::vector<float> values(config.elements);
+    auto transform = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            float x = static_cast<float>(i) * 0.001f;
+            values[i] = std::sqrt(x * x + 1.0f) * std::sin(x);
+        }
+    };
+    auto sum = [&] {
+        double total = 0.0;
+        for (float value : values) {
+            total += value;
+        }
+        return static_cast<uint64_t>(std::llround(total * 1000.0));
+    };
+
+    uint32_t chunks = std::max(std::thread::hardware_concurrency(), 1u);
+    uint64_t serial = 0, async = 0, job = 0;
+    double serialMs = timeRuns(config.runs, serial, [&] {
+        transform(0, config.elements);
+        return sum();
+    });
+    double asyncMs = timeRuns(config.runs, async, [&] {
+        std::vector<std::future<void>> futures;
+        uint32_t size = (config.elements + chunks - 1) / chunks;
+        for (uint32_t begin = 0; begin < config.elements; begin += size) {
+            futures.push_back(std::async(std::launch::async, transform, begin, std::min(config.elements, begin + size)));
+        }
+        for (auto& future : futures) {
+            future.get();
+        }
+        return sum();
+    });
+    double jobMs = timeRuns(config.runs, job, [&] {
+        jobs.parallelFor(config.elements, transform);
+        return sum();
+    });
+    printRow("for", serialMs, asyncMs, jobMs, serial == async && serial == job);
+}
+
+static void runStaged(const JobBenchConfig& config, JobSystem& jobs) {
+    constexpr uint32_t STAGES = 8;
+    constexpr uint32_t WIDTH = 64;
+    constexpr uint32_t TASK_WORK = 16; // smallTask calls per task
+
+    // task i of stage s reads two results of stage s - 1 -> the stages really depend on each other
+    std::vector<uint64_t> results(STAGES * WIDTH);
+    auto task = [&results](uint32_t stage, uint32_t i) {
+        uint64_t input = stage == 0 ? i : results[(stage - 1) * WIDTH + i] ^ results[(stage - 1) * WIDTH + (i + 1) % WIDTH];
+        for (uint32_t k = 0; k < TASK_WORK; ++k) {
+            input = smallTask(input);
+        }
+        results[stage * WIDTH + i] = input;
+    };
+    auto sum = [&] {
+        uint64_t total = 0;
+        for (uint32_t i = 0; i < WIDTH; ++i) {
+            total += results[(STAGES - 1) * WIDTH + i];
+        }
+        return total;
+    };
+
+    uint64_t serial = 0, async = 0, job = 0;
+    double serialMs = timeRuns(config.runs, serial, [&] {
+        for (uint32_t stage = 0; stage < STAGES; ++stage) {
+            for (uint32_t i = 0; i < WIDTH; ++i) {
+                task(stage, i);
+            }
+        }
+        return sum();
+    });
+    double asyncMs = timeRuns(config.runs, async, [&] {
+        for (uint32_t stage = 0; stage < STAGES; ++stage) {
+            std::vector<std::future<void>> futures;
+            for (uint32_t i = 0; i < WIDTH; ++i) {
+                futures.push_back(std::async(std::launch::async, task, stage, i));
+            }
+            for (auto& future : futures) {
+                future.get();
+            }
+        }
+        return sum();
+    });
+    double jobMs = timeRuns(config.runs, job, [&] {
+        // the whole graph is queued up front; each stage waits on the previous stage's counter
+        JobCounter counters[STAGES];
+        for (uint32_t stage = 0; stage < STAGES; ++stage) {
+            for (uint32_t i = 0; i < WIDTH; ++i) {
+                if (stage == 0) {
+                    jobs.run([&task, i] { task(0, i); }, &counters[0]);
+                } else {
+                    jobs.run([&task, stage, i] { task(stage, i); }, &counters[stage], counters[stage - 1]);
+                }
+            }
+        }
+        jobs.wait(counters[STAGES - 1]);
+        return sum();
+    });
+    printRow("staged", serialMs, asyncMs, jobMs, serial == async && serial == job);
+}
+
+int runJobBenchmark(int argc, char** argv) {
+    JobBenchConfig config = parseJobArgs(argc, argv);
+
+    JobSystemConfig jobConfig;
+    jobConfig.threads = config.threads;
+    jobConfig.pinThreads = config.pin;
+    JobSystem jobs(jobConfig);
+
+    std::printf("jobs: %u threads (%u hardware), %u runs each, fib(%u) cutoff %u, %u fine tasks, %u elements\n",
+        jobs.getThreadCount(), std::thread::hardware_concurrency(), config.runs,
+        config.fibonacci, config.cutoff, config.tasks, config.elements);
+    std::printf("%-10s %10s %10s %10s %10s %10s\n", "workload", "serial ms", "async ms", "jobs ms", "vs async", "vs serial");
+
+    runForkJoin(config, jobs);
+    runFine(config, jobs);
+    runFor(config, jobs);
+    runStaged(config, jobs);
+
+    return 0;
+}
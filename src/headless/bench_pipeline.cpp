@@ -0,0 +1,142 @@
+#include "benchmarks.h"
+#include "bench_common.h"
+#include "engine/frame_pipeline.h"
+#include "engine/renderer.h"
+#include "engine/rhi/null/null_device.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+// Serial frame loop vs. pipelined update / render stages on a CPU-heavy frame.
+// The update stage simulates (a fixed amount of arithmetic) and writes a snapshot; the render
+// stage does its own fixed CPU work (standing in for culling / recording of a big scene) and then
+// runs the renderer on the null device. Serially a frame costs update + render; pipelined it
+// should approach max(update, render), given a core per stage.
+
+struct PipelineBenchConfig {
+    uint32_t frames = 300;
+    uint32_t updateUs = 3000; // approximate CPU cost per stage, calibrated at startup
+    uint32_t renderUs = 2000;
+};
+
+static PipelineBenchConfig parsePipelineArgs(int argc, char** argv) {
+    PipelineBenchConfig config;
+    parseOptions(argc, argv, {
+        { "--frames", &config.frames },
+        { "--update-us", &config.updateUs },
+        { "--render-us", &config.renderUs }
+    });
+    return config;
+}
+
+struct alignas(256) PipelineSnapshot {
+    float mvp[16];
+    uint64_t frame = 0;
+    uint64_t simulation = 0; // result of the update's work -> the render stage consumes it
+};
+
+// fixed work, not a timed spin -> two stages sharing a core really take twice as long
+static uint64_t burn(uint64_t seed, uint64_t iterations) {
+    uint64_t x = seed | 1;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+    }
+    return x;
+}
+
+static uint64_t calibrateIterationsPerUs() {
+    const uint64_t iterations = 20000000;
+    auto start = Clock::now();
+    volatile uint64_t sink = burn(1, iterations);
+    (void)sink;
+    std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+    return static_cast<uint64_t>(iterations / elapsed.count());
+}
+
+// depth 0 -> serial
+static double runPipeline(const PipelineBenchConfig& config, uint32_t depth, uint64_t perUs, double& updateMs, double& renderMs) {
+    NullDeviceConfig deviceConfig;
+    deviceConfig.fenceLatency = 1;
+    NullDevice device(deviceConfig);
+
+    RendererConfig rendererConfig;
+    rendererConfig.width = 1280;
+    rendererConfig.height = 720;
+    Renderer renderer(&device, rendererConfig);
+
+    std::chrono::duration<double> updateTime{ 0 };
+    std::chrono::duration<double> renderTime{ 0 };
+    uint64_t checksum = 0;
+
+    auto update = [&](PipelineSnapshot& snapshot, uint64_t frame) {
+        renderer.waitForNextFrame(); // throttle before the update, like the app
+        auto t0 = Clock::now();
+        snapshot.frame = frame;
+        snapshot.simulation = burn(frame, config.updateUs * perUs);
+        for (uint32_t i = 0; i < 16; ++i) {
+            snapshot.mvp[i] = i % 5 == 0 ? 1.0f : 0.0f;
+        }
+        updateTime += Clock::now() - t0;
+    };
+    auto render = [&](const PipelineSnapshot& snapshot) {
+        auto t0 = Clock::now();
+        checksum += burn(snapshot.simulation, config.renderUs * perUs);
+        renderer.beginFrame();
+        renderer.update(snapshot.mvp, sizeof(snapshot.mvp));
+        renderer.render();
+        renderTime += Clock::now() - t0;
+    };
+
+    auto start = Clock::now();
+    if (depth == 0) {
+        PipelineSnapshot snapshot;
+        for (uint32_t frame = 0; frame < config.frames; ++frame) {
+            update(snapshot, frame);
+            render(snapshot);
+        }
+    } else {
+        FramePipeline<PipelineSnapshot> pipeline(depth, render);
+        for (uint32_t frame = 0; frame < config.frames; ++frame) {
+            update(pipeline.beginUpdate(), frame);
+            pipeline.endUpdate();
+        }
+        pipeline.flush();
+    }
+    std::chrono::duration<double, std::milli> total = Clock::now() - start;
+    renderer.flush();
+
+    double frames = static_cast<double>(config.frames);
+    updateMs = updateTime.count() * 1e3 / frames;
+    renderMs = renderTime.count() * 1e3 / frames;
+    return total.count() / frames;
+}
+
+int runPipelineBenchmark(int argc, char** argv) {
+    PipelineBenchConfig config = parsePipelineArgs(argc, argv);
+    uint64_t perUs = calibrateIterationsPerUs();
+
+    std::printf("pipeline: %u frames, update ~%u us, render ~%u us + renderer, %u hardware threads\n",
+        config.frames, config.updateUs, config.renderUs, std::thread::hardware_concurrency());
+    std::printf("%-8s %10s %10s %10s %10s %10s %9s\n", "mode", "ms/frame", "update ms", "render ms", "sum ms", "max ms", "speedup");
+
+    double serial = 0.0;
+    for (uint32_t depth : { 0u, 1u, 2u, 3u }) {
+        double updateMs = 0.0;
+        double renderMs = 0.0;
+        double frameMs = runPipeline(config, depth, perUs, updateMs, renderMs);
+        if (depth == 0) {
+            serial = frameMs;
+        }
+
+        char label[16];
+        std::snprintf(label, sizeof(label), depth == 0 ? "serial" : "depth %u", depth);
+        std::printf("%-8s %10.3f %10.3f %10.3f %10.3f %10.3f %8.2fx\n",
+            label, frameMs, updateMs, renderMs, updateMs + renderMs, std::max(updateMs, renderMs), serial / frameMs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include "benchmarks.h"
+#include "bench_common.h"
+#include "engine/rhi/null/null_device.h"
+#include "engine/rhi/rhi_command_queue.h"
+#include "engine/rhi/rhi_submission_batch.h"
+
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+// Recording throughput vs. thread count.
+// Every frame N draws are split over T workers, each recording into a list from its own
+// recording context and closing it into a shared submission batch; the main thread then
+// submits the batch with one execute call and one fence signal.
+
+struct RecordingBenchConfig {
+    uint32_t draws = 100000;
+    uint32_t frames = 50;
+    uint32_t maxThreads = 16;
+};
+
+static RecordingBenchConfig parseRecordingArgs(int argc, char** argv) {
+    RecordingBenchConfig config;
+    parseOptions(argc, argv, {
+        { "--draws", &config.draws },
+        { "--frames", &config.frames },
+        { "--threads", &config.maxThreads }
+    });
+    return config;
+}
+
+// the per-draw work a real pass would do: bind constants + mesh, draw
+static void recordDraws(RhiCommandList* list, RhiPipeline* pipeline, uint32_t first, uint32_t count) {
+    const RhiVertexBufferView vbView = { 0x10000, 8 * 32, 32 };
+    const RhiIndexBufferView ibView = { 0x20000, 36 * 4, RhiFormat::R32Uint };
+
+    list->setPipeline(pipeline);
+    list->setPrimitiveTopology(RhiPrimitiveTopology::TriangleList);
+    list->setVertexBuffer(0, vbView);
+    list->setIndexBuffer(ibView);
+
+    for (uint32_t i = first; i < first + count; ++i) {
+        list->setGraphicsRootConstantBufferView(0, 0x30000 + uint64_t(i) * 256);
+        list->drawIndexedInstanced(36, 1, 0, 0, 0);
+    }
+}
+
+static double measure(uint32_t threadCount, const RecordingBenchConfig& config) {
+    NullDevice device;
+    auto queue = device.createCommandQueue(RhiCommandListType::Direct);
+    auto pipeline = device.createPipeline({});
+
+    std::vector<RhiRecordingContext*> contexts(threadCount);
+    for (auto& context : contexts) {
+        context = queue->createRecordingContext();
+    }
+
+    RhiSubmissionBatch batch(queue.get());
+    std::atomic<bool> stop{ false };
+    std::barrier startBarrier(threadCount + 1);
+    std::barrier endBarrier(threadCount + 1);
+
+    std::vector<std::thread> workers;
+    for (uint32_t t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&, t] {
+            uint32_t chunk = (config.draws + threadCount - 1) / threadCount;
+            uint32_t first = std::min(config.draws, t * chunk);
+            uint32_t count = std::min(config.draws - first, chunk);
+
+            while (true) {
+                startBarrier.arrive_and_wait();
+                if (stop) {
+                    break;
+                }
+
+                auto list = contexts[t]->getCommandList();
+                recordDraws(list, pipeline.get(), first, count);
+                batch.add(list, t);
+
+                endBarrier.arrive_and_wait();
+            }
+        });
+    }
+
+    std::chrono::duration<double> total{ 0 };
+
+    for (uint32_t frame = 0; frame < config.frames; ++frame) {
+        auto t0 = Clock::now();
+        startBarrier.arrive_and_wait();
+        endBarrier.arrive_and_wait();
+        batch.submit();
+        total += Clock::now() - t0;
+    }
+
+    stop = true;
+    startBarrier.arrive_and_wait();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    return total.count() / config.frames;
+}
+
+int runRecordingBenchmark(int argc, char** argv) {
+    RecordingBenchConfig config = parseRecordingArgs(argc, argv);
+
+    std::printf(
+        "recording: %u draws/frame, %u frames, %u hardware threads\n",
+        config.draws,
+        config.frames,
+        std::thread::hardware_concurrency()
+    );
+    std::printf("%8s %14s %14s %10s\n", "threads", "ms/frame", "Mdraws/s", "speedup");
+
+    double baseline = 0.0;
+    for (uint32_t threads = 1; threads <= config.maxThreads; threads *= 2) {
+        double seconds = measure(threads, config);
+        if (threads == 1) {
+            baseline = seconds;
+        }
+
+        std::printf(
+            "%8u %14.3f %14.2f %9.2fx\n",
+            threads,
+            seconds * 1e3,
+            config.draws / seconds / 1e6,
+            baseline / seconds
+        );
+    }
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include "benchmarks.h"
+#include "bench_common.h"
+#include "engine/memory/residency_tracker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Residency policy against a simulated budget.
+// A streaming camera walks through the object list: every frame uses a window of objects around
+// its position plus a few random "hot" ones (UI, shared materials), the GPU trails the CPU by a
+// few frames, and the OS usage is whatever the tracker keeps resident. Reports how much gets paged
+// per frame and what the policy costs on the CPU.
+
+struct ResidencyBenchConfig {
+    uint32_t objects = 4096;
+    uint32_t frames = 2000;
+    uint32_t workingSet = 256; // objects per frame
+    uint32_t latency = 2;      // frames the GPU trails behind
+    uint32_t seed = 1234;
+};
+
+static ResidencyBenchConfig parseResidencyArgs(int argc, char** argv) {
+    ResidencyBenchConfig config;
+    parseOptions(argc, argv, {
+        { "--objects", &config.objects },
+        { "--frames", &config.frames },
+        { "--working-set", &config.workingSet },
+        { "--latency", &config.latency },
+        { "--seed", &config.seed }
+    });
+    return config;
+}
+
+static void runBudget(const ResidencyBenchConfig& config, const std::vector<uint64_t>& sizes, uint64_t totalBytes, double budgetFraction) {
+    std::mt19937 rng(config.seed);
+    const uint64_t budget = static_cast<uint64_t>(totalBytes * budgetFraction);
+    const uint32_t hotCount = std::max(1u, config.workingSet / 10);
+
+    ResidencyTracker tracker;
+    ResidencyTracker::Plan plan;
+
+    // ids start at 1 -> 0 never shows up as a pageable
+    for (uint32_t i = 0; i < config.objects; ++i) {
+        tracker.add(i + 1, sizes[i]);
+    }
+
+    // everything starts resident like freshly created resources -> first plan trims to budget
+    std::chrono::duration<double> policyTime{ 0 };
+    uint64_t evictedBytes = 0;
+    uint64_t residentBytes = 0;
+    uint64_t evictBatches = 0;
+    uint64_t residentBatches = 0;
+    uint64_t overBudgetFrames = 0;
+    uint64_t peakUsage = 0;
+
+    std::vector<uint64_t> used;
+    used.reserve(config.workingSet + hotCount);
+
+    for (uint32_t frame = 0; frame < config.frames; ++frame) {
+        uint64_t fence = frame + 1;
+        uint64_t completed = fence > config.latency ? fence - config.latency : 0;
+
+        // sliding window (one object further every frame) + random hot objects
+        used.clear();
+        uint32_t position = frame % config.objects;
+        for (uint32_t i = 0; i < config.workingSet; ++i) {
+            used.push_back((position + i) % config.objects + 1);
+        }
+        for (uint32_t i = 0; i < hotCount; ++i) {
+            used.push_back(rng() % config.objects + 1);
+        }
+
+        auto t0 = Clock::now();
+        for (uint64_t id : used) {
+            tracker.markUsed(id, fence);
+        }
+        tracker.plan(budget, tracker.getResidentBytes(), completed, plan);
+        policyTime += Clock::now() - t0;
+
+        evictedBytes += plan.evictBytes;
+        residentBytes += plan.makeResidentBytes;
+        evictBatches += plan.evict.empty() ? 0 : 1;
+        residentBatches += plan.makeResident.empty() ? 0 : 1;
+        overBudgetFrames += plan.overBudgetBytes > 0 ? 1 : 0;
+        peakUsage = std::max(peakUsage, tracker.getResidentBytes());
+    }
+
+    double frames = static_cast<double>(config.frames);
+    std::printf(
+        "%7.0f%% %10llu %10.2f %12.2f %12.2f %9.2f %9.2f %10llu %9.1f%%\n",
+        budgetFraction * 100.0,
+        static_cast<unsigned long long>(budget >> 20),
+        policyTime.count() * 1e6 / frames,
+        evictedBytes / frames / (1 << 20),
+        residentBytes / frames / (1 << 20),
+        evictBatches / frames,
+        residentBatches / frames,
+        static_cast<unsigned long long>(overBudgetFrames),
+        100.0 * peakUsage / budget
+    );
+}
+
+int runResidencyBenchmark(int argc, char** argv) {
+    ResidencyBenchConfig config = parseResidencyArgs(argc, argv);
+
+    // 64 KB .. 8 MB, log-uniform like a mix of meshes and placed heap blocks
+    std::mt19937 rng(config.seed);
+    std::uniform_real_distribution<double> logSize(16.0, 23.0);
+    std::vector<uint64_t> sizes(config.objects);
+    uint64_t totalBytes = 0;
+    for (auto& size : sizes) {
+        size = (static_cast<uint64_t>(std::exp2(logSize(rng))) + 0xFFFF) & ~0xFFFFull;
+        totalBytes += size;
+    }
+
+    std::printf("residency: %u objects (%llu MB), %u frames, working set %u, GPU latency %u frames\n",
+        config.objects, static_cast<unsigned long long>(totalBytes >> 20), config.frames, config.workingSet, config.latency);
+    std::printf("%8s %10s %10s %12s %12s %9s %9s %10s %10s\n",
+        "budget", "MB", "us/frame", "evict MB/f", "resid MB/f", "evicts/f", "resids/f", "over bud.", "peak use");
+
+    for (double fraction : { 1.0, 0.5, 0.25, 0.1 }) {
+        runBudget(config, sizes, totalBytes, fraction);
+    }
+
+    return 0;
+}
@@ -0,0 +1,149 @@
+#include "benchmarks.h"
+#include "bench_common.h"
+#include "engine/memory/tlsf_allocator.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// TLSF throughput and fragmentation on synthetic traces.
+// Each trace keeps a live set around a target fill level: it allocates log-uniform
+// sizes while below the target and frees random live blocks while above it, so the
+// heap churns the way streaming meshes / transient buffers do.
+
+struct TlsfBenchConfig {
+    uint32_t operations = 1000000;
+    uint32_t seed = 1234;
+};
+
+struct TlsfTrace {
+    const char* name;
+    uint64_t capacity;
+    uint64_t granularity;
+    uint64_t minSize;
+    uint64_t maxSize;
+    double targetFill; // fraction of capacity kept live
+};
+
+static TlsfBenchConfig parseTlsfArgs(int argc, char** argv) {
+    TlsfBenchConfig config;
+    parseOptions(argc, argv, {
+        { "--ops", &config.operations },
+        { "--seed", &config.seed }
+    });
+    return config;
+}
+
+// cost of the Clock::now() pair around every operation -> subtracted from the per-op times
+static double measureClockOverhead() {
+    const int samples = 100000;
+    std::chrono::duration<double> total{ 0 };
+    for (int i = 0; i < samples; ++i) {
+        auto t0 = Clock::now();
+        total += Clock::now() - t0;
+    }
+    return total.count() / samples;
+}
+
+static void runTrace(const TlsfTrace& trace, const TlsfBenchConfig& config, double clockOverhead) {
+    TlsfAllocator allocator(trace.capacity, trace.granularity);
+    std::mt19937_64 rng(config.seed);
+
+    std::uniform_real_distribution<double> logSize(std::log2(double(trace.minSize)), std::log2(double(trace.maxSize)));
+    std::vector<TlsfAllocation> live;
+    live.reserve(1 << 16);
+
+    // sizes / victims drawn up front -> only the allocator is timed
+    std::vector<uint64_t> sizes(config.operations);
+    std::vector<uint64_t> picks(config.operations);
+    for (uint32_t i = 0; i < config.operations; ++i) {
+        sizes[i] = static_cast<uint64_t>(std::exp2(logSize(rng)));
+        picks[i] = rng();
+    }
+
+    std::chrono::duration<double> allocTime{ 0 };
+    std::chrono::duration<double> freeTime{ 0 };
+    uint64_t allocs = 0;
+    uint64_t frees = 0;
+    uint64_t failures = 0;
+    uint64_t requested = 0;
+    uint64_t peakUsed = 0;
+    double worstFragmentation = 0.0;
+
+    const uint64_t target = static_cast<uint64_t>(trace.capacity * trace.targetFill);
+
+    for (uint32_t i = 0; i < config.operations; ++i) {
+        if (allocator.getUsed() < target || live.empty()) {
+            auto t0 = Clock::now();
+            TlsfAllocation allocation = allocator.allocate(sizes[i]);
+            allocTime += Clock::now() - t0;
+            allocs++;
+
+            if (allocation.isValid()) {
+                live.push_back(allocation);
+                requested += sizes[i];
+            } else {
+                failures++;
+
+                // a failure with this much free space is what fragmentation costs
+                uint64_t freeBytes = allocator.getFree();
+                if (freeBytes > 0) {
+                    double fragmentation = 1.0 - double(allocator.getLargestFreeBlock()) / double(freeBytes);
+                    worstFragmentation = std::max(worstFragmentation, fragmentation);
+                }
+            }
+        } else {
+            size_t victim = picks[i] % live.size();
+
+            auto t0 = Clock::now();
+            allocator.free(live[victim]);
+            freeTime += Clock::now() - t0;
+            frees++;
+
+            live[victim] = live.back();
+            live.pop_back();
+        }
+        peakUsed = std::max(peakUsed, allocator.getUsed());
+    }
+
+    uint64_t freeBytes = allocator.getFree();
+    double fragmentation = freeBytes ? 1.0 - double(allocator.getLargestFreeBlock()) / double(freeBytes) : 0.0;
+
+    std::printf(
+        "%-10s %10.1f %10.1f %10llu %9.1f%% %9.1f%% %9.1f%%\n",
+        trace.name,
+        allocs ? (allocTime.count() / allocs - clockOverhead) * 1e9 : 0.0,
+        frees ? (freeTime.count() / frees - clockOverhead) * 1e9 : 0.0,
+        static_cast<unsigned long long>(failures),
+        100.0 * peakUsed / trace.capacity,
+        100.0 * fragmentation,
+        100.0 * worstFragmentation
+    );
+}
+
+int runTlsfBenchmark(int argc, char** argv) {
+    TlsfBenchConfig config = parseTlsfArgs(argc, argv);
+
+    const TlsfTrace traces[] = {
+        // small upload sub-ranges (constants, dynamic vertices)
+        { "constants", 64ull << 20, 256, 256, 64ull << 10, 0.85 },
+        // placed buffers in 64 KB heap granularity (meshes)
+        { "placed", 256ull << 20, 64ull << 10, 64ull << 10, 8ull << 20, 0.80 },
+        // wide size range, near full -> worst case for fragmentation
+        { "mixed", 256ull << 20, 256, 256, 16ull << 20, 0.95 },
+    };
+
+    double clockOverhead = measureClockOverhead();
+
+    std::printf("tlsf: %u operations per trace, seed %u (%.1f ns timer overhead subtracted)\n",
+        config.operations, config.seed, clockOverhead * 1e9);
+    std::printf("%-10s %10s %10s %10s %10s %10s %10s\n", "trace", "alloc ns", "free ns", "failures", "peak use", "frag end", "frag fail");
+
+    for (const auto& trace : traces) {
+        runTrace(trace, config, clockOverhead);
+    }
+
+    return 0;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+// Headless benchmarks, all running on the null device.
+// Each takes the arguments following its name on the command line.
+
+int runRecordingBenchmark(int argc, char** argv);
+int runFenceWaiterBenchmark(int argc, char** argv);
+int runTlsfBenchmark(int argc, char** argv);
+int runDescriptorBenchmark(int argc, char** argv);
+int runResidencyBenchmark(int argc, char** argv);
+int runBarrierBenchmark(int argc, char** argv);
+int runAliasingBenchmark(int argc, char** argv);
+int runRenderGraphBenchmark(int argc, char** argv);
+int runGraphRecordingBenchmark(int argc, char** argv);
+int runJobBenchmark(int argc, char** argv);
+int runPipelineBenchmark(int argc, char** argv);
+int runDrawSortBenchmark(int argc, char** argv);
+int runInstancingBenchmark(int argc, char** argv);
+int runIndirectBenchmark(int argc, char** argv);
+int runGeometryBenchmark(int argc, char** argv);
+int runFrustumBenchmark(int argc, char** argv);
@@ -0,0 +1,247 @@
+#include "benchmarks.h"
+#include "bench_common.h"
+#include "engine/rhi/null/null_device.h"
+#include "engine/renderer.h"
+#include "engine/job_system.h"
+#include "engine/frame_pipeline.h"
+#include "engine/transient_resource_pool.h"
+#include "utils/frame_timer.h"
+#include "utils/logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+// Headless frame loop: the same update / record / submit path as Application,
+// driven by the null device so the CPU cost of a frame can be measured without a GPU or a window.
+//
+// usage: DIRECTX3D_HEADLESS [--frames N] [--width W] [--height H] [--latency L] [--async-compute 0|1] [--budget MB] [--job-threads N] [--pipeline 0|2|3]
+//                           [--frames-in-flight 1-4] [--instances N]
+//        DIRECTX3D_HEADLESS <benchmark> [options]   (see benchmarks.h)
+
+struct alignas(256) HeadlessConstants {
+    float mvp[16];
+};
+
+struct HeadlessConfig {
+    uint32_t frames = 1000;
+    uint32_t width = 1440;
+    uint32_t height = 700;
+    uint32_t fenceLatency = 1;
+    bool asyncCompute = false;
+    uint32_t budgetMB = 4096; // simulated video memory budget
+    uint32_t pipelineDepth = 0; // > 0 -> update and render on separate threads, this many snapshots
+    uint32_t jobThreads = 0; // > 0 -> job system with that many workers, render graph records in parallel
+    uint32_t framesInFlight = 2;
+    uint32_t instances = 0; // extra cube copies per frame, one instanced draw
+};
+
+static HeadlessConfig parseArgs(int argc, char** argv) {
+    HeadlessConfig config;
+    parseOptions(argc - 1, argv + 1, {
+        { "--frames", &config.frames },
+        { "--width", &config.width },
+        { "--height", &config.height },
+        { "--latency", &config.fenceLatency },
+        { "--async-compute", &config.asyncCompute },
+        { "--budget", &config.budgetMB },
+        { "--pipeline", &config.pipelineDepth },
+        { "--job-threads", &config.jobThreads },
+        { "--frames-in-flight", &config.framesInFlight },
+        { "--instances", &config.instances }
+    });
+    return config;
+}
+
+// rotation around Y, row-major -> stands in for the camera math the windowed app does
+static void computeConstants(HeadlessConstants& constants, double totalTime) {
+    float angle = static_cast<float>(totalTime);
+    float c = std::cos(angle);
+    float s = std::sin(angle);
+
+    const float m[16] = {
+           c, 0.0f,   -s, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+           s, 0.0f,    c, 0.0f,
+        0.0f, 0.0f, 5.0f, 1.0f
+    };
+    std::memcpy(constants.mvp, m, sizeof(m));
+}
+
+// grid of cubes in the XZ plane, written straight into the mapped instance stream
+static void writeInstances(const InstanceAllocation& allocation) {
+    uint32_t side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(allocation.count))));
+    for (uint32_t i = 0; i < allocation.count; ++i) {
+        InstanceData instance = {
+            {
+                1.0f, 0.0f, 0.0f, 0.0f,
+                0.0f, 1.0f, 0.0f, 0.0f,
+                0.0f, 0.0f, 1.0f, 0.0f,
+                static_cast<float>(i % side) * 3.0f, 0.0f, static_cast<float>(i / side) * 3.0f, 1.0f
+            },
+            { 1.0f, 1.0f, 1.0f, 1.0f }
+        };
+        allocation.instances[i] = instance;
+    }
+}
+
+struct Benchmark {
+    const char* name;
+    int (*run)(int argc, char** argv);
+};
+
+static const Benchmark benchmarks[] = {
+    { "record-threads", runRecordingBenchmark },
+    { "fence-waiter", runFenceWaiterBenchmark },
+    { "tlsf", runTlsfBenchmark },
+    { "descriptors", runDescriptorBenchmark },
+    { "residency", runResidencyBenchmark },
+    { "barriers", runBarrierBenchmark },
+    { "aliasing", runAliasingBenchmark },
+    { "render-graph", runRenderGraphBenchmark },
+    { "graph-record", runGraphRecordingBenchmark },
+    { "jobs", runJobBenchmark },
+    { "pipeline", runPipelineBenchmark },
+    { "draw-sort", runDrawSortBenchmark },
+    { "instancing", runInstancingBenchmark },
+    { "indirect", runIndirectBenchmark },
+    { "geometry", runGeometryBenchmark },
+    { "frustum", runFrustumBenchmark },
+};
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        for (const auto& benchmark : benchmarks) {
+            if (std::strcmp(argv[1], benchmark.name) == 0) {
+                return benchmark.run(argc - 2, argv + 2);
+            }
+        }
+    }
+
+    HeadlessConfig config = parseArgs(argc, argv);
+
+    NullDeviceConfig deviceConfig;
+    deviceConfig.fenceLatency = config.fenceLatency;
+    deviceConfig.videoMemoryBudget = uint64_t(config.budgetMB) << 20;
+    NullDevice device(deviceConfig);
+
+    RendererConfig rendererConfig;
+    rendererConfig.width = config.width;
+    rendererConfig.height = config.height;
+    rendererConfig.bufferCount = 3;
+    rendererConfig.framesInFlight = config.framesInFlight;
+    rendererConfig.maxInstances = std::max(config.instances, 1u);
+
+    std::unique_ptr<JobSystem> jobs;
+    if (config.jobThreads > 0) {
+        JobSystemConfig jobConfig;
+        jobConfig.threads = config.jobThreads;
+        jobs = std::make_unique<JobSystem>(jobConfig);
+        rendererConfig.jobs = jobs.get();
+    }
+
+    Renderer renderer(&device, rendererConfig);
+    device.getStats().reset();
+
+    std::chrono::duration<double> updateTime{ 0 };
+    std::chrono::duration<double> renderTime{ 0 }; // written by the render stage only
+    std::chrono::duration<double> throttleTime{ 0 };
+
+    // frame-latency throttle, before the update samples anything
+    auto waitForFrame = [&] {
+        auto t0 = Clock::now();
+        renderer.waitForNextFrame();
+        throttleTime += Clock::now() - t0;
+    };
+
+    // render stage: upload the snapshot's constants, record, submit, present
+    auto renderFrame = [&](const HeadlessConstants& constants) {
+        auto t0 = Clock::now();
+        renderer.beginFrame();
+        renderer.update(&constants, sizeof(constants));
+
+        if (config.instances > 0) {
+            InstanceAllocation instances = renderer.allocateInstances(config.instances);
+            writeInstances(instances);
+        }
+
+        if (config.asyncCompute) {
+            // stand-in for a culling / skinning pass whose output the frame consumes
+            RhiCommandQueue* computeQueue = renderer.getComputeQueue();
+            uint64_t value = computeQueue->executeCommandList(computeQueue->getCommandList());
+            renderer.addFrameDependency(computeQueue->getSyncPoint(value));
+        }
+
+        renderer.render();
+        renderTime += Clock::now() - t0;
+    };
+
+    Timer timer;
+    HeadlessConstants constants{};
+    auto start = Clock::now();
+
+    if (config.pipelineDepth > 0) {
+        FramePipeline<HeadlessConstants> pipeline(config.pipelineDepth, renderFrame);
+        for (uint32_t frame = 0; frame < config.frames; ++frame) {
+            waitForFrame();
+            timer.tick();
+
+            auto t0 = Clock::now();
+            HeadlessConstants& snapshot = pipeline.beginUpdate();
+            computeConstants(snapshot, timer.getTotalSeconds());
+            pipeline.endUpdate();
+            updateTime += Clock::now() - t0;
+        }
+        pipeline.flush();
+    } else {
+        for (uint32_t frame = 0; frame < config.frames; ++frame) {
+            waitForFrame();
+            timer.tick();
+
+            auto t0 = Clock::now();
+            computeConstants(constants, timer.getTotalSeconds());
+            updateTime += Clock::now() - t0;
+
+            renderFrame(constants);
+        }
+    }
+    std::chrono::duration<double> totalTime = Clock::now() - start;
+
+    renderer.flush();
+
+    const auto& stats = device.getStats();
+    double frames = static_cast<double>(config.frames == 0 ? 1 : config.frames);
+
+    std::printf("frames            %u\n", config.frames);
+    std::printf("update  (us/frame) %.3f\n", updateTime.count() * 1e6 / frames);
+    std::printf("render  (us/frame) %.3f\n", renderTime.count() * 1e6 / frames);
+    std::printf("throttle(us/frame) %.3f\n", throttleTime.count() * 1e6 / frames);
+    std::printf("total   (us/frame) %.3f\n", totalTime.count() * 1e6 / frames);
+    std::printf("execute calls     %llu\n", static_cast<unsigned long long>(stats.executeCalls.load()));
+    std::printf("lists executed    %llu\n", static_cast<unsigned long long>(stats.commandListsExecuted.load()));
+    std::printf("commands          %llu\n", static_cast<unsigned long long>(stats.commandsExecuted.load()));
+    std::printf("draws             %llu\n", static_cast<unsigned long long>(stats.drawCalls.load()));
+    std::printf("barriers          %llu\n", static_cast<unsigned long long>(stats.barriers.load()));
+    std::printf("barrier calls     %llu\n", static_cast<unsigned long long>(stats.barrierCalls.load()));
+    std::printf("split barriers    %llu\n", static_cast<unsigned long long>(stats.splitBarriers.load()));
+    std::printf("barriers/frame    %.2f (%.2f calls)\n", stats.barriers.load() / frames, stats.barrierCalls.load() / frames);
+    std::printf("aliasing barriers %llu\n", static_cast<unsigned long long>(stats.aliasingBarriers.load()));
+    std::printf("fence signals     %llu\n", static_cast<unsigned long long>(stats.fenceSignals.load()));
+    std::printf("fence waits       %llu\n", static_cast<unsigned long long>(stats.fenceWaits.load()));
+    std::printf("presents          %llu\n", static_cast<unsigned long long>(stats.presents.load()));
+    std::printf("latency waits     %llu (%u frames in flight)\n",
+        static_cast<unsigned long long>(stats.latencyWaits.load()), renderer.getFramesInFlight());
+    std::printf("queue waits       %llu\n", static_cast<unsigned long long>(stats.queueWaits.load()));
+    std::printf("bytes copied      %llu\n", static_cast<unsigned long long>(stats.bytesCopied.load()));
+    std::printf("descriptors       %llu\n", static_cast<unsigned long long>(stats.descriptorsWritten.load()));
+    std::printf("evictions         %llu\n", static_cast<unsigned long long>(stats.evictions.load()));
+    std::printf("made resident     %llu\n", static_cast<unsigned long long>(stats.makeResidents.load()));
+    std::printf("transient heaps   %llu KB (%llu KB saved)\n",
+        static_cast<unsigned long long>(renderer.getTransientPool()->getHeapBytes() >> 10),
+        static_cast<unsigned long long>(renderer.getTransientPool()->getSavedBytes() >> 10));
+
+    return 0;
+}
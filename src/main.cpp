@@ -9,7 +9,8 @@ WindowConfig config = {
     .width = 1440,
     .height = 700,
     .enabledDirectX = false,
-    .useWarp = false};
+    .useWarp = false,
+    .framesInFlight = 2};
 
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow)
 {
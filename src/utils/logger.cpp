@@ -1,13 +1,15 @@
 #include "logger.h"
 #include <chrono>
+#include <ctime>
 #include <iomanip>
 #include <sstream>
 #include <iostream>
 
 Logger::Logger() {
-    std::wstring logDir = L"logs";
-    CreateDirectoryW(logDir.c_str(), nullptr);
-    setLogFilePath(logDir + L"\\engine.log");
+    std::filesystem::path logDir = L"logs";
+    std::error_code ec;
+    std::filesystem::create_directories(logDir, ec);
+    setLogFilePath((logDir / L"engine.log").wstring());
 }
 
 Logger::~Logger() {
@@ -23,18 +25,24 @@ Logger& Logger::instance() {
 void Logger::setLogFilePath(const std::wstring& path) {
     std::lock_guard<std::mutex> lock(mutex);
     if (file.is_open()) file.close();
-    file.open(path, std::ios_base::app);
+    file.open(std::filesystem::path(path), std::ios_base::app);
 }
 
 void Logger::log(LogType level, const char* file, const char* function, int line, const wchar_t* format, ...) {
     wchar_t buffer[4096];
     va_list args;
     va_start(args, format);
+#if defined(_WIN32)
     vswprintf_s(buffer, sizeof(buffer)/sizeof(wchar_t), format, args);
+#else
+    vswprintf(buffer, sizeof(buffer)/sizeof(wchar_t), format, args);
+#endif
     va_end(args);
 
     std::wstring message = formatLogMessage(level, buffer, file, function, line);
+#if defined(_WIN32)
     OutputDebugStringW(message.c_str());
+#endif
     writeLog(message);
 }
 
@@ -50,7 +58,11 @@ std::wstring Logger::formatLogMessage(LogType level, const std::wstring& msg, co
     auto now = std::chrono::system_clock::now();
     std::time_t timeT = std::chrono::system_clock::to_time_t(now);
     std::tm localTime;
+#if defined(_WIN32)
     localtime_s(&localTime, &timeT);
+#else
+    localtime_r(&timeT, &localTime);
+#endif
 
     std::wstringstream ss;
     ss << L"[" << std::put_time(&localTime, L"%Y-%m-%d %H:%M:%S") << L"] ";
@@ -68,6 +80,7 @@ std::wstring Logger::formatLogMessage(LogType level, const std::wstring& msg, co
     return ss.str();
 }
 
+#if defined(_WIN32)
 void Logger::dumpD3D12DebugMessages(ComPtr<ID3D12Device2> device) {
 #if defined(_DEBUG)
     ComPtr<ID3D12InfoQueue> infoQueue;
@@ -89,5 +102,4 @@ void Logger::dumpD3D12DebugMessages(ComPtr<ID3D12Device2> device) {
     }
 #endif
 }
-
-
+#endif
@@ -3,14 +3,17 @@
 #include <string>
 #include <fstream>
 #include <mutex>
-#include <windows.h>
 #include <cstdarg>
 #include <filesystem>
 #include <vector>
-#include <d3d12.h>
-#include <wrl/client.h>
 
-using Microsoft::WRL::ComPtr;
+#if defined(_WIN32)
+    #include <windows.h>
+    #include <d3d12.h>
+    #include <wrl/client.h>
+
+    using Microsoft::WRL::ComPtr;
+#endif
 
 enum class LogType {
     Info,
@@ -25,8 +28,10 @@ public:
     void log(LogType level, const char* file, const char* function, int line, const wchar_t* format, ...);
     void setLogFilePath(const std::wstring& path);
 
+#if defined(_WIN32)
     // New: Dump all D3D12 debug messages from the device
     void dumpD3D12DebugMessages(ComPtr<ID3D12Device2> device);
+#endif
 
 private:
     Logger();
@@ -38,3 +43,9 @@ private:
     std::wofstream file;
     std::mutex mutex;
 };
+
+#define LOG_INFO(fmt, ...)    Logger::instance().log(LogType::Info,    __FILE__, __FUNCTION__, __LINE__, fmt, ##__VA_ARGS__)
+#define LOG_WARNING(fmt, ...) Logger::instance().log(LogType::Warning, __FILE__, __FUNCTION__, __LINE__, fmt, ##__VA_ARGS__)
+#define LOG_ERROR(fmt, ...)   Logger::instance().log(LogType::Error,   __FILE__, __FUNCTION__, __LINE__, fmt, ##__VA_ARGS__)
+#define LOG_DEBUG(fmt, ...)   Logger::instance().log(LogType::Debug,   __FILE__, __FUNCTION__, __LINE__, fmt, ##__VA_ARGS__)
+#define LOG_D3D12_MESSAGES(device) Logger::instance().dumpD3D12DebugMessages(device)
@@ -67,14 +67,6 @@
     #include <dxgidebug.h>
 #endif
 
-#define LOG_INFO(fmt, ...)    Logger::instance().log(LogType::Info,    __FILE__, __FUNCTION__, __LINE__, fmt, __VA_ARGS__)
-#define LOG_WARNING(fmt, ...) Logger::instance().log(LogType::Warning, __FILE__, __FUNCTION__, __LINE__, fmt, __VA_ARGS__)
-#define LOG_ERROR(fmt, ...)   Logger::instance().log(LogType::Error,   __FILE__, __FUNCTION__, __LINE__, fmt, __VA_ARGS__)
-#define LOG_DEBUG(fmt, ...)   Logger::instance().log(LogType::Debug,   __FILE__, __FUNCTION__, __LINE__, fmt, __VA_ARGS__)
-#define LOG_D3D12_MESSAGES(device) Logger::instance().dumpD3D12DebugMessages(device)
-
-static const UINT FRAMEBUFFERCOUNT = 3;
-
 using namespace Microsoft::WRL;
 using namespace DirectX;
 
@@ -88,6 +80,7 @@ struct WindowConfig {
     bool useWarp;
     bool fullscreen = false;
     bool resizable = true;
+    uint32_t framesInFlight = 2; // 1 - 4, CPU frames ahead of the GPU (latency vs. throughput)
 };
 
 struct CameraConfig {
@@ -96,11 +89,6 @@ struct CameraConfig {
     float farZ;
 };
 
-struct alignas(16) VertexStruct {
-    DirectX::XMFLOAT4 position;
-    DirectX::XMFLOAT4 color;
-};
-
 struct alignas(256) ConstantMVP
 {
     DirectX::XMMATRIX mvp;